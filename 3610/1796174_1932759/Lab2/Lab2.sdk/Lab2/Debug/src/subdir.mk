@@ -7,19 +7,52 @@ LD_SRCS += \
 ../src/lscript.ld 
 
 C_SRCS += \
+../src/bench.c \
 ../src/bsp_init.c \
+../src/dma.c \
+../src/osview.c \
+../src/paquet_io.c \
+../src/pio_emac.c \
+../src/pio_gen.c \
+../src/pio_pcap.c \
 ../src/platform.c \
-../src/routeur.c 
+../src/pmu.c \
+../src/profil.c \
+../src/routeur.c \
+../src/slab.c \
+../src/uart.c 
 
 OBJS += \
+./src/bench.o \
 ./src/bsp_init.o \
+./src/dma.o \
+./src/osview.o \
+./src/paquet_io.o \
+./src/pio_emac.o \
+./src/pio_gen.o \
+./src/pio_pcap.o \
 ./src/platform.o \
-./src/routeur.o 
+./src/pmu.o \
+./src/profil.o \
+./src/routeur.o \
+./src/slab.o \
+./src/uart.o 
 
 C_DEPS += \
+./src/bench.d \
 ./src/bsp_init.d \
+./src/dma.d \
+./src/osview.d \
+./src/paquet_io.d \
+./src/pio_emac.d \
+./src/pio_gen.d \
+./src/pio_pcap.d \
 ./src/platform.d \
-./src/routeur.d 
+./src/pmu.d \
+./src/profil.d \
+./src/routeur.d \
+./src/slab.d \
+./src/uart.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
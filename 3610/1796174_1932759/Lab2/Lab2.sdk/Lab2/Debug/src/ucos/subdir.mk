@@ -13,20 +13,29 @@ C_SRCS += \
 ../src/ucos/os_cpu_c.c \
 ../src/ucos/os_dbg.c \
 ../src/ucos/os_flag.c \
+../src/ucos/os_init_tbl.c \
+../src/ucos/os_int_q.c \
 ../src/ucos/os_mbox.c \
 ../src/ucos/os_mem.c \
 ../src/ucos/os_mutex.c \
+../src/ucos/os_mutex_ceil.c \
+../src/ucos/os_pq.c \
 ../src/ucos/os_q.c \
+../src/ucos/os_rr.c \
 ../src/ucos/os_sem.c \
+../src/ucos/os_set.c \
 ../src/ucos/os_task.c \
 ../src/ucos/os_time.c \
-../src/ucos/os_tmr.c 
+../src/ucos/os_tmr.c \
+../src/ucos/os_trace.c \
+../src/ucos/os_view.c 
 
 S_UPPER_SRCS += \
 ../src/ucos/CortexA-MPCore_GIC_a.S \
 ../src/ucos/CortexA-MPCore_SCU.S \
 ../src/ucos/asm_vectors.S \
-../src/ucos/os_cpu_a.S 
+../src/ucos/os_cpu_a.S \
+../src/ucos/os_cpu_mem_a.S 
 
 OBJS += \
 ./src/ucos/CortexA-MPCore_GIC_a.o \
@@ -38,22 +47,32 @@ OBJS += \
 ./src/ucos/os_cpu_a.o \
 ./src/ucos/os_cpu_c.o \
 ./src/ucos/os_cpu_fpu_a.o \
+./src/ucos/os_cpu_mem_a.o \
 ./src/ucos/os_dbg.o \
 ./src/ucos/os_flag.o \
+./src/ucos/os_init_tbl.o \
+./src/ucos/os_int_q.o \
 ./src/ucos/os_mbox.o \
 ./src/ucos/os_mem.o \
 ./src/ucos/os_mutex.o \
+./src/ucos/os_mutex_ceil.o \
+./src/ucos/os_pq.o \
 ./src/ucos/os_q.o \
+./src/ucos/os_rr.o \
 ./src/ucos/os_sem.o \
+./src/ucos/os_set.o \
 ./src/ucos/os_task.o \
 ./src/ucos/os_time.o \
-./src/ucos/os_tmr.o 
+./src/ucos/os_tmr.o \
+./src/ucos/os_trace.o \
+./src/ucos/os_view.o 
 
 S_UPPER_DEPS += \
 ./src/ucos/CortexA-MPCore_GIC_a.d \
 ./src/ucos/CortexA-MPCore_SCU.d \
 ./src/ucos/asm_vectors.d \
-./src/ucos/os_cpu_a.d 
+./src/ucos/os_cpu_a.d \
+./src/ucos/os_cpu_mem_a.d 
 
 C_DEPS += \
 ./src/ucos/CortexA-MPCore_GIC_c.d \
@@ -62,14 +81,22 @@ C_DEPS += \
 ./src/ucos/os_cpu_c.d \
 ./src/ucos/os_dbg.d \
 ./src/ucos/os_flag.d \
+./src/ucos/os_init_tbl.d \
+./src/ucos/os_int_q.d \
 ./src/ucos/os_mbox.d \
 ./src/ucos/os_mem.d \
 ./src/ucos/os_mutex.d \
+./src/ucos/os_mutex_ceil.d \
+./src/ucos/os_pq.d \
 ./src/ucos/os_q.d \
+./src/ucos/os_rr.d \
 ./src/ucos/os_sem.d \
+./src/ucos/os_set.d \
 ./src/ucos/os_task.d \
 ./src/ucos/os_time.d \
-./src/ucos/os_tmr.d 
+./src/ucos/os_tmr.d \
+./src/ucos/os_trace.d \
+./src/ucos/os_view.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,1189 @@
+#include "bench.h"
+#include "slab.h"
+#include "uart.h"
+#include "dma.h"
+#include <stdbool.h>
+#include <string.h>
+#include <malloc.h>
+#include <reent.h>
+#include <xil_printf.h>
+#include <xtime_l.h>
+#include <xuartps_hw.h>
+#include <xil_cache.h>
+#include <xil_io.h>
+#include <xil_mmu.h>
+#include <xemacps.h>
+#include <xl2cc.h>
+#include <xpseudo_asm.h>
+
+#if BENCH_EN
+/*
+ *********************************************************************************************************
+ *                                      Bancs d'essai du noyau
+ * -Mesurent en cycles CPU le coût d'un aller-retour post -> réveil de la tâche en attente.
+ * -XTime_GetTime() compte à la moitié de la fréquence du CPU (COUNTS_PER_SECOND).
+ *********************************************************************************************************
+ */
+
+typedef enum {
+	BENCH_MODE_MULTI, BENCH_MODE_SET, NB_BENCH_MODE
+} BENCH_MODE;
+
+typedef struct {
+	BENCH_MODE mode;
+	OS_EVENT *set;
+	OS_EVENT *sems[BENCH_MAX_EVENTS + 1];	// Terminé par NULL pour OSEventPendMulti()
+	volatile INT32U nb_recus;
+} BENCH_PARAM;
+
+typedef struct {
+	bool fp;								// La tâche utilise le FPU à chaque réveil
+	OS_EVENT *sem;
+	volatile INT32U nb_recus;
+} BENCH_CTX_PARAM;
+
+typedef struct {
+	bool ceil;								// Mutex à priorité plafond plutôt qu'OSMutex
+	OS_EVENT *mutex;
+	OS_MUTEX_CEIL mutex_ceil;
+	OS_EVENT *sem;
+	volatile INT32U nb_recus;
+} BENCH_MUTEX_PARAM;
+
+typedef struct {
+	OS_FLAG_GRP *grp;
+	volatile INT32U nb_recus;
+} BENCH_FLAG_PARAM;
+
+typedef struct {
+	OS_EVENT *q;
+	volatile INT32U nb_recus;
+	volatile INT32U nb_perdus;				// Plus anciens messages abandonnés par OS_Q_POLICY_DROP_HEAD
+} BENCH_Q_PARAM;
+
+typedef struct {
+	INT32U mots[16];						// Comme un Packet du routeur
+} BENCH_PAQUET;
+
+typedef struct {
+	bool pq;								// File à priorités plutôt que trois files et un ensemble
+	OS_EVENT *file;							// File à priorités, une bande par classe
+	OS_EVENT *set;							// Ensemble des files, servies dans l'ordre de leur priorité
+	OS_EVENT *qs[BENCH_PQ_NB_BANDES];
+	volatile INT32U nb_recus;
+	volatile INT32U nb_desordre;			// Messages reçus alors qu'une classe plus urgente attendait
+} BENCH_PQ_PARAM;
+
+static const char *bench_mode_nom[NB_BENCH_MODE] = { "OSEventPendMulti", "OSEventSetPend" };
+static const int bench_nb_events[] = { 3, 16, BENCH_MAX_EVENTS };
+static const size_t bench_malloc_tailles[] = { 16, 64, 512 };	// 64 octets : un Packet du routeur
+static const int bench_flag_nb_taches[] = { 0, 4, BENCH_FLAG_NB_MAX };
+static const INT32U bench_mem_tailles[] = { 16, 64, 256, 1024, BENCH_MEM_TAILLE_MAX };
+static const INT32U bench_cache_tailles[] = { 1024, 4096, 16384, 65536, 262144, BENCH_CACHE_TAILLE_MAX };
+static const INT32U bench_bd_rafales[] = { 1, 4, 16, 32 };
+#if DMA_EN
+static const INT32U bench_dma_tailles[] = { 64, 256, 1024, 2048, 4096, 16384, BENCH_DMA_TAILLE_MAX };
+#endif
+
+static OS_STK TaskBenchStk[BENCH_TASK_STK_SIZE];
+static OS_STK TaskBenchWaiterStk[BENCH_TASK_STK_SIZE];
+static OS_STK TaskBenchFlagStk[BENCH_FLAG_NB_MAX][BENCH_FLAG_STK_SIZE];
+
+static BENCH_PARAM bench_param;
+static BENCH_CTX_PARAM bench_ctx_param;
+static BENCH_MUTEX_PARAM bench_mutex_param;
+static BENCH_FLAG_PARAM bench_flag_param;
+static BENCH_Q_PARAM bench_q_param;
+static BENCH_PQ_PARAM bench_pq_param;
+static volatile double bench_fp_acc;
+
+static inline INT32U bench_cycles(XTime debut, XTime fin) {
+	return (INT32U) ((fin - debut) * 2);
+}
+
+void bench_create(void) {
+	OSTaskCreateExt(TaskBench, NULL, &TaskBenchStk[BENCH_TASK_STK_SIZE-1], BENCH_PRIO, BENCH_PRIO,
+			&TaskBenchStk[0], BENCH_TASK_STK_SIZE, NULL, OS_TASK_OPT_SAVE_FP);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          TaskBenchWaiter
+ * -Attend sur l'ensemble des sémaphores, soit avec OSEventPendMulti(), soit avec un ensemble
+ *  d'événements persistant, puis consomme le sémaphore prêt.
+ *********************************************************************************************************
+ */
+static void TaskBenchWaiter(void *data) {
+	BENCH_PARAM *param = data;
+	OS_EVENT *rdy[BENCH_MAX_EVENTS + 1];
+	void *msgs[BENCH_MAX_EVENTS + 1];
+	uint8_t err;
+
+	while (true) {
+		if (param->mode == BENCH_MODE_SET) {
+			if (OSEventSetPend(param->set, rdy, 1, 0, &err) > 0)
+				OSSemAccept(rdy[0]);
+		} else {
+			OSEventPendMulti(param->sems, rdy, msgs, 0, &err);	// Consomme le sémaphore
+		}
+		param->nb_recus++;
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                       bench_event_set
+ * -Compare OSEventPendMulti() à OSEventSetPend() pour 3, 16 et 64 sémaphores.
+ *********************************************************************************************************
+ */
+static void bench_event_set(void) {
+	uint8_t err;
+	XTime debut, fin;
+
+	xil_printf("\n---------- Attente multiple : cycles par aller-retour ----------\n");
+	for (int mode = 0; mode < NB_BENCH_MODE; ++mode) {
+		for (int n = 0; n < ARRAY_SIZE(bench_nb_events); ++n) {
+			int nb = bench_nb_events[n];
+
+			bench_param.mode = (BENCH_MODE) mode;
+			bench_param.nb_recus = 0;
+			bench_param.set = NULL;
+			if (bench_param.mode == BENCH_MODE_SET)
+				bench_param.set = OSEventSetCreate(&err);
+			for (int i = 0; i < nb; ++i) {
+				bench_param.sems[i] = OSSemCreate(0);
+				if (bench_param.set != NULL)
+					OSEventSetAdd(bench_param.set, bench_param.sems[i], i);
+			}
+			bench_param.sems[nb] = NULL;
+
+			OSTaskCreate(TaskBenchWaiter, &bench_param,
+					&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO);
+
+			XTime_GetTime(&debut);
+			for (int i = 0; i < BENCH_ITER; ++i)
+				OSSemPost(bench_param.sems[i % nb]);
+			XTime_GetTime(&fin);
+
+			xil_printf("%s, %d evenements : %d cycles (%d recus)\n", bench_mode_nom[mode], nb,
+					bench_cycles(debut, fin) / BENCH_ITER, bench_param.nb_recus);
+
+			OSTaskDel(BENCH_WAITER_PRIO);
+			if (bench_param.set != NULL)
+				OSEventSetDel(bench_param.set, OS_DEL_ALWAYS, &err);
+			for (int i = 0; i < nb; ++i)
+				OSSemDel(bench_param.sems[i], OS_DEL_ALWAYS, &err);
+		}
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                          TaskBenchCtxWaiter
+ * -Attend le sémaphore et, si demandé, fait un calcul en virgule flottante à chaque réveil.
+ *********************************************************************************************************
+ */
+static void TaskBenchCtxWaiter(void *data) {
+	BENCH_CTX_PARAM *param = data;
+	uint8_t err;
+
+	while (true) {
+		OSSemPend(param->sem, 0, &err);
+		if (param->fp)
+			bench_fp_acc = bench_fp_acc * 1.0001 + 1.0;
+		param->nb_recus++;
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                         bench_ctx_sw
+ * -Mesure un aller-retour (deux changements de contexte) selon les tâches qui utilisent le FPU :
+ *  aucune, la tâche en attente seulement, ou les deux.  Avec OS_CPU_FPU_LAZY_EN, les registres VFP
+ *  ne sont échangés que dans le dernier cas.
+ *********************************************************************************************************
+ */
+static void bench_ctx_sw(void) {
+	static const char *nom[] = { "sans FPU", "FPU en attente", "FPU des deux cotes" };
+	uint8_t err;
+	XTime debut, fin;
+
+	xil_printf("\n---------- Changement de contexte : cycles par aller-retour ----------\n");
+#if OS_CPU_FPU_EN == 0
+	xil_printf("OS_CPU_FPU_EN = 0 : registres VFP jamais commutes, les trois cas suivent le meme chemin\n");
+#endif
+	for (int cas = 0; cas < ARRAY_SIZE(nom); ++cas) {
+		bool fp_bench = (cas == 2);
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)
+		INT32U nb_sw = OS_CPU_FP_SwCtr;
+#endif
+
+		bench_ctx_param.fp = (cas > 0);
+		bench_ctx_param.nb_recus = 0;
+		bench_ctx_param.sem = OSSemCreate(0);
+		OSTaskCreateExt(TaskBenchCtxWaiter, &bench_ctx_param,
+				&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO, BENCH_WAITER_PRIO,
+				&TaskBenchWaiterStk[0], BENCH_TASK_STK_SIZE, NULL,
+				bench_ctx_param.fp ? OS_TASK_OPT_SAVE_FP : OS_TASK_OPT_NONE);
+
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i) {
+			OSSemPost(bench_ctx_param.sem);
+			if (fp_bench)
+				bench_fp_acc = bench_fp_acc * 0.9999 + 1.0;
+		}
+		XTime_GetTime(&fin);
+
+		xil_printf("%s : %d cycles (%d recus)\n", nom[cas],
+				bench_cycles(debut, fin) / BENCH_ITER, bench_ctx_param.nb_recus);
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)
+		xil_printf("  contextes VFP echanges : %d\n", OS_CPU_FP_SwCtr - nb_sw);
+#endif
+
+		OSTaskDel(BENCH_WAITER_PRIO);
+		OSSemDel(bench_ctx_param.sem, OS_DEL_ALWAYS, &err);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                         TaskBenchMutexWaiter
+ * -Réveillée par le sémaphore, prend puis rend le mutex que la tâche de mesure détient peut-être.
+ *********************************************************************************************************
+ */
+static void bench_mutex_pend(BENCH_MUTEX_PARAM *param) {
+	uint8_t err;
+
+	if (param->ceil)
+		OSMutexCeilPend(&param->mutex_ceil, 0, &err);
+	else
+		OSMutexPend(param->mutex, 0, &err);
+}
+
+static void bench_mutex_post(BENCH_MUTEX_PARAM *param) {
+	if (param->ceil)
+		OSMutexCeilPost(&param->mutex_ceil);
+	else
+		OSMutexPost(param->mutex);
+}
+
+static void TaskBenchMutexWaiter(void *data) {
+	BENCH_MUTEX_PARAM *param = data;
+	uint8_t err;
+
+	while (true) {
+		OSSemPend(param->sem, 0, &err);
+		bench_mutex_pend(param);
+		bench_mutex_post(param);
+		param->nb_recus++;
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_mutex
+ * -Compare OSMutexPend() / OSMutexPost() aux mutex à priorité plafond (OSMutexCeilPend()), sans
+ *  contention, puis quand une tâche plus prioritaire demande le mutex pendant que la tâche de mesure le
+ *  détient.  Avec le plafond, cette tâche n'est réveillée qu'à la libération et ne bloque pas.
+ *********************************************************************************************************
+ */
+static void bench_mutex(void) {
+	static const char *nom[] = { "OSMutexPend", "OSMutexCeilPend" };
+	uint8_t err;
+	XTime debut, fin;
+	INT32U sans_contention;
+
+	xil_printf("\n---------- Mutex : cycles par prise + liberation ----------\n");
+	bench_mutex_param.mutex = OSMutexCreate(BENCH_MUTEX_PIP, &err);
+	OSMutexCeilCreate(&bench_mutex_param.mutex_ceil, BENCH_WAITER_PRIO);
+	bench_mutex_param.sem = OSSemCreate(0);
+	for (int ceil = 0; ceil < ARRAY_SIZE(nom); ++ceil) {
+		bench_mutex_param.ceil = ceil;
+
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i) {
+			bench_mutex_pend(&bench_mutex_param);
+			bench_mutex_post(&bench_mutex_param);
+		}
+		XTime_GetTime(&fin);
+		sans_contention = bench_cycles(debut, fin) / BENCH_ITER;
+
+		bench_mutex_param.nb_recus = 0;
+		OSTaskCreate(TaskBenchMutexWaiter, &bench_mutex_param,
+				&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO);
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i) {
+			bench_mutex_pend(&bench_mutex_param);
+			OSSemPost(bench_mutex_param.sem);	// Réveille la tâche qui demande le mutex
+			bench_mutex_post(&bench_mutex_param);
+		}
+		XTime_GetTime(&fin);
+
+		xil_printf("%s : %d cycles sans contention, %d cycles avec (%d recus)\n", nom[ceil],
+				sans_contention, bench_cycles(debut, fin) / BENCH_ITER, bench_mutex_param.nb_recus);
+		OSTaskDel(BENCH_WAITER_PRIO);
+	}
+	OSMutexDel(bench_mutex_param.mutex, OS_DEL_ALWAYS, &err);
+	OSSemDel(bench_mutex_param.sem, OS_DEL_ALWAYS, &err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                  TaskBenchFlagWaiter / TaskBenchFlagIdle
+ * -TaskBenchFlagWaiter attend le bit 1 du groupe et le consomme.  Les TaskBenchFlagIdle attendent des
+ *  bits qui ne sont jamais postés : sans index, chaque OSFlagPost() les passe quand même en revue.
+ *********************************************************************************************************
+ */
+#define BENCH_FLAG_VIDE      ((OS_FLAGS) 0x01)			// Bit posté que personne n'attend
+#define BENCH_FLAG_REVEIL    ((OS_FLAGS) 0x02)			// Bit attendu par TaskBenchFlagWaiter
+
+static void TaskBenchFlagWaiter(void *data) {
+	BENCH_FLAG_PARAM *param = data;
+	uint8_t err;
+
+	while (true) {
+		OSFlagPend(param->grp, BENCH_FLAG_REVEIL, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err);
+		param->nb_recus++;
+	}
+}
+
+static void TaskBenchFlagIdle(void *data) {
+	OS_FLAGS bit = (OS_FLAGS) 1 << ((INT32U) data % (OS_FLAGS_NBITS - 2) + 2);
+	uint8_t err;
+
+	while (true)
+		OSFlagPend(bench_flag_param.grp, bit, OS_FLAG_WAIT_SET_ALL, 0, &err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_flag
+ * -Coût d'un OSFlagPost() selon le nombre de tâches en attente sur d'autres bits du groupe : post d'un
+ *  bit que personne n'attend (mise à 1 puis à 0), puis aller-retour vers la tâche qui attend le bit
+ *  posté.  À comparer entre une compilation avec OS_FLAG_WAIT_IX_EN à 1 et une à 0.
+ *********************************************************************************************************
+ */
+static void bench_flag(void) {
+	uint8_t err;
+	XTime debut, fin;
+	INT32U post;
+
+	xil_printf("\n---------- Groupes d'evenements sur %d bits (OS_FLAG_WAIT_IX_EN = %d) ----------\n",
+			OS_FLAGS_NBITS, OS_FLAG_WAIT_IX_EN);
+	for (int n = 0; n < ARRAY_SIZE(bench_flag_nb_taches); ++n) {
+		int nb = bench_flag_nb_taches[n];
+
+		bench_flag_param.grp = OSFlagCreate(0, &err);
+		bench_flag_param.nb_recus = 0;
+		for (int i = 0; i < nb; ++i)
+			OSTaskCreate(TaskBenchFlagIdle, (void *) i, &TaskBenchFlagStk[i][BENCH_FLAG_STK_SIZE-1],
+					BENCH_FLAG_PRIO + i);
+		OSTaskCreate(TaskBenchFlagWaiter, &bench_flag_param,
+				&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO);
+		OSTimeDly(1);											// Les tâches moins prioritaires se mettent en attente
+
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i) {
+			OSFlagPost(bench_flag_param.grp, BENCH_FLAG_VIDE, OS_FLAG_SET, &err);
+			OSFlagPost(bench_flag_param.grp, BENCH_FLAG_VIDE, OS_FLAG_CLR, &err);
+		}
+		XTime_GetTime(&fin);
+		post = bench_cycles(debut, fin) / (2 * BENCH_ITER);
+
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i)
+			OSFlagPost(bench_flag_param.grp, BENCH_FLAG_REVEIL, OS_FLAG_SET, &err);
+		XTime_GetTime(&fin);
+
+		xil_printf("%d taches en attente : post %d cycles, aller-retour %d cycles (%d recus)\n", nb, post,
+				bench_cycles(debut, fin) / BENCH_ITER, bench_flag_param.nb_recus);
+
+		OSTaskDel(BENCH_WAITER_PRIO);
+		for (int i = 0; i < nb; ++i)
+			OSTaskDel(BENCH_FLAG_PRIO + i);
+		OSFlagDel(bench_flag_param.grp, OS_DEL_ALWAYS, &err);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                           TaskBenchQWaiter
+ * -Consommateur lent : retire BENCH_Q_LOT messages de la file à chaque tick.
+ *********************************************************************************************************
+ */
+static void TaskBenchQWaiter(void *data) {
+	BENCH_Q_PARAM *param = data;
+	uint8_t err;
+
+	while (true) {
+		for (int i = 0; i < BENCH_Q_LOT; ++i) {
+			OSQPend(param->q, 0, &err);
+			param->nb_recus++;
+		}
+		OSTimeDly(1);
+	}
+}
+
+static void bench_q_perdu(void *msg) {
+	bench_q_param.nb_perdus++;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          bench_q_policy
+ * -Un producteur envoie BENCH_Q_NB_MSGS messages aussi vite que possible dans une file consommée
+ *  lentement, avec chaque politique de débordement puis avec OSQPostPend().  Affiche le débit en
+ *  sortie de file (jusqu'à ce qu'elle soit vide) et le nombre de messages perdus.
+ *********************************************************************************************************
+ */
+static void bench_q_policy(void) {
+	static const char *nom[] = { "OS_Q_POLICY_DROP_TAIL", "OS_Q_POLICY_DROP_HEAD", "OSQPostPend" };
+	static void *msgs[BENCH_Q_SIZE];
+	OS_Q_DATA q_data;
+	INT32U nb_rejetes, duree;
+	XTime debut, fin;
+	uint8_t err;
+
+	xil_printf("\n---------- File saturee : debit et pertes par politique ----------\n");
+	for (int mode = 0; mode < ARRAY_SIZE(nom); ++mode) {
+		bench_q_param.q = OSQCreate(&msgs[0], BENCH_Q_SIZE);
+		OSQPolicySet(bench_q_param.q, mode == 1 ? OS_Q_POLICY_DROP_HEAD : OS_Q_POLICY_DROP_TAIL, bench_q_perdu);
+		bench_q_param.nb_recus = 0;
+		bench_q_param.nb_perdus = 0;
+		nb_rejetes = 0;
+		OSTaskCreate(TaskBenchQWaiter, &bench_q_param,
+				&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO);
+
+		XTime_GetTime(&debut);
+		for (INT32U i = 0; i < BENCH_Q_NB_MSGS; ++i) {
+			if (mode == 2)
+				err = OSQPostPend(bench_q_param.q, (void *) i, 0);
+			else
+				err = OSQPost(bench_q_param.q, (void *) i);
+			if (err != OS_ERR_NONE)
+				nb_rejetes++;
+		}
+		do {										// Attend que le consommateur vide la file
+			OSTimeDly(1);
+			OSQQuery(bench_q_param.q, &q_data);
+		} while (q_data.OSNMsgs > 0);
+		XTime_GetTime(&fin);
+
+		duree = (INT32U) ((fin - debut) * 1000 / COUNTS_PER_SECOND);
+		xil_printf("%s : %d recus en %d ms (%d msg/s), %d perdus (plus anciens), %d rejetes, %d posts en attente\n",
+				nom[mode], bench_q_param.nb_recus, duree,
+				duree > 0 ? bench_q_param.nb_recus * 1000 / duree : 0,
+				bench_q_param.nb_perdus, nb_rejetes, q_data.OSQNPostWait);
+		OSTaskDel(BENCH_WAITER_PRIO);
+		OSQDel(bench_q_param.q, OS_DEL_ALWAYS, &err);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_q_stat
+ * -Coût d'un OSQPost() + OSQAccept() sans tâche en attente, à comparer entre une compilation avec
+ *  OS_Q_STAT_EN à 1 et une à 0, puis coût d'une lecture de la télémétrie d'une file.
+ *********************************************************************************************************
+ */
+static void bench_q_stat(void) {
+	static void *msgs[BENCH_Q_SIZE];
+	OS_EVENT *q;
+	XTime debut, fin;
+	uint8_t err;
+
+	xil_printf("\n---------- Telemetrie des files (OS_Q_STAT_EN = %d) ----------\n", OS_Q_STAT_EN);
+	q = OSQCreate(&msgs[0], BENCH_Q_SIZE);
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_ITER; ++i) {
+		OSQPost(q, NULL);
+		OSQAccept(q, &err);
+	}
+	XTime_GetTime(&fin);
+	xil_printf("OSQPost + OSQAccept : %d cycles\n", bench_cycles(debut, fin) / BENCH_ITER);
+#if OS_Q_STAT_EN > 0u
+	{
+		OS_Q_STAT stat;
+
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i)
+			OSQStatGet(q, &stat, OS_Q_STAT_OPT_NONE);
+		XTime_GetTime(&fin);
+		xil_printf("OSQStatGet : %d cycles (%d posts, max %d, moyenne %d.%02d)\n",
+				bench_cycles(debut, fin) / BENCH_ITER, stat.OSQNPosts, stat.OSQEntriesMax,
+				stat.OSQEntriesAvg / 100, stat.OSQEntriesAvg % 100);
+	}
+#endif
+	OSQDel(q, OS_DEL_ALWAYS, &err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                     bench_pq_post / bench_pq_accept
+ * -Envoie un message dans la classe 'bande' et retire le message le plus urgent sans attendre, avec la
+ *  file à priorités ou avec trois files et un ensemble d'événements comme dans le routeur.
+ * -Le message est sa propre classe, ce qui permet de vérifier l'ordre de service.
+ *********************************************************************************************************
+ */
+static INT8U bench_pq_post(BENCH_PQ_PARAM *param, INT8U bande) {
+	if (param->pq)
+		return OSPQPost(param->file, (void *) (INT32U) bande, bande);
+	return OSQPost(param->qs[bande], (void *) (INT32U) bande);
+}
+
+static INT32U bench_pq_accept(BENCH_PQ_PARAM *param, INT8U *err) {
+	OS_EVENT *rdy[1];
+
+	if (param->pq)
+		return (INT32U) OSPQAccept(param->file, NULL, err);
+	if (OSEventSetAccept(param->set, rdy, ARRAY_SIZE(rdy), err) == 0)
+		return 0;
+	return (INT32U) OSQAccept(rdy[0], err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          TaskBenchPQWaiter
+ * -Attend le message le plus urgent comme TaskForwarding : OSPQPend(), ou OSEventSetPend() suivi
+ *  d'OSQAccept() sur la file prête.
+ *********************************************************************************************************
+ */
+static void TaskBenchPQWaiter(void *data) {
+	BENCH_PQ_PARAM *param = data;
+	OS_EVENT *rdy[1];
+	uint8_t err;
+
+	while (true) {
+		if (param->pq) {
+			OSPQPend(param->file, 0, NULL, &err);
+		} else if (OSEventSetPend(param->set, rdy, ARRAY_SIZE(rdy), 0, &err) > 0) {
+			OSQAccept(rdy[0], &err);
+		}
+		param->nb_recus++;
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                              bench_pq
+ * -Compare la file à priorités (OSPQ) aux trois files servies par un ensemble d'événements du routeur :
+ *  latence d'un aller-retour post -> réveil de la tâche en attente, puis coût CPU d'une rafale de
+ *  BENCH_PQ_LOT messages répartis sur les classes, retirés sans attente du plus urgent au moins urgent.
+ *********************************************************************************************************
+ */
+static void bench_pq(void) {
+	static const char *nom[] = { "3 files + OSEventSet", "OSPQ" };
+	static void *msgs[BENCH_PQ_NB_BANDES][BENCH_Q_SIZE];
+	INT16U tailles[BENCH_PQ_NB_BANDES];
+	INT32U latence, rafale, msg;
+	INT8U bande, urgente;
+	XTime debut, fin;
+	uint8_t err;
+
+	xil_printf("\n---------- Files par classe : cycles par message ----------\n");
+	for (int mode = 0; mode < ARRAY_SIZE(nom); ++mode) {
+		bench_pq_param.pq = mode == 1;
+		bench_pq_param.nb_recus = 0;
+		bench_pq_param.nb_desordre = 0;
+		if (bench_pq_param.pq) {
+			for (int i = 0; i < BENCH_PQ_NB_BANDES; ++i)
+				tailles[i] = BENCH_Q_SIZE;
+			bench_pq_param.file = OSPQCreate(&msgs[0][0], tailles, BENCH_PQ_NB_BANDES, &err);
+		} else {
+			bench_pq_param.set = OSEventSetCreate(&err);
+			for (int i = 0; i < BENCH_PQ_NB_BANDES; ++i) {
+				bench_pq_param.qs[i] = OSQCreate(&msgs[i][0], BENCH_Q_SIZE);
+				OSEventSetAdd(bench_pq_param.set, bench_pq_param.qs[i], i);
+			}
+		}
+
+		// Latence : la tâche en attente, plus prioritaire, est réveillée à chaque post
+		OSTaskCreate(TaskBenchPQWaiter, &bench_pq_param,
+				&TaskBenchWaiterStk[BENCH_TASK_STK_SIZE-1], BENCH_WAITER_PRIO);
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_ITER; ++i)
+			bench_pq_post(&bench_pq_param, i % BENCH_PQ_NB_BANDES);
+		XTime_GetTime(&fin);
+		latence = bench_cycles(debut, fin) / BENCH_ITER;
+		OSTaskDel(BENCH_WAITER_PRIO);
+
+		// Rafale : post de BENCH_PQ_LOT messages, classes mélangées, puis retrait dans l'ordre
+		XTime_GetTime(&debut);
+		for (int iter = 0; iter < BENCH_ITER; ++iter) {
+			for (int i = 0; i < BENCH_PQ_LOT; ++i)
+				bench_pq_post(&bench_pq_param, (BENCH_PQ_LOT - 1 - i) % BENCH_PQ_NB_BANDES);
+			urgente = 0;
+			for (int i = 0; i < BENCH_PQ_LOT; ++i) {
+				msg = bench_pq_accept(&bench_pq_param, &err);
+				bande = (INT8U) msg;
+				if (err != OS_ERR_NONE || bande < urgente)
+					bench_pq_param.nb_desordre++;
+				urgente = bande;
+			}
+		}
+		XTime_GetTime(&fin);
+		rafale = bench_cycles(debut, fin) / (BENCH_ITER * BENCH_PQ_LOT);
+
+		xil_printf("%s : reveil %d cycles (%d recus), rafale %d cycles (%d hors ordre)\n", nom[mode],
+				latence, bench_pq_param.nb_recus, rafale, bench_pq_param.nb_desordre);
+		if (bench_pq_param.pq) {
+			OSPQDel(bench_pq_param.file, OS_DEL_ALWAYS, &err);
+		} else {
+			OSEventSetDel(bench_pq_param.set, OS_DEL_ALWAYS, &err);
+			for (int i = 0; i < BENCH_PQ_NB_BANDES; ++i)
+				OSQDel(bench_pq_param.qs[i], OS_DEL_ALWAYS, &err);
+		}
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_malloc
+ * -Compare le tas de newlib (_malloc_r(), _free_r()) aux slabs : BENCH_MALLOC_LOT allocations de même
+ *  taille puis leur libération, répétées BENCH_ITER fois.  Un premier lot non mesuré découpe les slabs.
+ *********************************************************************************************************
+ */
+static void bench_malloc(void) {
+	static void *blocs[BENCH_MALLOC_LOT];
+	XTime debut, fin;
+
+	xil_printf("\n---------- Allocation : cycles par malloc() + free() ----------\n");
+	for (int n = 0; n < ARRAY_SIZE(bench_malloc_tailles); ++n) {
+		size_t taille = bench_malloc_tailles[n];
+		INT32U cycles[2];
+
+		for (int slab = 0; slab < 2; ++slab) {
+			for (int iter = 0; iter <= BENCH_ITER; ++iter) {
+				if (iter == 1)
+					XTime_GetTime(&debut);
+				for (int i = 0; i < BENCH_MALLOC_LOT; ++i)
+					blocs[i] = slab ? slab_malloc(taille) : _malloc_r(_REENT, taille);
+				for (int i = 0; i < BENCH_MALLOC_LOT; ++i) {
+					if (slab)
+						slab_free(blocs[i]);
+					else
+						_free_r(_REENT, blocs[i]);
+				}
+			}
+			XTime_GetTime(&fin);
+			cycles[slab] = bench_cycles(debut, fin) / (BENCH_ITER * BENCH_MALLOC_LOT);
+		}
+		xil_printf("%d octets : newlib %d cycles, slabs %d cycles\n", (int) taille, cycles[0], cycles[1]);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_console
+ * -Coût pour la tâche d'un xil_printf() d'une ligne de 64 caractères comme celles du routeur.  Avec
+ *  UART_TX_EN, BENCH_CONSOLE_LIGNES lignes tiennent dans le tampon d'émission : la tâche ne fait que les
+ *  copier.  Sinon, elle attend l'UART (environ 5,5 ms par ligne à 115200 bauds).
+ *********************************************************************************************************
+ */
+static void bench_console(void) {
+	XTime debut, fin;
+	INT32U cycles;
+
+	xil_printf("\n---------- Console : cycles par ligne de xil_printf() ----------\n");
+	OSTimeDly(OS_TICKS_PER_SEC);							// Laisse l'UART vider le tampon
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_CONSOLE_LIGNES; ++i)
+		xil_printf("Paquet %08x -> %08x type %d ligne %02d ...................\n", 0x12345678,
+				0x9ABCDEF0, 1, i);
+	XTime_GetTime(&fin);
+	cycles = bench_cycles(debut, fin) / BENCH_CONSOLE_LIGNES;
+	xil_printf("%s : %d cycles par ligne\n", UART_TX_EN ? "Tampon + interruptions" : "Attente active", cycles);
+}
+
+/*
+ *********************************************************************************************************
+ *                                   Routines de copie comparées
+ * -bench_copie_octets() et bench_copie_mots() : les boucles d'origine de OS_MemCopy() et de
+ *  Xil_MemCpy(), comme références.
+ *********************************************************************************************************
+ */
+static void bench_copie_octets(void *dst, const void *src, INT32U n) {
+	INT8U *d = dst;
+	const INT8U *s = src;
+
+	while (n-- > 0)
+		*d++ = *s++;
+}
+
+static void bench_copie_mots(void *dst, const void *src, INT32U n) {
+	INT32U *d = dst;
+	const INT32U *s = src;
+
+	for (; n >= sizeof(INT32U); n -= sizeof(INT32U))
+		*d++ = *s++;
+	bench_copie_octets(d, s, n);
+}
+
+static void bench_copie_newlib(void *dst, const void *src, INT32U n) {
+	memcpy(dst, src, n);
+}
+
+static void bench_raz_mots(void *dst, INT32U n) {
+	INT32U *d = dst;
+
+	for (; n >= sizeof(INT32U); n -= sizeof(INT32U))
+		*d++ = 0;
+}
+
+static void bench_raz_newlib(void *dst, INT32U n) {
+	memset(dst, 0, n);
+}
+
+/*
+ *********************************************************************************************************
+ *                                            bench_mem
+ * -Cycles par copie et par remise à zéro de 16 octets à 4 Ko (tampons alignés, dans le cache L1/L2 après
+ *  la première itération), puis la copie d'un paquet de 64 octets par affectation et par
+ *  OS_CPU_MemCopy64().  La source décalée d'un octet mesure le cas d'alignements différents.
+ *********************************************************************************************************
+ */
+static void bench_mem(void) {
+	static INT64U src[BENCH_MEM_TAILLE_MAX / 8 + 1];
+	static INT64U dst[BENCH_MEM_TAILLE_MAX / 8 + 1];
+	static const struct {
+		const char *nom;
+		void (*copie)(void *, const void *, INT32U);
+		INT32U decalage;
+	} copies[] = {
+		{ "Octets (C)", bench_copie_octets, 0 },
+		{ "Mots (C)", bench_copie_mots, 0 },
+		{ "memcpy newlib", bench_copie_newlib, 0 },
+		{ "OS_CPU_MemCopy", OS_CPU_MemCopy, 0 },
+		{ "OS_CPU_MemCopyNEON", OS_CPU_MemCopyNEON, 0 },
+		{ "memcpy newlib +1", bench_copie_newlib, 1 },
+		{ "OS_CPU_MemCopy +1", OS_CPU_MemCopy, 1 },
+		{ "OS_CPU_MemCopyNEON +1", OS_CPU_MemCopyNEON, 1 },
+	};
+	static const struct {
+		const char *nom;
+		void (*raz)(void *, INT32U);
+	} raz[] = {
+		{ "Mots (C)", bench_raz_mots },
+		{ "memset newlib", bench_raz_newlib },
+		{ "OS_CPU_MemClr", OS_CPU_MemClr },
+		{ "OS_CPU_MemClrNEON", OS_CPU_MemClrNEON },
+	};
+	BENCH_PAQUET *a = (BENCH_PAQUET *) src, *b = (BENCH_PAQUET *) dst;
+	XTime debut, fin;
+
+	xil_printf("\n---------- Copie memoire : cycles par appel (16 64 256 1024 4096 octets) ----------\n");
+	for (int f = 0; f < ARRAY_SIZE(copies); ++f) {
+		xil_printf("%-22s", copies[f].nom);
+		for (int t = 0; t < ARRAY_SIZE(bench_mem_tailles); ++t) {
+			XTime_GetTime(&debut);
+			for (int i = 0; i < BENCH_MEM_ITER; ++i)
+				copies[f].copie(dst, (INT8U *) src + copies[f].decalage, bench_mem_tailles[t]);
+			XTime_GetTime(&fin);
+			xil_printf(" %6d", bench_cycles(debut, fin) / BENCH_MEM_ITER);
+		}
+		xil_printf("\n");
+	}
+	for (int f = 0; f < ARRAY_SIZE(raz); ++f) {
+		xil_printf("%-22s", raz[f].nom);
+		for (int t = 0; t < ARRAY_SIZE(bench_mem_tailles); ++t) {
+			XTime_GetTime(&debut);
+			for (int i = 0; i < BENCH_MEM_ITER; ++i)
+				raz[f].raz(dst, bench_mem_tailles[t]);
+			XTime_GetTime(&fin);
+			xil_printf(" %6d", bench_cycles(debut, fin) / BENCH_MEM_ITER);
+		}
+		xil_printf("\n");
+	}
+
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_MEM_ITER; ++i)
+		*b = *a;
+	XTime_GetTime(&fin);
+	xil_printf("Paquet : affectation %d cycles", bench_cycles(debut, fin) / BENCH_MEM_ITER);
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_MEM_ITER; ++i)
+		OS_CPU_MemCopy64(b, a);
+	XTime_GetTime(&fin);
+	xil_printf(", OS_CPU_MemCopy64 %d cycles", bench_cycles(debut, fin) / BENCH_MEM_ITER);
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_MEM_ITER; ++i)
+		OS_CPU_MemClr64(b);
+	XTime_GetTime(&fin);
+	xil_printf(", OS_CPU_MemClr64 %d cycles\n", bench_cycles(debut, fin) / BENCH_MEM_ITER);
+}
+
+/*
+ *********************************************************************************************************
+ *                                        bench_vider_lignes
+ * -La boucle d'origine de Xil_DCacheFlushRange(), comme référence : L1 puis L2 ligne par ligne, une
+ *  synchronisation du L2 par ligne, interruptions masquées pendant toute la plage.
+ *********************************************************************************************************
+ */
+static void bench_vider_lignes(INTPTR adr, INT32U taille) {
+	INT32U ligne = adr & ~31u, fin = adr + taille;
+	INT32U cpsr = mfcpsr();
+
+	mtcpsr(cpsr | 0xC0);
+	for (; ligne < fin; ligne += 32) {
+		asm_cp15_clean_inval_dc_line_mva_poc(ligne);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_PA_OFFSET, ligne);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_DUMMY_CACHE_SYNC_OFFSET, 0);
+	}
+	dsb();
+	mtcpsr(cpsr);
+}
+
+/*
+ *********************************************************************************************************
+ *                                           bench_cache
+ * -Cycles par maintenance du cache de 1 Ko à 512 Ko : vidage d'un tampon sale (écrit juste avant) par
+ *  Xil_DCacheFlushRange() et par la boucle d'origine, puis invalidation par Xil_DCacheInvalidateRange().
+ *  Au-delà des seuils de xil_cache.c (32 Ko et 256 Ko), tout le L1 puis tout le L2 est vidé.
+ *********************************************************************************************************
+ */
+static void bench_cache(void) {
+	static INT64U tampon[BENCH_CACHE_TAILLE_MAX / 8] __attribute__((aligned(32)));
+	XTime debut, fin;
+	INT32U vider, lignes, invalider;
+
+	xil_printf("\n---------- Cache : cycles par maintenance ----------\n");
+	xil_printf("%-8s %9s %9s %12s\n", "Octets", "Vidage", "Lignes", "Invalidation");
+	for (int t = 0; t < ARRAY_SIZE(bench_cache_tailles); ++t) {
+		vider = lignes = invalider = 0;
+		for (int i = 0; i < BENCH_CACHE_ITER; ++i) {
+			OS_CPU_MemClr(tampon, bench_cache_tailles[t]);
+			XTime_GetTime(&debut);
+			Xil_DCacheFlushRange((INTPTR) tampon, bench_cache_tailles[t]);
+			XTime_GetTime(&fin);
+			vider += bench_cycles(debut, fin);
+
+			OS_CPU_MemClr(tampon, bench_cache_tailles[t]);
+			XTime_GetTime(&debut);
+			bench_vider_lignes((INTPTR) tampon, bench_cache_tailles[t]);
+			XTime_GetTime(&fin);
+			lignes += bench_cycles(debut, fin);
+
+			XTime_GetTime(&debut);
+			Xil_DCacheInvalidateRange((INTPTR) tampon, bench_cache_tailles[t]);
+			XTime_GetTime(&fin);
+			invalider += bench_cycles(debut, fin);
+		}
+		xil_printf("%-8d %9d %9d %12d\n", bench_cache_tailles[t], vider / BENCH_CACHE_ITER,
+				lignes / BENCH_CACHE_ITER, invalider / BENCH_CACHE_ITER);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                     bench_bd_recevoir, bench_bd_envoyer
+ * -Jouent le rôle du GEM sur les anneaux simulés : marquent les 'nb' premiers BD du matériel comme une
+ *  trame reçue de BENCH_BD_TRAME octets (bit « new ») ou comme une trame envoyée (bit « used »).
+ *********************************************************************************************************
+ */
+static void bench_bd_recevoir(XEmacPs_BdRing *rx, INT32U nb) {
+	XEmacPs_Bd *bd = rx->HwHead;
+
+	for (INT32U i = 0; i < nb; ++i) {
+		XEmacPs_BdWrite(bd, XEMACPS_BD_STAT_OFFSET, XEMACPS_RXBUF_SOF_MASK | XEMACPS_RXBUF_EOF_MASK | BENCH_BD_TRAME);
+		XEmacPs_BdWrite(bd, XEMACPS_BD_ADDR_OFFSET, XEmacPs_BdRead(bd, XEMACPS_BD_ADDR_OFFSET) | XEMACPS_RXBUF_NEW_MASK);
+		bd = XEmacPs_BdRingNext(rx, bd);
+	}
+}
+
+static void bench_bd_envoyer(XEmacPs_BdRing *tx, INT32U nb) {
+	XEmacPs_Bd *bd = tx->HwHead;
+
+	for (INT32U i = 0; i < nb; ++i) {
+		XEmacPs_BdWrite(bd, XEMACPS_BD_STAT_OFFSET, XEmacPs_BdRead(bd, XEMACPS_BD_STAT_OFFSET) | XEMACPS_TXBUF_USED_MASK);
+		bd = XEmacPs_BdRingNext(tx, bd);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                             bench_bd
+ * -Milliers de descripteurs traités par seconde sur deux anneaux de BENCH_BD_NB BD en mémoire non
+ *  cachable, comme ceux de pio_emac.c, selon la taille des rafales :
+ *    - RX : BD par BD (XEmacPs_BdRingFromHwRx(), une invalidation par trame, recharge par
+ *      XEmacPs_BdRingAlloc()/XEmacPs_BdRingToHw() d'un BD), puis par rafale
+ *      (XEmacPs_BdRingFromHwRxBurst(), XEmacPs_BdRingRefillRx()) ;
+ *    - TX : XEmacPs_BdRingFromHwTx() et remise des BD un à un, puis XEmacPs_BdRingFromHwTxBurst().
+ * -Les tampons reviennent aussitôt à l'anneau.  Les adresses, longueurs et compteurs rendus par les
+ *  rafales sont vérifiés (erreurs).
+ *********************************************************************************************************
+ */
+static void bench_bd(void) {
+	static INT8U bd_mem[0x100000] __attribute__((aligned(0x100000)));	// Une section de la MMU
+	static INT8U tampons[BENCH_BD_NB][BENCH_BD_TAMPON] __attribute__((aligned(32)));
+	static XEmacPs_BdRing rx, tx;
+	XEmacPs_Bd modele, *premier, *bd;
+	UINTPTR adresses[BENCH_BD_NB], trames[BENCH_BD_NB];
+	u32 longueurs[BENCH_BD_NB];
+	XTime debut, fin;
+	INT32U rx_bd, rx_rafale, tx_bd, tx_rafale, n, erreurs = 0;
+
+	Xil_SetTlbAttributes((INTPTR) bd_mem, STRONG_ORDERED);
+	XEmacPs_BdClear(&modele);
+	XEmacPs_BdRingCreate(&rx, (UINTPTR) bd_mem, (UINTPTR) bd_mem, XEMACPS_BD_ALIGNMENT, BENCH_BD_NB);
+	XEmacPs_BdRingClone(&rx, &modele, XEMACPS_RECV);
+	XEmacPs_BdSetStatus(&modele, XEMACPS_TXBUF_USED_MASK);
+	XEmacPs_BdRingCreate(&tx, (UINTPTR) bd_mem + 4096, (UINTPTR) bd_mem + 4096, XEMACPS_BD_ALIGNMENT, BENCH_BD_NB);
+	XEmacPs_BdRingClone(&tx, &modele, XEMACPS_SEND);
+
+	for (int i = 0; i < BENCH_BD_NB; ++i)
+		adresses[i] = (UINTPTR) tampons[i];
+	Xil_DCacheFlushRange((INTPTR) tampons, sizeof(tampons));
+	if (XEmacPs_BdRingRefillRx(&rx, BENCH_BD_NB, adresses) != BENCH_BD_NB)
+		erreurs++;
+
+	xil_printf("\n---------- Anneaux de BD : milliers de descripteurs par seconde ----------\n");
+	xil_printf("%-8s %10s %10s %10s %10s\n", "Rafale", "RX BD", "RX rafale", "TX BD", "TX rafale");
+	for (int t = 0; t < ARRAY_SIZE(bench_bd_rafales); ++t) {
+		rx_bd = rx_rafale = tx_bd = tx_rafale = 0;
+		for (int i = 0; i < BENCH_BD_ITER; ++i) {
+			// RX, BD par BD (pio_emac.c avant les rafales)
+			bench_bd_recevoir(&rx, bench_bd_rafales[t]);
+			XTime_GetTime(&debut);
+			n = XEmacPs_BdRingFromHwRx(&rx, bench_bd_rafales[t], &premier);
+			bd = premier;
+			for (INT32U j = 0; j < n; ++j) {
+				adresses[j] = XEmacPs_BdGetBufAddr(bd) & XEMACPS_RXBUF_ADD_MASK;
+				Xil_DCacheInvalidateRange((INTPTR) adresses[j], BENCH_BD_DECALAGE + XEmacPs_BdGetLength(bd));
+				bd = XEmacPs_BdRingNext(&rx, bd);
+			}
+			XEmacPs_BdRingFree(&rx, n, premier);
+			for (INT32U j = 0; j < n; ++j) {
+				XEmacPs_BdRingAlloc(&rx, 1, &bd);
+				XEmacPs_BdWrite(bd, XEMACPS_BD_STAT_OFFSET, 0);
+				XEmacPs_BdClearRxNew(bd);
+				XEmacPs_BdSetAddressRx(bd, adresses[j]);
+				XEmacPs_BdRingToHw(&rx, 1, bd);
+			}
+			XTime_GetTime(&fin);
+			rx_bd += bench_cycles(debut, fin);
+
+			// RX par rafale
+			bench_bd_recevoir(&rx, bench_bd_rafales[t]);
+			XTime_GetTime(&debut);
+			n = XEmacPs_BdRingFromHwRxBurst(&rx, bench_bd_rafales[t], &premier, trames, longueurs,
+					BENCH_BD_DECALAGE);
+			for (INT32U j = 0; j < n; ++j)
+				adresses[j] = trames[j] - BENCH_BD_DECALAGE;
+			XEmacPs_BdRingFree(&rx, n, premier);
+			XEmacPs_BdRingRefillRx(&rx, n, adresses);
+			XTime_GetTime(&fin);
+			rx_rafale += bench_cycles(debut, fin);
+			if (n != bench_bd_rafales[t] || rx.HwCnt != BENCH_BD_NB)
+				erreurs++;
+			for (INT32U j = 0; j < n; ++j) {
+				if ((adresses[j] - (UINTPTR) tampons) % BENCH_BD_TAMPON != 0 || longueurs[j] != BENCH_BD_TRAME)
+					erreurs++;
+			}
+
+			// TX : trames d'un BD soumises, puis envoyées par le « GEM »
+			for (int mode = 0; mode < 2; ++mode) {
+				XEmacPs_BdRingAlloc(&tx, bench_bd_rafales[t], &premier);
+				bd = premier;
+				for (INT32U j = 0; j < bench_bd_rafales[t]; ++j) {
+					XEmacPs_BdSetAddressTx(bd, (UINTPTR) tampons[j]);
+					XEmacPs_BdSetLength(bd, BENCH_BD_TRAME);
+					XEmacPs_BdSetLast(bd);
+					XEmacPs_BdClearTxUsed(bd);
+					bd = XEmacPs_BdRingNext(&tx, bd);
+				}
+				XEmacPs_BdRingToHw(&tx, bench_bd_rafales[t], premier);
+				bench_bd_envoyer(&tx, bench_bd_rafales[t]);
+
+				XTime_GetTime(&debut);
+				if (mode == 0) {
+					n = XEmacPs_BdRingFromHwTx(&tx, bench_bd_rafales[t], &premier);
+					bd = premier;
+					for (INT32U j = 0; j < n; ++j) {
+						adresses[j] = XEmacPs_BdGetBufAddr(bd);
+						XEmacPs_BdWrite(bd, XEMACPS_BD_STAT_OFFSET,
+								XEMACPS_TXBUF_USED_MASK | (XEmacPs_BdIsTxWrap(bd) ? XEMACPS_TXBUF_WRAP_MASK : 0));
+						bd = XEmacPs_BdRingNext(&tx, bd);
+					}
+					XEmacPs_BdRingFree(&tx, n, premier);
+				} else {
+					n = XEmacPs_BdRingFromHwTxBurst(&tx, bench_bd_rafales[t], adresses);
+				}
+				XTime_GetTime(&fin);
+				if (mode == 0) {
+					tx_bd += bench_cycles(debut, fin);
+				} else {
+					tx_rafale += bench_cycles(debut, fin);
+					if (n != bench_bd_rafales[t] || tx.FreeCnt != BENCH_BD_NB || adresses[0] != (UINTPTR) tampons[0])
+						erreurs++;
+				}
+			}
+		}
+		n = bench_bd_rafales[t] * BENCH_BD_ITER;
+		xil_printf("%-8d %10d %10d %10d %10d\n", bench_bd_rafales[t],
+				(int)((INT64U) n * (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000) / rx_bd),
+				(int)((INT64U) n * (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000) / rx_rafale),
+				(int)((INT64U) n * (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000) / tx_bd),
+				(int)((INT64U) n * (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000) / tx_rafale));
+	}
+	xil_printf("%d erreurs\n", erreurs);
+}
+
+#if DMA_EN
+/*
+ *********************************************************************************************************
+ *                                            bench_dma
+ * -Cycles par copie de 64 octets à 64 Ko : OS_CPU_MemCopy() et dma_copier() jusqu'au réveil par le
+ *  sémaphore (latence, vidage et invalidation du cache compris), dont le temps de soumission seul (ce que
+ *  la tâche ne peut pas consacrer à autre chose).  Affiche la plus petite taille où le DMA est plus
+ *  rapide, à comparer à DMA_SEUIL.
+ *********************************************************************************************************
+ */
+static void bench_dma(void) {
+	static INT64U src[BENCH_DMA_TAILLE_MAX / 8];
+	static INT64U dst[BENCH_DMA_TAILLE_MAX / 8];
+	DMA_COPIE req;
+	DMA_STATS stats;
+	OS_EVENT *sem;
+	XTime debut, fin, soumis;
+	INT32U cpu, dma, soumission, croisement = 0;
+	uint8_t err;
+
+	xil_printf("\n---------- Copie par DMA : cycles par copie ----------\n");
+	xil_printf("%-8s %9s %9s %11s\n", "Octets", "CPU", "DMA", "Soumission");
+	sem = OSSemCreate(0);
+	memset(src, 0x5A, sizeof(src));
+	dma_stats(&stats, true);
+	for (int t = 0; t < ARRAY_SIZE(bench_dma_tailles); ++t) {
+		XTime_GetTime(&debut);
+		for (int i = 0; i < BENCH_DMA_ITER; ++i)
+			OS_CPU_MemCopy(dst, src, bench_dma_tailles[t]);
+		XTime_GetTime(&fin);
+		cpu = bench_cycles(debut, fin) / BENCH_DMA_ITER;
+
+		dma = soumission = 0;
+		for (int i = 0; i < BENCH_DMA_ITER; ++i) {
+			XTime_GetTime(&debut);
+			dma_copier(&req, dst, src, bench_dma_tailles[t], sem, NULL, NULL);
+			XTime_GetTime(&soumis);
+			OSSemPend(sem, 0, &err);
+			XTime_GetTime(&fin);
+			soumission += bench_cycles(debut, soumis);
+			dma += bench_cycles(debut, fin);
+		}
+		dma /= BENCH_DMA_ITER;
+		soumission /= BENCH_DMA_ITER;
+		if (croisement == 0 && dma < cpu)
+			croisement = bench_dma_tailles[t];
+		xil_printf("%-8d %9d %9d %11d\n", bench_dma_tailles[t], cpu, dma, soumission);
+	}
+	dma_stats(&stats, false);
+	if (croisement != 0)
+		xil_printf("DMA plus rapide a partir de %d octets (DMA_SEUIL = %d)\n", croisement, DMA_SEUIL);
+	else
+		xil_printf("DMA jamais plus rapide (DMA_SEUIL = %d)\n", DMA_SEUIL);
+	xil_printf("%d copies, %d erreurs, programmes : %d generes, %d reutilises\n", stats.copies, stats.erreurs,
+			stats.progs_generes, stats.progs_reutilises);
+
+	OSSemDel(sem, OS_DEL_ALWAYS, &err);
+}
+#endif
+
+#if UART_DMA_EN
+/*
+ *********************************************************************************************************
+ *                                        bench_console_fin
+ * -Fin de l'envoi par DMA, dans l'ISR : réveille bench_console_dma().
+ *********************************************************************************************************
+ */
+static void bench_console_fin(UART_DMA *req, void *arg) {
+	OSSemPost((OS_EVENT *) arg);
+}
+
+/*
+ *********************************************************************************************************
+ *                                        bench_console_dma
+ * -Cycles CPU pour envoyer 1 Ko sur la console : attente active (XUartPs_SendByte()), copie dans le
+ *  tampon (uart_ecrire()) et DMA (uart_dma_ecrire()).  Pour les deux derniers, le temps de la tâche
+ *  s'ajoute à celui des ISR de l'UART et du DMA pendant l'envoi (UART_STATS.cycles, qui compte aussi
+ *  l'affichage des autres tâches).
+ *********************************************************************************************************
+ */
+static void bench_console_dma(void) {
+	static char bench_console_buf[BENCH_CONSOLE_OCTETS];
+	static UART_DMA req;
+	UART_STATS stats;
+	OS_EVENT *sem;
+	XTime debut, fin;
+	INT32U cycles;
+	uint8_t err;
+
+	xil_printf("\n---------- Console : cycles CPU par Ko ----------\n");
+	for (int i = 0; i < BENCH_CONSOLE_OCTETS; ++i)
+		bench_console_buf[i] = (i % 64 == 63) ? '\n' : 'a' + (i / 64) % 26;
+	sem = OSSemCreate(0);
+
+	OSTimeDly(OS_TICKS_PER_SEC);							// Laisse l'UART vider le tampon
+	XTime_GetTime(&debut);
+	for (int i = 0; i < BENCH_CONSOLE_OCTETS; ++i)
+		XUartPs_SendByte(STDOUT_BASEADDRESS, bench_console_buf[i]);
+	XTime_GetTime(&fin);
+	cycles = bench_cycles(debut, fin);
+	xil_printf("Attente active : %d cycles\n", cycles);
+
+	OSTimeDly(OS_TICKS_PER_SEC);
+	uart_stats(&stats, true);
+	XTime_GetTime(&debut);
+	uart_ecrire(bench_console_buf, BENCH_CONSOLE_OCTETS);
+	XTime_GetTime(&fin);
+	OSTimeDly(OS_TICKS_PER_SEC);							// 89 ms à 115200 bauds
+	uart_stats(&stats, false);
+	cycles = bench_cycles(debut, fin);
+	xil_printf("Tampon + interruptions : %d cycles (tache %d, %d interruptions)\n", cycles + stats.cycles,
+			cycles, stats.interruptions);
+
+	OSTimeDly(OS_TICKS_PER_SEC);
+	uart_stats(&stats, true);
+	XTime_GetTime(&debut);
+	uart_dma_ecrire(&req, bench_console_buf, BENCH_CONSOLE_OCTETS, bench_console_fin, sem);
+	XTime_GetTime(&fin);
+	OSSemPend(sem, 0, &err);
+	uart_stats(&stats, false);
+	cycles = bench_cycles(debut, fin);
+	xil_printf("DMA : %d cycles (tache %d, %d interruptions, %d transferts, %d erreurs)\n",
+			cycles + stats.cycles, cycles, stats.interruptions + stats.dma_transferts, stats.dma_transferts,
+			stats.dma_erreurs);
+
+	OSSemDel(sem, OS_DEL_ALWAYS, &err);
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                              TaskBench
+ * -Exécute les bancs d'essai l'un après l'autre puis s'arrête.
+ *********************************************************************************************************
+ */
+void TaskBench(void *data) {
+	bench_event_set();
+	bench_ctx_sw();
+	bench_mutex();
+	bench_flag();
+	bench_q_policy();
+	bench_q_stat();
+	bench_pq();
+	bench_malloc();
+	bench_mem();
+	bench_cache();
+	bench_bd();
+#if DMA_EN
+	bench_dma();
+#endif
+	bench_console();
+#if UART_DMA_EN
+	bench_console_dma();
+#endif
+
+	xil_printf("\n---------- Fin des bancs d'essai ----------\n");
+	OSTaskDel(OS_PRIO_SELF);
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <ucos_ii.h>
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(x) (sizeof(x)/sizeof(x[0]))
+#endif
+
+/* ************************************************
+ *              CONFIGURATION DES BANCS
+ **************************************************/
+
+#define BENCH_EN                 0     // 1 : main() lance les bancs d'essai au lieu du routeur (0 : bench.c vide)
+
+#define BENCH_TASK_STK_SIZE      8192
+
+#define BENCH_WAITER_PRIO        20    // Plus prioritaire que la tâche de mesure : chaque post
+#define BENCH_PRIO               21    // provoque un changement de contexte vers l'attente
+#define BENCH_MUTEX_PIP          19    // Priorité réservée par le mutex à héritage de priorité
+#define BENCH_FLAG_PRIO          30    // Première des tâches en attente sur d'autres bits du groupe
+
+#define BENCH_ITER               1000  // Nb d'aller-retours mesurés par configuration
+#define BENCH_MAX_EVENTS         64    // Nb max. d'événements attendus simultanément
+#define BENCH_MALLOC_LOT         32    // Nb de blocs alloués avant d'être libérés
+#define BENCH_Q_SIZE             16    // Taille de la file saturée par le producteur
+#define BENCH_Q_NB_MSGS          400   // Nb de messages envoyés par configuration
+#define BENCH_Q_LOT              4     // Nb de messages consommés par tick
+#define BENCH_FLAG_NB_MAX        16    // Nb max. de tâches en attente sur d'autres bits
+#define BENCH_FLAG_STK_SIZE      512
+#define BENCH_PQ_NB_BANDES       3     // Comme les files high, medium et low du routeur
+#define BENCH_PQ_LOT             12    // Nb de messages postés avant d'être retirés (rafale)
+#define BENCH_CONSOLE_LIGNES     32    // Nb de lignes de 64 caractères affichées d'un coup
+#define BENCH_CONSOLE_OCTETS     1024  // Bloc envoyé par attente active, tampon et DMA (1 Ko)
+#define BENCH_MEM_ITER           200   // Nb de copies mesurées par routine et par taille
+#define BENCH_MEM_TAILLE_MAX     4096
+#define BENCH_CACHE_ITER         10    // Nb de maintenances mesurées par taille
+#define BENCH_CACHE_TAILLE_MAX   (512 * 1024)  // Taille du cache L2
+#define BENCH_BD_NB              64    // BD par anneau simulé (comme PIO_EMAC_NB_RX_BD)
+#define BENCH_BD_ITER            100   // Nb de rafales traitées par taille
+#define BENCH_BD_TAMPON          1536  // Comme PIO_EMAC_TAMPON
+#define BENCH_BD_DECALAGE        2     // Décalage RX du GEM
+#define BENCH_BD_TRAME           78    // Octets « reçus » par BD : en-tête Ethernet + Packet
+#define BENCH_DMA_ITER           20    // Nb de copies mesurées par taille, CPU et DMA
+#define BENCH_DMA_TAILLE_MAX     65536
+
+#define BENCH_OS_MAX_EVENTS      100   // OS_MAX_EVENTS requis : BENCH_MAX_EVENTS sémaphores, en plus des autres
+
+#if BENCH_EN && OS_MAX_EVENTS < BENCH_OS_MAX_EVENTS
+#error "bench.h : BENCH_EN demande OS_MAX_EVENTS >= BENCH_OS_MAX_EVENTS (os_cfg_r.h, puis tools/os_init_gen.py)"
+#endif
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+void bench_create(void);
+void TaskBench(void *data);
+
+#endif
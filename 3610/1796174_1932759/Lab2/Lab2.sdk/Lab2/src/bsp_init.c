@@ -1,11 +1,17 @@
 #include "bsp_init.h"
 #include "platform.h"
+#include "uart.h"
+#include "dma.h"
+#include "paquet_io.h"
+#include "profil.h"
 
 #include <stdio.h>
 #include <xparameters.h>
 #include <xil_printf.h>
 #include <xil_exception.h>
+#include <xil_mem.h>
 #include "os_cfg_r.h"
+#include <ucos_ii.h>
 
 #define TIMER_CLOCK_FREQUENCY 333000000
 #define TIMER_TICK_FREQUENCY OS_TICKS_PER_SEC
@@ -17,12 +23,22 @@
 XScuGic gic;
 XIntc axi_intc;
 XGpio gpSwitch;
+XDmaPs dmac;
+XEmacPs emac;
 
 int initialize_bsp() {
 	//disable_cache_for_section();
 	init_platform();
 	initialize_timer();
 	initialize_gpio();
+	initialize_dma();
+	initialize_uart();
+#if PIO_EMAC_EN
+	initialize_emac();
+#endif
+#if PROFIL_EN
+	initialize_ttc();
+#endif
 	return XST_SUCCESS;
 }
 
@@ -52,6 +68,90 @@ void initialize_gpio()
 
 }
 
+void initialize_uart()
+{
+#if UART_TX_EN
+	// voir uart.c : la console reste en attente active jusqu' connect_uart_irq()
+	int status;
+	status = uart_init();
+
+	if (status != XST_SUCCESS)
+		xil_printf("Error %d while initializing the UART\n", status);
+#endif
+}
+
+void initialize_dma()
+{
+	// PL330 du PS, partag par canal (voir uart.c)
+	int status;
+	XDmaPs_Config *dma_config;
+
+	dma_config = XDmaPs_LookupConfig(DMA_DEVICE_ID);
+	if (dma_config == NULL) {
+		xil_printf("Error while looking up the DMA controller\n");
+		return;
+	}
+
+	status = XDmaPs_CfgInitialize(&dmac, dma_config, dma_config->BaseAddress);
+	if (status != XST_SUCCESS)
+		xil_printf("Error %d while initializing the DMA controller\n", status);
+}
+
+void initialize_emac()
+{
+	// GEM0 du PS, ouvert par l'interface Ethernet des paquets (pio_emac.c)
+	int status;
+	XEmacPs_Config *emac_config;
+
+	emac_config = XEmacPs_LookupConfig(EMAC_DEVICE_ID);
+	if (emac_config == NULL) {
+		xil_printf("Error while looking up the Ethernet controller\n");
+		return;
+	}
+
+	status = XEmacPs_CfgInitialize(&emac, emac_config, emac_config->BaseAddress);
+	if (status != XST_SUCCESS)
+		xil_printf("Error %d while initializing the Ethernet controller\n", status);
+}
+
+void initialize_ttc()
+{
+	// TTC 0 du PS, base de temps des chantillons du profilage (voir profil.c)
+	int status;
+	status = profil_init();
+
+	if (status != XST_SUCCESS)
+		xil_printf("Error %d while initializing the profiling timer\n", status);
+}
+
+#if DMA_EN
+/**
+ * Done interrupt and ISR of each PL330 channel, for the copy channels of dma.c
+ */
+static const u32 dma_done_irq_id[XDMAPS_CHANNELS_PER_DEV] = {
+	XPAR_XDMAPS_0_DONE_INTR_0, XPAR_XDMAPS_0_DONE_INTR_1,
+	XPAR_XDMAPS_0_DONE_INTR_2, XPAR_XDMAPS_0_DONE_INTR_3,
+	XPAR_XDMAPS_0_DONE_INTR_4, XPAR_XDMAPS_0_DONE_INTR_5,
+	XPAR_XDMAPS_0_DONE_INTR_6, XPAR_XDMAPS_0_DONE_INTR_7
+};
+
+static void (*const dma_done_isr[XDMAPS_CHANNELS_PER_DEV])(XDmaPs *) = {
+	XDmaPs_DoneISR_0, XDmaPs_DoneISR_1, XDmaPs_DoneISR_2, XDmaPs_DoneISR_3,
+	XDmaPs_DoneISR_4, XDmaPs_DoneISR_5, XDmaPs_DoneISR_6, XDmaPs_DoneISR_7
+};
+#endif
+
+/**
+ * A faulting channel is killed by XDmaPs_FaultISR(): hand its command back
+ * to the channel's done handler, with DmaStatus set, so that its owner
+ * does not wait forever.
+ */
+static void dma_fault_handler(unsigned int channel, XDmaPs_Cmd *cmd, void *ref) {
+	XDmaPs_ChannelData *chan = &((XDmaPs *)ref)->Chans[channel];
+
+	if (chan->DoneHandler != NULL)
+		chan->DoneHandler(channel, cmd, chan->DoneRef);
+}
 
 ///////////////////////////////////////////////////////////////////////////
 //					      End of HW Setup
@@ -124,6 +224,33 @@ int initialize_axi_intc() {
 	return XST_SUCCESS;
 }
 
+#if (OS_CPU_INT_DIS_MEAS_EN > 0) || (OS_TASK_PROFILE_EN > 0u) || (OS_TRACE_EN > 0u)
+/**
+ * IRQs are serviced with interrupts masked: bracket the whole GIC dispatch
+ * so that the maximum interrupt disable time includes the ISRs themselves,
+ * and so that the ISRs are not charged to the interrupted task.
+ * The trace gets the ID of the pending interrupt (29: timer_isr,
+ * 31: XIntc_DeviceInterruptHandler); the matching exit is traced by OSIntExit().
+ */
+static void measured_irq_handler(void *data) {
+	OS_TRACE(OS_TRACE_TYPE_ISR_ENTER,
+			XScuGic_CPUReadReg((XScuGic *)data, XSCUGIC_HI_PEND_OFFSET) & XSCUGIC_ACK_INTID_MASK);
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+	OS_CPU_IntDisMeasStart();
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+	OS_CPU_IntCycStart();
+#endif
+	XScuGic_InterruptHandler((XScuGic *)data);
+#if OS_TASK_PROFILE_EN > 0u
+	OS_CPU_IntCycStop();
+#endif
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+	OS_CPU_IntDisMeasStop();
+#endif
+}
+#endif
+
 void enable_interrupt_controller() {
 	/*
 	 * Initialize the  exception table
@@ -133,7 +260,11 @@ void enable_interrupt_controller() {
 	/*
 	 * Register the interrupt controller handler with the exception table
 	 */
+#if (OS_CPU_INT_DIS_MEAS_EN > 0) || (OS_TASK_PROFILE_EN > 0u) || (OS_TRACE_EN > 0u)
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT, (Xil_ExceptionHandler)measured_irq_handler, &gic);
+#else
 	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT, (Xil_ExceptionHandler)XScuGic_InterruptHandler, &gic);
+#endif
 	
 	/*
 	 * Enable non-critical exceptions
@@ -169,6 +300,18 @@ int connect_irqs() {
 	if (status != XST_SUCCESS)
 		return XST_FAILURE;
 
+	status = connect_dma_irq();
+	if (status != XST_SUCCESS)
+		return XST_FAILURE;
+
+	status = connect_uart_irq();
+	if (status != XST_SUCCESS)
+		return XST_FAILURE;
+
+	status = connect_ttc_irq();
+	if (status != XST_SUCCESS)
+		return XST_FAILURE;
+
 	return XST_SUCCESS;
 }
 
@@ -247,6 +390,81 @@ int connect_gpio_irq() {
 	return XST_SUCCESS;
 }
 
+int connect_uart_irq() {
+#if UART_TX_EN
+	int status;
+
+	status = XScuGic_Connect(&gic, UART_TX_IRQ_ID, uart_isr, NULL);
+	if (status != XST_SUCCESS)
+		return status;
+
+	XScuGic_Enable(&gic, UART_TX_IRQ_ID);
+
+#if UART_DMA_EN
+	status = XScuGic_Connect(&gic, UART_DMA_IRQ_ID, uart_dma_isr, &dmac);
+	if (status != XST_SUCCESS)
+		return status;
+
+	XScuGic_Enable(&gic, UART_DMA_IRQ_ID);
+#endif
+
+	/*
+	 * From now on, outbyte() only copies into the TX buffer
+	 */
+	uart_demarrer();
+#endif
+	return XST_SUCCESS;
+}
+
+int connect_ttc_irq() {
+#if PROFIL_EN
+#if PROFIL_SOURCE == PROFIL_TTC
+	int status;
+
+	status = XScuGic_Connect(&gic, PROFIL_TTC_IRQ_ID, profil_isr, NULL);
+	if (status != XST_SUCCESS)
+		return status;
+
+	XScuGic_Enable(&gic, PROFIL_TTC_IRQ_ID);
+#endif
+
+	/*
+	 * From now on, every sample interrupt records the PC of the interrupted task
+	 */
+	profil_demarrer();
+#endif
+	return XST_SUCCESS;
+}
+
+int connect_dma_irq() {
+	int status;
+
+	XDmaPs_SetFaultHandler(&dmac, dma_fault_handler, &dmac);
+
+	status = XScuGic_Connect(&gic, DMA_FAULT_IRQ_ID, (Xil_ExceptionHandler)XDmaPs_FaultISR, &dmac);
+	if (status != XST_SUCCESS)
+		return status;
+
+	XScuGic_Enable(&gic, DMA_FAULT_IRQ_ID);
+
+#if DMA_EN
+	for (int i = DMA_CANAL_PREMIER; i < DMA_CANAL_PREMIER + DMA_NB_CANAUX; ++i) {
+		status = XScuGic_Connect(&gic, dma_done_irq_id[i], (Xil_ExceptionHandler)dma_done_isr[i], &dmac);
+		if (status != XST_SUCCESS)
+			return status;
+
+		XScuGic_Enable(&gic, dma_done_irq_id[i]);
+	}
+#endif
+
+	/*
+	 * From now on, dma_copier() hands the copies to the PL330
+	 */
+	dma_init();
+
+	return XST_SUCCESS;
+}
+
 void cleanup() {
 	/*
 	 * Disconnect and disable the interrupt
@@ -256,6 +474,9 @@ void cleanup() {
 	disconnect_fit_timer_1s_irq();
 	disconnect_fit_timer_3s_irq();
 	disconnect_gpio_irq();
+	disconnect_uart_irq();
+	disconnect_dma_irq();
+	disconnect_ttc_irq();
 }
 
 void disconnect_timer_irq() {
@@ -283,6 +504,39 @@ void disconnect_gpio_irq() {
 	XIntc_Disconnect(&axi_intc, GPIO_SW_IRQ_ID);
 }
 
+void disconnect_uart_irq() {
+#if UART_TX_EN
+	uart_arreter();
+	XScuGic_Disable(&gic, UART_TX_IRQ_ID);
+	XScuGic_Disconnect(&gic, UART_TX_IRQ_ID);
+#endif
+#if UART_DMA_EN
+	XScuGic_Disable(&gic, UART_DMA_IRQ_ID);
+	XScuGic_Disconnect(&gic, UART_DMA_IRQ_ID);
+#endif
+}
+
+void disconnect_dma_irq() {
+#if DMA_EN
+	for (int i = DMA_CANAL_PREMIER; i < DMA_CANAL_PREMIER + DMA_NB_CANAUX; ++i) {
+		XScuGic_Disable(&gic, dma_done_irq_id[i]);
+		XScuGic_Disconnect(&gic, dma_done_irq_id[i]);
+	}
+#endif
+	XScuGic_Disable(&gic, DMA_FAULT_IRQ_ID);
+	XScuGic_Disconnect(&gic, DMA_FAULT_IRQ_ID);
+}
+
+void disconnect_ttc_irq() {
+#if PROFIL_EN
+	profil_arreter();
+#if PROFIL_SOURCE == PROFIL_TTC
+	XScuGic_Disable(&gic, PROFIL_TTC_IRQ_ID);
+	XScuGic_Disconnect(&gic, PROFIL_TTC_IRQ_ID);
+#endif
+#endif
+}
+
 
 ///////////////////////////////////////////////////////////////////////////
 //						End of Interrupt Section
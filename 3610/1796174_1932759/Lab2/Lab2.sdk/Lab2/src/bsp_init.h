@@ -1,6 +1,8 @@
 #include <xscugic.h>
 #include <xintc.h>
 #include <xgpio.h>
+#include <xdmaps.h>
+#include <xemacps.h>
 #include <CortexA-MPCore_PrivateTimer.h>
 
 
@@ -10,10 +12,15 @@
 #define FIT_3S_IRQ_ID			XPAR_AXI_INTC_0_FIT_TIMER_1_INTERRUPT_INTR
 #define GPIO_SW_IRQ_ID			XPAR_AXI_INTC_0_AXI_GPIO_0_IP2INTC_IRPT_INTR
 #define GPIO_SW_DEVICE_ID		XPAR_AXI_GPIO_0_DEVICE_ID
+#define DMA_DEVICE_ID			XPAR_XDMAPS_1_DEVICE_ID
+#define DMA_FAULT_IRQ_ID		XPAR_XDMAPS_0_FAULT_INTR
+#define EMAC_DEVICE_ID			XPAR_XEMACPS_0_DEVICE_ID
 
 extern XScuGic gic;
 extern XIntc axi_intc;
 extern XGpio gpSwitch;
+extern XDmaPs dmac;
+extern XEmacPs emac;
 
 /**
  * Main BSP init Function
@@ -26,6 +33,10 @@ int initialize_bsp();
  */
 	void initialize_timer();
 	void initialize_gpio();
+	void initialize_uart();
+	void initialize_dma();
+	void initialize_emac();
+	void initialize_ttc();
 
 /**
  * Interrupt related functions
@@ -41,6 +52,9 @@ int initialize_bsp();
 			int connect_fit_timer_1s_irq();
 			int connect_fit_timer_3s_irq();
 			int connect_gpio_irq();
+			int connect_uart_irq();
+			int connect_dma_irq();
+			int connect_ttc_irq();
 
 void cleanup();
 	void disconnect_timer_irq();
@@ -48,6 +62,9 @@ void cleanup();
 	void disconnect_fit_timer_1s_irq();
 	void disconnect_fit_timer_3s_irq();
 	void disconnect_gpio_irq();
+	void disconnect_uart_irq();
+	void disconnect_dma_irq();
+	void disconnect_ttc_irq();
 
 
 /**
@@ -0,0 +1,289 @@
+#include "dma.h"
+#include "bsp_init.h"
+#include <string.h>
+#include <xil_cache.h>
+
+/*
+ *********************************************************************************************************
+ *                                    Copies mémoire par le DMA du PS
+ * -dma_copier() met une copie en file et retourne aussitôt.  Les DMA_NB_CANAUX canaux du PL330 à partir
+ *  de DMA_CANAL_PREMIER prennent les requêtes dans l'ordre ; à la fin d'une copie, l'ISR du canal
+ *  appelle 'fin', poste 'sem', puis lance la requête suivante.
+ * -Programmes : XDmaPs_GenDmaProg() construit un programme pour une taille et des alignements de la
+ *  source et de la destination donnés (DMASEV de son canal).  Chaque canal en garde DMA_PROG_CACHE ;
+ *  pour la copie suivante de même forme, seules les adresses des deux DMAMOV du début (SAR, DAR) sont
+ *  réécrites.
+ * -Cache : XDmaPs_Start() vide la source et invalide la destination avant la copie ; l'ISR invalide
+ *  encore la destination après, contre les lignes chargées par anticipation entre-temps.
+ * -Si XDmaPs_Start() ou la construction du programme échoue, ou si le canal signale une faute, le CPU
+ *  fait la copie (OS_CPU_MemCopy()) avant d'en signaler la fin ; req->erreur passe alors à vrai.
+ *********************************************************************************************************
+ */
+
+#define DMA_PROG_TAILLE          XDMAPS_CHAN_BUF_LEN
+#define DMA_DMAMOV               0xBC  // Code de DMAMOV, suivi du registre (SAR 0, DAR 2) et de 4 octets
+#define DMA_DMAMOV_SAR           0
+#define DMA_DMAMOV_DAR           2
+
+typedef struct {
+	INT32U taille;					// 0 : entrée libre
+	INT32U alignements;				// src % DMA_BURST_SIZE | (dst % DMA_BURST_SIZE) << 8
+	INT32U longueur;				// Octets du programme
+	INT32U utilisation;				// Dernière utilisation, pour remplacer la plus ancienne
+	INT8U prog[DMA_PROG_TAILLE] __attribute__((aligned(32)));
+} DMA_PROG;
+
+typedef struct {
+	XDmaPs_Cmd cmd;
+	DMA_COPIE *req;					// Copie en cours, NULL : canal libre
+	DMA_PROG progs[DMA_PROG_CACHE];
+} DMA_CANAL;
+
+#if DMA_EN
+static DMA_CANAL canaux[DMA_NB_CANAUX];
+static DMA_COPIE *attente_tete;		// Requêtes en attente d'un canal, dans l'ordre
+static DMA_COPIE *attente_queue;
+static INT32U nb_attente;
+static INT32U horloge;
+static bool pret;					// ISR des canaux connectées
+#endif
+static DMA_STATS stats;
+
+/*
+ *********************************************************************************************************
+ *                                           dma_terminer
+ * -Signale la fin d'une copie : 'fin' puis 'sem'.
+ *********************************************************************************************************
+ */
+static void dma_terminer(DMA_COPIE *req) {
+	req->terminee = true;
+	if (req->fin != NULL)
+		req->fin(req, req->arg);
+	if (req->sem != NULL)
+		OSSemPost(req->sem);
+}
+
+#if DMA_EN
+/*
+ *********************************************************************************************************
+ *                                            dma_prog
+ * -Programme du canal 'i' pour 'req' : repris du cache du canal si une copie de même taille et de mêmes
+ *  alignements l'a déjà construit, sinon construit par XDmaPs_GenDmaProg() à la place du moins récent.
+ *  Retourne NULL si le pilote ne peut pas le construire.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static DMA_PROG *dma_prog(int i, DMA_COPIE *req) {
+	DMA_CANAL *c = &canaux[i];
+	INT32U alignements = ((INT32U) req->src % DMA_BURST_SIZE) | ((INT32U) req->dst % DMA_BURST_SIZE) << 8;
+	INT32U src = (INT32U) req->src, dst = (INT32U) req->dst;
+	DMA_PROG *p = NULL, *vieux = &c->progs[0];
+
+	for (int k = 0; k < DMA_PROG_CACHE && p == NULL; ++k) {
+		if (c->progs[k].taille == req->taille && c->progs[k].alignements == alignements)
+			p = &c->progs[k];
+		else if (c->progs[k].utilisation < vieux->utilisation)
+			vieux = &c->progs[k];
+	}
+
+	if (p != NULL) {
+		stats.progs_reutilises++;
+		memcpy(&p->prog[2], &src, sizeof(src));
+		memcpy(&p->prog[8], &dst, sizeof(dst));
+	} else {
+		if (XDmaPs_GenDmaProg(&dmac, DMA_CANAL_PREMIER + i, &c->cmd) != XST_SUCCESS)
+			return NULL;
+		p = vieux;
+		p->longueur = c->cmd.GeneratedDmaProgLength;
+		memcpy(p->prog, c->cmd.GeneratedDmaProg, p->longueur);
+		XDmaPs_FreeDmaProg(&dmac, DMA_CANAL_PREMIER + i, &c->cmd);
+		p->taille = 0;
+		if (p->prog[0] == DMA_DMAMOV && p->prog[1] == DMA_DMAMOV_SAR &&
+				p->prog[6] == DMA_DMAMOV && p->prog[7] == DMA_DMAMOV_DAR) {
+			p->taille = req->taille;			// Réutilisable
+			p->alignements = alignements;
+		}
+		stats.progs_generes++;
+	}
+	p->utilisation = ++horloge;
+	Xil_DCacheFlushRange((INTPTR) p->prog, p->longueur);	// Lu par le PL330
+	return p;
+}
+
+/*
+ *********************************************************************************************************
+ *                                            dma_lancer
+ * -Démarre 'req' sur le canal libre 'i'.  Retourne faux si le DMA ne peut pas la faire.
+ *  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static bool dma_lancer(int i, DMA_COPIE *req) {
+	DMA_CANAL *c = &canaux[i];
+	DMA_PROG *p;
+
+	memset(&c->cmd, 0, sizeof(c->cmd));
+	c->cmd.ChanCtrl.SrcBurstSize = DMA_BURST_SIZE;
+	c->cmd.ChanCtrl.SrcBurstLen = DMA_BURST_LEN;
+	c->cmd.ChanCtrl.SrcInc = 1;
+	c->cmd.ChanCtrl.DstBurstSize = DMA_BURST_SIZE;
+	c->cmd.ChanCtrl.DstBurstLen = DMA_BURST_LEN;
+	c->cmd.ChanCtrl.DstInc = 1;
+	c->cmd.BD.SrcAddr = (u32) req->src;
+	c->cmd.BD.DstAddr = (u32) req->dst;
+	c->cmd.BD.Length = req->taille;
+
+	p = dma_prog(i, req);
+	if (p == NULL)
+		return false;
+	c->cmd.UserDmaProg = p->prog;
+	c->cmd.UserDmaProgLength = p->longueur;
+	if (XDmaPs_Start(&dmac, DMA_CANAL_PREMIER + i, &c->cmd, 0) != XST_SUCCESS)
+		return false;
+	c->req = req;
+	return true;
+}
+
+/*
+ *********************************************************************************************************
+ *                                            dma_servir
+ * -Donne les requêtes en attente aux canaux libres.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static void dma_servir(void) {
+	DMA_COPIE *req;
+	int i = 0;
+
+	while (attente_tete != NULL && i < DMA_NB_CANAUX) {
+		if (canaux[i].req != NULL) {
+			i++;
+			continue;
+		}
+		req = attente_tete;
+		attente_tete = req->suivant;
+		if (attente_tete == NULL)
+			attente_queue = NULL;
+		nb_attente--;
+		if (!dma_lancer(i, req)) {
+			OS_CPU_MemCopy(req->dst, req->src, req->taille);
+			req->erreur = true;
+			stats.erreurs++;
+			dma_terminer(req);
+		}
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                          dma_fin_canal
+ * -Fin d'une copie (XDmaPs_DoneISR_n(), ou faute relayée par bsp_init.c).  Après une faute, la
+ *  destination n'est pas fiable : le CPU refait toute la copie.
+ *********************************************************************************************************
+ */
+static void dma_fin_canal(unsigned int canal, XDmaPs_Cmd *cmd, void *ref) {
+	DMA_CANAL *c = ref;
+	DMA_COPIE *req = c->req;
+
+	c->req = NULL;
+	if (cmd->DmaStatus != 0) {
+		OS_CPU_MemCopy(req->dst, req->src, req->taille);
+		req->erreur = true;
+		stats.erreurs++;
+	} else {
+		Xil_DCacheInvalidateRange((INTPTR) req->dst, req->taille);
+		stats.copies++;
+		stats.octets += req->taille;
+	}
+	dma_terminer(req);
+	dma_servir();
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                             dma_init
+ * -Appelée par connect_dma_irq() une fois les ISR des canaux connectées.
+ *********************************************************************************************************
+ */
+void dma_init(void) {
+#if DMA_EN
+	for (int i = 0; i < DMA_NB_CANAUX; ++i)
+		XDmaPs_SetDoneHandler(&dmac, DMA_CANAL_PREMIER + i, dma_fin_canal, &canaux[i]);
+	pret = true;
+#endif
+}
+
+/*
+ *********************************************************************************************************
+ *                                            dma_copier
+ * -Copie 'taille' octets de 'src' vers 'dst' (sans recouvrement).  'req' doit rester valide jusqu'à la
+ *  fin, signalée par 'fin(req, arg)' puis OSSemPost('sem') depuis l'ISR du canal ('fin' et 'sem'
+ *  peuvent être NULL ; req->terminee passe à vrai).
+ * -Sans DMA ou avant dma_init(), le CPU copie et la fin est signalée avant de retourner.
+ *********************************************************************************************************
+ */
+void dma_copier(DMA_COPIE *req, void *dst, const void *src, INT32U taille, OS_EVENT *sem, DMA_FIN fin, void *arg) {
+#if DMA_EN
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	req->dst = dst;
+	req->src = src;
+	req->taille = taille;
+	req->sem = sem;
+	req->fin = fin;
+	req->arg = arg;
+	req->terminee = false;
+	req->erreur = false;
+	req->suivant = NULL;
+#if DMA_EN
+	if (pret && taille > 0) {
+		OS_ENTER_CRITICAL();
+		if (attente_queue != NULL)
+			attente_queue->suivant = req;
+		else
+			attente_tete = req;
+		attente_queue = req;
+		if (++nb_attente > stats.attente_max)
+			stats.attente_max = nb_attente;
+		dma_servir();
+		OS_EXIT_CRITICAL();
+		return;
+	}
+#endif
+	OS_CPU_MemCopy(dst, src, taille);
+	dma_terminer(req);
+}
+
+/*
+ *********************************************************************************************************
+ *                                            dma_memcpy
+ * -Copie synchrone : le CPU en dessous de DMA_SEUIL octets (ou hors d'une tâche), sinon le DMA pendant
+ *  que la tâche attend sur 'sem' (un sémaphore à 0 qui lui est propre).
+ *********************************************************************************************************
+ */
+void dma_memcpy(void *dst, const void *src, INT32U taille, OS_EVENT *sem) {
+	DMA_COPIE req;
+	uint8_t err;
+
+	if (taille < DMA_SEUIL || !OSRunning || OSIntNesting > 0 || OSLockNesting > 0) {
+		OS_CPU_MemCopy(dst, src, taille);
+		return;
+	}
+	dma_copier(&req, dst, src, taille, sem, NULL, NULL);
+	OSSemPend(sem, 0, &err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                             dma_stats
+ * -Copie les compteurs, puis les remet à zéro si 'reset'.
+ *********************************************************************************************************
+ */
+void dma_stats(DMA_STATS *s, bool reset) {
+	OS_CPU_SR cpu_sr = 0;
+
+	OS_ENTER_CRITICAL();
+	*s = stats;
+	if (reset)
+		memset(&stats, 0, sizeof(stats));
+	OS_EXIT_CRITICAL();
+}
@@ -0,0 +1,71 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include <ucos_ii.h>
+#include <stdbool.h>
+#include <xdmaps.h>
+#include "uart.h"
+
+/* ************************************************
+ *              CONFIGURATION DES COPIES PAR DMA
+ **************************************************/
+
+#define DMA_EN                   1     // 1 : dma_copier() passe par le PL330, 0 : copie par le CPU
+
+#define DMA_CANAL_PREMIER        1     // Canaux du PL330 réservés aux copies (le canal 0 sert à l'UART)
+#define DMA_NB_CANAUX            3
+
+#define DMA_BURST_SIZE           8     // Octets par transfert AXI (bus de 64 bits)
+#define DMA_BURST_LEN            16    // Transferts par rafale : 128 octets
+#define DMA_PROG_CACHE           4     // Programmes DMA gardés par canal (taille, alignements)
+#define DMA_SEUIL                2048  // dma_memcpy() : en dessous, copie par le CPU (voir bench_dma())
+
+#if DMA_EN && UART_DMA_EN && (DMA_CANAL_PREMIER <= UART_DMA_CANAL) && (UART_DMA_CANAL < DMA_CANAL_PREMIER + DMA_NB_CANAUX)
+#error "dma.h : UART_DMA_CANAL est parmi les canaux de copie"
+#endif
+#if DMA_CANAL_PREMIER + DMA_NB_CANAUX > XDMAPS_CHANNELS_PER_DEV
+#error "dma.h : le PL330 n'a que 8 canaux"
+#endif
+
+/* ************************************************
+ *              REQUÊTES
+ **************************************************/
+
+typedef struct dma_copie DMA_COPIE;
+typedef void (*DMA_FIN)(DMA_COPIE *req, void *arg);
+
+struct dma_copie {
+	void *dst;               // Ni 'dst' ni les lignes de cache qui le touchent ne doivent être
+	const void *src;         // écrites par le CPU avant la fin de la copie
+	INT32U taille;
+	OS_EVENT *sem;           // Posté à la fin de la copie (si non NULL)
+	DMA_FIN fin;             // Appelée à la fin de la copie, dans l'ISR du canal (si non NULL)
+	void *arg;
+	volatile bool terminee;
+	bool erreur;             // Faute du canal ou programme DMA impossible : le CPU a fait la copie
+	DMA_COPIE *suivant;
+};
+
+/* ************************************************
+ *              STATISTIQUES
+ **************************************************/
+
+typedef struct {
+	INT32U copies;           // Copies terminées
+	INT64U octets;
+	INT32U erreurs;
+	INT32U progs_generes;    // Programmes construits par XDmaPs_GenDmaProg()
+	INT32U progs_reutilises; // Programmes repris du cache du canal
+	INT32U attente_max;      // Maximum de requêtes en attente d'un canal libre
+} DMA_STATS;
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+void dma_init(void);
+void dma_copier(DMA_COPIE *req, void *dst, const void *src, INT32U taille, OS_EVENT *sem, DMA_FIN fin, void *arg);
+void dma_memcpy(void *dst, const void *src, INT32U taille, OS_EVENT *sem);
+void dma_stats(DMA_STATS *stats, bool reset);
+
+#endif
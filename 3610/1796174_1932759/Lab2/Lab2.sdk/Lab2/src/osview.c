@@ -0,0 +1,109 @@
+#include "osview.h"
+#include "uart.h"
+#include <stdbool.h>
+#include <xparameters.h>
+#include <xil_printf.h>
+#include <xuartps_hw.h>
+
+/*
+ *********************************************************************************************************
+ *                                    Vue du noyau sur l'UART
+ * -Toutes les OSVIEW_PERIODE ticks, ou dès que l'hôte envoie un octet, TaskOSView prend un instantané
+ *  avec OSViewSnap() et l'envoie sur l'UART de la console :
+ *      OSVIEW_SYNC0 OSVIEW_SYNC1 | instantané (OS_VIEW_HDR ...) | Fletcher-16 de l'instantané
+ * -L'UART est partagée avec xil_printf() : une trame entrecoupée par l'affichage d'une autre tâche
+ *  est rejetée par l'hôte (somme de contrôle) et la suivante la remplace.  L'instantané part par le
+ *  DMA (uart_dma_ecrire()) entre la synchronisation et la somme, copiées dans le tampon d'émission :
+ *  le reste de l'affichage passe avant ou après la trame, jamais au milieu.
+ * -osview_buf n'est réécrit qu'une fois l'envoi précédent terminé (osview_fin() poste osview_sem).
+ * -Le coût de OSViewSnap() est dans l'en-tête (OSViewCycles) : l'hôte l'affiche avec son maximum.
+ *********************************************************************************************************
+ */
+
+static OS_STK TaskOSViewStk[OSVIEW_STK_SIZE];
+static INT64U osview_buf[(OS_VIEW_SIZE_MAX + 7) / 8];	// Aligné sur 8 octets pour OSViewSnap()
+static UART_DMA osview_dma;
+static OS_EVENT *osview_sem;							// Posté à la fin de l'envoi de osview_buf
+
+void osview_create(void) {
+	uint8_t err;
+
+	OSTaskCreateExt(TaskOSView, NULL, &TaskOSViewStk[OSVIEW_STK_SIZE-1], OSVIEW_PRIO, OSVIEW_PRIO,
+			&TaskOSViewStk[0], OSVIEW_STK_SIZE, NULL, OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+	OSTaskNameSet(OSVIEW_PRIO, (INT8U *) "TaskOSView", &err);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          osview_demande
+ * -Vide la FIFO de réception de l'UART sans attendre, retourne vrai si l'hôte a envoyé un octet.
+ *********************************************************************************************************
+ */
+static bool osview_demande(void) {
+	bool demande = false;
+
+	while (XUartPs_IsReceiveData(STDIN_BASEADDRESS)) {
+		(void) XUartPs_ReadReg(STDIN_BASEADDRESS, XUARTPS_FIFO_OFFSET);
+		demande = true;
+	}
+	return demande;
+}
+
+/*
+ *********************************************************************************************************
+ *                                            osview_fin
+ * -Fin de l'envoi de l'instantané, dans l'ISR du DMA.
+ *********************************************************************************************************
+ */
+static void osview_fin(UART_DMA *req, void *arg) {
+	OSSemPost((OS_EVENT *) arg);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          osview_envoyer
+ * -Envoie une trame : synchronisation, instantané puis somme de Fletcher-16 (poids faible en premier).
+ *********************************************************************************************************
+ */
+static void osview_envoyer(const INT8U *p, INT32U taille) {
+	static const INT8U sync[2] = { OSVIEW_SYNC0, OSVIEW_SYNC1 };
+	INT16U s1 = 0, s2 = 0;
+	INT8U somme[2];
+
+	for (INT32U i = 0; i < taille; ++i) {
+		s1 = (s1 + p[i]) % 255;
+		s2 = (s2 + s1) % 255;
+	}
+	somme[0] = s1;
+	somme[1] = s2;
+	uart_ecrire(sync, sizeof(sync));
+	uart_dma_ecrire(&osview_dma, p, taille, osview_fin, osview_sem);
+	uart_ecrire(somme, sizeof(somme));
+}
+
+/*
+ *********************************************************************************************************
+ *                                            TaskOSView
+ *********************************************************************************************************
+ */
+void TaskOSView(void *data) {
+	INT32U dernier = OSTimeGet();
+	INT32U taille;
+	uint8_t err;
+
+	osview_sem = OSSemCreate(1);
+	OSEventNameSet(osview_sem, (INT8U *) "osview", &err);
+	while (true) {
+		OSTimeDly(OSVIEW_SONDAGE);
+		if (!osview_demande() && (OSVIEW_PERIODE == 0 || OSTimeGet() - dernier < OSVIEW_PERIODE))
+			continue;
+		dernier = OSTimeGet();
+
+		OSSemPend(osview_sem, 0, &err);				// Envoi précédent terminé
+		taille = OSViewSnap(osview_buf, sizeof(osview_buf), &err);
+		if (err == OS_ERR_NONE)
+			osview_envoyer((INT8U *) osview_buf, taille);
+		else
+			OSSemPost(osview_sem);
+	}
+}
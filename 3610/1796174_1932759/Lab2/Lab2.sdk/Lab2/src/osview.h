@@ -0,0 +1,28 @@
+#ifndef OSVIEW_H
+#define OSVIEW_H
+
+#include <ucos_ii.h>
+
+/* ************************************************
+ *              CONFIGURATION DE LA VUE DU NOYAU
+ **************************************************/
+
+#define OSVIEW_EN                1     // 1 : TaskOSView envoie des instantanés du noyau sur l'UART (tools/osview.py)
+
+#define OSVIEW_PRIO              40    // Moins prioritaire que le routeur et les bancs d'essai
+#define OSVIEW_STK_SIZE          2048
+
+#define OSVIEW_PERIODE           1000  // Envoi périodique en ticks (0 : seulement à la demande de l'hôte)
+#define OSVIEW_SONDAGE           50    // Lecture des demandes de l'hôte, en ticks
+
+#define OSVIEW_SYNC0             0x00  // Début de trame, absent du texte de xil_printf()
+#define OSVIEW_SYNC1             0xFF
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+void osview_create(void);
+void TaskOSView(void *data);
+
+#endif
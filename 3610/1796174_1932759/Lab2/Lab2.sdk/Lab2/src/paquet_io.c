@@ -0,0 +1,165 @@
+#include "paquet_io.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *********************************************************************************************************
+ *                                   Entrées et sorties des paquets
+ * -Le routeur reçoit ses paquets par pio_rx_burst() (TaskGeneratePacket), les envoie par pio_tx_burst()
+ *  (TaskPrint) et libère ceux qu'il rejette par pio_liberer(), sans savoir quelle interface est ouverte.
+ * -Un paquet est décrit par son adresse : alloué par malloc() (générateur, pcap) ou dans un tampon de
+ *  l'interface (EMAC, sans copie), que pio_liberer() lui rend.
+ * -Sur pcap et Ethernet, un paquet est la charge d'une trame Ethernet d'Ethertype PIO_ETHERTYPE, dans
+ *  l'ordre des octets du CPU.  L'adresse de destination désigne l'interface de sortie.
+ *********************************************************************************************************
+ */
+
+static const PIO_OPS *const interfaces[NB_PIO] = {
+	&pio_gen_ops,
+#if PIO_PCAP_EN
+	&pio_pcap_ops,
+#else
+	NULL,
+#endif
+#if PIO_EMAC_EN
+	&pio_emac_ops,
+#else
+	NULL,
+#endif
+};
+
+static const INT8U mac_routeur[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x10 };  // Administrée localement
+
+static const PIO_OPS *pio;
+static INT32U debut;
+PIO_STATS pio_compteurs;
+
+/*
+ *********************************************************************************************************
+ *                                             pio_ouvrir
+ * -Ouvre l'interface 'interface' (PIO_GEN, PIO_PCAP ou PIO_EMAC).  Retourne 0 si elle est prête.
+ *********************************************************************************************************
+ */
+int pio_ouvrir(int interface) {
+	if (interface < 0 || interface >= NB_PIO || interfaces[interface] == NULL)
+		return -1;
+	pio = interfaces[interface];
+	debut = OSTimeGet();
+	return pio->ouvrir();
+}
+
+const char *pio_nom(void) {
+	return pio != NULL ? pio->nom : "aucune";
+}
+
+/*
+ *********************************************************************************************************
+ *                                            pio_rx_burst
+ * -Reçoit au plus 'nb' paquets dans 'paquets'.  Retourne le nombre reçu, 0 si rien n'est arrivé.
+ *********************************************************************************************************
+ */
+int pio_rx_burst(Packet **paquets, int nb) {
+	int n = pio->rx_burst(paquets, nb);
+
+	pio_compteurs.rx_paquets += n;
+	pio_compteurs.rx_octets += (INT64U) n * pio->octets;
+	return n;
+}
+
+/*
+ *********************************************************************************************************
+ *                                            pio_tx_burst
+ * -Envoie les 'nb' paquets de 'paquets' sur l'interface de sortie 'interface' (0 à 2) et les libère,
+ *  envoyés ou non.  Retourne le nombre envoyé.  Les appels doivent être sérialisés (mutexPrinting).
+ *********************************************************************************************************
+ */
+int pio_tx_burst(int interface, Packet **paquets, int nb) {
+	int n = pio->tx_burst(interface, paquets, nb);
+
+	pio_compteurs.tx_paquets += n;
+	pio_compteurs.tx_octets += (INT64U) n * pio->octets;
+	return n;
+}
+
+/*
+ *********************************************************************************************************
+ *                                            pio_liberer
+ * -Libère un paquet : rend son tampon à l'interface qui l'a reçu, ou free().
+ *********************************************************************************************************
+ */
+void pio_liberer(Packet *paquet) {
+	if (pio != NULL && pio->possede != NULL && pio->possede(paquet))
+		pio->liberer(paquet);
+	else
+		free(paquet);
+}
+
+/*
+ *********************************************************************************************************
+ *                                             pio_stats
+ * -Copie les compteurs, puis les remet à zéro si 'reset'.
+ *********************************************************************************************************
+ */
+void pio_stats(PIO_STATS *stats, bool reset) {
+	OS_CPU_SR cpu_sr = 0;
+	INT32U maintenant = OSTimeGet();
+
+	OS_ENTER_CRITICAL();
+	*stats = pio_compteurs;
+	stats->ticks = maintenant - debut;
+	if (reset) {
+		memset(&pio_compteurs, 0, sizeof(pio_compteurs));
+		debut = maintenant;
+	}
+	OS_EXIT_CRITICAL();
+}
+
+/*
+ *********************************************************************************************************
+ *                                       pio_entete, pio_est_paquet
+ * -Écrit l'en-tête Ethernet d'un paquet envoyé sur l'interface de sortie 'interface' (destination
+ *  02:00:00:00:00:01 à 03), ou vérifie qu'une trame reçue porte un paquet du routeur.
+ *********************************************************************************************************
+ */
+void pio_entete(INT8U *trame, int interface) {
+	memcpy(&trame[0], mac_routeur, 5);
+	trame[5] = interface + 1;
+	memcpy(&trame[6], mac_routeur, 6);
+	trame[12] = PIO_ETHERTYPE >> 8;
+	trame[13] = PIO_ETHERTYPE & 0xFF;
+}
+
+bool pio_est_paquet(const INT8U *trame, INT32U longueur) {
+	return longueur >= PIO_TRAME && trame[12] == (PIO_ETHERTYPE >> 8) && trame[13] == (PIO_ETHERTYPE & 0xFF);
+}
+
+/*
+ *********************************************************************************************************
+ *                                            computeCRC
+ * -Calcule la check value d'un pointeur quelconque (cyclic redudancy check)
+ * -Retourne 0 si le CRC est correct, une autre valeur sinon.
+ *********************************************************************************************************
+ */
+unsigned int computeCRC(uint16_t* w, int nleft) {
+	unsigned int sum = 0;
+	uint16_t answer = 0;
+
+	// Adding words of 16 bits
+	while (nleft > 1) {
+		sum += *w++;
+		nleft -= 2;
+	}
+
+	// Handling the last byte
+	if (nleft == 1) {
+		*(unsigned char *) (&answer) = *(const unsigned char *) w;
+		sum += answer;
+	}
+
+	// Handling overflow
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum += (sum >> 16);
+
+	answer = ~sum;
+	return (unsigned int) answer;
+}
@@ -0,0 +1,110 @@
+#ifndef PAQUET_IO_H
+#define PAQUET_IO_H
+
+#include <ucos_ii.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ************************************************
+ *              CONFIGURATION DES INTERFACES
+ **************************************************/
+
+#define PIO_GEN                  0     // Générateur aléatoire (l'ancienne boucle de TaskGeneratePacket)
+#define PIO_PCAP                 1     // Fichiers pcap en mémoire, chargés et relus par JTAG (xsct)
+#define PIO_EMAC                 2     // Ethernet du PS (XEmacPs), tampons des anneaux de BD sans copie
+#define NB_PIO                   3
+
+#define PIO_INTERFACE            PIO_GEN  // Interface ouverte par create_application()
+#define PIO_PCAP_EN              (PIO_INTERFACE == PIO_PCAP)  // Compile l'interface pcap (2 images de PIO_PCAP_TAILLE octets)
+#define PIO_EMAC_EN              (PIO_INTERFACE == PIO_EMAC)  // Compile l'interface Ethernet (anneaux de BD et tampons)
+
+#define PIO_RAFALE               16    // Paquets reçus au plus par pio_rx_burst() dans TaskGeneratePacket
+
+#define PIO_ETHERTYPE            0x88B5  // Trames des paquets du routeur (Ethertype local expérimental IEEE)
+#define PIO_ENTETE               14    // En-tête Ethernet devant le paquet (pcap et EMAC)
+#define PIO_TRAME                (PIO_ENTETE + sizeof(Packet))
+
+#define PIO_PCAP_TAILLE          (1024 * 1024)  // Image pcap lue et image pcap écrite, en octets
+#define PIO_PCAP_RYTHME          1     // 1 : rejoue au rythme des horodatages, 0 : une rafale par tick
+#define PIO_PCAP_BOUCLE          1     // 1 : reprend l'image au début une fois lue
+
+#define PIO_EMAC_NB_RX_BD        64
+#define PIO_EMAC_NB_TX_BD        64
+#define PIO_EMAC_NB_TAMPONS      256   // Tampons des trames : anneau RX + paquets en cours dans le routeur
+#define PIO_EMAC_TAMPON          1536  // Octets par tampon (une trame de 1518 octets au plus)
+#define PIO_EMAC_VITESSE         1000  // Mb/s, doit correspondre au lien négocié par le PHY
+
+/* ************************************************
+ *              PAQUETS
+ **************************************************/
+
+typedef enum {
+	PACKET_VIDEO, PACKET_AUDIO, PACKET_AUTRE, NB_PACKET_TYPE
+} PACKET_TYPE;
+
+typedef struct {
+	unsigned int src;
+	unsigned int dst;
+	PACKET_TYPE type;
+	unsigned int crc;
+	unsigned int data[12];
+} Packet;
+
+_Static_assert(sizeof(Packet) == 64, "Les paquets sont copies avec OS_CPU_MemCopy64()");
+
+/* ************************************************
+ *              INTERFACES
+ **************************************************/
+
+// Les paquets (descripteurs) reçus appartiennent au routeur jusqu'à pio_liberer() ou pio_tx_burst()
+typedef struct {
+	const char *nom;
+	INT32U octets;                                      // Octets par paquet sur l'interface
+	int (*ouvrir)(void);                                // 0 si l'interface est prête
+	int (*rx_burst)(Packet **paquets, int nb);          // Paquets reçus (0 : rien pour l'instant)
+	int (*tx_burst)(int interface, Packet **paquets, int nb);  // Paquets envoyés, tous sont libérés
+	bool (*possede)(const Packet *paquet);              // Paquet dans un tampon de l'interface (NULL : jamais)
+	void (*liberer)(Packet *paquet);                    // Rend le tampon à l'interface
+} PIO_OPS;
+
+extern const PIO_OPS pio_gen_ops;
+#if PIO_PCAP_EN
+extern const PIO_OPS pio_pcap_ops;
+#endif
+#if PIO_EMAC_EN
+extern const PIO_OPS pio_emac_ops;
+#endif
+
+/* ************************************************
+ *              STATISTIQUES
+ **************************************************/
+
+typedef struct {
+	INT32U rx_paquets;
+	INT32U tx_paquets;
+	INT64U rx_octets;
+	INT64U tx_octets;
+	INT32U rx_rejets;        // Trames qui ne sont pas des paquets du routeur, ou plus de tampon libre
+	INT32U tx_rejets;        // Paquets perdus à l'envoi (anneau plein, image pcap pleine)
+	INT32U tx_copies;        // Paquets copiés dans un tampon de l'interface pour être envoyés
+	INT32U ticks;            // Durée de la mesure (depuis le dernier pio_stats(..., true))
+} PIO_STATS;
+
+extern PIO_STATS pio_compteurs;  // rx_rejets, tx_rejets et tx_copies, tenus par les interfaces
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+int pio_ouvrir(int interface);
+const char *pio_nom(void);
+int pio_rx_burst(Packet **paquets, int nb);
+int pio_tx_burst(int interface, Packet **paquets, int nb);
+void pio_liberer(Packet *paquet);
+void pio_stats(PIO_STATS *stats, bool reset);
+
+void pio_entete(INT8U *trame, int interface);
+bool pio_est_paquet(const INT8U *trame, INT32U longueur);
+unsigned int computeCRC(uint16_t *w, int nleft);
+
+#endif
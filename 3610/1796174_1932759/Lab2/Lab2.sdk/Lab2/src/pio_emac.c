@@ -0,0 +1,262 @@
+#include "paquet_io.h"
+#include "bsp_init.h"
+#include <stdlib.h>
+#include <xil_cache.h>
+#include <xil_mmu.h>
+#include <xil_printf.h>
+
+#if PIO_EMAC_EN
+/*
+ *********************************************************************************************************
+ *                                   Interface : Ethernet du PS (XEmacPs)
+ * -Réception sans copie : chaque BD de l'anneau RX reçoit un tampon de PIO_EMAC_TAMPON octets de la
+ *  réserve ; la trame est écrite 2 octets après son début (décalage RX du GEM), si bien que le paquet
+ *  qui suit l'en-tête Ethernet est aligné sur 16 octets.  Ce paquet est remis tel quel au routeur, et
+ *  pio_liberer() rend le tampon à la réserve ; l'anneau est rechargé au pio_rx_burst() suivant.
+ * -Les anneaux sont traités par rafales (XEmacPs_BdRingFromHwRxBurst(), XEmacPs_BdRingRefillRx(),
+ *  XEmacPs_BdRingFromHwTxBurst()) : chaque mot de BD est lu une fois, les trames d'une rafale sont
+ *  invalidées ensemble et les tampons sont pris et rendus à la réserve par lots.
+ * -Envoi : l'en-tête est écrit devant le paquet, dans son tampon, et le BD TX pointe la trame.  Un
+ *  paquet alloué par malloc() (copies de diffusion) est d'abord copié dans un tampon (tx_copies).  Les
+ *  tampons envoyés reviennent à la réserve au pio_tx_burst() suivant.
+ * -Les anneaux de BD sont dans une section de 1 Mo non cachable.  Les tampons de la réserve n'ont
+ *  jamais de ligne sale dans le cache (ils sont vidés après chaque écriture du CPU, avant l'envoi) : ils
+ *  sont donnés au GEM sans invalidation, et seules les trames reçues sont invalidées.
+ * -Sans interruption : pio_rx_burst() retourne 0 si rien n'est arrivé et TaskGeneratePacket attend un
+ *  tick.  Le PHY reste en autonégociation ; l'horloge du GEM est celle réglée par le FSBL.
+ *********************************************************************************************************
+ */
+
+#define EMAC_DECALAGE_RX         2                             // Octets avant la trame (NWCFG.RXOFFS)
+#define EMAC_DECALAGE            (EMAC_DECALAGE_RX + PIO_ENTETE)  // Du tampon au paquet
+#define EMAC_SECTION             0x100000                      // Section de la MMU
+
+static const INT8U mac_emac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x10 };
+
+static INT8U emac_bd[EMAC_SECTION] __attribute__((aligned(EMAC_SECTION)));
+static INT8U tampons[PIO_EMAC_NB_TAMPONS][PIO_EMAC_TAMPON] __attribute__((aligned(32)));
+static INT16U libres[PIO_EMAC_NB_TAMPONS];	// Pile des tampons libres
+static INT32U nb_libres;
+
+/*
+ *********************************************************************************************************
+ *                                     emac_prendre, emac_rendre
+ * -Tampons de la réserve, appelées par les tâches du routeur (pio_liberer()).  emac_prendre_lot() et
+ *  emac_rendre_lot() en prennent ou en rendent plusieurs dans une seule section critique.
+ *********************************************************************************************************
+ */
+static INT32U emac_prendre_lot(UINTPTR *adresses, INT32U nb) {
+	OS_CPU_SR cpu_sr = 0;
+	INT32U n;
+
+	OS_ENTER_CRITICAL();
+	if (nb > nb_libres)
+		nb = nb_libres;
+	for (n = 0; n < nb; ++n)
+		adresses[n] = (UINTPTR) tampons[libres[--nb_libres]];
+	OS_EXIT_CRITICAL();
+	return nb;
+}
+
+static void emac_rendre_lot(const UINTPTR *adresses, INT32U nb) {
+	OS_CPU_SR cpu_sr = 0;
+
+	OS_ENTER_CRITICAL();
+	for (INT32U n = 0; n < nb; ++n)
+		libres[nb_libres++] = ((const INT8U *) adresses[n] - &tampons[0][0]) / PIO_EMAC_TAMPON;
+	OS_EXIT_CRITICAL();
+}
+
+static INT8U *emac_prendre(void) {
+	OS_CPU_SR cpu_sr = 0;
+	INT8U *tampon = NULL;
+
+	OS_ENTER_CRITICAL();
+	if (nb_libres > 0)
+		tampon = tampons[libres[--nb_libres]];
+	OS_EXIT_CRITICAL();
+	return tampon;
+}
+
+static void emac_rendre(const void *adresse) {
+	OS_CPU_SR cpu_sr = 0;
+	INT16U i = ((const INT8U *) adresse - &tampons[0][0]) / PIO_EMAC_TAMPON;
+
+	OS_ENTER_CRITICAL();
+	libres[nb_libres++] = i;
+	OS_EXIT_CRITICAL();
+}
+
+static bool emac_possede(const Packet *paquet) {
+	return (const INT8U *) paquet >= &tampons[0][0] && (const INT8U *) paquet < &tampons[PIO_EMAC_NB_TAMPONS][0];
+}
+
+static void emac_liberer(Packet *paquet) {
+	emac_rendre(paquet);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          emac_remplir_rx
+ * -Donne un tampon libre à chaque BD libre de l'anneau RX, en un lot.
+ *********************************************************************************************************
+ */
+static void emac_remplir_rx(void) {
+	XEmacPs_BdRing *rx = &XEmacPs_GetRxRing(&emac);
+	UINTPTR adresses[PIO_EMAC_NB_RX_BD];
+	INT32U n, donnes;
+
+	n = emac_prendre_lot(adresses, XEmacPs_BdRingGetFreeCnt(rx));
+	donnes = XEmacPs_BdRingRefillRx(rx, n, adresses);
+	if (donnes < n)
+		emac_rendre_lot(&adresses[donnes], n - donnes);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          emac_liberer_tx
+ * -Rend à la réserve les tampons des trames envoyées ; leurs BD reviennent au CPU.
+ *********************************************************************************************************
+ */
+static void emac_liberer_tx(void) {
+	UINTPTR adresses[PIO_EMAC_NB_TX_BD];
+
+	emac_rendre_lot(adresses, XEmacPs_BdRingFromHwTxBurst(&XEmacPs_GetTxRing(&emac), PIO_EMAC_NB_TX_BD, adresses));
+}
+
+/*
+ *********************************************************************************************************
+ *                                            emac_ouvrir
+ * -Crée les deux anneaux, charge l'anneau RX et démarre le GEM (réception de toutes les adresses, le
+ *  tri se fait sur l'Ethertype).
+ *********************************************************************************************************
+ */
+static int emac_ouvrir(void) {
+	XEmacPs_BdRing *rx = &XEmacPs_GetRxRing(&emac);
+	XEmacPs_BdRing *tx = &XEmacPs_GetTxRing(&emac);
+	UINTPTR bd_rx = (UINTPTR) emac_bd;
+	UINTPTR bd_tx = bd_rx + XEmacPs_BdRingMemCalc(XEMACPS_BD_ALIGNMENT, PIO_EMAC_NB_RX_BD);
+	XEmacPs_Bd modele;
+
+	if (emac.IsReady != XIL_COMPONENT_IS_READY)
+		return -1;
+
+	for (INT32U i = 0; i < PIO_EMAC_NB_TAMPONS; ++i)
+		libres[i] = i;
+	nb_libres = PIO_EMAC_NB_TAMPONS;
+	Xil_DCacheFlushRange((INTPTR) tampons, sizeof(tampons));	// Lignes salies par la mise à zéro du .bss
+
+	Xil_SetTlbAttributes(bd_rx, STRONG_ORDERED);
+
+	XEmacPs_BdClear(&modele);
+	if (XEmacPs_BdRingCreate(rx, bd_rx, bd_rx, XEMACPS_BD_ALIGNMENT, PIO_EMAC_NB_RX_BD) != XST_SUCCESS ||
+			XEmacPs_BdRingClone(rx, &modele, XEMACPS_RECV) != XST_SUCCESS)
+		return -1;
+	XEmacPs_BdSetStatus(&modele, XEMACPS_TXBUF_USED_MASK);
+	if (XEmacPs_BdRingCreate(tx, bd_tx, bd_tx, XEMACPS_BD_ALIGNMENT, PIO_EMAC_NB_TX_BD) != XST_SUCCESS ||
+			XEmacPs_BdRingClone(tx, &modele, XEMACPS_SEND) != XST_SUCCESS)
+		return -1;
+	emac_remplir_rx();
+
+	XEmacPs_SetMacAddress(&emac, (void *) mac_emac, 1);
+	XEmacPs_SetOptions(&emac, XEMACPS_PROMISC_OPTION);
+	XEmacPs_SetMdioDivisor(&emac, MDC_DIV_224);
+	XEmacPs_SetOperatingSpeed(&emac, PIO_EMAC_VITESSE);
+	XEmacPs_WriteReg(emac.Config.BaseAddress, XEMACPS_NWCFG_OFFSET,
+			(XEmacPs_ReadReg(emac.Config.BaseAddress, XEMACPS_NWCFG_OFFSET) & ~XEMACPS_NWCFG_RXOFFS_MASK) |
+			(EMAC_DECALAGE_RX << 14));
+	XEmacPs_Start(&emac);
+	return 0;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          emac_rx_burst
+ * -Remet au routeur les paquets des trames reçues, dans leurs tampons.
+ *********************************************************************************************************
+ */
+static int emac_rx_burst(Packet **paquets, int nb) {
+	XEmacPs_BdRing *rx = &XEmacPs_GetRxRing(&emac);
+	XEmacPs_Bd *premier;
+	UINTPTR trames[PIO_RAFALE];
+	u32 longueurs[PIO_RAFALE];
+	u32 n;
+	int recus = 0;
+
+	if (nb > PIO_RAFALE)
+		nb = PIO_RAFALE;
+	// Trames invalidées et en-têtes préchargés par le pilote
+	n = XEmacPs_BdRingFromHwRxBurst(rx, nb, &premier, trames, longueurs, EMAC_DECALAGE_RX);
+	for (u32 i = 0; i < n; ++i) {
+		if (pio_est_paquet((const INT8U *) trames[i], longueurs[i])) {
+			paquets[recus++] = (Packet *) (trames[i] + PIO_ENTETE);
+		} else {
+			pio_compteurs.rx_rejets++;
+			emac_rendre((const void *) trames[i]);
+		}
+	}
+	if (n > 0)
+		XEmacPs_BdRingFree(rx, n, premier);
+	emac_remplir_rx();
+	return recus;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          emac_tx_burst
+ * -Envoie les paquets dans leurs tampons (en les y copiant au besoin), une trame par BD, puis lance
+ *  l'émission une fois pour la rafale.
+ *********************************************************************************************************
+ */
+static int emac_tx_burst(int interface, Packet **paquets, int nb) {
+	XEmacPs_BdRing *tx = &XEmacPs_GetTxRing(&emac);
+	XEmacPs_Bd *bd;
+	Packet *paquet;
+	INT8U *tampon, *trame;
+	int envoyes = 0;
+
+	emac_liberer_tx();
+	for (int i = 0; i < nb; ++i) {
+		paquet = paquets[i];
+		if (!emac_possede(paquet)) {
+			tampon = emac_prendre();
+			if (tampon == NULL) {
+				pio_compteurs.tx_rejets++;
+				pio_liberer(paquet);
+				continue;
+			}
+			OS_CPU_MemCopy64(tampon + EMAC_DECALAGE, paquet);
+			pio_liberer(paquet);
+			paquet = (Packet *) (tampon + EMAC_DECALAGE);
+			pio_compteurs.tx_copies++;
+		}
+		if (XEmacPs_BdRingAlloc(tx, 1, &bd) != XST_SUCCESS) {
+			pio_compteurs.tx_rejets++;
+			emac_rendre(paquet);
+			continue;
+		}
+		trame = (INT8U *) paquet - PIO_ENTETE;
+		pio_entete(trame, interface);
+		Xil_DCacheFlushRange((INTPTR) trame, PIO_TRAME);
+		XEmacPs_BdSetAddressTx(bd, (UINTPTR) trame);
+		XEmacPs_BdSetLength(bd, PIO_TRAME);
+		XEmacPs_BdSetLast(bd);
+		XEmacPs_BdClearTxUsed(bd);
+		XEmacPs_BdRingToHw(tx, 1, bd);
+		envoyes++;
+	}
+	if (envoyes > 0)
+		XEmacPs_Transmit(&emac);
+	return envoyes;
+}
+
+const PIO_OPS pio_emac_ops = {
+	.nom = "ethernet",
+	.octets = PIO_TRAME,
+	.ouvrir = emac_ouvrir,
+	.rx_burst = emac_rx_burst,
+	.tx_burst = emac_tx_burst,
+	.possede = emac_possede,
+	.liberer = emac_liberer,
+};
+#endif
@@ -0,0 +1,120 @@
+#include "paquet_io.h"
+#include <stdlib.h>
+#include <xil_printf.h>
+
+/*
+ *********************************************************************************************************
+ *                                   Interface : générateur aléatoire
+ * -Génère des paquets par phases de 0 à 249 paquets, un toutes les 2 ms, séparées de 500 ms.
+ * -À des fins de développement de votre application, vous pouvez *temporairement* modifier la variable
+ *  "shouldSlowthingsDown" à  true pour ne générer que quelques paquets par seconde, et ainsi pouvoir
+ *  déboguer le flot de vos paquets de manière plus saine d'esprit. Cependant, la correction sera effectuée
+ *  avec cette variable à false.
+ * -Les paquets envoyés sont affichés sur la console.
+ *********************************************************************************************************
+ */
+
+static const bool shouldSlowThingsDown = true;		// Variable à modifier
+
+static bool isGenPhase;						// Indique si on est dans la phase de generation ou non
+static int packGenQty;
+static int nbGeneres;
+static int delai;							// Attente en ms avant le prochain paquet
+
+static int gen_ouvrir(void) {
+	srand(42);
+	isGenPhase = true;
+	packGenQty = (rand() % 250);
+	nbGeneres = 0;
+	delai = 0;
+	return 0;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           gen_rx_burst
+ * -Attend le moment du prochain paquet et le génère (un seul par appel : le rythme est celui du
+ *  générateur d'origine, la même suite de rand()).
+ *********************************************************************************************************
+ */
+static int gen_rx_burst(Packet **paquets, int nb) {
+	Packet *packet;
+
+	if (delai > 0)
+		OSTimeDlyHMSM(0, 0, 0, delai);
+	if (!isGenPhase) {
+		OSTimeDlyHMSM(0, 0, 0, 500);
+		isGenPhase = true;
+		packGenQty = (rand() % 250);
+		xil_printf(
+				"GENERATE: Generation de %d paquets durant les %d prochaines millisecondes\n",
+				packGenQty, packGenQty * 2);
+	}
+
+	packet = malloc(sizeof(Packet));
+	if (packet == NULL) {
+		pio_compteurs.rx_rejets++;
+		delai = 2;
+		return 0;
+	}
+
+	packet->src = rand() * (UINT32_MAX / RAND_MAX);
+	packet->dst = rand() * (UINT32_MAX / RAND_MAX);
+	packet->type = rand() % NB_PACKET_TYPE;
+
+	for (int i = 0; i < sizeof(packet->data) / sizeof(packet->data[0]); ++i)
+		packet->data[i] = (unsigned int) rand();
+	packet->data[0] = nbGeneres;
+
+	//Compute CRC
+	packet->crc = 0;
+	if (rand() % 10 == 9) // 10% of Packets with bad CRC
+		packet->crc = 1234;
+	else
+		packet->crc = computeCRC((uint16_t*) packet, sizeof(Packet));
+
+	nbGeneres++;
+
+	if (shouldSlowThingsDown) {
+		xil_printf("GENERATE : ********Generation du Paquet # %d ******** \n", nbGeneres);
+		xil_printf("ADD %x \n", packet);
+		xil_printf("	** src : %x \n", packet->src);
+		xil_printf("	** dst : %x \n", packet->dst);
+		xil_printf("	** crc : %x \n", packet->crc);
+		xil_printf("	** type : %d \n", packet->type);
+		delai = 200 + rand() % 600;
+	} else {
+		delai = 2;
+		if ((nbGeneres % packGenQty) == 0) //On génère jusqu'à 250 paquets par phase de génération
+			isGenPhase = false;
+	}
+
+	paquets[0] = packet;
+	return 1;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           gen_tx_burst
+ * -Affiche les infos des paquets arrivés à destination et libère la mémoire allouée.
+ *********************************************************************************************************
+ */
+static int gen_tx_burst(int interface, Packet **paquets, int nb) {
+	Packet *packet;
+
+	for (int i = 0; i < nb; ++i) {
+		packet = paquets[i];
+		xil_printf("INT %d - SRC %08x - DST %08x - TYPE %d - CRC  %d - DATA %x\n", interface, packet->src,
+				packet->dst, packet->type, packet->crc, packet->data);
+		pio_liberer(packet);
+	}
+	return nb;
+}
+
+const PIO_OPS pio_gen_ops = {
+	.nom = "generateur",
+	.octets = sizeof(Packet),
+	.ouvrir = gen_ouvrir,
+	.rx_burst = gen_rx_burst,
+	.tx_burst = gen_tx_burst,
+};
@@ -0,0 +1,193 @@
+#include "paquet_io.h"
+#include <stdlib.h>
+#include <string.h>
+#include <xil_printf.h>
+
+#if PIO_PCAP_EN
+/*
+ *********************************************************************************************************
+ *                                   Interface : fichiers pcap en mémoire
+ * -pio_pcap_entree : image d'un fichier pcap (Ethernet), copiée par JTAG avant le lancement, à
+ *  l'adresse affichée par pio_ouvrir() (ou 'nm Lab2.elf') :
+ *      xsct% dow -data capture.pcap <adresse>
+ *  Les trames d'Ethertype PIO_ETHERTYPE sont rejouées au rythme de leurs horodatages (PIO_PCAP_RYTHME),
+ *  les autres sont comptées dans rx_rejets.
+ * -pio_pcap_sortie : les paquets envoyés, image pcap de pio_pcap_sortie_taille octets, relue par :
+ *      xsct% mrd -bin -file sortie.pcap <adresse> <mots>
+ *  La sortie d'un passage peut être rejouée au suivant ; Wireshark lit les deux.
+ *********************************************************************************************************
+ */
+
+#define PCAP_MAGIC               0xA1B2C3D4u
+#define PCAP_MAGIC_INVERSE       0xD4C3B2A1u   // Fichier écrit par une machine gros-boutiste
+#define PCAP_LINKTYPE_ETHERNET   1
+
+typedef struct {
+	INT32U magic;
+	INT16U version_majeure;
+	INT16U version_mineure;
+	INT32S zone;
+	INT32U precision;
+	INT32U snaplen;
+	INT32U linktype;
+} PCAP_ENTETE;
+
+typedef struct {
+	INT32U sec;
+	INT32U usec;
+	INT32U longueur;         // Octets enregistrés
+	INT32U longueur_orig;
+} PCAP_ENREG;
+
+INT8U pio_pcap_entree[PIO_PCAP_TAILLE] __attribute__((aligned(32)));
+INT8U pio_pcap_sortie[PIO_PCAP_TAILLE] __attribute__((aligned(32)));
+INT32U pio_pcap_sortie_taille;
+
+static bool valide;						// pio_pcap_entree contient une image pcap
+static bool inverse;					// Champs à retourner
+static INT32U position;					// Prochain enregistrement de l'entrée
+static INT64U us_debut;					// Horodatage du premier enregistrement rejoué
+static INT32U ticks_debut;
+
+static inline INT32U pcap_mot(INT32U mot) {
+	return inverse ? __builtin_bswap32(mot) : mot;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           pcap_ouvrir
+ * -Vérifie l'image d'entrée et écrit l'en-tête de l'image de sortie.
+ *********************************************************************************************************
+ */
+static int pcap_ouvrir(void) {
+	PCAP_ENTETE entete;
+
+	memset(&entete, 0, sizeof(entete));
+	entete.magic = PCAP_MAGIC;
+	entete.version_majeure = 2;
+	entete.version_mineure = 4;
+	entete.snaplen = 65535;
+	entete.linktype = PCAP_LINKTYPE_ETHERNET;
+	memcpy(pio_pcap_sortie, &entete, sizeof(entete));
+	pio_pcap_sortie_taille = sizeof(entete);
+
+	memcpy(&entete, pio_pcap_entree, sizeof(entete));
+	inverse = entete.magic == PCAP_MAGIC_INVERSE;
+	valide = (entete.magic == PCAP_MAGIC || inverse) && pcap_mot(entete.linktype) == PCAP_LINKTYPE_ETHERNET;
+	position = sizeof(entete);
+	us_debut = UINT64_MAX;
+
+	xil_printf("PCAP : entree a %x (%d octets), sortie a %x\n", pio_pcap_entree, PIO_PCAP_TAILLE, pio_pcap_sortie);
+	if (!valide) {
+		xil_printf("PCAP : pas d'image pcap Ethernet en entree (dow -data)\n");
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          pcap_rx_burst
+ * -Rejoue les enregistrements suivants : avec PIO_PCAP_RYTHME, attend l'heure du premier et prend ceux
+ *  qui sont dus ; sinon prend une rafale par tick.  À la fin de l'image, reprend au début
+ *  (PIO_PCAP_BOUCLE) ou ne reçoit plus rien.
+ *********************************************************************************************************
+ */
+static int pcap_rx_burst(Packet **paquets, int nb) {
+	PCAP_ENREG enreg;
+	Packet *paquet;
+	INT64U us;
+	bool repris = false;
+	int n = 0;
+
+	if (!valide)
+		return 0;
+#if !PIO_PCAP_RYTHME
+	OSTimeDly(1);
+#endif
+	while (n < nb) {
+		if (position + sizeof(enreg) > PIO_PCAP_TAILLE) {
+			valide = PIO_PCAP_BOUCLE && !repris;	// Une image sans paquet ne boucle pas sans fin
+			if (!valide)
+				break;
+			position = sizeof(PCAP_ENTETE);
+			us_debut = UINT64_MAX;
+			repris = true;
+		}
+		memcpy(&enreg, &pio_pcap_entree[position], sizeof(enreg));
+		enreg.longueur = pcap_mot(enreg.longueur);
+		if (enreg.longueur == 0 || enreg.longueur > PIO_PCAP_TAILLE - position - sizeof(enreg)) {
+			position = PIO_PCAP_TAILLE;		// Fin de l'image
+			continue;
+		}
+
+		us = (INT64U) pcap_mot(enreg.sec) * 1000000 + pcap_mot(enreg.usec);
+		if (us_debut == UINT64_MAX) {
+			us_debut = us;
+			ticks_debut = OSTimeGet();
+		}
+#if PIO_PCAP_RYTHME
+		{
+			INT32U du = (us - us_debut) * OS_TICKS_PER_SEC / 1000000;
+			INT32U ecoule = OSTimeGet() - ticks_debut;
+			if (du > ecoule) {
+				if (n > 0)
+					break;
+				OSTimeDly(du - ecoule);
+			}
+		}
+#endif
+
+		position += sizeof(enreg);
+		if (!pio_est_paquet(&pio_pcap_entree[position], enreg.longueur) ||
+				(paquet = malloc(sizeof(Packet))) == NULL) {
+			pio_compteurs.rx_rejets++;
+		} else {
+			memcpy(paquet, &pio_pcap_entree[position + PIO_ENTETE], sizeof(Packet));
+			paquets[n++] = paquet;
+			repris = false;
+		}
+		position += enreg.longueur;
+	}
+	return n;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          pcap_tx_burst
+ * -Ajoute les paquets à l'image de sortie, horodatés au tick près.
+ *********************************************************************************************************
+ */
+static int pcap_tx_burst(int interface, Packet **paquets, int nb) {
+	PCAP_ENREG enreg;
+	INT32U ticks = OSTimeGet();
+	int n = 0;
+
+	enreg.sec = ticks / OS_TICKS_PER_SEC;
+	enreg.usec = (ticks % OS_TICKS_PER_SEC) * (1000000 / OS_TICKS_PER_SEC);
+	enreg.longueur = PIO_TRAME;
+	enreg.longueur_orig = PIO_TRAME;
+	for (int i = 0; i < nb; ++i) {
+		if (pio_pcap_sortie_taille + sizeof(enreg) + PIO_TRAME > PIO_PCAP_TAILLE) {
+			pio_compteurs.tx_rejets++;
+		} else {
+			memcpy(&pio_pcap_sortie[pio_pcap_sortie_taille], &enreg, sizeof(enreg));
+			pio_pcap_sortie_taille += sizeof(enreg);
+			pio_entete(&pio_pcap_sortie[pio_pcap_sortie_taille], interface);
+			memcpy(&pio_pcap_sortie[pio_pcap_sortie_taille + PIO_ENTETE], paquets[i], sizeof(Packet));
+			pio_pcap_sortie_taille += PIO_TRAME;
+			n++;
+		}
+		pio_liberer(paquets[i]);
+	}
+	return n;
+}
+
+const PIO_OPS pio_pcap_ops = {
+	.nom = "pcap",
+	.octets = PIO_TRAME,
+	.ouvrir = pcap_ouvrir,
+	.rx_burst = pcap_rx_burst,
+	.tx_burst = pcap_tx_burst,
+};
+#endif
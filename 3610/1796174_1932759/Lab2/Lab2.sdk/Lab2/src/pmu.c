@@ -0,0 +1,172 @@
+#include "pmu.h"
+#include <string.h>
+#include <xil_printf.h>
+
+#if PMU_EN
+/*
+ *********************************************************************************************************
+ *                              Compteurs matériels par tâche et par région
+ * -Le port compte, pour chaque tâche et pour les ISR, les instructions, les accès et défauts du cache de
+ *  données L1, les défauts du TLB, les branches mal prédites, les cycles d'attente des données et les
+ *  lectures du L2 (OS_CPU_PmuCharge(), à chaque commutation).
+ * -PMU_REGION(r) ajoute à la région 'r' les événements de la tâche appelante jusqu'à la fin du bloc,
+ *  moins le coût de la mesure elle-même (calibré au premier pmu_afficher()).
+ * -pmu_afficher() donne, depuis l'affichage précédent, l'IPC et les taux de défauts de chaque étage du
+ *  routeur (une priorité : les TaskPrint en round-robin sont additionnées), des ISR et des régions.
+ *  Les défauts L2 comptent aussi les lectures des autres maîtres (second CPU, ACP).
+ *********************************************************************************************************
+ */
+
+typedef struct {
+	INT64U ctr[OS_CPU_PMU_NBR];
+	INT32U passages;
+} PMU_TOTAL;
+
+static const char *const noms[PMU_NB_REGIONS] = {
+	"reception", "classification", "CRC", "acheminement", "emission"
+};
+
+static PMU_TOTAL regions[PMU_NB_REGIONS + 1];			// + la région vide du calibrage
+static PMU_TOTAL regions_prec[PMU_NB_REGIONS];
+static OS_CPU_PMU_CTRS etages[OS_LOWEST_PRIO + 2];		// Par priorité, puis les ISR
+static OS_CPU_PMU_CTRS etages_prec[OS_LOWEST_PRIO + 2];
+static INT32U surcout[OS_CPU_PMU_NBR];					// Événements d'un passage dans une région vide
+static bool calibre;
+
+/*
+ *********************************************************************************************************
+ *                                         pmu_debut, pmu_fin
+ * -Début et fin d'une mesure de la tâche appelante (voir PMU_REGION()).
+ *********************************************************************************************************
+ */
+PMU_MESURE pmu_debut(INT8U region) {
+	PMU_MESURE mesure;
+	OS_CPU_PMU_CTRS ctrs;
+
+	mesure.region = region;
+	mesure.tache = OSTCBCur - &OSTCBTbl[0];
+	OS_CPU_PmuRd(mesure.tache, &ctrs);
+	for (int i = 0; i < OS_CPU_PMU_NBR; ++i)
+		mesure.debut[i] = ctrs.Ctr[i];
+	return mesure;
+}
+
+void pmu_fin(PMU_MESURE *mesure) {
+	OS_CPU_SR cpu_sr = 0;
+	OS_CPU_PMU_CTRS ctrs;
+	PMU_TOTAL *total = &regions[mesure->region];
+
+	OS_CPU_PmuRd(mesure->tache, &ctrs);
+	OS_ENTER_CRITICAL();
+	for (int i = 0; i < OS_CPU_PMU_NBR; ++i)
+		total->ctr[i] += (INT32U) ctrs.Ctr[i] - mesure->debut[i];
+	total->passages++;
+	OS_EXIT_CRITICAL();
+}
+
+static void pmu_calibrer(void) {
+	PMU_TOTAL *vide = &regions[PMU_NB_REGIONS];
+
+	for (int n = 0; n < PMU_CALIBRAGE; ++n) {
+		PMU_REGION(PMU_NB_REGIONS);
+	}
+	for (int i = 0; i < OS_CPU_PMU_NBR; ++i)
+		surcout[i] = vide->ctr[i] / vide->passages;
+	calibre = true;
+}
+
+/*
+ *********************************************************************************************************
+ *                                             pmu_taux
+ * -Affiche les taux des événements 'd' : IPC, défauts L1D (%), défauts du TLB et branches mal prédites
+ *  par 1000 instructions, cycles d'attente des données (%), défauts des lectures L2 (%).
+ *********************************************************************************************************
+ */
+static INT32U pmu_ratio(INT64U num, INT64U den) {
+	return den != 0 ? num / den : 0;
+}
+
+static void pmu_taux(const INT64U *d) {
+	INT64U l2_defauts = d[OS_CPU_PMU_L2_RD_REQ] > d[OS_CPU_PMU_L2_RD_HIT] ?
+			d[OS_CPU_PMU_L2_RD_REQ] - d[OS_CPU_PMU_L2_RD_HIT] : 0;
+	INT32U ipc = pmu_ratio(d[OS_CPU_PMU_INSTR] * 100, d[OS_CPU_PMU_CYC]);
+	INT32U l1d = pmu_ratio(d[OS_CPU_PMU_DC_MISS] * 10000, d[OS_CPU_PMU_DC_ACCESS]);
+	INT32U tlb = pmu_ratio(d[OS_CPU_PMU_TLB_MISS] * 100000, d[OS_CPU_PMU_INSTR]);
+	INT32U br = pmu_ratio(d[OS_CPU_PMU_BR_MISS] * 100000, d[OS_CPU_PMU_INSTR]);
+	INT32U attente = pmu_ratio(d[OS_CPU_PMU_STALL] * 10000, d[OS_CPU_PMU_CYC]);
+	INT32U l2 = pmu_ratio(l2_defauts * 10000, d[OS_CPU_PMU_L2_RD_REQ]);
+
+	xil_printf("IPC %d.%02d, L1D %d.%02d %%, TLB %d.%02d/ki, branches %d.%02d/ki, attente %d.%02d %%, L2 %d.%02d %%\n",
+			ipc / 100, ipc % 100, l1d / 100, l1d % 100, tlb / 100, tlb % 100, br / 100, br % 100,
+			attente / 100, attente % 100, l2 / 100, l2 % 100);
+}
+
+/*
+ *********************************************************************************************************
+ *                                           pmu_afficher
+ * -Événements de chaque étage (priorité), des ISR et de chaque région depuis l'appel précédent.
+ *********************************************************************************************************
+ */
+void pmu_afficher(void) {
+	OS_CPU_SR cpu_sr = 0;
+	INT8U idx[OS_CPU_PMU_NBR_TCB];
+	INT8U prio[OS_CPU_PMU_NBR_TCB];
+	INT8U nb = 0;
+	OS_CPU_PMU_CTRS ctrs;
+	INT64U d[OS_CPU_PMU_NBR];
+	PMU_TOTAL r;
+	OS_TCB *ptcb;
+
+	if (!calibre)
+		pmu_calibrer();
+
+	// Tâches existantes (OSTCBList, copiée en section critique), puis leurs compteurs par priorité
+	memset(etages, 0, sizeof(etages));
+	OS_ENTER_CRITICAL();
+	for (ptcb = OSTCBList; ptcb != NULL && nb < OS_CPU_PMU_NBR_TCB; ptcb = ptcb->OSTCBNext) {
+		idx[nb] = ptcb - &OSTCBTbl[0];
+		prio[nb] = ptcb->OSTCBPrio;
+		nb++;
+	}
+	OS_EXIT_CRITICAL();
+	for (int k = 0; k < nb; ++k) {
+		OS_CPU_PmuRd(idx[k], &ctrs);
+		for (int i = 0; i < OS_CPU_PMU_NBR; ++i)
+			etages[prio[k]].Ctr[i] += ctrs.Ctr[i];
+	}
+	OS_CPU_PmuRd(OS_CPU_PMU_ISR, &etages[OS_LOWEST_PRIO + 1]);
+
+	xil_printf("PMU : IPC, defauts L1D, TLB et branches par 1000 instructions, attente des donnees, defauts L2\n");
+	for (int p = 0; p <= OS_LOWEST_PRIO + 1; ++p) {
+		if (etages[p].Ctr[OS_CPU_PMU_CYC] <= etages_prec[p].Ctr[OS_CPU_PMU_CYC])
+			continue;					// Étage inactif (ou tâche supprimée)
+		for (int i = 0; i < OS_CPU_PMU_NBR; ++i)
+			d[i] = etages[p].Ctr[i] - etages_prec[p].Ctr[i];
+		if (p <= OS_LOWEST_PRIO)
+			xil_printf("  Tache %d : ", p);
+		else
+			xil_printf("  ISR : ");
+		pmu_taux(d);
+	}
+	memcpy(etages_prec, etages, sizeof(etages));
+
+	for (int n = 0; n < PMU_NB_REGIONS; ++n) {
+		OS_ENTER_CRITICAL();
+		r = regions[n];
+		OS_EXIT_CRITICAL();
+		if (r.passages == regions_prec[n].passages)
+			continue;
+		for (int i = 0; i < OS_CPU_PMU_NBR; ++i) {
+			d[i] = r.ctr[i] - regions_prec[n].ctr[i];
+			if (d[i] > (INT64U) surcout[i] * (r.passages - regions_prec[n].passages))
+				d[i] -= (INT64U) surcout[i] * (r.passages - regions_prec[n].passages);
+			else
+				d[i] = 0;
+		}
+		xil_printf("  Region %s : %d passages, %d cycles/passage, ", noms[n], r.passages - regions_prec[n].passages,
+				(INT32U)(d[OS_CPU_PMU_CYC] / (r.passages - regions_prec[n].passages)));
+		pmu_taux(d);
+		regions_prec[n] = r;
+	}
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef PMU_H
+#define PMU_H
+
+#include <ucos_ii.h>
+#include <stdbool.h>
+
+/* ************************************************
+ *              CONFIGURATION DES COMPTEURS MATÉRIELS
+ **************************************************/
+
+#define PMU_EN                   1     // 1 : régions mesurées et rapport de TaskStats (compteurs du port, OS_CPU_PMU_EN)
+
+#define PMU_CALIBRAGE            16    // Passages d'une région vide pour mesurer le coût de PMU_REGION()
+
+#if PMU_EN && !(OS_CPU_PMU_EN > 0)
+#error "pmu.h : PMU_EN demande OS_CPU_PMU_EN (os_cpu.h)"
+#endif
+
+/* ************************************************
+ *              RÉGIONS
+ **************************************************/
+
+typedef enum {
+	PMU_RECEPTION,           // pio_rx_burst() de TaskGeneratePacket
+	PMU_CLASSIFICATION,      // Filtre des sources de TaskComputing
+	PMU_CRC,                 // computePacketCRC()
+	PMU_ACHEMINEMENT,        // Choix de l'interface de sortie par TaskForwarding
+	PMU_EMISSION,            // pio_tx_burst() de TaskPrint
+	PMU_NB_REGIONS
+} PMU_REGION_ID;
+
+typedef struct {
+	INT8U region;
+	INT8U tache;             // Index de la tâche dans OSTCBTbl[]
+	INT32U debut[OS_CPU_PMU_NBR];
+} PMU_MESURE;
+
+// Mesure le reste du bloc englobant, jusqu'à l'accolade fermante (même par return, break ou continue).
+// Seuls les événements de la tâche comptent : ni ceux des tâches qui la préemptent, ni ceux des ISR.
+#if PMU_EN
+#define PMU_REGION(region) \
+	PMU_MESURE pmu_mesure_##region __attribute__((cleanup(pmu_fin))) = pmu_debut(region)
+#else
+#define PMU_REGION(region)
+#endif
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+PMU_MESURE pmu_debut(INT8U region);
+void pmu_fin(PMU_MESURE *mesure);
+void pmu_afficher(void);
+
+#endif
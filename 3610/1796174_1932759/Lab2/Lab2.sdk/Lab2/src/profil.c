@@ -0,0 +1,300 @@
+#include "profil.h"
+#include <string.h>
+#include <xil_printf.h>
+#include <xttcps.h>
+
+#if PROFIL_EN
+/*
+ *********************************************************************************************************
+ *                                    Profilage par échantillonnage du PC
+ * -À chaque échantillon (tick de l'OS ou TTC 0, PROFIL_SOURCE), profil_echantillon() relit le PC de la
+ *  tâche interrompue dans le contexte que le port vient de sauver (OSTCBCur->OSTCBStkPtr, voir
+ *  OS_CPU_ARM_ExceptIrqHndlr) et incrémente la case de PROFIL_BIN octets de code qui le contient, dans
+ *  l'histogramme de la tâche.  Une ISR interrompue (OSIntNesting > 1, contexte à OS_CPU_ExceptStkPtr)
+ *  va dans le profil PROFIL_ISR.  Le GIC sert les IRQ sans imbrication (measured_irq_handler()) : ce
+ *  profil reste vide tant qu'aucune ISR ne rétablit les interruptions ; le temps des ISR est alors dans
+ *  « CPU ISR » de TaskStats, et 'retardes' compte les échantillons retenus par une ISR ou une section
+ *  critique (leur PC est celui où la tâche a repris).
+ * -Le tick est synchrone des réveils des tâches (OSTimeDly()) et biaise le profil ; le TTC a son horloge.
+ * -profil_afficher() écrit un gmon.out par tâche dans profil_gmon (histogramme seul, comme celui de
+ *  profile/ du BSP, mais sans -pg ni _gmonparam) et affiche les cases les plus chargées.  Sur l'hôte :
+ *      xsct% mrd -bin -file gmon_t5.out <adresse> <mots>
+ *      $ arm-none-eabi-gprof -b -p Lab2.elf gmon_t5.out
+ *      $ arm-none-eabi-addr2line -f -e Lab2.elf <case>
+ *********************************************************************************************************
+ */
+
+#define GMON_VERSION             1
+#define GMON_TAG_TIME_HIST       0
+#define GMON_ENTETE              53    // "gmon", version, 12 octets libres, étiquette, en-tête de l'histogramme
+
+#if PROFIL_SOURCE == PROFIL_TTC
+#define PROFIL_TAUX              PROFIL_FREQ_HZ
+#else
+#define PROFIL_TAUX              OS_TICKS_PER_SEC
+#endif
+
+typedef struct {
+	INT8U prio;						// Tâche du profil (profils 0 à PROFIL_NB_TACHES - 1)
+	INT32U echantillons;
+	INT32U cases[PROFIL_NB_CASES];
+} PROFIL;
+
+extern char __text_start[];			// lscript.ld
+extern char __text_end[];
+
+INT8U profil_gmon[PROFIL_NB_PROFILS][PROFIL_GMON_TAILLE] __attribute__((aligned(4)));
+
+static PROFIL profils[PROFIL_NB_PROFILS];
+static INT8U profil_prio[OS_LOWEST_PRIO + 1];	// Profil de chaque priorité, 0xFF : pas encore vue
+static INT8U nb_taches;
+static INT32U nb_cases;						// Cases couvrant .text (PROFIL_NB_CASES au plus)
+static bool actif;
+static PROFIL_STATS stats;
+static INT32U debut;
+#if PROFIL_SOURCE == PROFIL_TTC
+static XTtcPs ttc;
+static INT32U seuil_retard;					// PROFIL_RETARD_US en périodes du compteur du TTC
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                        profil_echantillon
+ * -Appelée par une ISR (profil_isr() ou timer_isr()), interruptions masquées.
+ *********************************************************************************************************
+ */
+void profil_echantillon(void) {
+	INT32U ts = OS_TS_GET();
+	INT32U *contexte;
+	INT32U i;
+	INT8U n;
+
+	if (!actif || OSIntNesting == 0)		// OSRunning à 0 : le port n'a pas sauvé de contexte
+		return;
+	if (OSIntNesting > 1) {
+		contexte = (INT32U *) OS_CPU_ExceptStkPtr;
+		n = PROFIL_ISR;
+	} else {
+		contexte = (INT32U *) OSTCBCur->OSTCBStkPtr;
+		n = profil_prio[OSTCBCur->OSTCBPrio];
+		if (n == 0xFF) {
+			n = nb_taches < PROFIL_NB_TACHES ? nb_taches++ : PROFIL_AUTRES;
+			profils[n].prio = OSTCBCur->OSTCBPrio;
+			profil_prio[OSTCBCur->OSTCBPrio] = n;
+		}
+	}
+
+	i = (contexte[15] - (INT32U) __text_start) / PROFIL_BIN;	// CPSR, R0-R12, LR, PC
+	if (i < nb_cases)
+		profils[n].cases[i]++;
+	else
+		stats.hors_texte++;
+	profils[n].echantillons++;
+	stats.echantillons++;
+
+	ts = OS_TS_GET() - ts;
+	stats.cycles += ts;
+	if (ts > stats.cycles_max)
+		stats.cycles_max = ts;
+}
+
+#if PROFIL_SOURCE == PROFIL_TTC
+/*
+ *********************************************************************************************************
+ *                                            profil_isr
+ * -Intervalle du TTC écoulé.  Le compteur repart de 0 à l'échéance : sa valeur est le retard de l'ISR.
+ *********************************************************************************************************
+ */
+void profil_isr(void *not_valid) {
+	INT32U retard = XTtcPs_GetCounterValue(&ttc);
+	INT32U isr = XTtcPs_GetInterruptStatus(&ttc);
+
+	XTtcPs_ClearInterruptStatus(&ttc, isr);
+	if (isr & XTTCPS_IXR_INTERVAL_MASK) {
+		if (retard > seuil_retard)
+			stats.retardes++;
+		profil_echantillon();
+	}
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                            profil_init
+ * -Appelée par initialize_bsp() : prépare le TTC, qui reste arrêté jusqu'à profil_demarrer().
+ *********************************************************************************************************
+ */
+int profil_init(void) {
+	memset(profil_prio, 0xFF, sizeof(profil_prio));
+	nb_cases = ((INT32U) __text_end - (INT32U) __text_start + PROFIL_BIN - 1) / PROFIL_BIN;
+	if (nb_cases > PROFIL_NB_CASES) {
+		xil_printf("PROFIL : .text depasse PROFIL_TEXTE_MAX de %d octets\n",
+				(nb_cases - PROFIL_NB_CASES) * PROFIL_BIN);
+		nb_cases = PROFIL_NB_CASES;
+	}
+
+#if PROFIL_SOURCE == PROFIL_TTC
+	XTtcPs_Config *config;
+	XInterval intervalle;
+	INT8U prescaler;
+	int status;
+
+	config = XTtcPs_LookupConfig(PROFIL_TTC_DEVICE_ID);
+	if (config == NULL)
+		return XST_FAILURE;
+	status = XTtcPs_CfgInitialize(&ttc, config, config->BaseAddress);
+	if (status == XST_DEVICE_IS_STARTED) {	// Laissé en marche par le passage précédent (débogueur)
+		XTtcPs_Stop(&ttc);
+		status = XTtcPs_CfgInitialize(&ttc, config, config->BaseAddress);
+	}
+	if (status != XST_SUCCESS)
+		return status;
+
+	XTtcPs_SetOptions(&ttc, XTTCPS_OPTION_INTERVAL_MODE | XTTCPS_OPTION_WAVE_DISABLE);
+	XTtcPs_CalcIntervalFromFreq(&ttc, PROFIL_FREQ_HZ, &intervalle, &prescaler);
+	if (prescaler == 0xFF)
+		return XST_FAILURE;
+	XTtcPs_SetInterval(&ttc, intervalle);
+	XTtcPs_SetPrescaler(&ttc, prescaler);
+
+	seuil_retard = config->InputClockHz / 1000000 * PROFIL_RETARD_US;
+	if (prescaler != XTTCPS_CLK_CNTRL_PS_DISABLE)
+		seuil_retard >>= prescaler + 1;
+#endif
+	return XST_SUCCESS;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          profil_demarrer
+ * -Appelée par connect_ttc_irq() une fois profil_isr() connectée (sans rien connecter avec PROFIL_TICK).
+ *********************************************************************************************************
+ */
+void profil_demarrer(void) {
+	debut = OSTimeGet();
+	actif = true;
+#if PROFIL_SOURCE == PROFIL_TTC
+	XTtcPs_EnableInterrupts(&ttc, XTTCPS_IXR_INTERVAL_MASK);
+	XTtcPs_Start(&ttc);
+#endif
+}
+
+void profil_arreter(void) {
+	actif = false;
+#if PROFIL_SOURCE == PROFIL_TTC
+	XTtcPs_Stop(&ttc);
+	XTtcPs_DisableInterrupts(&ttc, XTTCPS_IXR_INTERVAL_MASK);
+#endif
+}
+
+/*
+ *********************************************************************************************************
+ *                                            profil_stats
+ * -Copie les compteurs, puis les remet à zéro si 'reset'.  Les histogrammes ne sont jamais remis à zéro.
+ *********************************************************************************************************
+ */
+void profil_stats(PROFIL_STATS *s, bool reset) {
+	OS_CPU_SR cpu_sr = 0;
+	INT32U maintenant = OSTimeGet();
+
+	OS_ENTER_CRITICAL();
+	*s = stats;
+	s->ticks = maintenant - debut;
+	if (reset) {
+		memset(&stats, 0, sizeof(stats));
+		debut = maintenant;
+	}
+	OS_EXIT_CRITICAL();
+}
+
+/*
+ *********************************************************************************************************
+ *                                         profil_gmon_ecrire
+ * -Écrit l'histogramme 'profil' au format gmon.out (GMON_TAG_TIME_HIST, compteurs de 16 bits).  Au-delà
+ *  de 65535 échantillons par case, les compteurs sont divisés par 'echelle' et le taux aussi : gprof
+ *  affiche toujours des secondes.  Retourne la taille de l'image en octets.
+ *********************************************************************************************************
+ */
+static INT32U profil_gmon_ecrire(INT8U *image, const PROFIL *profil) {
+	INT32U bas = (INT32U) __text_start;
+	INT32U haut = bas + nb_cases * PROFIL_BIN;
+	INT32U version = GMON_VERSION;
+	INT32U max = 0, echelle, taux;
+	INT16U compteur;
+
+	for (INT32U i = 0; i < nb_cases; ++i) {
+		if (profil->cases[i] > max)
+			max = profil->cases[i];
+	}
+	echelle = max / 65536 + 1;
+	taux = PROFIL_TAUX / echelle;
+
+	memset(image, 0, GMON_ENTETE);
+	memcpy(&image[0], "gmon", 4);
+	memcpy(&image[4], &version, 4);
+	image[20] = GMON_TAG_TIME_HIST;
+	memcpy(&image[21], &bas, 4);
+	memcpy(&image[25], &haut, 4);
+	memcpy(&image[29], &nb_cases, 4);
+	memcpy(&image[33], &taux, 4);
+	memcpy(&image[37], "seconds", 7);
+	image[52] = 's';
+	for (INT32U i = 0; i < nb_cases; ++i) {
+		compteur = profil->cases[i] / echelle;
+		memcpy(&image[GMON_ENTETE + 2 * i], &compteur, 2);
+	}
+	return GMON_ENTETE + 2 * nb_cases;
+}
+
+/*
+ *********************************************************************************************************
+ *                                          profil_afficher
+ * -Pour chaque profil non vide : part des échantillons depuis le démarrage, image gmon.out à relire et
+ *  les PROFIL_TOP cases les plus chargées (adresse du début de la case, pour addr2line).
+ *********************************************************************************************************
+ */
+void profil_afficher(void) {
+	INT32U top[PROFIL_TOP];
+	INT32U total = 0, taille, part;
+	PROFIL *profil;
+	int nb_top, j;
+
+	for (int n = 0; n < PROFIL_NB_PROFILS; ++n)
+		total += profils[n].echantillons;
+	if (total == 0)
+		return;
+
+	for (int n = 0; n < PROFIL_NB_PROFILS; ++n) {
+		profil = &profils[n];
+		if (profil->echantillons == 0)
+			continue;
+
+		// Cases triées par compteur décroissant
+		nb_top = 0;
+		for (INT32U i = 0; i < nb_cases; ++i) {
+			if (profil->cases[i] == 0 || (nb_top == PROFIL_TOP && profil->cases[i] <= profil->cases[top[nb_top - 1]]))
+				continue;
+			if (nb_top < PROFIL_TOP)
+				nb_top++;
+			for (j = nb_top - 1; j > 0 && profil->cases[top[j - 1]] < profil->cases[i]; --j)
+				top[j] = top[j - 1];
+			top[j] = i;
+		}
+
+		taille = profil_gmon_ecrire(profil_gmon[n], profil);
+		part = (INT64U) profil->echantillons * 10000 / total;
+		if (n == PROFIL_ISR)
+			xil_printf("  Profil ISR");
+		else if (n == PROFIL_AUTRES)
+			xil_printf("  Profil autres taches");
+		else
+			xil_printf("  Profil tache %d", profil->prio);
+		xil_printf(" : %d echantillons (%d.%02d %%), gmon.out a %x (%d mots)\n", profil->echantillons,
+				part / 100, part % 100, profil_gmon[n], (taille + 3) / 4);
+		for (j = 0; j < nb_top; ++j) {
+			xil_printf("    %08x : %d\n", (INT32U) __text_start + top[j] * PROFIL_BIN,
+					profil->cases[top[j]]);
+		}
+	}
+}
+#endif
@@ -0,0 +1,66 @@
+#ifndef PROFIL_H
+#define PROFIL_H
+
+#include <ucos_ii.h>
+#include <stdbool.h>
+#include <xparameters.h>
+
+/* ************************************************
+ *              CONFIGURATION DU PROFILAGE
+ **************************************************/
+
+#define PROFIL_EN                1     // 1 : échantillonne le PC des tâches (voir profil.c)
+
+#define PROFIL_TICK              0     // Échantillon à chaque tick de l'OS (timer_isr), OS_TICKS_PER_SEC
+#define PROFIL_TTC               1     // Échantillon à chaque interruption du TTC 0, PROFIL_FREQ_HZ
+#define PROFIL_SOURCE            PROFIL_TTC
+
+#define PROFIL_FREQ_HZ           10000 // Échantillons par seconde (PROFIL_TTC)
+#define PROFIL_TTC_DEVICE_ID     XPAR_XTTCPS_0_DEVICE_ID
+#define PROFIL_TTC_IRQ_ID        XPAR_XTTCPS_0_INTR
+#define PROFIL_RETARD_US         2     // Échantillon pris plus tard : ISR ou section critique en cours
+
+#define PROFIL_BIN               32    // Octets de code par case de l'histogramme (puissance de 2)
+#define PROFIL_TEXTE_MAX         (256 * 1024)  // Octets de .text couverts à partir de __text_start
+#define PROFIL_NB_TACHES         12    // Tâches profilées séparément, les suivantes vont dans « autres »
+#define PROFIL_TOP               5     // Cases les plus chargées affichées par tâche
+
+#define PROFIL_NB_CASES          (PROFIL_TEXTE_MAX / PROFIL_BIN)
+#define PROFIL_ISR               PROFIL_NB_TACHES         // Profil des ISR interrompues (IRQ imbriquées)
+#define PROFIL_AUTRES            (PROFIL_NB_TACHES + 1)   // Profil des tâches au-delà de PROFIL_NB_TACHES
+#define PROFIL_NB_PROFILS        (PROFIL_NB_TACHES + 2)
+
+#define PROFIL_GMON_TAILLE       (((53 + 2 * PROFIL_NB_CASES) + 3) & ~3)  // Octets par image gmon.out
+
+#if PROFIL_BIN & (PROFIL_BIN - 1)
+#error "profil.h : PROFIL_BIN doit etre une puissance de 2"
+#endif
+
+/* ************************************************
+ *              STATISTIQUES
+ **************************************************/
+
+typedef struct {
+	INT32U echantillons;     // Échantillons pris (tâches et ISR)
+	INT32U hors_texte;       // PC hors de [__text_start, __text_start + PROFIL_TEXTE_MAX[
+	INT32U retardes;         // Pris plus de PROFIL_RETARD_US après l'échéance du TTC
+	INT32U cycles;           // Cycles CPU passés dans profil_echantillon() (OS_TS_GET())
+	INT32U cycles_max;
+	INT32U ticks;            // Durée de la mesure (depuis le dernier profil_stats(..., true))
+} PROFIL_STATS;
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+int profil_init(void);
+void profil_demarrer(void);
+void profil_arreter(void);
+void profil_isr(void *not_valid);
+void profil_echantillon(void);
+void profil_stats(PROFIL_STATS *stats, bool reset);
+void profil_afficher(void);
+
+extern INT8U profil_gmon[PROFIL_NB_PROFILS][PROFIL_GMON_TAILLE];
+
+#endif
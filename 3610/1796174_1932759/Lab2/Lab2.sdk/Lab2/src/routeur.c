@@ -1,15 +1,23 @@
 #include "routeur.h"
+#include "bench.h"
+#include "slab.h"
+#include "osview.h"
+#include "uart.h"
+#include "profil.h"
+#include "pmu.h"
 #include "bsp_init.h"
 #include "platform.h"
 #include <stdlib.h>
 #include <stdbool.h>
 #include <xil_printf.h>
 #include <xgpio.h>
+#include <xtime_l.h>
 
 ///////////////////////////////////////////////////////////////////////////////////////
 //								uC-OS global variables
 ///////////////////////////////////////////////////////////////////////////////////////
 #define TASK_STK_SIZE 8192
+#define TASK_STK_OPT (OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR)
 
 ///////////////////////////////////////////////////////////////////////////////////////
 //								Routines d'interruptions
@@ -18,20 +26,23 @@
 void timer_isr(void* not_valid) {
 	if (private_timer_irq_triggered()) {
 		private_timer_clear_irq();
+#if PROFIL_EN && PROFIL_SOURCE == PROFIL_TICK
+		profil_echantillon();
+#endif
 		OSTimeTick();
 	}
 }
 
 void fit_timer_1s_isr(void *not_valid) {
 	uint8_t err;
-	err = OSSemPost(semVerifySrc);
-	err_msg("semVerifySrc_fit_timer_1s_isr", err);
+	OSFlagPost(flagsVerify, FLAG_VERIFY_SRC, OS_FLAG_SET, &err);
+	err_msg("flagsVerify_fit_timer_1s_isr", err);
 }
 
 void fit_timer_3s_isr(void *not_valid) {
 	uint8_t err;
-	err = OSSemPost(semVerifyCRC);
-	err_msg("semVerifyCRC_fit_timer_3s_isr", err);
+	OSFlagPost(flagsVerify, FLAG_VERIFY_CRC, OS_FLAG_SET, &err);
+	err_msg("flagsVerify_fit_timer_3s_isr", err);
 }
 
 void gpio_isr(void * not_valid) {
@@ -41,59 +52,108 @@ void gpio_isr(void * not_valid) {
 
 /*
  *********************************************************************************************************
- *                                            computeCRC
- * -Calcule la check value d'un pointeur quelconque (cyclic redudancy check)
+ *                                          computePacketCRC
+ * -Calcule la check value d'un paquet en utilisant un CRC (cyclic redudancy check)
  * -Retourne 0 si le CRC est correct, une autre valeur sinon.
  *********************************************************************************************************
  */
-unsigned int computeCRC(uint16_t* w, int nleft) {
-	unsigned int sum = 0;
-	uint16_t answer = 0;
-
-	// Adding words of 16 bits
-	while (nleft > 1) {
-		sum += *w++;
-		nleft -= 2;
-	}
-
-	// Handling the last byte
-	if (nleft == 1) {
-		*(unsigned char *) (&answer) = *(const unsigned char *) w;
-		sum += answer;
-	}
-
-	// Handling overflow
-	sum = (sum & 0xffff) + (sum >> 16);
-	sum += (sum >> 16);
-
-	answer = ~sum;
-	return (unsigned int) answer;
+static inline unsigned int computePacketCRC(Packet* packet) {
+	PMU_REGION(PMU_CRC);
+	return computeCRC((uint16_t*) packet, sizeof(Packet));
 }
 
 /*
  *********************************************************************************************************
- *                                          computePacketCRC
- * -Calcule la check value d'un paquet en utilisant un CRC (cyclic redudancy check)
- * -Retourne 0 si le CRC est correct, une autre valeur sinon.
+ *                                          routeur_post
+ * -Envoie un paquet dans une file selon ROUTEUR_Q_POST_BLOQUANT : en attendant une place au plus
+ *  ROUTEUR_Q_POST_TIMEOUT ticks, ou en appliquant la politique de la file (ROUTEUR_Q_POLICY).
+ * -Si le paquet n'a pas été envoyé (OS_ERR_Q_FULL ou OS_ERR_TIMEOUT), l'appelant doit le libérer.
  *********************************************************************************************************
  */
-static inline unsigned int computePacketCRC(Packet* packet) {
-	return computeCRC((uint16_t*) packet, sizeof(Packet));
+static INT8U routeur_post(OS_EVENT *q, Packet *packet) {
+#if ROUTEUR_Q_POST_BLOQUANT
+	return OSQPostPend(q, packet, ROUTEUR_Q_POST_TIMEOUT);
+#else
+	return OSQPost(q, packet);
+#endif
+}
+
+// Envoie un paquet vérifié à TaskForwarding : dans la bande 'bande' de forwardPQ ou dans la file 'q'
+static INT8U routeur_dispatch(OS_EVENT *q, INT8U bande, Packet *packet) {
+#if ROUTEUR_PQ_EN
+	return OSPQPost(forwardPQ, packet, bande);
+#else
+	return routeur_post(q, packet);
+#endif
+}
+
+static inline bool routeur_rejete(INT8U err) {
+	return err == OS_ERR_Q_FULL || err == OS_ERR_TIMEOUT;
+}
+
+// Paquet le plus ancien d'une file pleine, abandonné par OS_Q_POLICY_DROP_HEAD
+static void paquet_perdu(void *packet) {
+	pio_liberer(packet);
+}
+
+#if OS_Q_STAT_EN > 0u
+// Maximum et moyenne (pondérée par le temps) du nb de paquets d'une file depuis le dernier appel
+static void stats_file(OS_EVENT *q, int *max, int *moyenne) {
+	OS_Q_STAT stat;
+
+	if (OSQStatGet(q, &stat, OS_Q_STAT_OPT_RESET) == OS_ERR_NONE) {
+		*max = stat.OSQEntriesMax;
+		*moyenne = stat.OSQEntriesAvg / 100;
+	}
 }
+#endif
+
+#if ROUTEUR_PQ_EN && (OS_PQ_STAT_EN > 0u)
+// Maximum, nb de paquets envoyés et rejetés de chaque bande de forwardPQ depuis le dernier appel
+static void stats_bandes(void) {
+	static const char *noms[] = { "high", "medium", "low" };	// Indexés par FORWARD_SET_xxx_PRIO
+	OS_PQ_STAT stat;
+	OS_PQ_BAND_STAT *bande;
+
+	if (OSPQStatGet(forwardPQ, &stat, OS_Q_STAT_OPT_RESET) != OS_ERR_NONE)
+		return;
+	for (int i = 0; i < stat.OSPQNbrBands; i++) {
+		bande = &stat.OSPQBandTbl[i];
+		xil_printf("Bande %s : maximum %d, %d paquets, %d rejetes (pleine)\n", noms[i],
+				bande->OSPQBandEntriesMax, bande->OSPQBandNPosts, bande->OSPQBandNFull);
+	}
+}
+#endif
 ///////////////////////////////////////////////////////////////////////////////////////
 //								uC/OS-II part
 ///////////////////////////////////////////////////////////////////////////////////////
 int main() {
+	XTime debut, fin_init, fin;
+
+	XTime_GetTime(&debut);
 
 	initialize_bsp();
 
 	// Initialize uC/OS-II
 	OSInit();
+	XTime_GetTime(&fin_init);
 
+#if BENCH_EN
+	bench_create();
+#else
 	create_application();
+#endif
+#if OSVIEW_EN
+	osview_create();
+#endif
 
 	prepare_and_enable_irq();
 
+	// Temps de demarrage, a comparer avec OS_INIT_STATIC_EN et OS_TASK_STK_CLR_LAZY_EN a 0 (os_cfg_r.h)
+	XTime_GetTime(&fin);
+	xil_printf("Demarrage : BSP + OSInit() %d us, main() -> OSStart() %d us\n",
+			(int)((fin_init - debut) * 1000000 / COUNTS_PER_SECOND), (int)((fin - debut) * 1000000 / COUNTS_PER_SECOND));
+
 	xil_printf("*** Starting uC/OS-II scheduler ***\n");
 
 	OSStart();
@@ -109,6 +169,10 @@ int main() {
 void create_application() {
 	int error;
 
+	error = pio_ouvrir(PIO_INTERFACE);
+	if (error != 0)
+		xil_printf("Error %d while opening the packet interface\n", error);
+
 	error = create_tasks();
 	if (error != 0)
 		xil_printf("Error %d while creating tasks\n", error);
@@ -130,15 +194,27 @@ int create_tasks() {
 	static OS_STK TaskPrint2Stk[TASK_STK_SIZE];
 	static OS_STK TaskPrint3Stk[TASK_STK_SIZE];
 
-	OSTaskCreate(TaskGeneratePacket, NULL, &TaskReceiveStk[TASK_STK_SIZE-1], TASK_GENERATE_PRIO);
-	OSTaskCreate(TaskVerifySource, NULL, &TaskVerifySourceStk[TASK_STK_SIZE-1], TASK_STOP_PRIO);
-	OSTaskCreate(TaskVerifyCRC, NULL, &TaskVerifyCRCStk[TASK_STK_SIZE-1], TASK_RESET_PRIO);
-	OSTaskCreate(TaskStats, NULL, &TaskStatsStk[TASK_STK_SIZE-1], TASK_STATS_PRIO);
-	OSTaskCreate(TaskComputing, NULL, &TaskComputeStk[TASK_STK_SIZE-1], TASK_COMPUTING_PRIO);
-	OSTaskCreate(TaskForwarding, NULL, &TaskForwardingStk[TASK_STK_SIZE-1], TASK_FORWARDING_PRIO);
-	OSTaskCreate(TaskPrint, &print_param[0], &TaskPrint1Stk[TASK_STK_SIZE-1], TASK_PRINT1_PRIO);
-	OSTaskCreate(TaskPrint, &print_param[1], &TaskPrint2Stk[TASK_STK_SIZE-1], TASK_PRINT2_PRIO);
-	OSTaskCreate(TaskPrint, &print_param[2], &TaskPrint3Stk[TASK_STK_SIZE-1], TASK_PRINT3_PRIO);
+	OSTaskCreateExt(TaskGeneratePacket, NULL, &TaskReceiveStk[TASK_STK_SIZE-1], TASK_GENERATE_PRIO, TASK_GENERATE_PRIO,
+			&TaskReceiveStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskVerifySource, NULL, &TaskVerifySourceStk[TASK_STK_SIZE-1], TASK_STOP_PRIO, TASK_STOP_PRIO,
+			&TaskVerifySourceStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskVerifyCRC, NULL, &TaskVerifyCRCStk[TASK_STK_SIZE-1], TASK_RESET_PRIO, TASK_RESET_PRIO,
+			&TaskVerifyCRCStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskStats, NULL, &TaskStatsStk[TASK_STK_SIZE-1], TASK_STATS_PRIO, TASK_STATS_PRIO,
+			&TaskStatsStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskComputing, NULL, &TaskComputeStk[TASK_STK_SIZE-1], TASK_COMPUTING_PRIO, TASK_COMPUTING_PRIO,
+			&TaskComputeStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskForwarding, NULL, &TaskForwardingStk[TASK_STK_SIZE-1], TASK_FORWARDING_PRIO, TASK_FORWARDING_PRIO,
+			&TaskForwardingStk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+
+	// Les 3 TaskPrint partagent la même priorité et le CPU en round-robin
+	OSSchedRRCreate(TASK_PRINT_PRIO, TASK_PRINT_NB, TASK_PRINT_QUANTUM);
+	OSTaskCreateExt(TaskPrint, &print_param[0], &TaskPrint1Stk[TASK_STK_SIZE-1], TASK_PRINT_PRIO, TASK_PRINT_PRIO,
+			&TaskPrint1Stk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskPrint, &print_param[1], &TaskPrint2Stk[TASK_STK_SIZE-1], TASK_PRINT_PRIO, TASK_PRINT_PRIO,
+			&TaskPrint2Stk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
+	OSTaskCreateExt(TaskPrint, &print_param[2], &TaskPrint3Stk[TASK_STK_SIZE-1], TASK_PRINT_PRIO, TASK_PRINT_PRIO,
+			&TaskPrint3Stk[0], TASK_STK_SIZE, NULL, TASK_STK_OPT);
 	
 	return 0;
 }
@@ -147,18 +223,49 @@ int create_events() {
 	uint8_t err;
 
 	static void* inputMsg[1024];
+
+	inputQ = OSQCreate(&inputMsg[0], 1024);
+
+	// Ce que font les files pleines des paquets (voir routeur_post())
+	err = OSQPolicySet(inputQ, ROUTEUR_Q_POLICY, paquet_perdu);
+	err_msg("OSQPolicySet inputQ", err);
+
+#if ROUTEUR_PQ_EN
+	// TaskForwarding reçoit toujours le paquet de la bande la plus urgente de forwardPQ
+	static void* forwardMsg[3 * 1024];
+	static INT16U forwardTailles[] = { 1024, 1024, 1024 };	// high, medium, low (FORWARD_SET_xxx_PRIO)
+
+	forwardPQ = OSPQCreate(&forwardMsg[0], forwardTailles, ARRAY_SIZE(forwardTailles), &err);
+	err_msg("OSPQCreate forwardPQ", err);
+#else
 	static void* lowMsg[1024];
 	static void* mediumMsg[1024];
 	static void* highMsg[1024];
 
-	inputQ = OSQCreate(&inputMsg[0], 1024);
 	lowQ = OSQCreate(&lowMsg[0], 1024);
 	mediumQ = OSQCreate(&mediumMsg[0], 1024);
 	highQ = OSQCreate(&highMsg[0], 1024);
 
-	semVerifySrc = OSSemCreate(0);
-	semVerifyCRC = OSSemCreate(0);
-	semStats = OSSemCreate(0);
+	err = OSQPolicySet(lowQ, ROUTEUR_Q_POLICY, paquet_perdu);
+	err_msg("OSQPolicySet lowQ", err);
+	err = OSQPolicySet(mediumQ, ROUTEUR_Q_POLICY, paquet_perdu);
+	err_msg("OSQPolicySet mediumQ", err);
+	err = OSQPolicySet(highQ, ROUTEUR_Q_POLICY, paquet_perdu);
+	err_msg("OSQPolicySet highQ", err);
+
+	// TaskForwarding attend sur les 3 files à la fois, la plus prioritaire servie en premier
+	forwardSet = OSEventSetCreate(&err);
+	err_msg("OSEventSetCreate forwardSet", err);
+	err = OSEventSetAdd(forwardSet, highQ, FORWARD_SET_HIGH_PRIO);
+	err_msg("OSEventSetAdd highQ", err);
+	err = OSEventSetAdd(forwardSet, mediumQ, FORWARD_SET_MEDIUM_PRIO);
+	err_msg("OSEventSetAdd mediumQ", err);
+	err = OSEventSetAdd(forwardSet, lowQ, FORWARD_SET_LOW_PRIO);
+	err_msg("OSEventSetAdd lowQ", err);
+#endif
+
+	flagsVerify = OSFlagCreate(0, &err);
+	err_msg("OSFlagCreate flagsVerify", err);
 
 	mutexPacketSourceRejete = OSMutexCreate(MUT_REJET_PRIO, &err);
 	mutexPacketCRCRejete = OSMutexCreate(MUT_CRC_PRIO, &err);
@@ -180,74 +287,38 @@ int create_events() {
 /*
  *********************************************************************************************************
  *											  TaskGeneratePacket
- *  - Génère des paquets et les envoie dans la InputQ.
- *  - À des fins de développement de votre application, vous pouvez *temporairement* modifier la variable
- *    "shouldSlowthingsDown" à  true pour ne générer que quelques paquets par seconde, et ainsi pouvoir
- *    déboguer le flot de vos paquets de manière plus saine d'esprit. Cependant, la correction sera effectuée
- *    avec cette variable Ã  false.
+ *  - Reçoit les paquets de l'interface ouverte (PIO_INTERFACE, paquet_io.h) par rafales et les envoie
+ *    dans la InputQ.  Le générateur aléatoire d'origine est l'interface PIO_GEN (pio_gen.c).
  *********************************************************************************************************
  */
 void TaskGeneratePacket(void *data) {
-	srand(42);
 	uint8_t err;
-	bool isGenPhase = true; 					// Indique si on est dans la phase de generation ou non
-	const bool shouldSlowThingsDown = true;		// Variable � modifier
-	int packGenQty = (rand() % 250);
-	while (true) {
-		if (isGenPhase) {
-			Packet *packet = malloc(sizeof(Packet));
-
-			packet->src = rand() * (UINT32_MAX / RAND_MAX);
-			packet->dst = rand() * (UINT32_MAX / RAND_MAX);
-			packet->type = rand() % NB_PACKET_TYPE;
+	Packet *paquets[PIO_RAFALE];
+	int nb;
 
-			for (int i = 0; i < ARRAY_SIZE(packet->data); ++i)
-				packet->data[i] = (unsigned int) rand();
-			packet->data[0] = nbPacketCrees;
-
-			//Compute CRC
-			packet->crc = 0;
-			if (rand() % 10 == 9) // 10% of Packets with bad CRC
-				packet->crc = 1234;
-			else
-				packet->crc = computePacketCRC(packet);
+	while (true) {
+		{
+			PMU_REGION(PMU_RECEPTION);
+			nb = pio_rx_burst(paquets, PIO_RAFALE);
+		}
+		if (nb == 0) {
+			OSTimeDly(1);
+			continue;
+		}
 
+		for (int i = 0; i < nb; ++i) {
 			nbPacketCrees++;
+			err = routeur_post(inputQ, paquets[i]);
 
-			if (shouldSlowThingsDown) {
-				xil_printf("GENERATE : ********Génération du Paquet # %d ******** \n", nbPacketCrees);
-				xil_printf("ADD %x \n", packet);
-				xil_printf("	** src : %x \n", packet->src);
-				xil_printf("	** dst : %x \n", packet->dst);
-				xil_printf("	** crc : %x \n", packet->crc);
-				xil_printf("	** type : %d \n", packet->type);
-			}
-
-			err = OSQPost(inputQ, packet);
-
-			if (err == OS_ERR_Q_FULL) {
+			if (routeur_rejete(err)) {
+#if OS_TRACE_EN > 0u
+				// Fige la trace peu après la première saturation pour voir ce qui l'a causée
+				OSTraceTrigger(err, OS_TRACE_SIZE / 4u);
+#endif
 				xil_printf(
-						"GENERATE: Paquet rejet� a l'entr�e car la FIFO est pleine !\n");
-				free(packet);
+						"GENERATE: Paquet rejete a l'entree car la FIFO est pleine !\n");
+				pio_liberer(paquets[i]);
 			}
-
-			if (shouldSlowThingsDown) {
-				OSTimeDlyHMSM(0, 0, 0, 200 + rand() % 600);
-			} else {
-				OSTimeDlyHMSM(0, 0, 0, 2);
-
-				if ((nbPacketCrees % packGenQty) == 0) //On g�n�re jusqu'� 250 paquets par phase de g�n�ration
-						{
-					isGenPhase = false;
-				}
-			}
-		} else {
-			OSTimeDlyHMSM(0, 0, 0, 500);
-			isGenPhase = true;
-			packGenQty = (rand() % 250);
-			xil_printf(
-					"GENERATE: G�n�ration de %d paquets durant les %d prochaines millisecondes\n",
-					packGenQty, packGenQty * 2);
 		}
 	}
 }
@@ -262,9 +333,9 @@ void TaskGeneratePacket(void *data) {
 void TaskVerifySource(void *data) {
 	uint8_t err;
 	while(true) {
-		OSSemPend(semVerifySrc, 0, &err);
+		OSFlagPend(flagsVerify, FLAG_VERIFY_SRC, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err);
 
-		err_msg("semVerifySrc", err);
+		err_msg("flagsVerify source", err);
 		OSMutexPend(mutexPacketSourceRejete, 0, &err);
 		err_msg("Pend mutexPacketSourceRejete", err);
 		if (nbPacketSourceRejete >= 200) {
@@ -292,9 +363,9 @@ void TaskVerifySource(void *data) {
 void TaskVerifyCRC(void *data) {
 	uint8_t err;
 	while(true) {
-		OSSemPend(semVerifyCRC, 0, &err);
+		OSFlagPend(flagsVerify, FLAG_VERIFY_CRC, OS_FLAG_WAIT_SET_ANY + OS_FLAG_CONSUME, 0, &err);
 
-		err_msg("semVerifyCRC", err);
+		err_msg("flagsVerify CRC", err);
 		OSMutexPend(mutexPacketCRCRejete, 0, &err);
 		err_msg("Pend mutexPacketCRCRejete", err);
 		if (nbPacketCRCRejete >= 200) {
@@ -324,6 +395,7 @@ void TaskComputing(void *pdata) {
 	uint8_t err;
 	Packet *packet = NULL;
 	int waitCnt = 220000;
+	bool rejete;
 	while(true){
 		packet = OSQPend(inputQ, 0, &err);
 		err_msg("inputQ", err);
@@ -331,15 +403,20 @@ void TaskComputing(void *pdata) {
 		while (--waitCnt);
 		waitCnt = 220000;
 
-		if ((packet->src >= REJECT_LOW1 && packet->src <= REJECT_HIGH1)|
-			(packet->src >= REJECT_LOW2 && packet->src <= REJECT_HIGH2)|
-			(packet->src >= REJECT_LOW3 && packet->src <= REJECT_HIGH3)|
-			(packet->src >= REJECT_LOW4 && packet->src <= REJECT_HIGH4)){
+		{
+			PMU_REGION(PMU_CLASSIFICATION);
+			rejete = (packet->src >= REJECT_LOW1 && packet->src <= REJECT_HIGH1)|
+				(packet->src >= REJECT_LOW2 && packet->src <= REJECT_HIGH2)|
+				(packet->src >= REJECT_LOW3 && packet->src <= REJECT_HIGH3)|
+				(packet->src >= REJECT_LOW4 && packet->src <= REJECT_HIGH4);
+		}
+
+		if (rejete){
 
 			OSMutexPend(mutexPacketSourceRejete, 0, &err);
 			err_msg("Pend mutexPacketSourceRejete", err);
 			nbPacketSourceRejete++;
-			free(packet);
+			pio_liberer(packet);
 			err = OSMutexPost(mutexPacketSourceRejete);
 			err_msg("Post mutexPacketSourceRejete", err);
 			
@@ -348,16 +425,16 @@ void TaskComputing(void *pdata) {
 			OSMutexPend(mutexPacketCRCRejete, 0, &err);
 			err_msg("Pend mutexPacketCRCRejete", err);
 			nbPacketCRCRejete++;
-			free(packet);
+			pio_liberer(packet);
 			err = OSMutexPost(mutexPacketCRCRejete);
 			err_msg("Post mutexPacketCRCRejete", err);
 		}
 		else if (packet->type == PACKET_VIDEO) {
-			err = OSQPost(highQ, packet);
-			if (err == OS_ERR_Q_FULL){
+			err = routeur_dispatch(highQ, FORWARD_SET_HIGH_PRIO, packet);
+			if (routeur_rejete(err)){
 				OSMutexPend(mutexMemory, 0, &err);
 				err_msg("Pend mutexMemory", err);
-				free(packet);
+				pio_liberer(packet);
 				err = OSMutexPost(mutexMemory);
 				err_msg("Post mutexMemory", err);
 				err = OSMutexPost(mutexPrinting);
@@ -379,11 +456,11 @@ void TaskComputing(void *pdata) {
 			}
 		}
 		else if (packet->type == PACKET_AUDIO) {
-			err = OSQPost(mediumQ, packet);
-			if (err == OS_ERR_Q_FULL){
+			err = routeur_dispatch(mediumQ, FORWARD_SET_MEDIUM_PRIO, packet);
+			if (routeur_rejete(err)){
 				OSMutexPend(mutexMemory, 0, &err);
 				err_msg("Pend mutexMemory", err);
-				free(packet);
+				pio_liberer(packet);
 				err = OSMutexPost(mutexMemory);
 				err_msg("Post mutexMemory", err);
 				err = OSMutexPost(mutexPrinting);
@@ -404,11 +481,11 @@ void TaskComputing(void *pdata) {
 			}
 		}
 		else if (packet->type == PACKET_AUTRE) {
-			err = OSQPost(lowQ, packet);
-			if (err == OS_ERR_Q_FULL){
+			err = routeur_dispatch(lowQ, FORWARD_SET_LOW_PRIO, packet);
+			if (routeur_rejete(err)){
 				OSMutexPend(mutexMemory, 0, &err);
 				err_msg("Pend mutexMemory", err);
-				free(packet);
+				pio_liberer(packet);
 				err = OSMutexPost(mutexMemory);
 				err_msg("Post mutexMemory", err);
 				err = OSMutexPost(mutexPrinting);
@@ -448,19 +525,25 @@ void TaskComputing(void *pdata) {
 void TaskForwarding(void *pdata) {
 	uint8_t err;
 	Packet *packet = NULL;
+#if !ROUTEUR_PQ_EN
+	OS_EVENT *readyQ[1];
+#endif
 	while (true) {
-		/* À compléter */
-		packet = OSQAccept(highQ, &err);
+#if ROUTEUR_PQ_EN
+		// Bloque jusqu'à ce qu'une bande soit non vide et reçoit le paquet de la plus urgente
+		packet = OSPQPend(forwardPQ, 0, NULL, &err);
+		err_msg("OSPQPend forwardPQ", err);
+#else
+		// Bloque jusqu'à ce qu'une file soit non vide : highQ, puis mediumQ, puis lowQ
+		OSEventSetPend(forwardSet, readyQ, ARRAY_SIZE(readyQ), 0, &err);
+		err_msg("OSEventSetPend forwardSet", err);
+		if (err != OS_ERR_NONE)
+			continue;
+		packet = OSQAccept(readyQ[0], &err);
 		err_msg("Error accepting queue", err);
-		if (packet == NULL) {
-			packet = OSQAccept(mediumQ, &err);
-			err_msg("Error accepting queue", err);
-		}
-		if (packet == NULL) {
-			packet = OSQAccept(lowQ, &err);
-			err_msg("Error accepting queue", err);
-		}
-		else if (packet != NULL) {
+#endif
+		if (packet != NULL) {
+			PMU_REGION(PMU_ACHEMINEMENT);
 			if (packet->dst >= INT1_LOW && packet->dst <= INT1_HIGH) {
 				err = OSMboxPost(mbox[0], packet);
 				err_msg("Error posting mbox", err);
@@ -477,9 +560,9 @@ void TaskForwarding(void *pdata) {
 				OSMutexPend(mutexMemory, 0, &err);
 				err_msg("Error accepting mutex", err);
 				Packet *packet2 = malloc(sizeof(Packet));
-				*packet2 = *packet;
+				OS_CPU_MemCopy64(packet2, packet);		// Deux LDM/STM de 32 octets
 				Packet *packet3 = malloc(sizeof(Packet));
-				*packet3 = *packet;
+				OS_CPU_MemCopy64(packet3, packet);
 				err = OSMutexPost(mutexMemory);
 				err_msg("Error posting mutex", err);
 				
@@ -506,6 +589,15 @@ void TaskStats(void *pdata) {
 	uint8_t err;
 	while (true) {
 		/* À compléter */
+#if OS_Q_STAT_EN > 0u
+		// Les files tiennent elles-mêmes leur maximum et leur occupation moyenne
+		stats_file(inputQ, &max_msg_input, &moyenne_msg_input);
+#if !ROUTEUR_PQ_EN
+		stats_file(lowQ, &max_msg_low, &moyenne_msg_low);
+		stats_file(mediumQ, &max_msg_medium, &moyenne_msg_medium);
+		stats_file(highQ, &max_msg_high, &moyenne_msg_high);
+#endif
+#endif
 
 		xil_printf("\n------------------ Affichage des statistiques ------------------\n");
 		xil_printf("Nb de packets total traites : %d\n", nbPacketCrees);
@@ -516,12 +608,183 @@ void TaskStats(void *pdata) {
 		xil_printf("Nb d'echantillons de la période de profilage : %d\n", nb_echantillons);
 		xil_printf("Maximum file input : %d\n", max_msg_input);
 		xil_printf("Moyenne file input : %d\n", moyenne_msg_input);
+#if ROUTEUR_PQ_EN
+#if OS_PQ_STAT_EN > 0u
+		stats_bandes();
+#endif
+#else
 		xil_printf("Maximum file low : %d\n", max_msg_low);
 		xil_printf("Moyenne file low : %d\n", moyenne_msg_low);
 		xil_printf("Maximum file medium : %d\n", max_msg_medium);
 		xil_printf("Moyenne file medium : %d\n", moyenne_msg_medium);
 		xil_printf("Maximum file high : %d\n", max_msg_high);
 		xil_printf("Moyenne file high : %d\n", moyenne_msg_high);
+#endif
+		// Débit de l'interface depuis le dernier affichage
+		{
+			PIO_STATS s;
+			pio_stats(&s, true);
+			if (s.ticks > 0) {
+				xil_printf("  Interface %s : RX %d paquets/s (%d Ko/s), TX %d paquets/s (%d Ko/s)\n", pio_nom(),
+						(int)((INT64U) s.rx_paquets * OS_TICKS_PER_SEC / s.ticks),
+						(int)(s.rx_octets * OS_TICKS_PER_SEC / s.ticks / 1024),
+						(int)((INT64U) s.tx_paquets * OS_TICKS_PER_SEC / s.ticks),
+						(int)(s.tx_octets * OS_TICKS_PER_SEC / s.ticks / 1024));
+				xil_printf("  %d rejets RX, %d rejets TX, %d copies TX\n", s.rx_rejets, s.tx_rejets, s.tx_copies);
+			}
+		}
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+		// Durée max. où les interruptions ont été masquées (ISR comprises)
+		xil_printf("Interruptions masquees (max) : %d cycles\n", OS_CPU_IntDisMeasCntsMax * 2);
+#endif
+#if OS_ISR_POST_DEFERRED_EN > 0
+		// Les ISR reçoivent OS_ERR_NONE : les posts qui échouent au rejeu ne sont visibles qu'ici
+		{
+			INT32U echecs = 0;
+			for (int t = 0; t < OS_INT_Q_TYPE_NBR; t++)
+				echecs += OSIntQErrCtr[t];
+			xil_printf("Posts differes des ISR (max en attente / perdus / echoues) : %d / %d / %d\n",
+					OSIntQNbrEntriesMax, OSIntQOvfCtr, echecs);
+			if (echecs > 0)
+				xil_printf("  Echecs sem %d, q %d, q front %d, q opt %d, mbox %d, mbox opt %d, flag %d, pq %d (derniere erreur %d)\n",
+						OSIntQErrCtr[OS_INT_Q_TYPE_SEM_POST], OSIntQErrCtr[OS_INT_Q_TYPE_Q_POST],
+						OSIntQErrCtr[OS_INT_Q_TYPE_Q_POST_FRONT], OSIntQErrCtr[OS_INT_Q_TYPE_Q_POST_OPT],
+						OSIntQErrCtr[OS_INT_Q_TYPE_MBOX_POST], OSIntQErrCtr[OS_INT_Q_TYPE_MBOX_POST_OPT],
+						OSIntQErrCtr[OS_INT_Q_TYPE_FLAG_POST], OSIntQErrCtr[OS_INT_Q_TYPE_PQ_POST], OSIntQErrLast);
+		}
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+		// Utilisation du CPU par tâche depuis le dernier affichage (en centièmes de %)
+		{
+			static OS_TASK_CYC_SNAP snaps[2];
+			static INT8U snap_cur = 0;
+			OS_TASK_CYC_SNAP *prev = &snaps[snap_cur];
+			OS_TASK_CYC_SNAP *cur = &snaps[snap_cur ^ 1];
+			INT16U usage;
+			OSTaskCycSnap(cur);
+			for (INT8U prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+				usage = OSTaskCycUsage(prev, cur, prio, &err);
+				if (err == OS_ERR_NONE) {
+					xil_printf("  CPU tache %d : %d.%02d %% (%d commutations)\n", prio,
+							usage / 100, usage % 100, OSTCBPrioTbl[prio]->OSTCBCtxSwCtr);
+				}
+			}
+			usage = OSTaskCycUsage(prev, cur, OS_TASK_CYC_ISR, &err);
+			xil_printf("  CPU ISR : %d.%02d %%\n", usage / 100, usage % 100);
+			snap_cur ^= 1;
+		}
+#endif
+#if PROFIL_EN
+		// Coût du profilage depuis le dernier affichage (hors entrée et sortie d'IRQ), puis profil par tâche
+		{
+			PROFIL_STATS p;
+			INT32U charge;
+			profil_stats(&p, true);
+			if (p.echantillons > 0 && p.ticks > 0) {
+				charge = (INT64U) p.cycles * 10000 /
+						((INT64U) p.ticks * (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / OS_TICKS_PER_SEC));
+				xil_printf("Profilage : %d echantillons/s, %d retardes, %d hors .text\n",
+						(int)((INT64U) p.echantillons * OS_TICKS_PER_SEC / p.ticks), p.retardes, p.hors_texte);
+				xil_printf("  %d cycles par echantillon (max %d), charge %d.%02d %%\n",
+						p.cycles / p.echantillons, p.cycles_max, charge / 100, charge % 100);
+			}
+			profil_afficher();
+		}
+#endif
+#if PMU_EN
+		// Événements matériels par étage du routeur, ISR et région mesurée (PMU_REGION())
+		pmu_afficher();
+#endif
+#if OS_CPU_INT_DIS_PROF_EN > 0
+		// Sections critiques les plus longues (fichier:ligne du OS_ENTER_CRITICAL)
+		{
+			OS_CPU_INT_DIS_SITE *sites[5];
+			INT8U nb_sites = OS_CPU_IntDisProfTop(sites, ARRAY_SIZE(sites));
+			for (INT8U i = 0; i < nb_sites; i++) {
+				xil_printf("  %s:%d max %d cycles, moy %d cycles, %d appels\n",
+						sites[i]->File, sites[i]->Line, sites[i]->CycMax,
+						(INT32U)(sites[i]->CycTot / sites[i]->Ctr), sites[i]->Ctr);
+			}
+			xil_printf("  Echantillons perdus : %d\n", OS_CPU_IntDisProfLostCtr);
+		}
+#endif
+#if OS_TASK_STAT_STK_CHK_EN > 0u
+		// Utilisation maximale des piles et taille conseillée (utilisation + 25 %, multiple de 64 mots)
+		{
+			OS_STK_DATA stk_data;
+			INT32U used, size;
+			for (INT8U prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+				err = OSTaskStkHwm(prio, &stk_data);
+				if (err == OS_ERR_NONE || err == OS_ERR_TASK_STK_OVF) {
+					used = stk_data.OSUsed / sizeof(OS_STK);
+					size = (used + used / 4 + OS_TASK_STK_GUARD_SIZE + 63) & ~63uL;
+					xil_printf("  Pile tache %d : %d / %d mots, taille conseillee : %d%s\n", prio, used,
+							(stk_data.OSUsed + stk_data.OSFree) / sizeof(OS_STK), size,
+							err == OS_ERR_TASK_STK_OVF ? " (DEBORDEMENT)" : "");
+				}
+			}
+		}
+#endif
+#if OS_Q_POLICY_EN > 0u
+		// Débit du routeur depuis le dernier affichage et pertes de chaque file selon sa politique
+		{
+			static INT32U traites_prec = 0;
+			static INT32U temps_prec = 0;
+#if ROUTEUR_PQ_EN
+			static const char *noms[] = { "input" };
+			OS_EVENT *files[] = { inputQ };
+#else
+			static const char *noms[] = { "input", "high", "medium", "low" };
+			OS_EVENT *files[] = { inputQ, highQ, mediumQ, lowQ };
+#endif
+			OS_Q_DATA q_data;
+			INT32U temps = OSTimeGet();
+			if (temps != temps_prec)
+				xil_printf("  Debit : %d paquets/s\n",
+						(nbPacketTraites - traites_prec) * OS_TICKS_PER_SEC / (temps - temps_prec));
+			traites_prec = nbPacketTraites;
+			temps_prec = temps;
+			for (int i = 0; i < ARRAY_SIZE(files); i++) {
+				if (OSQQuery(files[i], &q_data) == OS_ERR_NONE)
+					xil_printf("  File %s : %d perdus (plus anciens), %d rejetes, %d posts en attente\n",
+							noms[i], q_data.OSQNDropHead, q_data.OSQNDropTail, q_data.OSQNPostWait);
+			}
+		}
+#endif
+#if SLAB_MALLOC_EN
+		// Allocateur à slabs : blocs utilisés, libres et perte due à l'arrondi à la classe
+		{
+			SLAB_STATS slabs;
+			SLAB_STATS_CLASSE *c;
+			slab_stats(&slabs);
+			for (int i = 0; i < SLAB_NB_CLASSES; i++) {
+				c = &slabs.classes[i];
+				if (c->nb_allocs > 0) {
+					xil_printf("  Classe %d o : %d utilises (max %d), %d libres, %d slabs, perte %d %%\n",
+							c->taille, c->nb_utilises, c->nb_utilises_max, c->nb_libres, c->nb_slabs,
+							(INT32U) (100 - c->octets_demandes * 100 / ((INT64U) c->nb_allocs * c->taille)));
+				}
+			}
+			xil_printf("  Arene des slabs : %d / %d octets, tas newlib : %d octets (%d gros blocs, %d hors arene)\n",
+					slabs.arena_utilisee, SLAB_ARENA_SIZE, slabs.tas_newlib, slabs.nb_gros, slabs.nb_secours);
+		}
+#endif
+#if UART_TX_EN
+		// Console : débit réel de l'UART et octets perdus ou attentes quand le tampon est plein
+		{
+			UART_STATS uart;
+			uart_stats(&uart, true);
+			if (uart.ticks > 0)
+				xil_printf("  UART : %d octets/s, occupation max %d / %d, %d perdus, %d attentes, %d interruptions\n",
+						(INT32U) ((INT64U) (uart.octets + uart.dma_octets) * OS_TICKS_PER_SEC / uart.ticks),
+						uart.occupation_max, UART_TX_TAILLE, uart.rejets, uart.attentes, uart.interruptions);
+#if UART_DMA_EN
+			if (uart.dma_transferts > 0)
+				xil_printf("  UART DMA : %d octets en %d transferts, %d erreurs, %d cycles dans les ISR\n",
+						uart.dma_octets, uart.dma_transferts, uart.dma_erreurs, uart.cycles);
+#endif
+		}
+#endif
 
 		/* À compléter */
 	}
@@ -530,7 +793,7 @@ void TaskStats(void *pdata) {
 /*
  *********************************************************************************************************
  *											  TaskPrint
- *  -Affiche les infos des paquets arrivés Ã  destination et libere la mémoire allouée
+ *  -Envoie les paquets arrivés à destination sur l'interface ouverte (pio_tx_burst())
  *********************************************************************************************************
  */
 void TaskPrint(void *data) {
@@ -544,17 +807,15 @@ void TaskPrint(void *data) {
 		err_msg("OSMboxPend TaskPrint", err);
 
 		if (packet != NULL) {
+			// Envoi sur l'interface, qui libère le paquet (affichage pour le générateur)
 			OSMutexPend(mutexPrinting, 0, &err);
 			err_msg("mutexPrinting", err);
-			xil_printf("INT %d - SRC %08x - DST %08x - TYPE %d - CRC  %d - DATA %x\n", intID, packet->src, packet->dst, packet->type, packet->crc, packet->data);
+			{
+				PMU_REGION(PMU_EMISSION);
+				pio_tx_burst(intID, &packet, 1);
+			}
 			err = OSMutexPost(mutexPrinting);
 			err_msg("mutexPrinting", err);
-
-			OSMutexPend(mutexMemory, 0, &err);
-			err_msg("mutexMemory", err);
-			free(packet);
-			err = OSMutexPost(mutexMemory);
-			err_msg("mutexMemory", err);
 		}
 
 	}
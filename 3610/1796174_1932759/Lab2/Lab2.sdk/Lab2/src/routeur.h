@@ -1,6 +1,7 @@
 #include <ucos_ii.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include "paquet_io.h"
 
 #define ARRAY_SIZE(x) (sizeof(x)/sizeof(x[0]))
 
@@ -16,9 +17,12 @@
 #define		 	TASK_STATS_PRIO	   	  9
 #define          TASK_COMPUTING_PRIO       14
 #define          TASK_FORWARDING_PRIO      16
-#define          TASK_PRINT1_PRIO          11
+#define          TASK_PRINT_PRIO           11  // Niveau round-robin partagé par les 3 TaskPrint
+#define          TASK_PRINT1_PRIO          11  // Priorités occupées par le niveau
 #define          TASK_PRINT2_PRIO          12
 #define          TASK_PRINT3_PRIO          13
+#define          TASK_PRINT_NB             3
+#define          TASK_PRINT_QUANTUM        5   // Quantum en ticks
 
 #define          MUT_PRINT_PRIO            6
 #define          MUT_REJET_PRIO            5
@@ -46,18 +50,6 @@
 #define REJECT_LOW4   0xD0000000
 #define REJECT_HIGH4  0xD7FFFFFF
 
-typedef enum {
-	PACKET_VIDEO, PACKET_AUDIO, PACKET_AUTRE, NB_PACKET_TYPE
-} PACKET_TYPE;
-
-typedef struct {
-	unsigned int src;
-	unsigned int dst;
-	PACKET_TYPE type;
-	unsigned int crc;
-	unsigned int data[12];
-} Packet;
-
 typedef struct {
 	unsigned int interfaceID;
 	OS_EVENT *Mbox;
@@ -79,14 +71,33 @@ OS_EVENT *inputQ;
 OS_EVENT *lowQ;
 OS_EVENT *mediumQ;
 OS_EVENT *highQ;
+OS_EVENT *forwardPQ;
+
+#define ROUTEUR_PQ_EN             1      // 1 : une file à priorités (forwardPQ), une bande par classe, remplace highQ, mediumQ, lowQ et forwardSet
+
+#define ROUTEUR_Q_POLICY          OS_Q_POLICY_DROP_TAIL  // File pleine : rejette le nouveau paquet (DROP_TAIL) ou le plus ancien (DROP_HEAD)
+#define ROUTEUR_Q_POST_BLOQUANT   0      // 1 : les producteurs attendent une place (OSQPostPend()) au lieu d'appliquer la politique
+                                         //     (les bandes de forwardPQ rejettent toujours le nouveau paquet quand elles sont pleines)
+#define ROUTEUR_Q_POST_TIMEOUT    10     // Attente max. d'une place en ticks, après quoi le paquet est rejeté
 
 /* ************************************************
- *                  Semaphores
+ *                  Event sets
  **************************************************/
 
-OS_EVENT* semVerifySrc;
-OS_EVENT* semStats;
-OS_EVENT* semVerifyCRC;
+#define FORWARD_SET_HIGH_PRIO     0   // Ordre de service des files par TaskForwarding (aussi bandes de forwardPQ)
+#define FORWARD_SET_MEDIUM_PRIO   1
+#define FORWARD_SET_LOW_PRIO      2
+
+OS_EVENT *forwardSet;
+
+/* ************************************************
+ *                  Event flags
+ **************************************************/
+
+#define FLAG_VERIFY_SRC           0x01  // Posté chaque seconde par fit_timer_1s_isr
+#define FLAG_VERIFY_CRC           0x02  // Posté toutes les 3 secondes par fit_timer_3s_isr
+
+OS_FLAG_GRP *flagsVerify;
 
 /* ************************************************
  *                  Mutexes
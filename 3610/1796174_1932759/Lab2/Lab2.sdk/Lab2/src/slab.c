@@ -0,0 +1,313 @@
+#include "slab.h"
+#include <stdbool.h>
+#include <string.h>
+#include <malloc.h>
+#include <reent.h>
+
+/*
+ *********************************************************************************************************
+ *                                    Allocateur à slabs
+ * -Les blocs de 16 à 2048 octets viennent de slabs de SLAB_SIZE octets, découpées dans une arène
+ *  réservée une fois pour toutes dans le tas de newlib.  Chaque slab ne sert qu'une classe de taille :
+ *  free() retrouve la classe d'un bloc par son adresse, sans en-tête.
+ * -Chaque tâche garde un magasin de blocs libres par classe.  Seule la tâche elle-même y touche, ce
+ *  qui permet d'allouer et de libérer sans verrou.  Le magasin vide ou plein échange SLAB_MAG_XFER
+ *  blocs avec la réserve commune de la classe, sous OSSchedLock() (chemin lent).
+ * -Ni les slabs ni les magasins ne sont rendus : la mémoire d'une classe est celle de son maximum.
+ *  Une fois l'arène épuisée (ou impossible à réserver), newlib sert les petits blocs ; slab_free() les
+ *  lui rend d'après leur adresse.
+ * -Comme celles de newlib, ces fonctions ne doivent pas être appelées depuis une ISR.
+ *********************************************************************************************************
+ */
+
+#define SLAB_NB_SLABS     (SLAB_ARENA_SIZE / SLAB_SIZE)
+#define SLAB_NB_SLOTS     (OS_MAX_TASKS + OS_N_SYS_TASKS)   // Un magasin par TCB de OSTCBTbl[] ...
+#define SLAB_SLOT_INIT    SLAB_NB_SLOTS                     // ... et un pour les appels avant OSStart()
+#define SLAB_TAILLE_MAX   (1u << (SLAB_MIN_SHIFT + SLAB_NB_CLASSES - 1))
+
+typedef struct slab_bloc {
+	struct slab_bloc *suivant;
+} SLAB_BLOC;
+
+typedef struct {
+	void *blocs[SLAB_MAG_SIZE];
+	INT32U nb;
+	INT32U nb_allocs;
+	INT32U nb_frees;
+	INT64U octets_demandes;
+} SLAB_MAG;
+
+typedef struct {
+	SLAB_BLOC *libres;         // Réserve commune
+	INT32U nb_libres;
+	INT32U nb_slabs;
+	INT32U nb_utilises_max;
+	INT32U nb_lents;
+} SLAB_CLASSE;
+
+static INT8U *slab_arena;                                   // Alignée sur SLAB_SIZE
+static bool slab_arena_echec;
+static INT32U slab_nb_decoupees;                            // Slabs déjà attribuées à une classe
+static INT8U slab_classe_de[SLAB_NB_SLABS];
+static SLAB_CLASSE slab_classes[SLAB_NB_CLASSES];
+static SLAB_MAG slab_mags[SLAB_NB_SLOTS + 1][SLAB_NB_CLASSES];
+static INT32U slab_nb_gros;
+static INT32U slab_nb_secours;                              // Petits blocs servis par newlib
+
+static inline INT8U slab_classe(size_t taille) {
+	if (taille <= (1u << SLAB_MIN_SHIFT))
+		return 0;
+	return (INT8U) (32 - __builtin_clz(taille - 1) - SLAB_MIN_SHIFT);
+}
+
+static inline INT32U slab_taille(INT8U classe) {
+	return 1u << (SLAB_MIN_SHIFT + classe);
+}
+
+static inline bool slab_dans_arena(void *p) {
+	return slab_arena != NULL && (INT8U *) p >= slab_arena && (INT8U *) p < slab_arena + SLAB_ARENA_SIZE;
+}
+
+// Le TCB courant ne change pas tant que la tâche s'exécute : son magasin lui est réservé.
+static inline SLAB_MAG *slab_mag(INT8U classe) {
+	if (OSRunning == OS_FALSE)
+		return &slab_mags[SLAB_SLOT_INIT][classe];
+	return &slab_mags[OSTCBCur - OSTCBTbl][classe];
+}
+
+/*
+ *********************************************************************************************************
+ *                                          slab_decouper
+ * -Attribue la prochaine slab de l'arène à la classe et met ses blocs dans la réserve commune.
+ *  Appelée avec l'ordonnanceur verrouillé.
+ *********************************************************************************************************
+ */
+static void slab_decouper(INT8U classe) {
+	SLAB_CLASSE *c = &slab_classes[classe];
+	INT32U taille = slab_taille(classe);
+	INT8U *bloc;
+
+	if (slab_arena == NULL && !slab_arena_echec) {
+		slab_arena = _memalign_r(_REENT, SLAB_SIZE, SLAB_ARENA_SIZE);
+		slab_arena_echec = (slab_arena == NULL);
+	}
+	if (slab_arena == NULL || slab_nb_decoupees == SLAB_NB_SLABS)
+		return;
+
+	slab_classe_de[slab_nb_decoupees] = classe;
+	bloc = slab_arena + slab_nb_decoupees * SLAB_SIZE;
+	slab_nb_decoupees++;
+	for (INT32U i = 0; i < SLAB_SIZE / taille; ++i, bloc += taille) {
+		((SLAB_BLOC *) bloc)->suivant = c->libres;
+		c->libres = (SLAB_BLOC *) bloc;
+	}
+	c->nb_libres += SLAB_SIZE / taille;
+	c->nb_slabs++;
+}
+
+static INT32U slab_nb_utilises(INT8U classe) {
+	INT32U nb = 0;
+
+	for (int slot = 0; slot <= SLAB_NB_SLOTS; ++slot)
+		nb += slab_mags[slot][classe].nb_allocs - slab_mags[slot][classe].nb_frees;
+	return nb;
+}
+
+/*
+ *********************************************************************************************************
+ *                                       slab_remplir / slab_vider
+ * -Chemin lent : échangent SLAB_MAG_XFER blocs entre le magasin de la tâche et la réserve commune.
+ *********************************************************************************************************
+ */
+static void slab_remplir(SLAB_MAG *mag, INT8U classe) {
+	SLAB_CLASSE *c = &slab_classes[classe];
+	INT32U nb;
+
+	OSSchedLock();
+	c->nb_lents++;
+	nb = slab_nb_utilises(classe);
+	if (nb > c->nb_utilises_max)
+		c->nb_utilises_max = nb;
+	if (c->nb_libres < SLAB_MAG_XFER)
+		slab_decouper(classe);
+	while (mag->nb < SLAB_MAG_XFER && c->libres != NULL) {
+		mag->blocs[mag->nb++] = c->libres;
+		c->libres = c->libres->suivant;
+		c->nb_libres--;
+	}
+	OSSchedUnlock();
+}
+
+static void slab_vider(SLAB_MAG *mag, INT8U classe) {
+	SLAB_CLASSE *c = &slab_classes[classe];
+	SLAB_BLOC *bloc;
+
+	OSSchedLock();
+	c->nb_lents++;
+	for (int i = 0; i < SLAB_MAG_XFER; ++i) {
+		bloc = mag->blocs[--mag->nb];
+		bloc->suivant = c->libres;
+		c->libres = bloc;
+	}
+	c->nb_libres += SLAB_MAG_XFER;
+	OSSchedUnlock();
+}
+
+/*
+ *********************************************************************************************************
+ *                                      slab_malloc / slab_free
+ *********************************************************************************************************
+ */
+void *slab_malloc(size_t taille) {
+	SLAB_MAG *mag;
+	INT8U classe;
+	void *p;
+
+	if (taille > SLAB_TAILLE_MAX) {
+		OSSchedLock();
+		slab_nb_gros++;
+		OSSchedUnlock();
+		return _malloc_r(_REENT, taille);
+	}
+
+	classe = slab_classe(taille);
+	mag = slab_mag(classe);
+	if (mag->nb == 0) {
+		slab_remplir(mag, classe);
+		if (mag->nb == 0) {						// Arène épuisée : newlib prend le relais
+			OSSchedLock();
+			slab_nb_secours++;
+			OSSchedUnlock();
+			return _malloc_r(_REENT, taille);
+		}
+	}
+	p = mag->blocs[--mag->nb];
+	mag->nb_allocs++;
+	mag->octets_demandes += taille;
+	return p;
+}
+
+void slab_free(void *p) {
+	SLAB_MAG *mag;
+	INT8U classe;
+
+	if (p == NULL)
+		return;
+	if (!slab_dans_arena(p)) {
+		_free_r(_REENT, p);
+		return;
+	}
+
+	classe = slab_classe_de[((INT8U *) p - slab_arena) / SLAB_SIZE];
+	mag = slab_mag(classe);
+	if (mag->nb == SLAB_MAG_SIZE)
+		slab_vider(mag, classe);
+	mag->blocs[mag->nb++] = p;
+	mag->nb_frees++;
+}
+
+void *slab_calloc(size_t nb, size_t taille) {
+	void *p;
+
+	if (taille != 0 && nb > (size_t) -1 / taille)
+		return NULL;
+	p = slab_malloc(nb * taille);
+	if (p != NULL)
+		memset(p, 0, nb * taille);
+	return p;
+}
+
+void *slab_realloc(void *p, size_t taille) {
+	void *nouveau;
+	INT32U ancienne;
+
+	if (p == NULL)
+		return slab_malloc(taille);
+	if (taille == 0) {
+		slab_free(p);
+		return NULL;
+	}
+	if (!slab_dans_arena(p))
+		return _realloc_r(_REENT, p, taille);
+
+	ancienne = slab_taille(slab_classe_de[((INT8U *) p - slab_arena) / SLAB_SIZE]);
+	if (taille <= ancienne)
+		return p;
+	nouveau = slab_malloc(taille);
+	if (nouveau != NULL) {
+		memcpy(nouveau, p, ancienne);
+		slab_free(p);
+	}
+	return nouveau;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           slab_stats
+ * -Les compteurs des magasins sont lus sans verrou : une tâche peut allouer pendant le relevé.
+ *********************************************************************************************************
+ */
+void slab_stats(SLAB_STATS *stats) {
+	SLAB_STATS_CLASSE *s;
+	SLAB_MAG *mag;
+
+	OSSchedLock();
+	for (INT8U classe = 0; classe < SLAB_NB_CLASSES; ++classe) {
+		s = &stats->classes[classe];
+		memset(s, 0, sizeof(*s));
+		s->taille = slab_taille(classe);
+		s->nb_slabs = slab_classes[classe].nb_slabs;
+		s->nb_utilises_max = slab_classes[classe].nb_utilises_max;
+		s->nb_libres = slab_classes[classe].nb_libres;
+		s->nb_lents = slab_classes[classe].nb_lents;
+		for (int slot = 0; slot <= SLAB_NB_SLOTS; ++slot) {
+			mag = &slab_mags[slot][classe];
+			s->nb_libres += mag->nb;
+			s->nb_allocs += mag->nb_allocs;
+			s->nb_utilises += mag->nb_allocs - mag->nb_frees;
+			s->octets_demandes += mag->octets_demandes;
+		}
+		if (s->nb_utilises > s->nb_utilises_max)
+			s->nb_utilises_max = s->nb_utilises;
+	}
+	stats->arena_utilisee = slab_nb_decoupees * SLAB_SIZE;
+	stats->nb_gros = slab_nb_gros;
+	stats->nb_secours = slab_nb_secours;
+	stats->tas_newlib = _mallinfo_r(_REENT).uordblks;
+	OSSchedUnlock();
+}
+
+/*
+ *********************************************************************************************************
+ *                                      Raccordement à newlib
+ * -__malloc_lock() et __malloc_unlock() protègent le tas de newlib, que newlib appelle lui-même
+ *  (printf(), strdup(), ...) ou que les slabs lui demandent.  OSSchedLock() s'imbrique et ne fait
+ *  rien avant OSStart() ni dans une ISR.
+ * -Avec SLAB_MALLOC_EN, malloc() et compagnie remplacent ceux de newlib à l'édition de liens.
+ *********************************************************************************************************
+ */
+void __malloc_lock(struct _reent *r) {
+	OSSchedLock();
+}
+
+void __malloc_unlock(struct _reent *r) {
+	OSSchedUnlock();
+}
+
+#if SLAB_MALLOC_EN
+void *malloc(size_t taille) {
+	return slab_malloc(taille);
+}
+
+void free(void *p) {
+	slab_free(p);
+}
+
+void *calloc(size_t nb, size_t taille) {
+	return slab_calloc(nb, taille);
+}
+
+void *realloc(void *p, size_t taille) {
+	return slab_realloc(p, taille);
+}
+#endif
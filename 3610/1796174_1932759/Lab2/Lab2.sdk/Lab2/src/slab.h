@@ -0,0 +1,54 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <ucos_ii.h>
+#include <stddef.h>
+
+/* ************************************************
+ *              CONFIGURATION DE L'ALLOCATEUR
+ **************************************************/
+
+#define SLAB_MALLOC_EN           1         // 1 : malloc(), free(), calloc() et realloc() passent par les slabs
+
+#define SLAB_ARENA_SIZE          0x100000  // Part du tas réservée aux slabs (_HEAP_SIZE = 2 Mo, voir lscript.ld)
+#define SLAB_SIZE                4096      // Taille d'une slab, puissance de 2
+#define SLAB_MIN_SHIFT           4         // Plus petite classe : 16 octets
+#define SLAB_NB_CLASSES          8         // Classes de 16 à 2048 octets, au-delà : tas de newlib
+
+#define SLAB_MAG_SIZE            16        // Nb max. de blocs gardés par tâche et par classe
+#define SLAB_MAG_XFER            8         // Nb de blocs échangés avec la réserve commune
+
+/* ************************************************
+ *              STATISTIQUES
+ **************************************************/
+
+typedef struct {
+	INT32U taille;             // Taille des blocs de la classe
+	INT32U nb_slabs;           // Slabs découpées pour la classe (jamais rendues)
+	INT32U nb_utilises;        // Blocs alloués et pas encore libérés
+	INT32U nb_utilises_max;    // Maximum de nb_utilises relevé par le chemin lent
+	INT32U nb_libres;          // Blocs libres : réserve commune et magasins des tâches
+	INT32U nb_allocs;          // Allocations depuis le démarrage
+	INT32U nb_lents;           // Passages par le chemin lent (réserve commune verrouillée)
+	INT64U octets_demandes;    // Somme des tailles demandées, pour la fragmentation interne
+} SLAB_STATS_CLASSE;
+
+typedef struct {
+	SLAB_STATS_CLASSE classes[SLAB_NB_CLASSES];
+	INT32U arena_utilisee;     // Octets de l'arène découpés en slabs
+	INT32U nb_gros;            // Allocations trop grandes pour les slabs, servies par newlib
+	INT32U nb_secours;         // Petites allocations servies par newlib, arène épuisée
+	INT32U tas_newlib;         // Octets alloués par newlib (arène des slabs comprise)
+} SLAB_STATS;
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+void *slab_malloc(size_t taille);
+void slab_free(void *p);
+void *slab_calloc(size_t nb, size_t taille);
+void *slab_realloc(void *p, size_t taille);
+void slab_stats(SLAB_STATS *stats);
+
+#endif
@@ -0,0 +1,436 @@
+#include "uart.h"
+#include "bsp_init.h"
+#include <string.h>
+#include <xil_printf.h>
+#include <xuartps.h>
+
+/*
+ *********************************************************************************************************
+ *                                   Console UART par interruptions
+ * -outbyte() remplace celui du BSP : xil_printf() copie ses octets dans un tampon circulaire de
+ *  UART_TX_TAILLE octets au lieu d'attendre la FIFO de l'UART (86 us par octet à 115200 bauds).
+ * -L'interruption « FIFO vide » de l'UART remplit sa FIFO (64 octets) depuis le tampon, et n'est activée
+ *  que tant que le tampon n'est pas vide.
+ * -Tampon plein : selon UART_TX_POLITIQUE, la tâche attend que l'interruption libère de la place ou
+ *  les octets sont perdus.  Dans une ISR ou l'ordonnanceur verrouillé, ils sont toujours perdus ; avant
+ *  OSStart(), l'appelant vide lui-même le tampon dans la FIFO.
+ * -Avant uart_demarrer() et après uart_arreter(), outbyte() attend la FIFO comme celui du BSP.
+ * -uart_dma_ecrire() envoie un bloc sans le copier : l'UART du PS n'a pas de signal de requête vers le
+ *  PL330, le DMA ne peut donc pas suivre la FIFO de lui-même.  Chaque interruption « FIFO vide » lance
+ *  un transfert de UART_DMA_BLOC octets au plus (XDmaPs_Start()) au lieu que le CPU écrive la FIFO
+ *  octet par octet.  Les requêtes sont servies dans l'ordre, avec le tampon : les octets écrits
+ *  avant la requête partent avant elle.
+ *********************************************************************************************************
+ */
+
+#define UART_TX_BLOC             256   // Octets copiés par section critique
+
+#if UART_TX_EN
+static XUartPs uart;
+static INT8U tx_buf[UART_TX_TAILLE];
+static volatile INT32U tx_in;			// tx_in - tx_out octets en attente (indices modulo 2^32)
+static volatile INT32U tx_out;
+static volatile bool tx_actif;			// Interruption « FIFO vide » activée
+static volatile INT32U tx_attente;		// Nb de tâches en attente de place
+static bool demarre;
+static OS_EVENT *tx_sem;
+static UART_STATS stats;
+#if UART_DMA_EN
+static XDmaPs_Cmd dma_cmd;
+static UART_DMA *volatile dma_tete;		// Requêtes en attente, dans l'ordre
+static UART_DMA *dma_queue;
+static volatile bool dma_actif;			// Transfert en cours sur UART_DMA_CANAL
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                          uart_remplir
+ * -Copie le tampon dans la FIFO de l'UART jusqu'à ce qu'elle soit pleine, sans dépasser la prochaine
+ *  requête DMA.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static void uart_remplir(void) {
+	INT32U base = uart.Config.BaseAddress;
+	INT32U limite = tx_in;
+
+#if UART_DMA_EN
+	if (dma_tete != NULL)
+		limite = dma_tete->position;
+#endif
+	while (tx_out != limite && !XUartPs_IsTransmitFull(base)) {
+		XUartPs_WriteReg(base, XUARTPS_FIFO_OFFSET, tx_buf[tx_out & (UART_TX_TAILLE - 1)]);
+		tx_out++;
+		stats.octets++;
+	}
+}
+
+#if UART_DMA_EN
+/*
+ *********************************************************************************************************
+ *                                         uart_dma_avancer
+ * -'n' octets de la première requête sont dans la FIFO.  Une requête terminée est retirée de la liste
+ *  et 'fin' appelée.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static void uart_dma_avancer(INT32U n) {
+	UART_DMA *req = dma_tete;
+
+	req->envoyes += n;
+	if (req->envoyes < req->taille)
+		return;
+	dma_tete = req->suivant;
+	if (dma_tete == NULL)
+		dma_queue = NULL;
+	if (req->fin != NULL)
+		req->fin(req, req->arg);
+}
+
+/*
+ *********************************************************************************************************
+ *                                          uart_dma_lancer
+ * -FIFO vide : transfère le bloc suivant de la première requête.  Si XDmaPs_Start() refuse, le CPU
+ *  écrit le bloc lui-même.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static void uart_dma_lancer(void) {
+	UART_DMA *req = dma_tete;
+	INT32U n = req->taille - req->envoyes;
+
+	if (n > UART_DMA_BLOC)
+		n = UART_DMA_BLOC;
+	memset(&dma_cmd, 0, sizeof(dma_cmd));
+	dma_cmd.ChanCtrl.SrcBurstSize = 1;		// Un octet par écriture dans la FIFO, à adresse fixe
+	dma_cmd.ChanCtrl.SrcBurstLen = 1;
+	dma_cmd.ChanCtrl.SrcInc = 1;
+	dma_cmd.ChanCtrl.DstBurstSize = 1;
+	dma_cmd.ChanCtrl.DstBurstLen = 1;
+	dma_cmd.ChanCtrl.DstInc = 0;
+	dma_cmd.BD.SrcAddr = (u32) (req->buf + req->envoyes);
+	dma_cmd.BD.DstAddr = uart.Config.BaseAddress + XUARTPS_FIFO_OFFSET;
+	dma_cmd.BD.Length = n;
+	if (XDmaPs_Start(&dmac, UART_DMA_CANAL, &dma_cmd, 0) == XST_SUCCESS) {
+		dma_actif = true;
+		return;
+	}
+	stats.dma_erreurs++;
+	for (INT32U i = 0; i < n; ++i)
+		XUartPs_WriteReg(uart.Config.BaseAddress, XUARTPS_FIFO_OFFSET, req->buf[req->envoyes + i]);
+	stats.octets += n;
+	uart_dma_avancer(n);
+}
+
+/*
+ *********************************************************************************************************
+ *                                           uart_dma_fin
+ * -Fin d'un transfert (XDmaPs_DoneISR_0(), ou faute relayée par bsp_init.c) : les octets sont dans la
+ *  FIFO, l'interruption « FIFO vide » lancera le bloc suivant.
+ *********************************************************************************************************
+ */
+static void uart_dma_fin(unsigned int canal, XDmaPs_Cmd *cmd, void *ref) {
+	dma_actif = false;
+	if (cmd->DmaStatus != 0)
+		stats.dma_erreurs++;
+	else {
+		stats.dma_octets += cmd->BD.Length;
+		stats.dma_transferts++;
+	}
+	uart_dma_avancer(cmd->BD.Length);
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                           uart_servir
+ * -Envoie ce qui doit partir ensuite : le tampon jusqu'à la prochaine requête DMA, puis un bloc de
+ *  celle-ci si la FIFO est vide.  Retourne vrai s'il reste quelque chose à envoyer (l'interruption
+ *  « FIFO vide » doit rester active).  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static bool uart_servir(void) {
+#if UART_DMA_EN
+	if (dma_actif)
+		return true;
+	uart_remplir();
+	if (dma_tete != NULL && tx_out == dma_tete->position &&
+			(XUartPs_ReadReg(uart.Config.BaseAddress, XUARTPS_SR_OFFSET) & XUARTPS_SR_TXEMPTY))
+		uart_dma_lancer();
+	return tx_out != tx_in || dma_tete != NULL;
+#else
+	uart_remplir();
+	return tx_out != tx_in;
+#endif
+}
+
+/*
+ *********************************************************************************************************
+ *                                          uart_relancer
+ * -Démarre l'émission si l'interruption n'est pas déjà active : la FIFO est remplie, puis l'interruption
+ *  prend le relais.  Interruptions masquées.
+ *********************************************************************************************************
+ */
+static void uart_relancer(void) {
+	INT32U base = uart.Config.BaseAddress;
+
+	if (tx_actif)
+		return;
+	XUartPs_WriteReg(base, XUARTPS_ISR_OFFSET, XUARTPS_IXR_TXEMPTY);	// Oublie une FIFO vide passée
+	if (uart_servir()) {
+		tx_actif = true;
+		XUartPs_WriteReg(base, XUARTPS_IER_OFFSET, XUARTPS_IXR_TXEMPTY);
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                             uart_isr
+ * -FIFO vide : la remplit (ou lance le DMA), désactive l'interruption quand il ne reste rien à envoyer
+ *  et réveille une tâche en attente de place.
+ *********************************************************************************************************
+ */
+void uart_isr(void *not_valid) {
+	INT32U base = uart.Config.BaseAddress;
+	INT32U ts = OS_TS_GET();
+	INT32U isr;
+
+	isr = XUartPs_ReadReg(base, XUARTPS_ISR_OFFSET) & XUartPs_ReadReg(base, XUARTPS_IMR_OFFSET);
+	XUartPs_WriteReg(base, XUARTPS_ISR_OFFSET, isr);
+	if (isr & XUARTPS_IXR_TXEMPTY) {
+		stats.interruptions++;
+		if (!uart_servir()) {
+			XUartPs_WriteReg(base, XUARTPS_IDR_OFFSET, XUARTPS_IXR_TXEMPTY);
+			tx_actif = false;
+		}
+		if (tx_attente > 0)
+			OSSemPost(tx_sem);
+	}
+	stats.cycles += OS_TS_GET() - ts;
+}
+
+#if UART_DMA_EN
+/*
+ *********************************************************************************************************
+ *                                           uart_dma_isr
+ * -Interruption de fin du canal UART_DMA_CANAL du PL330 ('data' : &dmac).  Le pilote libère le programme
+ *  DMA puis appelle uart_dma_fin().
+ *********************************************************************************************************
+ */
+void uart_dma_isr(void *data) {
+	INT32U ts = OS_TS_GET();
+
+	XDmaPs_DoneISR_0((XDmaPs *) data);
+	stats.cycles += OS_TS_GET() - ts;
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                             uart_init
+ * -Appelée par initialize_bsp() : l'UART reste en attente active jusqu'à uart_demarrer().
+ *********************************************************************************************************
+ */
+int uart_init(void) {
+	XUartPs_Config *config;
+	int status;
+
+	config = XUartPs_LookupConfig(UART_TX_DEVICE_ID);
+	if (config == NULL)
+		return XST_FAILURE;
+	status = XUartPs_CfgInitialize(&uart, config, config->BaseAddress);
+	if (status != XST_SUCCESS)
+		return status;
+	XUartPs_SetInterruptMask(&uart, 0);
+	return XST_SUCCESS;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           uart_demarrer
+ * -Appelée par connect_uart_irq() une fois uart_isr() connectée : outbyte() passe par le tampon.
+ *********************************************************************************************************
+ */
+void uart_demarrer(void) {
+	uint8_t err;
+
+	if (tx_sem == NULL) {
+		tx_sem = OSSemCreate(0);
+		OSEventNameSet(tx_sem, (INT8U *) "uart_tx", &err);
+	}
+#if UART_DMA_EN
+	XDmaPs_SetDoneHandler(&dmac, UART_DMA_CANAL, uart_dma_fin, NULL);
+#endif
+	stats.ticks = OSTimeGet();
+	demarre = true;
+}
+
+/*
+ *********************************************************************************************************
+ *                                           uart_arreter
+ * -Vide le tampon en attente active et revient à l'outbyte() du BSP (avant de déconnecter uart_isr()).
+ *  Les requêtes DMA en attente sont d'abord terminées par les interruptions.
+ *********************************************************************************************************
+ */
+void uart_arreter(void) {
+	OS_CPU_SR cpu_sr = 0;
+
+#if UART_DMA_EN
+	while (dma_tete != NULL)
+		;
+#endif
+	OS_ENTER_CRITICAL();
+	XUartPs_WriteReg(uart.Config.BaseAddress, XUARTPS_IDR_OFFSET, XUARTPS_IXR_TXEMPTY);
+	tx_actif = false;
+	while (tx_out != tx_in)
+		uart_remplir();
+	demarre = false;
+	OS_EXIT_CRITICAL();
+}
+
+/*
+ *********************************************************************************************************
+ *                                           uart_attendre
+ * -Tampon plein.  Retourne faux si les octets doivent être perdus, vrai pour réessayer.
+ *  Appelée interruptions masquées, les rétablit avant de retourner.
+ *********************************************************************************************************
+ */
+static bool uart_attendre(OS_CPU_SR cpu_sr) {
+	uint8_t err;
+
+	if (UART_TX_POLITIQUE == UART_TX_REJETER || OSIntNesting > 0 || (OSRunning && OSLockNesting > 0)) {
+		OS_EXIT_CRITICAL();
+		return false;
+	}
+	if (!OSRunning) {									// Personne d'autre ne videra le tampon
+		uart_remplir();
+		OS_EXIT_CRITICAL();
+		return true;
+	}
+	tx_attente++;
+	stats.attentes++;
+	OS_EXIT_CRITICAL();
+	OSSemPend(tx_sem, 0, &err);
+	OS_ENTER_CRITICAL();
+	tx_attente--;
+	OS_EXIT_CRITICAL();
+	return true;
+}
+#endif
+
+/*
+ *********************************************************************************************************
+ *                                            uart_ecrire
+ * -Copie 'taille' octets dans le tampon d'émission (par blocs de UART_TX_BLOC octets, interruptions
+ *  masquées) et démarre l'émission.
+ *********************************************************************************************************
+ */
+void uart_ecrire(const void *buf, INT32U taille) {
+	const INT8U *p = buf;
+#if UART_TX_EN
+	INT32U debut, n, premier;
+	OS_CPU_SR cpu_sr = 0;
+
+	while (taille > 0 && demarre) {
+		OS_ENTER_CRITICAL();
+		n = UART_TX_TAILLE - (tx_in - tx_out);		// Place libre
+		if (n == 0) {
+			if (!uart_attendre(cpu_sr)) {
+				OS_ENTER_CRITICAL();
+				stats.rejets += taille;
+				OS_EXIT_CRITICAL();
+				return;
+			}
+			continue;
+		}
+		if (n > taille)
+			n = taille;
+		if (n > UART_TX_BLOC)
+			n = UART_TX_BLOC;
+		debut = tx_in & (UART_TX_TAILLE - 1);
+		premier = (n < UART_TX_TAILLE - debut) ? n : UART_TX_TAILLE - debut;
+		memcpy(&tx_buf[debut], p, premier);
+		memcpy(&tx_buf[0], p + premier, n - premier);
+		tx_in += n;
+		if (tx_in - tx_out > stats.occupation_max)
+			stats.occupation_max = tx_in - tx_out;
+		uart_relancer();
+		OS_EXIT_CRITICAL();
+		p += n;
+		taille -= n;
+	}
+#endif
+	while (taille > 0) {								// Pas (encore) d'interruption
+		XUartPs_SendByte(STDOUT_BASEADDRESS, *p++);
+		taille--;
+	}
+}
+
+/*
+ *********************************************************************************************************
+ *                                          uart_dma_ecrire
+ * -Envoie 'taille' octets de 'buf' sans les copier : 'req' et 'buf' doivent rester valides jusqu'à
+ *  l'appel de 'fin(req, arg)', depuis l'ISR du DMA (OSSemPost() pour réveiller la tâche qui attend).
+ * -Sans DMA ou avant uart_demarrer(), copie par uart_ecrire() et appelle 'fin' avant de retourner.
+ *********************************************************************************************************
+ */
+void uart_dma_ecrire(UART_DMA *req, const void *buf, INT32U taille, UART_DMA_FIN fin, void *arg) {
+#if UART_DMA_EN
+	OS_CPU_SR cpu_sr = 0;
+#endif
+
+	req->buf = buf;
+	req->taille = taille;
+	req->fin = fin;
+	req->arg = arg;
+	req->envoyes = 0;
+	req->suivant = NULL;
+#if UART_DMA_EN
+	OS_ENTER_CRITICAL();
+	if (demarre && taille > 0) {
+		req->position = tx_in;
+		if (dma_queue != NULL)
+			dma_queue->suivant = req;
+		else
+			dma_tete = req;
+		dma_queue = req;
+		uart_relancer();
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	OS_EXIT_CRITICAL();
+#endif
+	uart_ecrire(buf, taille);
+	if (fin != NULL)
+		fin(req, arg);
+}
+
+#if UART_TX_EN
+/*
+ *********************************************************************************************************
+ *                                              outbyte
+ * -Remplace celui du BSP (libxil.a) pour xil_printf().
+ *********************************************************************************************************
+ */
+void outbyte(char8 c) {
+	uart_ecrire(&c, 1);
+}
+
+/*
+ *********************************************************************************************************
+ *                                            uart_stats
+ * -Copie les compteurs depuis la dernière remise à zéro, puis les remet à zéro si 'reset'.
+ *********************************************************************************************************
+ */
+void uart_stats(UART_STATS *s, bool reset) {
+	INT32U maintenant = OSTimeGet();
+	OS_CPU_SR cpu_sr = 0;
+
+	OS_ENTER_CRITICAL();
+	*s = stats;
+	s->ticks = maintenant - stats.ticks;
+	if (reset) {
+		memset(&stats, 0, sizeof(stats));
+		stats.occupation_max = tx_in - tx_out;
+		stats.ticks = maintenant;
+	}
+	OS_EXIT_CRITICAL();
+}
+#endif
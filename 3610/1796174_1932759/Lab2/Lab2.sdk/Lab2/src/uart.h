@@ -0,0 +1,79 @@
+#ifndef UART_H
+#define UART_H
+
+#include <ucos_ii.h>
+#include <stdbool.h>
+#include <xparameters.h>
+
+/* ************************************************
+ *              CONFIGURATION DE LA CONSOLE UART
+ **************************************************/
+
+#define UART_TX_EN               1     // 1 : outbyte() écrit dans un tampon vidé par interruptions, 0 : attente active du BSP
+
+#define UART_TX_DEVICE_ID        XPAR_XUARTPS_0_DEVICE_ID
+#define UART_TX_IRQ_ID           XPAR_XUARTPS_1_INTR    // PS7_UART_1 (STDOUT_BASEADDRESS)
+
+#define UART_TX_TAILLE           16384 // Tampon d'émission en octets (puissance de 2)
+
+#define UART_TX_BLOQUER          0     // Tampon plein : la tâche attend de la place
+#define UART_TX_REJETER          1     // Tampon plein : les octets sont perdus (comptés)
+#define UART_TX_POLITIQUE        UART_TX_BLOQUER
+
+#define UART_DMA_EN              1     // 1 : uart_dma_ecrire() envoie sans copie par le DMA (PL330), 0 : copie dans le tampon
+#define UART_DMA_CANAL           0     // Canal du PL330, doit correspondre à UART_DMA_IRQ_ID et à uart_dma_isr()
+#define UART_DMA_IRQ_ID          XPAR_XDMAPS_0_DONE_INTR_0
+#define UART_DMA_BLOC            64    // Octets par transfert : la FIFO d'émission de l'UART, vide
+
+#if UART_DMA_EN && !UART_TX_EN
+#error "uart.h : UART_DMA_EN demande UART_TX_EN"
+#endif
+
+/* ************************************************
+ *              STATISTIQUES
+ **************************************************/
+
+typedef struct {
+	INT32U octets;           // Octets écrits dans la FIFO de l'UART
+	INT32U rejets;           // Octets perdus, tampon plein (UART_TX_REJETER, ISR ou ordonnanceur verrouillé)
+	INT32U attentes;         // Nombre de fois qu'une tâche a attendu de la place (UART_TX_BLOQUER)
+	INT32U interruptions;    // Interruptions « FIFO vide »
+	INT32U occupation_max;   // Occupation maximum du tampon en octets
+	INT32U dma_octets;       // Octets écrits dans la FIFO par le DMA
+	INT32U dma_transferts;   // Transferts DMA (UART_DMA_BLOC octets au plus)
+	INT32U dma_erreurs;      // Transferts en faute ou refusés par XDmaPs_Start() (envoyés par le CPU)
+	INT32U cycles;           // Cycles CPU passés dans uart_isr() et uart_dma_isr() (OS_TS_GET())
+	INT32U ticks;            // Durée de la mesure (depuis le dernier uart_stats(..., true))
+} UART_STATS;
+
+/* ************************************************
+ *              ENVOI PAR DMA
+ **************************************************/
+
+typedef struct uart_dma UART_DMA;
+typedef void (*UART_DMA_FIN)(UART_DMA *req, void *arg);
+
+struct uart_dma {
+	const INT8U *buf;        // Ne doit pas changer avant l'appel de 'fin'
+	INT32U taille;
+	UART_DMA_FIN fin;        // Appelée à la fin de l'envoi, dans une ISR (ou par uart_dma_ecrire() sans DMA)
+	void *arg;
+	INT32U envoyes;          // Octets déjà écrits dans la FIFO
+	INT32U position;         // Octets du tampon d'émission à envoyer avant (tx_in à la soumission)
+	UART_DMA *suivant;
+};
+
+/* ************************************************
+ *              PROTOTYPES
+ **************************************************/
+
+int uart_init(void);
+void uart_demarrer(void);
+void uart_arreter(void);
+void uart_isr(void *not_valid);
+void uart_dma_isr(void *data);
+void uart_ecrire(const void *buf, INT32U taille);
+void uart_dma_ecrire(UART_DMA *req, const void *buf, INT32U taille, UART_DMA_FIN fin, void *arg);
+void uart_stats(UART_STATS *stats, bool reset);
+
+#endif
@@ -35,17 +35,32 @@
 
 #define OS_EVENT_MULTI_EN         1u   /* Include code for OSEventPendMulti()                          */
 #define OS_EVENT_NAME_EN          1u   /* Enable names for Sem, Mutex, Mbox and Q                      */
+#define OS_EVENT_SET_EN           1u   /* Include code for persistent event sets (OSEventSetPend())    */
+#define OS_EVENT_SET_ACCEPT_EN    1u   /*     Include code for OSEventSetAccept()                      */
+#define OS_EVENT_SET_DEL_EN       1u   /*     Include code for OSEventSetDel()                         */
+#define OS_EVENT_SET_SIZE        64u   /*     Max. number of members of an event set (MUST be <= 64)   */
+
+#define OS_INIT_STATIC_EN         1u   /* Free lists of OS_TCBs, OS_EVENTs, ... initialized in .data   */
+                                       /* ... (OS_INIT_TBL.C, run tools/os_init_gen.py after changing  */
+                                       /* ... OS_MAX_TASKS/EVENTS/FLAGS/QS/PQS or OS_TASK_STAT_EN)     */
 
 #define OS_LOWEST_PRIO           63u   /* Defines the lowest priority that can be assigned ...         */
                                        /* ... MUST NEVER be higher than 254!                           */
 
 #define OS_MAX_EVENTS            50u   /* Max. number of event control blocks in your application      */
+                                       /* ... 100u for the benchmarks (BENCH_EN, bench.h)              */
+#define OS_MAX_EVENT_SETS         2u   /* Max. number of event sets           in your application      */
 #define OS_MAX_FLAGS              5u   /* Max. number of Event Flag Groups    in your application      */
 #define OS_MAX_MEM_PART           5u   /* Max. number of memory partitions                             */
+#define OS_MAX_PQS                2u   /* Max. number of priority queues      in your application      */
 #define OS_MAX_QS                 10u   /* Max. number of queue control blocks in your application      */
 #define OS_MAX_TASKS             20u   /* Max. number of tasks in your application, MUST be >= 2       */
 
 #define OS_SCHED_LOCK_EN          1u   /* Include code for OSSchedLock() and OSSchedUnlock()           */
+#define OS_SCHED_RR_EN            1u   /* Allow several tasks per priority level (round-robin)         */
+#define OS_SCHED_RR_MAX_LEVELS    2u   /*     Max. number of round-robin levels                        */
+#define OS_SCHED_RR_MAX_TASKS     4u   /*     Max. number of tasks in a round-robin level              */
+#define OS_SCHED_RR_QUANTUM      10u   /*     Default time quantum (in ticks)                          */
 
 #define OS_TICK_STEP_EN           1u   /* Enable tick stepping feature for uC/OS-View                  */
 #define OS_TICKS_PER_SEC       1000u   /* Set the number of ticks in one second                        */
@@ -55,6 +70,7 @@
 #define OS_TASK_TMR_STK_SIZE    128u   /* Timer      task stack size (# of OS_STK wide entries)        */
 #define OS_TASK_STAT_STK_SIZE   128u   /* Statistics task stack size (# of OS_STK wide entries)        */
 #define OS_TASK_IDLE_STK_SIZE   128u   /* Idle       task stack size (# of OS_STK wide entries)        */
+#define OS_TASK_INT_Q_STK_SIZE  256u   /* ISR queue  task stack size (# of OS_STK wide entries)        */
 
 
                                        /* --------------------- TASK MANAGEMENT ---------------------- */
@@ -68,6 +84,10 @@
 #define OS_TASK_REG_TBL_SIZE      1u   /*     Size of task variables array (#of INT32U entries)        */
 #define OS_TASK_STAT_EN           1u   /*     Enable (1) or Disable(0) the statistics task             */
 #define OS_TASK_STAT_STK_CHK_EN   1u   /*     Check task stacks from statistic task                    */
+#define OS_TASK_STK_CHK_SLICE   256u   /*         Max. # of stack entries checked per task every 100 ms */
+#define OS_TASK_STK_CLR_LAZY_EN   1u   /*         Stacks cleared (OS_TASK_OPT_STK_CLR) by the idle task */
+#define OS_TASK_STK_CLR_SLICE   256u   /*         Max. # of stack entries cleared per idle task loop    */
+#define OS_TASK_STK_GUARD_SIZE    4u   /*         # of guard entries at the end of each stack (0 = none) */
 #define OS_TASK_SUSPEND_EN        1u   /*     Include code for OSTaskSuspend() and OSTaskResume()      */
 #define OS_TASK_SW_HOOK_EN        1u   /*     Include code for OSTaskSwHook()                          */
 
@@ -79,7 +99,8 @@
 #define OS_FLAG_NAME_EN           1u   /*     Enable names for event flag group                        */
 #define OS_FLAG_QUERY_EN          1u   /*     Include code for OSFlagQuery()                           */
 #define OS_FLAG_WAIT_CLR_EN       1u   /* Include code for Wait on Clear EVENT FLAGS                   */
-#define OS_FLAGS_NBITS           16u   /* Size in #bits of OS_FLAGS data type (8, 16 or 32)            */
+#define OS_FLAG_WAIT_IX_EN        1u   /* Index waiting tasks by the bit(s) they wait for              */
+#define OS_FLAGS_NBITS           32u   /* Size in #bits of OS_FLAGS data type (8, 16, 32 or 64)        */
 
 
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
@@ -103,6 +124,7 @@
 #define OS_MUTEX_ACCEPT_EN        1u   /*     Include code for OSMutexAccept()                         */
 #define OS_MUTEX_DEL_EN           1u   /*     Include code for OSMutexDel()                            */
 #define OS_MUTEX_QUERY_EN         1u   /*     Include code for OSMutexQuery()                          */
+#define OS_MUTEX_CEIL_EN          1u   /* Enable (1) or Disable (0) the priority ceiling mutexes       */
 
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
@@ -115,6 +137,16 @@
 #define OS_Q_POST_FRONT_EN        1u   /*     Include code for OSQPostFront()                          */
 #define OS_Q_POST_OPT_EN          1u   /*     Include code for OSQPostOpt()                            */
 #define OS_Q_QUERY_EN             1u   /*     Include code for OSQQuery()                              */
+#define OS_Q_STAT_EN              1u   /*     Include queue telemetry and OSQStatGet()                 */
+#define OS_Q_POLICY_EN            1u   /*     Include OSQPolicySet(), OSQPostPend() and drop counters  */
+
+
+                                       /* ----------------- PRIORITY MESSAGE QUEUES ------------------ */
+#define OS_PQ_EN                  1u   /* Enable (1) or Disable (0) code generation for PRIORITY QUEUES*/
+#define OS_PQ_ACCEPT_EN           1u   /*     Include code for OSPQAccept()                            */
+#define OS_PQ_DEL_EN              1u   /*     Include code for OSPQDel()                               */
+#define OS_PQ_STAT_EN             1u   /*     Include code for OSPQStatGet()                           */
+#define OS_PQ_BANDS_MAX           4u   /*     Max. number of bands of a priority queue (<= 32)         */
 
 
                                        /* ------------------------ SEMAPHORES ------------------------ */
@@ -140,4 +172,19 @@
 #define OS_TMR_CFG_WHEEL_SIZE     8u   /*     Size of timer wheel (#Spokes)                            */
 #define OS_TMR_CFG_TICKS_PER_SEC 10u   /*     Rate at which timer management task runs (Hz)            */
 
+
+                                       /* -------------------- DEFERRED ISR POSTS -------------------- */
+#define OS_ISR_POST_DEFERRED_EN   1u   /* Posts made from ISRs are replayed by a task (1) or not (0)   */
+#define OS_INT_Q_SIZE            16u   /*     Max. number of posts waiting to be replayed              */
+#define OS_TASK_INT_Q_PRIO        0u   /*     ISR queue task priority, MUST be the highest one         */
+
+
+                                       /* ----------------------- EVENT TRACE ------------------------ */
+#define OS_TRACE_EN               1u   /* Enable (1) or Disable (0) the kernel event trace recorder    */
+#define OS_TRACE_SIZE          1024u   /*     Number of events kept in the trace (power of 2, <= 4096) */
+
+
+                                       /* ------------------------ KERNEL VIEW ----------------------- */
+#define OS_VIEW_EN                1u   /* Enable (1) or Disable (0) the kernel view snapshots          */
+
 #endif
@@ -61,7 +61,9 @@ INT8U  const  OSUnMapTbl[256] = {
 *********************************************************************************************************
 */
 
+#if OS_INIT_STATIC_EN == 0u
 static  void  OS_InitEventList(void);
+#endif
 
 static  void  OS_InitMisc(void);
 
@@ -73,7 +75,9 @@ static  void  OS_InitTaskIdle(void);
 static  void  OS_InitTaskStat(void);
 #endif
 
+#if OS_INIT_STATIC_EN == 0u
 static  void  OS_InitTCBList(void);
+#endif
 
 static  void  OS_SchedNew(void);
 
@@ -141,6 +145,7 @@ INT8U  OSEventNameGet (OS_EVENT   *pevent,
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_PQ:
              break;
 
         default:
@@ -219,6 +224,7 @@ void  OSEventNameSet (OS_EVENT  *pevent,
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_PQ:
              break;
 
         default:
@@ -564,6 +570,11 @@ INT16U  OSEventPendMulti (OS_EVENT  **pevents_pend,
 * Arguments  : none
 *
 * Returns    : none
+*
+* Notes      : 1) When OS_INIT_STATIC_EN is set, the free lists of OS_TCBs, OS_EVENTs, event flag groups,
+*                 queues and priority queues are not built here: they are initialized in .data (see
+*                 OS_INIT_TBL.C) and the tables that start out cleared are in .bss.  OSInit() must then
+*                 be called only once after reset, before any of them is used.
 *********************************************************************************************************
 */
 
@@ -575,11 +586,21 @@ void  OSInit (void)
 
     OS_InitRdyList();                                            /* Initialize the Ready List                */
 
+#if OS_INIT_STATIC_EN == 0u                                      /* See Note #1                              */
     OS_InitTCBList();                                            /* Initialize the free list of OS_TCBs      */
 
     OS_InitEventList();                                          /* Initialize the free list of OS_EVENTs    */
+#endif
+
+#if OS_SCHED_RR_EN > 0u
+    OS_SchedRRInit();                                            /* Initialize the round-robin levels        */
+#endif
 
-#if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    OS_EventSetInit();                                           /* Initialize the free list of event sets   */
+#endif
+
+#if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u) && (OS_INIT_STATIC_EN == 0u)
     OS_FlagInit();                                               /* Initialize the event flag structures     */
 #endif
 
@@ -587,10 +608,14 @@ void  OSInit (void)
     OS_MemInit();                                                /* Initialize the memory manager            */
 #endif
 
-#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u) && (OS_INIT_STATIC_EN == 0u)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u) && (OS_INIT_STATIC_EN == 0u)
+    OS_PQInit();                                                 /* Initialize the priority queue structures */
+#endif
+
     OS_InitTaskIdle();                                           /* Create the Idle Task                     */
 #if OS_TASK_STAT_EN > 0u
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
@@ -600,6 +625,14 @@ void  OSInit (void)
     OSTmr_Init();                                                /* Initialize the Timer Manager             */
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    OS_IntQInit();                                               /* Create the ISR post queue task           */
+#endif
+
+#if OS_TRACE_EN > 0u
+    OS_TraceInit();                                              /* Clear the event trace                    */
+#endif
+
     OSInitHookEnd();                                             /* Call port specific init. code            */
 
 #if OS_DEBUG_EN > 0u
@@ -638,6 +671,7 @@ void  OSIntEnter (void)
         if (OSIntNesting < 255u) {
             OSIntNesting++;                      /* Increment ISR nesting level                        */
         }
+        OS_TRACE(OS_TRACE_TYPE_ISR_ENTER, 0u);
     }
 }
 /*$PAGE*/
@@ -657,6 +691,8 @@ void  OSIntEnter (void)
 *                 to OSIntEnter() at the beginning of the ISR you MUST have a call to OSIntExit() at the
 *                 end of the ISR.
 *              2) Rescheduling is prevented when the scheduler is locked (see OS_SchedLock())
+*              3) When the last nested ISR completes, the ISR post queue task is readied if ISRs queued
+*                 posts (see OS_ISR_POST_DEFERRED_EN).
 *********************************************************************************************************
 */
 
@@ -670,10 +706,14 @@ void  OSIntExit (void)
 
     if (OSRunning == OS_TRUE) {
         OS_ENTER_CRITICAL();
+        OS_TRACE(OS_TRACE_TYPE_ISR_EXIT, 0u);
         if (OSIntNesting > 0u) {                           /* Prevent OSIntNesting from wrapping       */
             OSIntNesting--;
         }
         if (OSIntNesting == 0u) {                          /* Reschedule only if all ISRs complete ... */
+#if OS_ISR_POST_DEFERRED_EN > 0u
+            OS_IntQTaskRdy();                              /* Replay the posts deferred by the ISRs    */
+#endif
             if (OSLockNesting == 0u) {                     /* ... and not locked.                      */
                 OS_SchedNew();
                 OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
@@ -954,6 +994,9 @@ void  OSTimeTick (void)
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#if OS_SCHED_RR_EN > 0u
+        OS_SchedRRTick();                                  /* Charge time slice of running task            */
+#endif
     }
 }
 
@@ -1272,6 +1315,7 @@ void  OS_EventWaitListInit (OS_EVENT *pevent)
 *********************************************************************************************************
 */
 
+#if OS_INIT_STATIC_EN == 0u
 static  void  OS_InitEventList (void)
 {
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
@@ -1310,6 +1354,7 @@ static  void  OS_InitEventList (void)
 #endif
 #endif
 }
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1333,6 +1378,15 @@ static  void  OS_InitMisc (void)
     OSIntNesting              = 0u;                        /* Clear the interrupt nesting counter      */
     OSLockNesting             = 0u;                        /* Clear the scheduling lock counter        */
 
+#if OS_TASK_PROFILE_EN > 0u
+    OSIntCyclesTot            = 0uL;                       /* Clear the time spent in ISRs             */
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0u
+    OSMutexCeilSchedPend      = OS_FALSE;                  /* No context switch held back by a ceiling */
+    OSMutexCeilTCB            = (OS_TCB *)0;               /* No task holds a ceiling mutex            */
+#endif
+
     OSTaskCtr                 = 0u;                        /* Clear the number of tasks                */
 
     OSRunning                 = OS_FALSE;                  /* Indicate that multitasking not started   */
@@ -1346,6 +1400,10 @@ static  void  OS_InitMisc (void)
     OSStatRdy                 = OS_FALSE;                  /* Statistic task is not ready              */
 #endif
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TASK_STK_CLR_LAZY_EN > 0u)
+    OSTaskStkClrPrio          = 0u;                        /* Idle task starts clearing stacks at 0    */
+#endif
+
 #ifdef OS_SAFETY_CRITICAL_IEC61508
     OSSafetyCriticalStartFlag = OS_FALSE;                  /* Still allow creation of objects          */
 #endif
@@ -1519,6 +1577,7 @@ static  void  OS_InitTaskStat (void)
 *********************************************************************************************************
 */
 
+#if OS_INIT_STATIC_EN == 0u
 static  void  OS_InitTCBList (void)
 {
     INT8U    ix;
@@ -1546,6 +1605,7 @@ static  void  OS_InitTCBList (void)
     OSTCBList               = (OS_TCB *)0;                       /* TCB lists initializations          */
     OSTCBFreeList           = &OSTCBTbl[0];
 }
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1562,18 +1622,36 @@ static  void  OS_InitTCBList (void)
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Note that we can only clear up to 64K bytes of RAM.  This is not an issue because none
 *                 of the uses of this function gets close to this limit.
-*              3) The clear is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the destination.
+*              3) The bytes up to the first 32-bit boundary and after the last one are cleared one at a
+*                 time, the rest a word at a time.
+*              4) With OS_CPU_MEM_ASM_EN, the port's OS_CPU_MemClr() clears 32 bytes per STM instead.
 *********************************************************************************************************
 */
 
 void  OS_MemClr (INT8U  *pdest,
                  INT16U  size)
 {
-    while (size > 0u) {
+#if OS_CPU_MEM_ASM_EN > 0
+    OS_CPU_MemClr((void *)pdest, (INT32U)size);                /* See Note #4                              */
+#else
+    INT32U  *pdest32;
+
+
+    while ((size > 0u) && (((INT32U)pdest & (sizeof(INT32U) - 1u)) != 0u)) {
+        *pdest++ = (INT8U)0;                                   /* Clear up to a word boundary              */
+        size--;
+    }
+    pdest32 = (INT32U *)(void *)pdest;
+    while (size >= sizeof(INT32U)) {                           /* Clear a word at a time                   */
+        *pdest32++ = 0uL;
+        size      -= sizeof(INT32U);
+    }
+    pdest = (INT8U *)pdest32;
+    while (size > 0u) {                                        /* Clear the remaining bytes                */
         *pdest++ = (INT8U)0;
         size--;
     }
+#endif
 }
 /*$PAGE*/
 /*
@@ -1595,8 +1673,11 @@ void  OS_MemClr (INT8U  *pdest,
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
 *              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              3) When the source and destination have the same alignment, the bytes up to the first
+*                 32-bit boundary and after the last one are copied one at a time, the rest a word at a
+*                 time.  Otherwise, the copy is done one byte at a time.
+*              4) With OS_CPU_MEM_ASM_EN, the port's OS_CPU_MemCopy() copies 32 bytes per LDM/STM instead
+*                 (and a word at a time when the alignments differ).
 *********************************************************************************************************
 */
 
@@ -1604,10 +1685,32 @@ void  OS_MemCopy (INT8U  *pdest,
                   INT8U  *psrc,
                   INT16U  size)
 {
-    while (size > 0u) {
+#if OS_CPU_MEM_ASM_EN > 0
+    OS_CPU_MemCopy((void *)pdest, (const void *)psrc, (INT32U)size);  /* See Note #4                       */
+#else
+    INT32U  *pdest32;
+    INT32U  *psrc32;
+
+
+    if ((((INT32U)pdest ^ (INT32U)psrc) & (sizeof(INT32U) - 1u)) == 0u) {
+        while ((size > 0u) && (((INT32U)pdest & (sizeof(INT32U) - 1u)) != 0u)) {
+            *pdest++ = *psrc++;                                /* Copy up to a word boundary               */
+            size--;
+        }
+        pdest32 = (INT32U *)(void *)pdest;
+        psrc32  = (INT32U *)(void *)psrc;
+        while (size >= sizeof(INT32U)) {                       /* Copy a word at a time                    */
+            *pdest32++ = *psrc32++;
+            size      -= sizeof(INT32U);
+        }
+        pdest = (INT8U *)pdest32;
+        psrc  = (INT8U *)psrc32;
+    }
+    while (size > 0u) {                                        /* Copy the remaining (or all) bytes        */
         *pdest++ = *psrc++;
         size--;
     }
+#endif
 }
 /*$PAGE*/
 /*
@@ -1666,11 +1769,18 @@ void  OS_Sched (void)
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Interrupts are assumed to be disabled when this function is called.
+*              3) While a ready task holds priority ceiling mutexes, the ready tasks at or below its
+*                 ceiling are ignored, whichever task is running (see os_mutex_ceil.c).  Only the first
+*                 ready task of OSMutexCeilTCB needs to be checked: a task can only acquire a ceiling
+*                 mutex while it runs, hence above the ceilings of the holders already in the stack.
 *********************************************************************************************************
 */
 
 static  void  OS_SchedNew (void)
 {
+#if OS_MUTEX_CEIL_EN > 0u
+    OS_TCB   *ptcb;
+#endif
 #if OS_LOWEST_PRIO <= 63u                        /* See if we support up to 64 tasks                   */
     INT8U   y;
 
@@ -1694,6 +1804,20 @@ static  void  OS_SchedNew (void)
         OSPrioHighRdy = (INT8U)((y << 4u) + OSUnMapTbl[(OS_PRIO)(*ptbl >> 8u) & 0xFFu] + 8u);
     }
 #endif
+#if OS_MUTEX_CEIL_EN > 0u
+    ptcb = OSMutexCeilTCB;                       /* Find the ready task with the highest ceiling ...   */
+    while ((ptcb != (OS_TCB *)0) &&
+           ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) == 0u)) {
+        ptcb = ptcb->OSTCBCeilNext;
+    }
+    if (ptcb != (OS_TCB *)0) {                   /* ... and hold back the tasks at or below it         */
+        if ((OSPrioHighRdy != ptcb->OSTCBPrio) &&
+            (OSPrioHighRdy >= ptcb->OSTCBCeilPrio)) {
+            OSPrioHighRdy        = ptcb->OSTCBPrio;
+            OSMutexCeilSchedPend = OS_TRUE;      /* Switch when the ceiling mutex is released          */
+        }
+    }
+#endif
 }
 
 /*$PAGE*/
@@ -1746,6 +1870,8 @@ INT8U  OS_StrLen (INT8U *psrc)
 *                 interrupts.
 *              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
 *                 power.
+*              3) With OS_TASK_STK_CLR_LAZY_EN, the stacks of the tasks created with OS_TASK_OPT_STK_CLR
+*                 are cleared here, a few entries per loop (see OS_TaskStkClrIdle()).
 *********************************************************************************************************
 */
 
@@ -1762,6 +1888,9 @@ void  OS_TaskIdle (void *p_arg)
         OS_ENTER_CRITICAL();
         OSIdleCtr++;
         OS_EXIT_CRITICAL();
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TASK_STK_CLR_LAZY_EN > 0u)
+        OS_TaskStkClrIdle();                     /* Clear part of a task stack (see note #3)           */
+#endif
         OSTaskIdleHook();                        /* Call user definable HOOK                           */
     }
 }
@@ -1838,34 +1967,127 @@ void  OS_TaskStat (void *p_arg)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) A full scan of every stack every 100 ms reads up to the whole free part of each stack.
+*                 Instead, at most OS_TASK_STK_CHK_SLICE entries of each stack are checked per call.  The
+*                 check resumes where it stopped and sweeps from the high-water mark (the deepest entry
+*                 found in use so far) to the end of the stack, then starts over from the mark.  Any
+*                 entry found in use on the way becomes the new mark.
+*              2) The guard at the end of the stack (see OS_TaskStkClr()) is checked on every call.
+*              3) A stack that the idle task has not finished clearing yet (see OS_TaskStkClrIdle()) is
+*                 skipped: its old content would be counted as used.
+*              4) This function is INTERNAL to uC/OS-II and your application should not call it.
 *********************************************************************************************************
 */
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
 void  OS_TaskStatStkChk (void)
 {
-    OS_TCB      *ptcb;
-    OS_STK_DATA  stk_data;
-    INT8U        err;
-    INT8U        prio;
+    OS_TCB    *ptcb;
+    OS_STK    *pbos;
+    OS_STK    *pchk;
+    OS_STK    *phwm;
+    OS_STK    *plim;
+    INT32U     nchk;
+    INT32U     size;
+    INT8U      prio;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+    BOOLEAN    ovf;
+#endif
+#if OS_CRITICAL_METHOD == 3u                                 /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
 
 
     for (prio = 0u; prio <= OS_TASK_IDLE_PRIO; prio++) {
-        err = OSTaskStkChk(prio, &stk_data);
-        if (err == OS_ERR_NONE) {
-            ptcb = OSTCBPrioTbl[prio];
-            if (ptcb != (OS_TCB *)0) {                               /* Make sure task 'ptcb' is ...   */
-                if (ptcb != OS_TCB_RESERVED) {                       /* ... still valid.               */
-#if OS_TASK_PROFILE_EN > 0u
-                    #if OS_STK_GROWTH == 1u
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize;
-                    #else
-                    ptcb->OSTCBStkBase = ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize;
-                    #endif
-                    ptcb->OSTCBStkUsed = stk_data.OSUsed;            /* Store the number of bytes used */
+        OS_ENTER_CRITICAL();
+        ptcb = OSTCBPrioTbl[prio];
+        if ((ptcb == (OS_TCB *)0) ||                         /* Make sure task 'ptcb' is valid ...       */
+            (ptcb == OS_TCB_RESERVED) ||
+            ((ptcb->OSTCBOpt & OS_TASK_OPT_STK_CHK) == 0u)) { /* ... and has stack checking enabled      */
+            OS_EXIT_CRITICAL();
+#if OS_TASK_STK_CLR_LAZY_EN > 0u
+        } else if (ptcb->OSTCBStkClrPtr != (OS_STK *)0) {    /* Stack not cleared yet (see Note #3)      */
+            OS_EXIT_CRITICAL();
+#endif
+        } else {
+            pbos = ptcb->OSTCBStkBottom;
+            size = ptcb->OSTCBStkSize;
+            pchk = ptcb->OSTCBStkChkPtr;
+            phwm = ptcb->OSTCBStkHwmPtr;
+            OS_EXIT_CRITICAL();
+#if OS_STK_GROWTH == 1u
+            plim = pbos;                                     /* Last entry to check                      */
+#if OS_TASK_STK_GUARD_SIZE > 0u
+            if (size > OS_TASK_STK_GUARD_SIZE) {
+                plim += OS_TASK_STK_GUARD_SIZE;
+            }
+#endif
+            if (pchk <= plim) {                              /* Sweep done, start over from the mark     */
+                pchk = phwm;
+            }
+            nchk = OS_TASK_STK_CHK_SLICE;
+            while ((nchk > 0u) && (pchk > plim)) {
+                pchk--;
+                if (*pchk != (OS_STK)0) {                    /* Entry in use below the mark              */
+                    phwm = pchk;
+                }
+                nchk--;
+            }
+#else
+            plim = pbos;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+            if (size > OS_TASK_STK_GUARD_SIZE) {
+                plim -= OS_TASK_STK_GUARD_SIZE;
+            }
+#endif
+            if (pchk >= plim) {
+                pchk = phwm;
+            }
+            nchk = OS_TASK_STK_CHK_SLICE;
+            while ((nchk > 0u) && (pchk < plim)) {
+                pchk++;
+                if (*pchk != (OS_STK)0) {
+                    phwm = pchk;
+                }
+                nchk--;
+            }
+#endif
+#if OS_TASK_STK_GUARD_SIZE > 0u
+            ovf = OS_FALSE;
+            if (size > OS_TASK_STK_GUARD_SIZE) {
+                for (nchk = 0u; nchk < OS_TASK_STK_GUARD_SIZE; nchk++) {
+#if OS_STK_GROWTH == 1u
+                    if (pbos[nchk] != (OS_STK)OS_TASK_STK_GUARD_PATTERN) {
+#else
+                    if (*(pbos - nchk) != (OS_STK)OS_TASK_STK_GUARD_PATTERN) {
+#endif
+                        ovf = OS_TRUE;
+                    }
+                }
+            }
 #endif
+            OS_ENTER_CRITICAL();
+            if (OSTCBPrioTbl[prio] == ptcb) {                /* Make sure task was not deleted meanwhile */
+                ptcb->OSTCBStkChkPtr = pchk;
+                ptcb->OSTCBStkHwmPtr = phwm;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+                if (ovf == OS_TRUE) {
+                    ptcb->OSTCBStkOvf = OS_TRUE;             /* Kept until the task is deleted          */
                 }
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+                #if OS_STK_GROWTH == 1u
+                ptcb->OSTCBStkBase = pbos + size;
+                ptcb->OSTCBStkUsed = (INT32U)(ptcb->OSTCBStkBase - phwm) * sizeof(OS_STK);
+                #else
+                ptcb->OSTCBStkBase = pbos - size;
+                ptcb->OSTCBStkUsed = (INT32U)(phwm - ptcb->OSTCBStkBase) * sizeof(OS_STK);
+                #endif
+#endif
             }
+            OS_EXIT_CRITICAL();
         }
     }
 }
@@ -1948,6 +2170,34 @@ INT8U  OS_TCBInit (INT8U    prio,
         ptcb->OSTCBStkBottom     = pbos;                   /* Store pointer to bottom of stack         */
         ptcb->OSTCBOpt           = opt;                    /* Store task options                       */
         ptcb->OSTCBId            = id;                     /* Store task ID                            */
+#if OS_TASK_STAT_STK_CHK_EN > 0u
+#if OS_STK_GROWTH == 1u                                    /* No stack entry found in use yet          */
+        ptcb->OSTCBStkHwmPtr     = pbos + stk_size;
+#else
+        ptcb->OSTCBStkHwmPtr     = pbos - stk_size;
+#endif
+        ptcb->OSTCBStkChkPtr     = ptcb->OSTCBStkHwmPtr;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+        ptcb->OSTCBStkOvf        = OS_FALSE;
+#endif
+#if OS_TASK_STK_CLR_LAZY_EN > 0u
+        ptcb->OSTCBStkClrPtr     = (OS_STK *)0;
+        if ((opt & OS_TASK_OPT_STK_CHK) != 0x0000u) {
+            if ((opt & OS_TASK_OPT_STK_CLR) != 0x0000u) {  /* Stack to be cleared by the idle task ... */
+                ptcb->OSTCBStkClrPtr = pbos;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+                if (stk_size > OS_TASK_STK_GUARD_SIZE) {   /* ... past the guard (see OS_TaskStkClr()) */
+#if OS_STK_GROWTH == 1u
+                    ptcb->OSTCBStkClrPtr = pbos + OS_TASK_STK_GUARD_SIZE;
+#else
+                    ptcb->OSTCBStkClrPtr = pbos - OS_TASK_STK_GUARD_SIZE;
+#endif
+                }
+#endif
+            }
+        }
+#endif
+#endif
 #else
         pext                     = pext;                   /* Prevent compiler warning if not used     */
         stk_size                 = stk_size;
@@ -1960,6 +2210,11 @@ INT8U  OS_TCBInit (INT8U    prio,
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
+#if OS_MUTEX_CEIL_EN > 0u
+        ptcb->OSTCBCeilPrio      = OS_MUTEX_CEIL_NONE;     /* Task holds no priority ceiling mutex     */
+        ptcb->OSTCBCeilNext      = (OS_TCB *)0;
+#endif
+
 #if OS_LOWEST_PRIO <= 63u                                         /* Pre-compute X, Y                  */
         ptcb->OSTCBY             = (INT8U)(prio >> 3u);
         ptcb->OSTCBX             = (INT8U)(prio & 0x07u);
@@ -1988,6 +2243,8 @@ INT8U  OS_TCBInit (INT8U    prio,
 
 #if OS_TASK_PROFILE_EN > 0u
         ptcb->OSTCBCtxSwCtr    = 0uL;                      /* Initialize profiling variables           */
+        ptcb->OSTCBCtxSwOutCtr = 0uL;
+        ptcb->OSTCBFPCtr       = 0uL;
         ptcb->OSTCBCyclesStart = 0uL;
         ptcb->OSTCBCyclesTot   = 0uL;
         ptcb->OSTCBStkBase     = (OS_STK *)0;
@@ -2004,6 +2261,10 @@ INT8U  OS_TCBInit (INT8U    prio,
         }
 #endif
 
+#if OS_SCHED_RR_EN > 0u
+        OS_SchedRRTCBInit(ptcb);                           /* Attach task to its round-robin level     */
+#endif
+
         OSTCBInitHook(ptcb);
 
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
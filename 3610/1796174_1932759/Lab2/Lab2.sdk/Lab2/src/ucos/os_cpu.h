@@ -34,6 +34,10 @@
 #define  OS_CPU_FPU_EN    0                      /* HW floating point support disabled by default      */
 #endif
 
+#ifndef  OS_CPU_FPU_LAZY_EN                      /* Only with OS_CPU_FPU_EN, which also needs OS_MEM_EN */
+#define  OS_CPU_FPU_LAZY_EN    1                 /* Switch VFP registers on first use (see OS_CPU_C.C) */
+#endif
+
 #ifndef  OS_CPU_EXCEPT_STK_SIZE
 #define  OS_CPU_EXCEPT_STK_SIZE    128           /* Default exception stack size is 128 OS_STK entries */
 #endif
@@ -44,7 +48,51 @@
 *********************************************************************************************************
 */
 
-#define  OS_CPU_INT_DIS_MEAS_EN    0
+#ifndef  OS_CPU_INT_DIS_MEAS_EN
+#define  OS_CPU_INT_DIS_MEAS_EN    0             /* Track max. interrupt disable time (global timer)   */
+#endif
+
+#ifndef  OS_CPU_INT_DIS_PROF_EN
+#define  OS_CPU_INT_DIS_PROF_EN    0             /* Per call site disable time histograms (PMU cycles) */
+#endif
+
+#define  OS_CPU_INT_DIS_PROF_SITES       64      /* Max. number of critical sections tracked           */
+#define  OS_CPU_INT_DIS_PROF_BUCKETS      8      /* Histogram buckets: < 64, < 128, ... , >= 4096 cyc. */
+#define  OS_CPU_INT_DIS_PROF_BUCKET_SHIFT 6      /* log2 of the upper bound of the first bucket        */
+
+/*
+*********************************************************************************************************
+*                                        MEMORY COPY AND CLEAR
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_MEM_ASM_EN
+#define  OS_CPU_MEM_ASM_EN         1             /* OS_MemCopy()/OS_MemClr() use OS_CPU_MEM_A.S        */
+#endif
+
+/*
+*********************************************************************************************************
+*                                  PER TASK PERFORMANCE MONITOR EVENTS
+*********************************************************************************************************
+*/
+
+#ifndef  OS_CPU_PMU_EN
+#define  OS_CPU_PMU_EN             1             /* Per task PMU and L2 event counts (OSTaskSwHook())  */
+#endif
+
+#define  OS_CPU_PMU_INSTR          0             /* Instructions renamed (executed, speculatively)     */
+#define  OS_CPU_PMU_DC_ACCESS      1             /* L1 data cache accesses                             */
+#define  OS_CPU_PMU_DC_MISS        2             /* L1 data cache refills                              */
+#define  OS_CPU_PMU_TLB_MISS       3             /* Main TLB refills, data side                        */
+#define  OS_CPU_PMU_BR_MISS        4             /* Branches mispredicted or not predicted             */
+#define  OS_CPU_PMU_STALL          5             /* Cycles stalled waiting for the load/store unit     */
+#define  OS_CPU_PMU_L2_RD_HIT      6             /* L2 data read hits (PL310: every master)            */
+#define  OS_CPU_PMU_L2_RD_REQ      7             /* L2 data read requests                              */
+#define  OS_CPU_PMU_CYC            8             /* CPU cycles (PMCCNTR)                               */
+#define  OS_CPU_PMU_NBR            9
+
+#define  OS_CPU_PMU_NBR_TCB        (OS_MAX_TASKS + 2u)   /* Entries of OSTCBTbl[] (OS_N_SYS_TASKS <= 2) */
+#define  OS_CPU_PMU_ISR            0xFFu         /* OS_CPU_PmuRd() index of the events counted in ISRs */
 
 /*
 *********************************************************************************************************
@@ -101,6 +149,7 @@ typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity
 typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
 typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
 typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef unsigned long long INT64U;               /* Unsigned 64 bit quantity                           */
 typedef float          FP32;                     /* Single precision floating point                    */
 typedef double         FP64;                     /* Double precision floating point                    */
 
@@ -134,19 +183,28 @@ typedef unsigned int   OS_CPU_SR;                /* Define size of CPU status re
 #if      OS_CRITICAL_METHOD == 3
 
 #if      OS_CPU_INT_DIS_MEAS_EN > 0
-
-#define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save();  \
-                               OS_CPU_IntDisMeasStart();}
-#define  OS_EXIT_CRITICAL()   {OS_CPU_IntDisMeasStop();   \
-                               OS_CPU_SR_Restore(cpu_sr);}
-
+#define  OS_CPU_INT_DIS_MEAS_START()    OS_CPU_IntDisMeasStart()
+#define  OS_CPU_INT_DIS_MEAS_STOP()     OS_CPU_IntDisMeasStop()
 #else
+#define  OS_CPU_INT_DIS_MEAS_START()
+#define  OS_CPU_INT_DIS_MEAS_STOP()
+#endif
 
-#define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save();}
-#define  OS_EXIT_CRITICAL()   {OS_CPU_SR_Restore(cpu_sr);}
-
+#if      OS_CPU_INT_DIS_PROF_EN > 0             /* The call site is the OS_ENTER_CRITICAL() location  */
+#define  OS_CPU_INT_DIS_PROF_START()    OS_CPU_IntDisProfStart(__FILE__, __LINE__)
+#define  OS_CPU_INT_DIS_PROF_STOP()     OS_CPU_IntDisProfStop()
+#else
+#define  OS_CPU_INT_DIS_PROF_START()
+#define  OS_CPU_INT_DIS_PROF_STOP()
 #endif
 
+#define  OS_ENTER_CRITICAL()  {cpu_sr = OS_CPU_SR_Save();  \
+                               OS_CPU_INT_DIS_MEAS_START(); \
+                               OS_CPU_INT_DIS_PROF_START();}
+#define  OS_EXIT_CRITICAL()   {OS_CPU_INT_DIS_PROF_STOP();  \
+                               OS_CPU_INT_DIS_MEAS_STOP();  \
+                               OS_CPU_SR_Restore(cpu_sr);}
+
 #endif
 
 /*
@@ -159,6 +217,12 @@ typedef unsigned int   OS_CPU_SR;                /* Define size of CPU status re
 
 #define  OS_TASK_SW()         OSCtxSw()
 
+#define  OS_TS_GET()          OS_CPU_CycCntRd()   /* Time stamps: PMU cycle counter                     */
+#define  OS_TS_FREQ_HZ        666666687uL         /* CPU clock (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ)    */
+
+                                                  /* Index of the lowest bit set in 'x' (x != 0): RBIT+CLZ */
+#define  OS_CPU_CntTrailZeros(x)  ((INT8U)__builtin_ctz((unsigned int)(x)))
+
 /*
 *********************************************************************************************************
 *                                            GLOBAL VARIABLES
@@ -168,11 +232,53 @@ typedef unsigned int   OS_CPU_SR;                /* Define size of CPU status re
                                                   /* Variables used to measure interrupt disable time  */
 #if OS_CPU_INT_DIS_MEAS_EN > 0
 OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasNestingCtr;
-OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasCntsEnter;
-OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasCntsExit;
-OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasCntsMax;
-OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasCntsDelta;
-OS_CPU_EXT  INT16U   OS_CPU_IntDisMeasCntsOvrhd;
+OS_CPU_EXT  INT32U   OS_CPU_IntDisMeasCntsEnter;
+OS_CPU_EXT  INT32U   OS_CPU_IntDisMeasCntsExit;
+OS_CPU_EXT  INT32U   OS_CPU_IntDisMeasCntsMax;     /* In global timer counts (CPU clock / 2)            */
+OS_CPU_EXT  INT32U   OS_CPU_IntDisMeasCntsDelta;
+OS_CPU_EXT  INT32U   OS_CPU_IntDisMeasCntsOvrhd;
+#endif
+
+                                                  /* Per call site interrupt disable time profile      */
+#if OS_CPU_INT_DIS_PROF_EN > 0
+typedef struct os_cpu_int_dis_site {
+    const char  *File;                            /* Call site of OS_ENTER_CRITICAL() (NULL if unused)  */
+    INT32U       Line;
+    INT32U       Ctr;                             /* Number of times interrupts were disabled           */
+    INT32U       CycMax;                          /* Longest disable time (CPU cycles)                  */
+    INT64U       CycTot;                          /* Total disable time   (CPU cycles)                  */
+    INT32U       Hist[OS_CPU_INT_DIS_PROF_BUCKETS];   /* Histogram of disable times                     */
+} OS_CPU_INT_DIS_SITE;
+
+OS_CPU_EXT  OS_CPU_INT_DIS_SITE  OS_CPU_IntDisProfTbl[OS_CPU_INT_DIS_PROF_SITES];
+OS_CPU_EXT  INT16U               OS_CPU_IntDisProfNestingCtr;
+OS_CPU_EXT  const char          *OS_CPU_IntDisProfFile;   /* Site of the outermost critical section     */
+OS_CPU_EXT  INT32U               OS_CPU_IntDisProfLine;
+OS_CPU_EXT  INT32U               OS_CPU_IntDisProfCycEnter;
+OS_CPU_EXT  INT32U               OS_CPU_IntDisProfCycOvrhd;
+OS_CPU_EXT  INT32U               OS_CPU_IntDisProfLostCtr;    /* Samples dropped, site table full       */
+#endif
+
+                                                  /* Time spent in ISRs (see OS_CPU_IntCycStart())      */
+#if OS_TASK_PROFILE_EN > 0u
+OS_CPU_EXT  INT32U   OS_CPU_IntCycEnter;
+#endif
+
+                                                  /* Per task event counts (see OS_CPU_PmuCharge())    */
+#if OS_CPU_PMU_EN > 0
+typedef struct os_cpu_pmu_ctrs {
+    INT64U   Ctr[OS_CPU_PMU_NBR];                 /* Indexed by OS_CPU_PMU_INSTR ... OS_CPU_PMU_CYC     */
+} OS_CPU_PMU_CTRS;
+
+OS_CPU_EXT  OS_CPU_PMU_CTRS  OS_CPU_PmuTaskTbl[OS_CPU_PMU_NBR_TCB];  /* Same index as OSTCBTbl[]      */
+OS_CPU_EXT  OS_CPU_PMU_CTRS  OS_CPU_PmuIntTot;
+OS_CPU_EXT  INT32U           OS_CPU_PmuStart[OS_CPU_PMU_NBR];        /* Counters at the last charge    */
+#endif
+
+                                                  /* Lazy VFP context switching                        */
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)
+OS_CPU_EXT  INT32U   OS_CPU_FP_TrapCtr;           /* Number of first uses of the VFP after a switch    */
+OS_CPU_EXT  INT32U   OS_CPU_FP_SwCtr;             /* Number of VFP contexts actually switched          */
 #endif
 
 OS_CPU_EXT  OS_STK   OS_CPU_ExceptStk[OS_CPU_EXCEPT_STK_SIZE];
@@ -201,8 +307,14 @@ void       OS_CPU_SR_IRQ_En                   (void);
 void       OS_CPU_FP_Init                     (void);
 void       OS_CPU_FP_Restore                  (void *pblk);
 void       OS_CPU_FP_Save                     (void *pblk);
+
+void       OS_CPU_FP_En                       (void);  /* See OS_CPU_FPU_A.S                           */
+void       OS_CPU_FP_Dis                      (void);
+INT32U     OS_CPU_FP_IsEn                     (void);
 #endif
 
+INT32U     OS_CPU_FP_UndefHndlr               (void);  /* Called by the undefined instruction handler  */
+
 void       OSCtxSw                            (void);
 void       OSIntCtxSw                         (void);
 void       OSStartHighRdy                     (void);
@@ -221,11 +333,44 @@ void       OS_CPU_ExceptHndlr                 (INT32U  except_type);
 
 INT32U     OS_CPU_ExceptStkChk                (void);
 
+void       OS_CPU_CycCntInit                  (void);
+INT32U     OS_CPU_CycCntRd                    (void);
+
+BOOLEAN    OS_CPU_AtomicCAS                   (volatile INT32U *paddr, INT32U expected, INT32U desired);
+
+                                                 /* See OS_CPU_MEM_A.S                                 */
+void       OS_CPU_MemCopy                     (void *pdest, const void *psrc, INT32U size);
+void       OS_CPU_MemClr                      (void *pdest, INT32U size);
+void       OS_CPU_MemCopy64                   (void *pdest, const void *psrc);
+void       OS_CPU_MemClr64                    (void *pdest);
+                                                 /* Tasks created with OS_TASK_OPT_SAVE_FP only        */
+void       OS_CPU_MemCopyNEON                 (void *pdest, const void *psrc, INT32U size);
+void       OS_CPU_MemClrNEON                  (void *pdest, INT32U size);
+
+#if OS_TASK_PROFILE_EN > 0u
+void       OS_CPU_IntCycStart                 (void);
+void       OS_CPU_IntCycStop                  (void);
+#endif
+
+#if OS_CPU_PMU_EN > 0
+void       OS_CPU_PmuInit                     (void);
+void       OS_CPU_PmuCharge                   (OS_CPU_PMU_CTRS *pctrs);
+void       OS_CPU_PmuRd                       (INT8U idx, OS_CPU_PMU_CTRS *pctrs);
+#endif
+
+#if OS_CPU_INT_DIS_PROF_EN > 0
+void       OS_CPU_IntDisProfInit              (void);
+void       OS_CPU_IntDisProfReset             (void);
+void       OS_CPU_IntDisProfStart             (const char *file, INT32U line);
+void       OS_CPU_IntDisProfStop              (void);
+INT8U      OS_CPU_IntDisProfTop               (OS_CPU_INT_DIS_SITE **psites, INT8U nbr_max);
+#endif
+
 #if OS_CPU_INT_DIS_MEAS_EN > 0
 void       OS_CPU_IntDisMeasInit              (void);
 void       OS_CPU_IntDisMeasStart             (void);
 void       OS_CPU_IntDisMeasStop              (void);
-INT16U     OS_CPU_IntDisMeasTmrRd             (void);
+INT32U     OS_CPU_IntDisMeasTmrRd             (void);
 #endif
 
 #endif
@@ -23,6 +23,17 @@
 #define  OS_CPU_GLOBALS
 #include "ucos_ii.h"
 #include "os_cpu.h"
+#include <xpseudo_asm.h>
+
+#if OS_CPU_INT_DIS_MEAS_EN > 0
+#include <xil_io.h>
+#include <xtime_l.h>
+#endif
+
+#if OS_CPU_PMU_EN > 0
+#include <xpm_counter.h>
+#include <xl2cc_counter.h>
+#endif
 
 /*$PAGE*/
 /*
@@ -35,8 +46,8 @@
 *           4) ARM_SVC_MODE_ARM is the CPSR bit mask for SVC MODE + ARM Mode
             5) OS_NTASKS_FP  establishes the number of tasks capable of supporting floating-point.  One
 *              task is removed for the idle task because it doesn't do floating-point at all.
-*           6) OS_FP_STORAGE_SIZE  currently allocates 128 bytes of storage in order to accomodate
-*              thirty-two single-precision 32-bit, or sixteen double-precision 64-bit VFP registers.
+*           6) OS_FP_STORAGE_SIZE  allocates storage for the thirty-two double-precision 64-bit VFPv3
+*              registers (D0-D31) and FPSCR, rounded up to a multiple of 8 bytes.
 *********************************************************************************************************
 */
 
@@ -47,7 +58,11 @@
 #define  ARM_SVC_MODE_ARM      (0x00000013L + ARM_MODE_ARM)
 
 #define  OS_NTASKS_FP          (OS_MAX_TASKS + OS_N_SYS_TASKS - 1)
-#define  OS_FP_STORAGE_SIZE            128L
+#define  OS_FP_STORAGE_SIZE            264L
+
+#if (OS_CPU_FPU_EN > 0) && ((OS_MEM_EN == 0) || (OS_MAX_MEM_PART == 0))
+#error  "OS_CPU_FPU_EN requires OS_MEM_EN: the VFP registers are saved in a memory partition"
+#endif
 
 /*
 *********************************************************************************************************
@@ -64,6 +79,10 @@ static  OS_MEM  *OSFPPartPtr;                    /* Ptr to memory partition for
 static  INT32U   OSFPPart[OS_NTASKS_FP][OS_FP_STORAGE_SIZE / sizeof(INT32U)];
 #endif
 
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)
+static  OS_TCB  *OSFPOwnerPtr;                   /* Task whose context is in the VFP registers         */
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -79,7 +98,7 @@ static  INT32U   OSFPPart[OS_NTASKS_FP][OS_FP_STORAGE_SIZE / sizeof(INT32U)];
 * Returns    : none
 *
 * Note(s)    : 1) Tasks that are to use FP support MUST be created with OSTaskCreateExt().
-*              2) For the ARM VFP, 128 bytes are required to save the VFP context.
+*              2) For the ARM VFPv3, 260 bytes are required to save the VFP context.
 *                 The INT32U data type is used to ensure that storage is aligned on a 32-bit boundary.
 *              3) If you need to perform floating point operations from within the OSStatTaskHook(),
 *                 then you must change the 'Options' attribute for OSTaskCreatExt() when creating
@@ -98,6 +117,11 @@ void  OS_CPU_FP_Init (void)
 
 
     OSFPPartPtr = OSMemCreate(&OSFPPart[0][0], OS_NTASKS_FP, OS_FP_STORAGE_SIZE, &err);
+#if OS_CPU_FPU_LAZY_EN > 0
+    OSFPOwnerPtr      = (OS_TCB *)0;                   /* No task owns the VFP registers yet           */
+    OS_CPU_FP_TrapCtr = 0;
+    OS_CPU_FP_SwCtr   = 0;
+#endif
 
 #if OS_TASK_STAT_EN && OS_TASK_CREATE_EXT_EN           /* CHANGE 'OPTIONS' for OS_TaskStat()           */
     ptcb            = OSTCBPrioTbl[OS_TASK_STAT_PRIO];
@@ -105,7 +129,11 @@ void  OS_CPU_FP_Init (void)
     pblk            = OSMemGet(OSFPPartPtr, &err);     /* Get storage for VFP registers                */
     if (pblk != (void *)0) {                           /* Did we get a memory block?                   */
         ptcb->OSTCBExtPtr = pblk;                      /* Yes, Link to task's TCB                      */
+#if OS_CPU_FPU_LAZY_EN > 0
+        OS_MemClr((INT8U *)pblk, OS_FP_STORAGE_SIZE);  /*      Start with cleared VFP registers        */
+#else
         OS_CPU_FP_Save(pblk);                          /*      Save the VFP registers in block         */
+#endif
     }
 #endif
 }
@@ -164,10 +192,20 @@ void  OSInitHookBegin (void)
 #if OS_CPU_HOOKS_EN > 0 && OS_VERSION > 203
 void  OSInitHookEnd (void)
 {
+    OS_CPU_CycCntInit();                         /* Start the PMU cycle counter                        */
+
+#if OS_CPU_PMU_EN > 0
+    OS_CPU_PmuInit();                            /* Start the PMU and L2 event counters                */
+#endif
+
 #if OS_CPU_INT_DIS_MEAS_EN > 0
     OS_CPU_IntDisMeasInit();
 #endif
 
+#if OS_CPU_INT_DIS_PROF_EN > 0
+    OS_CPU_IntDisProfInit();
+#endif
+
 #if OS_CPU_FPU_EN > 0
     OS_CPU_FP_Init();                            /* Initialize support for VFP register save / restore */
 #endif
@@ -199,7 +237,11 @@ void  OSTaskCreateHook (OS_TCB *ptcb)
         pblk = OSMemGet(OSFPPartPtr, &err);      /* Yes, Get storage for VFP registers                 */
         if (pblk != (void *)0) {                 /*      Did we get a memory block?                    */
             ptcb->OSTCBExtPtr = pblk;            /*      Yes, Link to task's TCB                       */
+#if OS_CPU_FPU_LAZY_EN > 0                       /*           The VFP may be disabled: don't touch it  */
+            OS_MemClr((INT8U *)pblk, OS_FP_STORAGE_SIZE);
+#else
             OS_CPU_FP_Save(pblk);                /*           Save the VFP registers in block          */
+#endif
         }
     }
 #endif
@@ -233,6 +275,11 @@ void  OSTaskDelHook (OS_TCB *ptcb)
             OSMemPut(OSFPPartPtr, ptcb->OSTCBExtPtr);      /*      Return memory block to free pool    */
         }
     }
+#if OS_CPU_FPU_LAZY_EN > 0
+    if (OSFPOwnerPtr == ptcb) {                            /* Its VFP registers need not be saved      */
+        OSFPOwnerPtr = (OS_TCB *)0;
+    }
+#endif
 #endif
 
 #if OS_APP_HOOKS_EN > 0
@@ -364,11 +411,39 @@ OS_STK *OSTaskStkInit (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT
 #if (OS_CPU_HOOKS_EN > 0) && (OS_TASK_SW_HOOK_EN > 0)
 void  OSTaskSwHook (void)
 {
-#if OS_CPU_FPU_EN > 0
-    void  *pblk;
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN == 0)
+    void    *pblk;
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+    INT32U   cyc;
+#endif
+
+#if OS_TASK_PROFILE_EN > 0u                                /* Charge the task being switched out       */
+    cyc = OS_CPU_CycCntRd();
+    if (OSRunning == OS_TRUE) {
+        OSTCBCur->OSTCBCyclesTot += (INT32U)(cyc - OSTCBCur->OSTCBCyclesStart);
+        OSTCBCur->OSTCBCtxSwOutCtr++;
+    }
+    OSTCBHighRdy->OSTCBCyclesStart = cyc;
+#endif
+
+#if OS_CPU_PMU_EN > 0                                      /* Charge the events to the same task       */
+    if (OSRunning == OS_TRUE) {
+        OS_CPU_PmuCharge(&OS_CPU_PmuTaskTbl[OSTCBCur - &OSTCBTbl[0]]);
+    } else {
+        OS_CPU_PmuCharge((OS_CPU_PMU_CTRS *)0);
+    }
 #endif
 
-#if OS_CPU_FPU_EN > 0                                      /* Save VFP context of preempted task       */
+    OS_TRACE(OS_TRACE_TYPE_TASK_SW, OSPrioHighRdy);
+
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)      /* Lazy: only enable the VFP for its owner  */
+    if (OSTCBHighRdy == OSFPOwnerPtr) {
+        OS_CPU_FP_En();
+    } else {
+        OS_CPU_FP_Dis();                                   /* First VFP instruction will trap          */
+    }
+#elif OS_CPU_FPU_EN > 0                                    /* Save VFP context of preempted task       */
     if (OSRunning == OS_TRUE) {                            /* Don't save on OSStart()!                 */
         if (OSTCBCur->OSTCBOpt & OS_TASK_OPT_SAVE_FP) {    /* See if task used FP                      */
             pblk = OSTCBCur->OSTCBExtPtr;                  /* Yes, Get pointer to FP storage area      */
@@ -392,6 +467,65 @@ void  OSTaskSwHook (void)
 }
 #endif
 
+/*
+*********************************************************************************************************
+*                                     LAZY VFP CONTEXT SWITCHING
+*
+* Description: This function is called by the undefined instruction handler (see ASM_VECTORS.S).  With
+*              OS_CPU_FPU_LAZY_EN, OSTaskSwHook() disables the VFP (FPEXC.EN = 0) unless the task being
+*              switched in already owns the VFP registers, so the first VFP instruction the task executes
+*              traps here.  The VFP is then enabled and, if another task owns the registers, they are
+*              saved in the owner's storage and the current task's registers are restored.
+*
+* Arguments  : none
+*
+* Returns    : 1    if the trap was a lazy VFP switch: the VFP instruction must be executed again.
+*              0    otherwise: the instruction is really undefined.
+*
+* Note(s)    : 1) Called in undefined mode, with IRQs disabled.
+*              2) Tasks that never use the VFP, and tasks that run between two slices of the same VFP
+*                 task, cost nothing: the registers stay in the VFP.
+*              3) As before, ISRs MUST NOT use the VFP.
+*********************************************************************************************************
+*/
+
+INT32U  OS_CPU_FP_UndefHndlr (void)
+{
+#if (OS_CPU_FPU_EN > 0) && (OS_CPU_FPU_LAZY_EN > 0)
+    void  *pblk;
+
+
+    if (OS_CPU_FP_IsEn() != 0) {                           /* VFP was enabled: not a lazy VFP trap     */
+        return (0);
+    }
+    if (OSRunning != OS_TRUE) {
+        return (0);
+    }
+    OS_CPU_FP_En();
+    OS_CPU_FP_TrapCtr++;
+#if OS_TASK_PROFILE_EN > 0u
+    OSTCBCur->OSTCBFPCtr++;
+#endif
+    if (OSFPOwnerPtr != OSTCBCur) {                        /* Registers belong to another task         */
+        if (OSFPOwnerPtr != (OS_TCB *)0) {
+            pblk = OSFPOwnerPtr->OSTCBExtPtr;
+            if ((OSFPOwnerPtr->OSTCBOpt & OS_TASK_OPT_SAVE_FP) && (pblk != (void *)0)) {
+                OS_CPU_FP_Save(pblk);                      /* Save the VFP registers of the owner      */
+            }
+        }
+        pblk = OSTCBCur->OSTCBExtPtr;
+        if ((OSTCBCur->OSTCBOpt & OS_TASK_OPT_SAVE_FP) && (pblk != (void *)0)) {
+            OS_CPU_FP_Restore(pblk);                       /* Get the VFP registers of the new owner   */
+        }
+        OSFPOwnerPtr = OSTCBCur;
+        OS_CPU_FP_SwCtr++;
+    }
+    return (1);
+#else
+    return (0);
+#endif
+}
+
 /*
 *********************************************************************************************************
 *                                           OS_TCBInit() HOOK
@@ -490,6 +624,422 @@ void  OS_CPU_IntDisMeasStop (void)
         }
     }
 }
+
+
+/*
+*********************************************************************************************************
+*                             INTERRUPT DISABLE TIME MEASUREMENT, TIMER READ
+*
+* Description : This function reads the lower 32 bits of the Cortex-A9 global timer, which counts at half
+*               the CPU clock (COUNTS_PER_SECOND).
+*
+* Arguments   : None.
+*
+* Note(s)     : 1) The upper 32 bits are not needed: a wrap of the lower word is handled by the unsigned
+*                  subtraction in OS_CPU_IntDisMeasStop().
+*********************************************************************************************************
+*/
+
+INT32U  OS_CPU_IntDisMeasTmrRd (void)
+{
+    return (Xil_In32(GLOBAL_TMR_BASEADDR + GTIMER_COUNTER_LOWER_OFFSET));
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         PMU CYCLE COUNTER
+*
+* Description : OS_CPU_CycCntInit() enables and resets the Cortex-A9 PMU cycle counter (PMCCNTR), which
+*               counts CPU clock cycles.  OS_CPU_CycCntRd() returns its current value.
+*
+* Arguments   : None.
+*
+* Note(s)     : 1) The counter wraps every 2^32 cycles (about 6.4 s at 666 MHz): use unsigned differences.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_CycCntInit (void)
+{
+    mtcp(XREG_CP15_PERF_MONITOR_CTRL, mfcp(XREG_CP15_PERF_MONITOR_CTRL) | 0x05u);  /* PMCR.E = 1, PMCR.C = 1   */
+    mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000000u);                                 /* Enable PMCCNTR           */
+}
+
+
+INT32U  OS_CPU_CycCntRd (void)
+{
+    return (mfcp(XREG_CP15_PERF_CYCLE_COUNTER));
+}
+
+
+/*
+*********************************************************************************************************
+*                                         ATOMIC COMPARE AND SWAP
+*
+* Description : Stores 'desired' at 'paddr' if it still contains 'expected', without disabling interrupts.
+*
+* Arguments   : paddr       is the address of the word to update.
+*
+*               expected    is the value the word must contain.
+*
+*               desired     is the new value of the word.
+*
+* Returns     : OS_TRUE     if the word was updated.
+*               OS_FALSE    if it did not contain 'expected'.
+*
+* Note(s)     : 1) On the target, the exclusive monitor fails the STREX whenever an exception is taken
+*                  between LDREX and STREX, which then retries.  A DMB orders the update with the accesses
+*                  it protects.
+*               2) Other builds (e.g. host tests of the kernel) use the C11 atomics.
+*********************************************************************************************************
+*/
+
+#if defined(__ARM_ARCH_7A__)
+BOOLEAN  OS_CPU_AtomicCAS (volatile INT32U  *paddr,
+                           INT32U            expected,
+                           INT32U            desired)
+{
+    INT32U  val;
+    INT32U  fail;
+
+
+    do {
+        __asm__ __volatile__("ldrex  %0, [%1]" : "=&r" (val) : "r" (paddr) : "memory");
+        if (val != expected) {
+            __asm__ __volatile__("clrex" : : : "memory");
+            return (OS_FALSE);
+        }
+        __asm__ __volatile__("strex  %0, %2, [%1]" : "=&r" (fail) : "r" (paddr), "r" (desired) : "memory");
+    } while (fail != 0u);
+    __asm__ __volatile__("dmb" : : : "memory");
+    return (OS_TRUE);
+}
+#else
+#include <stdatomic.h>
+
+BOOLEAN  OS_CPU_AtomicCAS (volatile INT32U  *paddr,
+                           INT32U            expected,
+                           INT32U            desired)
+{
+    if (atomic_compare_exchange_strong((volatile _Atomic INT32U *)paddr, &expected, desired)) {
+        return (OS_TRUE);
+    }
+    return (OS_FALSE);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TIME SPENT IN ISRs
+*
+* Description : These functions are called by the IRQ handler around the dispatch of the interrupt.  The
+*               cycles spent in between are added to OSIntCyclesTot and are not charged to the task that
+*               was interrupted (see OSTaskSwHook()).
+*
+* Arguments   : None.
+*
+* Note(s)     : 1) Interrupts are disabled during these calls, and IRQs do not nest.
+*               2) The context save and OSIntExit() are outside of the measurement: they are charged to
+*                  the tasks.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0u
+void  OS_CPU_IntCycStart (void)
+{
+#if OS_CPU_PMU_EN > 0
+    if (OSRunning == OS_TRUE) {                            /* Events up to here go to the task         */
+        OS_CPU_PmuCharge(&OS_CPU_PmuTaskTbl[OSTCBCur - &OSTCBTbl[0]]);
+    } else {
+        OS_CPU_PmuCharge((OS_CPU_PMU_CTRS *)0);
+    }
+#endif
+    OS_CPU_IntCycEnter = OS_CPU_CycCntRd();
+}
+
+
+void  OS_CPU_IntCycStop (void)
+{
+    INT32U  cyc;
+
+
+    cyc             = OS_CPU_CycCntRd() - OS_CPU_IntCycEnter;
+    OSIntCyclesTot += cyc;
+    if (OSRunning == OS_TRUE) {
+        OSTCBCur->OSTCBCyclesStart += cyc;                 /* Don't charge the ISR to the task         */
+    }
+#if OS_CPU_PMU_EN > 0
+    OS_CPU_PmuCharge(&OS_CPU_PmuIntTot);
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     PER TASK PERFORMANCE MONITOR EVENTS
+*
+* Description : The six PMU event counters (XPM_CNTRCFG12), the two PL310 event counters and the cycle
+*               counter run freely.  At each context switch, OSTaskSwHook() charges their increments since
+*               the last charge to the task being switched out, which virtualizes the counters per task
+*               without saving or reloading them.  With OS_TASK_PROFILE_EN, OS_CPU_IntCycStart() and
+*               OS_CPU_IntCycStop() charge the ISRs to OS_CPU_PmuIntTot in the same way.
+*
+* Note(s)     : 1) OS_CPU_PmuTaskTbl[] has the index of OSTCBTbl[]: the tasks of a round-robin priority
+*                  are counted apart.
+*               2) The PL310 counts the L2 reads of every master (both CPUs, ACP), not only of the task.
+*               3) A charge reads 9 counters: about a hundred cycles, mostly the 2 L2 controller reads.
+*********************************************************************************************************
+*/
+
+#if OS_CPU_PMU_EN > 0
+static  void  OS_CPU_PmuCtrRd (INT32U *pctr)
+{
+    Xpm_ReadEventCounters(&pctr[OS_CPU_PMU_INSTR]);        /* Counters 0 to 5, in XPM_CNTRCFG12 order  */
+    XL2cc_EventCtrRead(&pctr[OS_CPU_PMU_L2_RD_HIT], &pctr[OS_CPU_PMU_L2_RD_REQ]);
+    pctr[OS_CPU_PMU_CYC] = OS_CPU_CycCntRd();
+}
+
+
+void  OS_CPU_PmuInit (void)
+{
+    Xpm_SetEvents(XPM_CNTRCFG12);                          /* Leaves the cycle counter running         */
+    XL2cc_EventCtrInit(XL2CC_DRHIT, XL2CC_DRREQ);
+    XL2cc_EventCtrStart();
+    OS_CPU_PmuCtrRd(OS_CPU_PmuStart);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        CHARGE THE EVENTS
+*
+* Description : Adds the increments of the counters since the last charge to 'pctrs' (dropped if NULL).
+*
+* Note(s)     : 1) Interrupts are disabled during this call.
+*               2) The PL310 counters saturate instead of wrapping: they are restarted at half range.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_PmuCharge (OS_CPU_PMU_CTRS *pctrs)
+{
+    INT32U  ctr[OS_CPU_PMU_NBR];
+    INT8U   i;
+
+
+    OS_CPU_PmuCtrRd(ctr);
+    for (i = 0; i < OS_CPU_PMU_NBR; i++) {
+        if (pctrs != (OS_CPU_PMU_CTRS *)0) {
+            pctrs->Ctr[i] += (INT32U)(ctr[i] - OS_CPU_PmuStart[i]);
+        }
+        OS_CPU_PmuStart[i] = ctr[i];
+    }
+    if (ctr[OS_CPU_PMU_L2_RD_REQ] >= 0x80000000u) {
+        XL2cc_EventCtrStart();                             /* Resets both counters                     */
+        OS_CPU_PmuStart[OS_CPU_PMU_L2_RD_HIT] = 0;
+        OS_CPU_PmuStart[OS_CPU_PMU_L2_RD_REQ] = 0;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          READ THE EVENTS
+*
+* Description : Copies the events counted for the task at OSTCBTbl[idx], or for the ISRs (OS_CPU_PMU_ISR).
+*               The running task is charged first, so that its counts are up to date.
+*********************************************************************************************************
+*/
+
+void  OS_CPU_PmuRd (INT8U idx, OS_CPU_PMU_CTRS *pctrs)
+{
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    if (idx == OS_CPU_PMU_ISR) {
+        *pctrs = OS_CPU_PmuIntTot;
+    } else {
+        if ((OSRunning == OS_TRUE) && (OSIntNesting == 0) && (&OSTCBTbl[idx] == OSTCBCur)) {
+            OS_CPU_PmuCharge(&OS_CPU_PmuTaskTbl[idx]);
+        }
+        *pctrs = OS_CPU_PmuTaskTbl[idx];
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                              PER CALL SITE INTERRUPT DISABLE TIME PROFILER
+*
+* Description : OS_ENTER_CRITICAL() passes its __FILE__ and __LINE__ to OS_CPU_IntDisProfStart().  Only the
+*               outermost critical section is timed; the time, in PMU cycles, is charged to the site that
+*               opened it.  Each site keeps a count, a maximum, a total and a log2 histogram.
+*
+* Note(s)     : 1) Sites are found by open addressing in OS_CPU_IntDisProfTbl[] AFTER the exit time stamp is
+*                  taken, so the lookup is not charged to the critical section.
+*               2) When the table is full, samples of new sites are counted in OS_CPU_IntDisProfLostCtr.
+*               3) With OS_CPU_INT_DIS_PROF_EN == 0, OS_ENTER_CRITICAL()/OS_EXIT_CRITICAL() are unchanged.
+*********************************************************************************************************
+*/
+
+#if OS_CPU_INT_DIS_PROF_EN > 0
+void  OS_CPU_IntDisProfInit (void)
+{
+    INT16U  i;
+
+
+    OS_CPU_IntDisProfReset();
+    OS_CPU_IntDisProfCycOvrhd = 0;
+    OS_CPU_IntDisProfStart(__FILE__, __LINE__);            /* Measure the overhead of the functions    */
+    OS_CPU_IntDisProfStop();
+    for (i = 0; i < OS_CPU_INT_DIS_PROF_SITES; i++) {      /* Only one site was recorded               */
+        OS_CPU_IntDisProfCycOvrhd += OS_CPU_IntDisProfTbl[i].CycMax;
+    }
+    OS_CPU_IntDisProfReset();
+}
+
+
+void  OS_CPU_IntDisProfReset (void)
+{
+    INT16U  i;
+    INT16U  j;
+
+
+    for (i = 0; i < OS_CPU_INT_DIS_PROF_SITES; i++) {
+        OS_CPU_IntDisProfTbl[i].File   = (const char *)0;
+        OS_CPU_IntDisProfTbl[i].Line   = 0;
+        OS_CPU_IntDisProfTbl[i].Ctr    = 0;
+        OS_CPU_IntDisProfTbl[i].CycMax = 0;
+        OS_CPU_IntDisProfTbl[i].CycTot = 0;
+        for (j = 0; j < OS_CPU_INT_DIS_PROF_BUCKETS; j++) {
+            OS_CPU_IntDisProfTbl[i].Hist[j] = 0;
+        }
+    }
+    OS_CPU_IntDisProfLostCtr = 0;
+}
+
+
+void  OS_CPU_IntDisProfStart (const char *file, INT32U line)
+{
+    OS_CPU_IntDisProfNestingCtr++;
+    if (OS_CPU_IntDisProfNestingCtr == 1) {                /* Only measure at the first nested level   */
+        OS_CPU_IntDisProfFile     = file;
+        OS_CPU_IntDisProfLine     = line;
+        OS_CPU_IntDisProfCycEnter = OS_CPU_CycCntRd();
+    }
+}
+
+
+void  OS_CPU_IntDisProfStop (void)
+{
+    OS_CPU_INT_DIS_SITE  *psite;
+    INT32U                cyc;
+    INT32U                ix;
+    INT32U                probe;
+    INT32U                bucket;
+
+
+    cyc = OS_CPU_CycCntRd() - OS_CPU_IntDisProfCycEnter;
+    OS_CPU_IntDisProfNestingCtr--;
+    if (OS_CPU_IntDisProfNestingCtr != 0) {
+        return;
+    }
+    if (cyc > OS_CPU_IntDisProfCycOvrhd) {                 /* Remove the overhead of the functions     */
+        cyc -= OS_CPU_IntDisProfCycOvrhd;
+    } else {
+        cyc  = 0;
+    }
+
+    ix = (((INT32U)OS_CPU_IntDisProfFile >> 2) ^ (OS_CPU_IntDisProfLine * 31u)) % OS_CPU_INT_DIS_PROF_SITES;
+    for (probe = 0; probe < OS_CPU_INT_DIS_PROF_SITES; probe++) {
+        psite = &OS_CPU_IntDisProfTbl[ix];
+        if (psite->File == (const char *)0) {              /* New site                                 */
+            psite->File = OS_CPU_IntDisProfFile;
+            psite->Line = OS_CPU_IntDisProfLine;
+            break;
+        }
+        if ((psite->File == OS_CPU_IntDisProfFile) &&
+            (psite->Line == OS_CPU_IntDisProfLine)) {
+            break;
+        }
+        ix++;
+        if (ix >= OS_CPU_INT_DIS_PROF_SITES) {
+            ix = 0;
+        }
+    }
+    if (probe == OS_CPU_INT_DIS_PROF_SITES) {              /* Table full                               */
+        OS_CPU_IntDisProfLostCtr++;
+        return;
+    }
+
+    psite->Ctr++;
+    psite->CycTot += cyc;
+    if (cyc > psite->CycMax) {
+        psite->CycMax = cyc;
+    }
+    bucket = 0;
+    cyc  >>= OS_CPU_INT_DIS_PROF_BUCKET_SHIFT;
+    while ((cyc != 0) && (bucket < (OS_CPU_INT_DIS_PROF_BUCKETS - 1))) {
+        cyc >>= 1;
+        bucket++;
+    }
+    psite->Hist[bucket]++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                    TOP INTERRUPT DISABLE OFFENDERS
+*
+* Description : This function returns the call sites with the longest interrupt disable times.
+*
+* Arguments   : psites      is an array where pointers to the sites are returned, longest first.
+*
+*               nbr_max     is the number of entries of 'psites'.
+*
+* Returns     : The number of sites returned in 'psites'.
+*
+* Note(s)     : 1) The sites keep being updated while they are read: copy them if consistency matters.
+*********************************************************************************************************
+*/
+
+INT8U  OS_CPU_IntDisProfTop (OS_CPU_INT_DIS_SITE **psites, INT8U nbr_max)
+{
+    OS_CPU_INT_DIS_SITE  *psite;
+    INT16U                i;
+    INT8U                 nbr;
+    INT8U                 j;
+
+
+    nbr = 0;
+    for (i = 0; i < OS_CPU_INT_DIS_PROF_SITES; i++) {      /* Insertion sort on CycMax, descending     */
+        psite = &OS_CPU_IntDisProfTbl[i];
+        if (psite->File == (const char *)0) {
+            continue;
+        }
+        j = nbr;
+        while ((j > 0) && (psites[j - 1]->CycMax < psite->CycMax)) {
+            if (j < nbr_max) {
+                psites[j] = psites[j - 1];
+            }
+            j--;
+        }
+        if (j < nbr_max) {
+            psites[j] = psite;
+            if (nbr < nbr_max) {
+                nbr++;
+            }
+        }
+    }
+    return (nbr);
+}
 #endif
 
 
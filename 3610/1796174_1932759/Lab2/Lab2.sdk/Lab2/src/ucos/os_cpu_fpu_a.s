@@ -26,6 +26,15 @@
 
     .global  OS_CPU_FP_Restore
     .global  OS_CPU_FP_Save
+    .global  OS_CPU_FP_En
+    .global  OS_CPU_FP_Dis
+    .global  OS_CPU_FP_IsEn
+
+@********************************************************************************************************
+@                                                EQUATES
+@********************************************************************************************************
+
+    .equ     OS_CPU_ARM_FPEXC_EN,              0x40000000       @ FPEXC.EN: VFP enabled.
 
 @********************************************************************************************************
 @                                      CODE GENERATION DIRECTIVES
@@ -49,7 +58,10 @@
 @*********************************************************************************************************
 
 OS_CPU_FP_Restore:
-        FLDMIAS R0!, {S0-S31}           @ Restore the VFP registers from pblk
+        VLDMIA  R0!, {D0-D15}           @ Restore the VFP registers from pblk
+        VLDMIA  R0!, {D16-D31}
+        LDR     R1, [R0]                @ Restore FPSCR
+        VMSR    FPSCR, R1
         BX      LR                      @ Return to calling function
 
 @*********************************************************************************************************
@@ -68,8 +80,38 @@ OS_CPU_FP_Restore:
 @*********************************************************************************************************
 
 OS_CPU_FP_Save:
-        FSTMIAS R0!, {S0-S31}           @ Save the VFP registers in pblk
+        VSTMIA  R0!, {D0-D15}           @ Save the VFP registers in pblk
+        VSTMIA  R0!, {D16-D31}
+        VMRS    R1, FPSCR               @ Save FPSCR
+        STR     R1, [R0]
         BX      LR                      @ Return to calling function
 
+@*********************************************************************************************************
+@                                       ENABLE/DISABLE THE VFP
+@                                   void   OS_CPU_FP_En  (void)
+@                                   void   OS_CPU_FP_Dis (void)
+@                                   INT32U OS_CPU_FP_IsEn(void)
+@
+@ Description : These functions set, clear and read FPEXC.EN.  While the VFP is disabled, VFP instructions
+@               raise an undefined instruction exception (see OS_CPU_FP_UndefHndlr()).
+@*********************************************************************************************************
+
+OS_CPU_FP_En:
+        VMRS    R0, FPEXC
+        ORR     R0, R0, #OS_CPU_ARM_FPEXC_EN
+        VMSR    FPEXC, R0
+        BX      LR
+
+OS_CPU_FP_Dis:
+        VMRS    R0, FPEXC
+        BIC     R0, R0, #OS_CPU_ARM_FPEXC_EN
+        VMSR    FPEXC, R0
+        BX      LR
+
+OS_CPU_FP_IsEn:
+        VMRS    R0, FPEXC
+        AND     R0, R0, #OS_CPU_ARM_FPEXC_EN
+        BX      LR
+
 
         .ltorg
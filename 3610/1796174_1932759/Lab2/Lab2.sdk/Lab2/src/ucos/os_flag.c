@@ -35,6 +35,13 @@
 static  void     OS_FlagBlock(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT32U timeout);
 static  BOOLEAN  OS_FlagTaskRdy(OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy);
 
+#if OS_FLAG_WAIT_IX_EN > 0u
+static  INT8U    OS_FlagBitLow(OS_FLAGS flags);
+static  void     OS_FlagIxLink(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode);
+static  void     OS_FlagIxUnlink(OS_FLAG_NODE *pnode);
+static  BOOLEAN  OS_FlagIxPost(OS_FLAG_GRP *pgrp, INT8U ix);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -215,6 +222,9 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS  flags,
                             INT8U    *perr)
 {
     OS_FLAG_GRP *pgrp;
+#if OS_FLAG_WAIT_IX_EN > 0u
+    INT8U        ix;
+#endif
 #if OS_CRITICAL_METHOD == 3u                        /* Allocate storage for CPU status register        */
     OS_CPU_SR    cpu_sr = 0u;
 #endif
@@ -245,6 +255,14 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS  flags,
         pgrp->OSFlagType     = OS_EVENT_TYPE_FLAG;  /* Set to event flag group type                    */
         pgrp->OSFlagFlags    = flags;               /* Set to desired initial value                    */
         pgrp->OSFlagWaitList = (void *)0;           /* Clear list of tasks waiting on flags            */
+#if OS_FLAG_WAIT_IX_EN > 0u
+        for (ix = 0u; ix < OS_FLAG_WAIT_IX_SIZE; ix++) {
+            pgrp->OSFlagWaitTbl[ix] = (void *)0;
+        }
+        pgrp->OSFlagWaitBits = (OS_FLAGS)0;
+        pgrp->OSFlagWaitAny  = (OS_FLAGS)0;
+        pgrp->OSFlagWaitClr  = (OS_FLAGS)0;
+#endif
 #if OS_FLAG_NAME_EN > 0u
         pgrp->OSFlagName     = (INT8U *)(void *)"?";
 #endif
@@ -808,6 +826,9 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
 *                            OS_ERR_FLAG_INVALID_PGRP   You passed a NULL pointer
 *                            OS_ERR_EVENT_TYPE          You are not pointing to an event flag group
 *                            OS_ERR_FLAG_INVALID_OPT    You specified an invalid option
+*                            OS_ERR_INT_Q_FULL          Called from an ISR while the ISR post queue is
+*                                                       full.  The other errors of a post made from an
+*                                                       ISR are only counted (see OS_IntQPost()).
 *
 * Returns    : the new value of the event flags bits that are still set.
 *
@@ -817,6 +838,15 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
 *                 flag group.
 *              2) The amount of time interrupts are DISABLED depends on the number of tasks waiting on
 *                 the event flag group.
+*
+* Note(s)    : 1) With OS_FLAG_WAIT_IX_EN, only the tasks that may become ready are looked at (see
+*                 OS_FlagIxLink()): the tasks in the lists of the bits set, plus the tasks waiting for ANY
+*                 of several bits when these overlap 'flags', or the tasks waiting for bits to be cleared
+*                 when 'opt' is OS_FLAG_CLR.  The cost of a post no longer grows with the tasks waiting
+*                 for other bits.
+*              2) As without the index, the bits changed by OSFlagAccept() or by OSFlagPend() consuming
+*                 them do not ready any task.  A task waiting for ALL bits set is however only looked at
+*                 again when the bit it is listed under is posted.
 *********************************************************************************************************
 */
 OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
@@ -824,11 +854,16 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
                       INT8U         opt,
                       INT8U        *perr)
 {
-    OS_FLAG_NODE *pnode;
     BOOLEAN       sched;
     OS_FLAGS      flags_cur;
+#if OS_FLAG_WAIT_IX_EN > 0u
+    OS_FLAGS      bits;
+    INT8U         ix;
+#else
+    OS_FLAG_NODE *pnode;
     OS_FLAGS      flags_rdy;
     BOOLEAN       rdy;
+#endif
 #if OS_CRITICAL_METHOD == 3u                         /* Allocate storage for CPU status register       */
     OS_CPU_SR     cpu_sr = 0u;
 #endif
@@ -851,6 +886,12 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                         /* Called from ISR, defer to ISR queue task       */
+        *perr = OS_IntQPost(OS_INT_Q_TYPE_FLAG_POST, (void *)pgrp, (void *)0, flags, opt);
+        return ((OS_FLAGS)0);
+    }
+#endif
 /*$PAGE*/
     OS_ENTER_CRITICAL();
     switch (opt) {
@@ -868,6 +909,31 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
              return ((OS_FLAGS)0);
     }
     sched = OS_FALSE;                                /* Indicate that we don't need rescheduling       */
+#if OS_FLAG_WAIT_IX_EN > 0u
+    if (opt == OS_FLAG_SET) {                        /* Only tasks waiting for a bit set can be ready  */
+        bits = (OS_FLAGS)(flags & pgrp->OSFlagWaitBits);
+        while (bits != (OS_FLAGS)0) {                /* Go through the lists of the bits just posted   */
+            ix    = OS_FlagBitLow(bits);
+            bits &= (OS_FLAGS)(bits - 1u);
+            if (OS_FlagIxPost(pgrp, ix) == OS_TRUE) {
+                sched = OS_TRUE;
+            }
+        }
+        if ((flags & pgrp->OSFlagWaitAny) != (OS_FLAGS)0) {
+            if (OS_FlagIxPost(pgrp, OS_FLAG_WAIT_IX_ANY) == OS_TRUE) {
+                sched = OS_TRUE;
+            }
+        }
+#if OS_FLAG_WAIT_CLR_EN > 0u
+    } else {                                         /* Only tasks waiting for a bit cleared           */
+        if ((flags & pgrp->OSFlagWaitClr) != (OS_FLAGS)0) {
+            if (OS_FlagIxPost(pgrp, OS_FLAG_WAIT_IX_CLR) == OS_TRUE) {
+                sched = OS_TRUE;
+            }
+        }
+#endif
+    }
+#else
     pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
     while (pnode != (OS_FLAG_NODE *)0) {             /* Go through all tasks waiting on event flag(s)  */
         switch (pnode->OSFlagNodeWaitType) {
@@ -919,6 +985,7 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *pgrp,
         }
         pnode = (OS_FLAG_NODE *)pnode->OSFlagNodeNext; /* Point to next task waiting for event flag(s) */
     }
+#endif
     OS_EXIT_CRITICAL();
     if (sched == OS_TRUE) {
         OS_Sched();
@@ -984,6 +1051,33 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP  *pgrp,
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     FIND LOWEST BIT SET IN EVENT FLAGS
+*
+* Description: This function is internal to uC/OS-II and returns the position of the lowest bit set.
+*
+* Arguments  : flags         is the bit pattern, which MUST NOT be 0.
+*
+* Returns    : The position of the lowest bit set (0 for bit 0).
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_WAIT_IX_EN > 0u
+static  INT8U  OS_FlagBitLow (OS_FLAGS  flags)
+{
+#if OS_FLAGS_NBITS == 64u
+    if ((INT32U)flags == 0u) {                            /* No bit set in the lower half               */
+        return ((INT8U)(32u + OS_CPU_CntTrailZeros((INT32U)(flags >> 32u))));
+    }
+#endif
+    return (OS_CPU_CntTrailZeros((INT32U)flags));
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1049,6 +1143,9 @@ static  void  OS_FlagBlock (OS_FLAG_GRP  *pgrp,
         pnode_next->OSFlagNodePrev = pnode;           /* No, link in doubly linked list                */
     }
     pgrp->OSFlagWaitList = (void *)pnode;
+#if OS_FLAG_WAIT_IX_EN > 0u
+    OS_FlagIxLink(pgrp, pnode);                       /* Also list node under the bit(s) it waits for  */
+#endif
 
     y            =  OSTCBCur->OSTCBY;                 /* Suspend current task until flag(s) received   */
     OSRdyTbl[y] &= (OS_PRIO)~OSTCBCur->OSTCBBitX;
@@ -1113,6 +1210,224 @@ void  OS_FlagInit (void)
 #endif
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               LIST EVENT FLAG NODE UNDER THE BIT(s) IT WAITS FOR
+*
+* Description: This function is internal to uC/OS-II and is used to add an event flag node to the list of
+*              OSFlagWaitTbl[] that OSFlagPost() looks at when the node's wait may be satisfied:
+*
+*                  OS_FLAG_WAIT_SET_ALL   the list of the lowest bit still cleared.  Setting any other bit
+*                                         cannot ready the task.
+*                  OS_FLAG_WAIT_SET_ANY   the list of the bit when waiting for a single bit, otherwise
+*                                         list OS_FLAG_WAIT_IX_ANY.
+*                  OS_FLAG_WAIT_CLR_xxx   list OS_FLAG_WAIT_IX_CLR.
+*
+* Arguments  : pgrp          is a pointer to the event flag group.
+*
+*              pnode         is a pointer to the node, with its flags and wait type already set.
+*
+* Returns    : none
+*
+* Called by  : OS_FlagBlock()   OS_FLAG.C
+*              OS_FlagIxPost()  OS_FLAG.C
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_WAIT_IX_EN > 0u
+static  void  OS_FlagIxLink (OS_FLAG_GRP   *pgrp,
+                             OS_FLAG_NODE  *pnode)
+{
+    OS_FLAGS       flags;
+    INT8U          ix;
+    OS_FLAG_NODE  *pnode_next;
+
+
+    flags = pnode->OSFlagNodeFlags;
+    switch (pnode->OSFlagNodeWaitType) {
+        case OS_FLAG_WAIT_SET_ALL:                        /* Wait for the first bit still missing       */
+             ix = OS_FlagBitLow((OS_FLAGS)(flags & (OS_FLAGS)~pgrp->OSFlagFlags));
+             break;
+
+        case OS_FLAG_WAIT_SET_ANY:
+             if ((flags != (OS_FLAGS)0) && ((flags & (OS_FLAGS)(flags - 1u)) == (OS_FLAGS)0)) {
+                 ix = OS_FlagBitLow(flags);               /* A single bit                               */
+             } else {
+                 ix                   = OS_FLAG_WAIT_IX_ANY;
+                 pgrp->OSFlagWaitAny |= flags;
+             }
+             break;
+
+        default:
+             ix                   = OS_FLAG_WAIT_IX_CLR;
+             pgrp->OSFlagWaitClr |= flags;
+             break;
+    }
+    if (ix < OS_FLAGS_NBITS) {
+        pgrp->OSFlagWaitBits |= (OS_FLAGS)((OS_FLAGS)1 << ix);
+    }
+    pnode->OSFlagNodeIx     = ix;                         /* Add node at beginning of the list          */
+    pnode->OSFlagNodeIxNext = pgrp->OSFlagWaitTbl[ix];
+    pnode->OSFlagNodeIxPrev = (void *)0;
+    pnode_next              = (OS_FLAG_NODE *)pgrp->OSFlagWaitTbl[ix];
+    if (pnode_next != (OS_FLAG_NODE *)0) {
+        pnode_next->OSFlagNodeIxPrev = pnode;
+    }
+    pgrp->OSFlagWaitTbl[ix] = (void *)pnode;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 READY TASKS OF ONE LIST OF THE EVENT FLAG INDEX
+*
+* Description: This function is internal to uC/OS-II and is used by OSFlagPost() to check the waits of the
+*              nodes in list 'ix' of OSFlagWaitTbl[] against the new value of the flags.
+*
+* Arguments  : pgrp          is a pointer to the event flag group.
+*
+*              ix            is the list to go through.
+*
+* Returns    : OS_TRUE       If a task has been placed in the ready list and thus needs scheduling
+*              OS_FALSE      Otherwise
+*
+* Called by  : OSFlagPost()  OS_FLAG.C
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) The list of a bit is only gone through once the bit is set: its OS_FLAG_WAIT_SET_ALL
+*                 nodes not ready yet move to the list of their next missing bit, which empties it.
+*              3) Lists OS_FLAG_WAIT_IX_ANY and OS_FLAG_WAIT_IX_CLR are summarized by OSFlagWaitAny and
+*                 OSFlagWaitClr.  These are recomputed here and only grow elsewhere.
+*              4) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_WAIT_IX_EN > 0u
+static  BOOLEAN  OS_FlagIxPost (OS_FLAG_GRP  *pgrp,
+                                INT8U         ix)
+{
+    OS_FLAG_NODE *pnode;
+    OS_FLAG_NODE *pnode_next;
+    OS_FLAGS      flags_rdy;
+    OS_FLAGS      flags_left;
+    BOOLEAN       rdy;
+    BOOLEAN       sched;
+
+
+    sched      = OS_FALSE;
+    flags_left = (OS_FLAGS)0;
+    pnode      = (OS_FLAG_NODE *)pgrp->OSFlagWaitTbl[ix];
+    while (pnode != (OS_FLAG_NODE *)0) {
+        pnode_next = (OS_FLAG_NODE *)pnode->OSFlagNodeIxNext;  /* Node may leave the list          */
+        switch (pnode->OSFlagNodeWaitType) {
+            case OS_FLAG_WAIT_SET_ALL:                    /* See if all req. flags are set              */
+                 flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                 rdy       = (flags_rdy == pnode->OSFlagNodeFlags) ? OS_TRUE : OS_FALSE;
+                 break;
+
+            case OS_FLAG_WAIT_SET_ANY:                    /* See if any flag set                        */
+                 flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                 rdy       = (flags_rdy != (OS_FLAGS)0) ? OS_TRUE : OS_FALSE;
+                 break;
+
+#if OS_FLAG_WAIT_CLR_EN > 0u
+            case OS_FLAG_WAIT_CLR_ALL:                    /* See if all req. flags are cleared          */
+                 flags_rdy = (OS_FLAGS)~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags;
+                 rdy       = (flags_rdy == pnode->OSFlagNodeFlags) ? OS_TRUE : OS_FALSE;
+                 break;
+
+            case OS_FLAG_WAIT_CLR_ANY:                    /* See if any flag cleared                    */
+                 flags_rdy = (OS_FLAGS)~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags;
+                 rdy       = (flags_rdy != (OS_FLAGS)0) ? OS_TRUE : OS_FALSE;
+                 break;
+#endif
+
+            default:
+                 flags_rdy = (OS_FLAGS)0;
+                 rdy       = OS_FALSE;
+                 break;
+        }
+        if (rdy == OS_TRUE) {
+            if (OS_FlagTaskRdy(pnode, flags_rdy) == OS_TRUE) {  /* Make task RTR, event(s) Rx'd    */
+                sched = OS_TRUE;
+            }
+        } else if (ix < OS_FLAGS_NBITS) {                 /* Wait for the next missing bit              */
+            OS_FlagIxUnlink(pnode);
+            OS_FlagIxLink(pgrp, pnode);
+        } else {
+            flags_left |= pnode->OSFlagNodeFlags;
+        }
+        pnode = pnode_next;
+    }
+    if (ix == OS_FLAG_WAIT_IX_ANY) {
+        pgrp->OSFlagWaitAny = flags_left;
+    } else if (ix == OS_FLAG_WAIT_IX_CLR) {
+        pgrp->OSFlagWaitClr = flags_left;
+    } else {
+        ;
+    }
+    return (sched);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              UNLINK EVENT FLAG NODE FROM THE LIST OF ITS BIT(s)
+*
+* Description: This function is internal to uC/OS-II and is used to remove an event flag node from its
+*              list of OSFlagWaitTbl[].
+*
+* Arguments  : pnode         is a pointer to the node.
+*
+* Returns    : none
+*
+* Called by  : OS_FlagIxPost()  OS_FLAG.C
+*              OS_FlagUnlink()  OS_FLAG.C
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_FLAG_WAIT_IX_EN > 0u
+static  void  OS_FlagIxUnlink (OS_FLAG_NODE *pnode)
+{
+    OS_FLAG_GRP  *pgrp;
+    OS_FLAG_NODE *pnode_prev;
+    OS_FLAG_NODE *pnode_next;
+    INT8U         ix;
+
+
+    pgrp       = (OS_FLAG_GRP  *)pnode->OSFlagNodeFlagGrp;
+    ix         = pnode->OSFlagNodeIx;
+    pnode_prev = (OS_FLAG_NODE *)pnode->OSFlagNodeIxPrev;
+    pnode_next = (OS_FLAG_NODE *)pnode->OSFlagNodeIxNext;
+    if (pnode_prev == (OS_FLAG_NODE *)0) {                      /* Is it first node in the list?       */
+        pgrp->OSFlagWaitTbl[ix] = (void *)pnode_next;
+        if (pnode_next != (OS_FLAG_NODE *)0) {
+            pnode_next->OSFlagNodeIxPrev = (OS_FLAG_NODE *)0;
+        } else if (ix < OS_FLAGS_NBITS) {                       /* List of the bit now empty           */
+            pgrp->OSFlagWaitBits &= (OS_FLAGS)~((OS_FLAGS)1 << ix);
+        } else if (ix == OS_FLAG_WAIT_IX_ANY) {
+            pgrp->OSFlagWaitAny   = (OS_FLAGS)0;
+        } else {
+            pgrp->OSFlagWaitClr   = (OS_FLAGS)0;
+        }
+    } else {
+        pnode_prev->OSFlagNodeIxNext = pnode_next;
+        if (pnode_next != (OS_FLAG_NODE *)0) {
+            pnode_next->OSFlagNodeIxPrev = pnode_prev;
+        }
+    }
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1206,6 +1521,9 @@ void  OS_FlagUnlink (OS_FLAG_NODE *pnode)
             pnode_next->OSFlagNodePrev = pnode_prev;            /*      No, Link around current node   */
         }
     }
+#if OS_FLAG_WAIT_IX_EN > 0u
+    OS_FlagIxUnlink(pnode);
+#endif
 #if OS_TASK_DEL_EN > 0u
     ptcb                = (OS_TCB *)pnode->OSFlagNodeTCB;
     ptcb->OSTCBFlagNode = (OS_FLAG_NODE *)0;
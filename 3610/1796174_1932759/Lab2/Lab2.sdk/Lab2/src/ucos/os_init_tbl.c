@@ -0,0 +1,222 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                  STATICALLY INITIALIZED KERNEL TABLES
+*
+* File    : OS_INIT_TBL.C
+* Version : V2.91
+*
+* Generated by tools/os_init_gen.py from OS_CFG_R.H, DO NOT EDIT.
+*
+* The free lists built by OS_InitTCBList(), OS_InitEventList(), OS_FlagInit(), OS_QInit() and OS_PQInit()
+* when OS_INIT_STATIC_EN is 0, placed in .data so that OSInit() does not have to build them.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_INIT_STATIC_EN > 0u
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    FREE LIST OF TASK CONTROL BLOCKS
+*********************************************************************************************************
+*/
+
+#if (OS_MAX_TASKS + OS_N_SYS_TASKS) != 22u
+#error  "OS_INIT_TBL.C, OS_MAX_TASKS or OS_TASK_STAT_EN changed: run tools/os_init_gen.py"
+#endif
+
+#if OS_TASK_NAME_EN > 0u
+#define  OS_INIT_TCB(next)    { .OSTCBNext = (next), .OSTCBTaskName = (INT8U *)(void *)"?" }
+#else
+#define  OS_INIT_TCB(next)    { .OSTCBNext = (next) }
+#endif
+
+OS_TCB    OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS] = {
+    OS_INIT_TCB(&OSTCBTbl[1]),
+    OS_INIT_TCB(&OSTCBTbl[2]),
+    OS_INIT_TCB(&OSTCBTbl[3]),
+    OS_INIT_TCB(&OSTCBTbl[4]),
+    OS_INIT_TCB(&OSTCBTbl[5]),
+    OS_INIT_TCB(&OSTCBTbl[6]),
+    OS_INIT_TCB(&OSTCBTbl[7]),
+    OS_INIT_TCB(&OSTCBTbl[8]),
+    OS_INIT_TCB(&OSTCBTbl[9]),
+    OS_INIT_TCB(&OSTCBTbl[10]),
+    OS_INIT_TCB(&OSTCBTbl[11]),
+    OS_INIT_TCB(&OSTCBTbl[12]),
+    OS_INIT_TCB(&OSTCBTbl[13]),
+    OS_INIT_TCB(&OSTCBTbl[14]),
+    OS_INIT_TCB(&OSTCBTbl[15]),
+    OS_INIT_TCB(&OSTCBTbl[16]),
+    OS_INIT_TCB(&OSTCBTbl[17]),
+    OS_INIT_TCB(&OSTCBTbl[18]),
+    OS_INIT_TCB(&OSTCBTbl[19]),
+    OS_INIT_TCB(&OSTCBTbl[20]),
+    OS_INIT_TCB(&OSTCBTbl[21]),
+    OS_INIT_TCB((OS_TCB *)0)
+};
+
+OS_TCB   *OSTCBFreeList = &OSTCBTbl[0];
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   FREE LIST OF EVENT CONTROL BLOCKS
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+#if (OS_MAX_EVENTS) != 50u
+#error  "OS_INIT_TBL.C, OS_MAX_EVENTS changed: run tools/os_init_gen.py"
+#endif
+
+#if OS_EVENT_NAME_EN > 0u
+#define  OS_INIT_EVENT(next)  { .OSEventPtr = (next), .OSEventName = (INT8U *)(void *)"?" }
+#else
+#define  OS_INIT_EVENT(next)  { .OSEventPtr = (next) }
+#endif
+
+OS_EVENT  OSEventTbl[OS_MAX_EVENTS] = {
+    OS_INIT_EVENT(&OSEventTbl[1]),
+    OS_INIT_EVENT(&OSEventTbl[2]),
+    OS_INIT_EVENT(&OSEventTbl[3]),
+    OS_INIT_EVENT(&OSEventTbl[4]),
+    OS_INIT_EVENT(&OSEventTbl[5]),
+    OS_INIT_EVENT(&OSEventTbl[6]),
+    OS_INIT_EVENT(&OSEventTbl[7]),
+    OS_INIT_EVENT(&OSEventTbl[8]),
+    OS_INIT_EVENT(&OSEventTbl[9]),
+    OS_INIT_EVENT(&OSEventTbl[10]),
+    OS_INIT_EVENT(&OSEventTbl[11]),
+    OS_INIT_EVENT(&OSEventTbl[12]),
+    OS_INIT_EVENT(&OSEventTbl[13]),
+    OS_INIT_EVENT(&OSEventTbl[14]),
+    OS_INIT_EVENT(&OSEventTbl[15]),
+    OS_INIT_EVENT(&OSEventTbl[16]),
+    OS_INIT_EVENT(&OSEventTbl[17]),
+    OS_INIT_EVENT(&OSEventTbl[18]),
+    OS_INIT_EVENT(&OSEventTbl[19]),
+    OS_INIT_EVENT(&OSEventTbl[20]),
+    OS_INIT_EVENT(&OSEventTbl[21]),
+    OS_INIT_EVENT(&OSEventTbl[22]),
+    OS_INIT_EVENT(&OSEventTbl[23]),
+    OS_INIT_EVENT(&OSEventTbl[24]),
+    OS_INIT_EVENT(&OSEventTbl[25]),
+    OS_INIT_EVENT(&OSEventTbl[26]),
+    OS_INIT_EVENT(&OSEventTbl[27]),
+    OS_INIT_EVENT(&OSEventTbl[28]),
+    OS_INIT_EVENT(&OSEventTbl[29]),
+    OS_INIT_EVENT(&OSEventTbl[30]),
+    OS_INIT_EVENT(&OSEventTbl[31]),
+    OS_INIT_EVENT(&OSEventTbl[32]),
+    OS_INIT_EVENT(&OSEventTbl[33]),
+    OS_INIT_EVENT(&OSEventTbl[34]),
+    OS_INIT_EVENT(&OSEventTbl[35]),
+    OS_INIT_EVENT(&OSEventTbl[36]),
+    OS_INIT_EVENT(&OSEventTbl[37]),
+    OS_INIT_EVENT(&OSEventTbl[38]),
+    OS_INIT_EVENT(&OSEventTbl[39]),
+    OS_INIT_EVENT(&OSEventTbl[40]),
+    OS_INIT_EVENT(&OSEventTbl[41]),
+    OS_INIT_EVENT(&OSEventTbl[42]),
+    OS_INIT_EVENT(&OSEventTbl[43]),
+    OS_INIT_EVENT(&OSEventTbl[44]),
+    OS_INIT_EVENT(&OSEventTbl[45]),
+    OS_INIT_EVENT(&OSEventTbl[46]),
+    OS_INIT_EVENT(&OSEventTbl[47]),
+    OS_INIT_EVENT(&OSEventTbl[48]),
+    OS_INIT_EVENT(&OSEventTbl[49]),
+    OS_INIT_EVENT((OS_EVENT *)0)
+};
+
+OS_EVENT *OSEventFreeList = &OSEventTbl[0];
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     FREE LIST OF EVENT FLAG GROUPS
+*********************************************************************************************************
+*/
+
+#if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
+#if (OS_MAX_FLAGS) != 5u
+#error  "OS_INIT_TBL.C, OS_MAX_FLAGS changed: run tools/os_init_gen.py"
+#endif
+
+#if OS_FLAG_NAME_EN > 0u
+#define  OS_INIT_FLAG(next)   { .OSFlagWaitList = (next), .OSFlagName = (INT8U *)(void *)"?" }
+#else
+#define  OS_INIT_FLAG(next)   { .OSFlagWaitList = (next) }
+#endif
+
+OS_FLAG_GRP  OSFlagTbl[OS_MAX_FLAGS] = {
+    OS_INIT_FLAG(&OSFlagTbl[1]),
+    OS_INIT_FLAG(&OSFlagTbl[2]),
+    OS_INIT_FLAG(&OSFlagTbl[3]),
+    OS_INIT_FLAG(&OSFlagTbl[4]),
+    OS_INIT_FLAG((void *)0)
+};
+
+OS_FLAG_GRP *OSFlagFreeList = &OSFlagTbl[0];
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   FREE LIST OF QUEUE CONTROL BLOCKS
+*********************************************************************************************************
+*/
+
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+#if (OS_MAX_QS) != 10u
+#error  "OS_INIT_TBL.C, OS_MAX_QS changed: run tools/os_init_gen.py"
+#endif
+
+#define  OS_INIT_Q(next)      { .OSQPtr = (next) }
+
+OS_Q      OSQTbl[OS_MAX_QS] = {
+    OS_INIT_Q(&OSQTbl[1]),
+    OS_INIT_Q(&OSQTbl[2]),
+    OS_INIT_Q(&OSQTbl[3]),
+    OS_INIT_Q(&OSQTbl[4]),
+    OS_INIT_Q(&OSQTbl[5]),
+    OS_INIT_Q(&OSQTbl[6]),
+    OS_INIT_Q(&OSQTbl[7]),
+    OS_INIT_Q(&OSQTbl[8]),
+    OS_INIT_Q(&OSQTbl[9]),
+    OS_INIT_Q((OS_Q *)0)
+};
+
+OS_Q     *OSQFreeList = &OSQTbl[0];
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               FREE LIST OF PRIORITY QUEUE CONTROL BLOCKS
+*********************************************************************************************************
+*/
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+#if (OS_MAX_PQS) != 2u
+#error  "OS_INIT_TBL.C, OS_MAX_PQS changed: run tools/os_init_gen.py"
+#endif
+
+#define  OS_INIT_PQ(next)     { .OSPQPtr = (next) }
+
+OS_PQ     OSPQTbl[OS_MAX_PQS] = {
+    OS_INIT_PQ(&OSPQTbl[1]),
+    OS_INIT_PQ((OS_PQ *)0)
+};
+
+OS_PQ    *OSPQFreeList = &OSPQTbl[0];
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                          DEFERRED ISR POSTS
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_INT_Q.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_ISR_POST_DEFERRED_EN > 0u
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q  *pentry);
+
+static  void  OS_IntQTask   (void      *p_arg);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 DEFERRED ISR POSTS INITIALIZATION
+*
+* Description: This function is called by OSInit() to initialize the ISR post queue and to create the
+*              task that replays the posts.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) OS_TASK_INT_Q_PRIO MUST be the highest priority used so that deferred posts are
+*                 replayed before any other task runs.
+*********************************************************************************************************
+*/
+
+void  OS_IntQInit (void)
+{
+#if OS_TASK_NAME_EN > 0u
+    INT8U  err;
+#endif
+
+
+    OS_MemClr((INT8U *)&OSIntQTbl[0], sizeof(OSIntQTbl));  /* Clear the ISR post queue                 */
+    OSIntQIn            = 0u;
+    OSIntQOut           = 0u;
+    OSIntQNbrEntriesMax = 0u;
+    OSIntQOvfCtr        = 0u;
+    OS_MemClr((INT8U *)&OSIntQErrCtr[0], sizeof(OSIntQErrCtr));
+    OSIntQErrLast       = OS_ERR_NONE;
+
+#if OS_TASK_CREATE_EXT_EN > 0u
+    #if OS_STK_GROWTH == 1u
+    (void)OSTaskCreateExt(OS_IntQTask,
+                          (void *)0,                                       /* No arguments passed to OS_IntQTask()    */
+                          &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1u],     /* Set Top-Of-Stack                        */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSIntQTaskStk[0],                               /* Set Bottom-Of-Stack                     */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                        */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack     */
+    #else
+    (void)OSTaskCreateExt(OS_IntQTask,
+                          (void *)0,                                       /* No arguments passed to OS_IntQTask()    */
+                          &OSIntQTaskStk[0],                               /* Set Top-Of-Stack                        */
+                          OS_TASK_INT_Q_PRIO,
+                          OS_TASK_INT_Q_ID,
+                          &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1u],     /* Set Bottom-Of-Stack                     */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                        */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack     */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1u
+    (void)OSTaskCreate(OS_IntQTask,
+                       (void *)0,
+                       &OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE - 1u],
+                       OS_TASK_INT_Q_PRIO);
+    #else
+    (void)OSTaskCreate(OS_IntQTask,
+                       (void *)0,
+                       &OSIntQTaskStk[0],
+                       OS_TASK_INT_Q_PRIO);
+    #endif
+#endif
+
+#if OS_TASK_NAME_EN > 0u
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)(void *)"uC/OS-II ISR Q", &err);
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   QUEUE A POST MADE FROM AN ISR
+*
+* Description: This function is called by OSSemPost(), OSQPost(), OSQPostFront(), OSQPostOpt(),
+*              OSMboxPost(), OSMboxPostOpt() and OSFlagPost() when they are called from an ISR.  Instead
+*              of updating the kernel objects with interrupts disabled, the request is stored in the ISR
+*              post queue and replayed by OS_IntQTask() once all ISRs have completed.
+*
+* Arguments  : type          is the kind of post to replay (see OS_INT_Q_TYPE_xxx).
+*
+*              pobj          is a pointer to the event control block or to the event flag group.
+*
+*              pmsg          is the message to post (queues and mailboxes only).
+*
+*              flags         are the flags to post (event flag groups only).
+*
+*              opt           are the options of the post (xxxPostOpt() and OSFlagPost() only).
+*
+* Returns    : OS_ERR_NONE          the post was queued.
+*              OS_ERR_INT_Q_FULL    the ISR post queue is full, the post is lost.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) No critical section is used: a slot is reserved with an atomic compare-and-swap
+*                 (LDREX/STREX) on OSIntQIn so that nested ISRs never share a slot.  OS_IntQTask() only
+*                 runs once all ISRs are done, so every reserved slot has been written when it is read.
+*              3) uC/OS-II only runs on one CPU, hence a single queue.
+*              4) The post itself only happens when it is replayed, so an ISR never gets its result: a
+*                 post to a full queue or mailbox, or a semaphore overflow, still returns OS_ERR_NONE to
+*                 the ISR.  OS_IntQTask() counts these failures per type of post in OSIntQErrCtr[] and
+*                 keeps the last error code in OSIntQErrLast.
+*********************************************************************************************************
+*/
+
+INT8U  OS_IntQPost (INT8U            type,
+                    void            *pobj,
+                    void            *pmsg,
+                    OS_INT_Q_FLAGS   flags,
+                    INT8U            opt)
+{
+    OS_INT_Q  *pentry;
+    INT16U     in;
+    INT16U     in_next;
+    INT16U     nbr_entries;
+
+
+    do {                                                   /* Reserve a slot                           */
+        in      = OSIntQIn;
+        in_next = in + 1u;
+        if (in_next >= OS_INT_Q_SIZE) {                    /* Wrap IN index                            */
+            in_next = 0u;
+        }
+        if (in_next == OSIntQOut) {                        /* Queue full?                              */
+            OSIntQOvfCtr++;
+            return (OS_ERR_INT_Q_FULL);
+        }
+    } while (__sync_bool_compare_and_swap(&OSIntQIn, in, in_next) == 0);
+
+    pentry               = &OSIntQTbl[in];
+    pentry->OSIntQType   = type;
+    pentry->OSIntQOpt    = opt;
+    pentry->OSIntQObjPtr = pobj;
+    pentry->OSIntQMsgPtr = pmsg;
+    pentry->OSIntQFlags  = flags;
+    __sync_synchronize();                                  /* Entry written before the task reads it   */
+
+    if (in_next >= OSIntQOut) {                            /* Track the maximum queue depth            */
+        nbr_entries = in_next - OSIntQOut;
+    } else {
+        nbr_entries = OS_INT_Q_SIZE - OSIntQOut + in_next;
+    }
+    if (nbr_entries > OSIntQNbrEntriesMax) {
+        OSIntQNbrEntriesMax = nbr_entries;
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   READY THE ISR POST QUEUE TASK
+*
+* Description: This function is called by OSIntExit() when the last nested ISR completes.  If posts were
+*              queued, the ISR post queue task is made ready so that the scheduler switches to it.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_IntQTaskRdy (void)
+{
+    OS_TCB  *ptcb;
+
+
+    if (OSIntQIn == OSIntQOut) {                           /* Nothing to replay                        */
+        return;
+    }
+    ptcb = OSTCBPrioTbl[OS_TASK_INT_Q_PRIO];
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) != OS_STAT_RDY) {   /* Task waiting for posts?             */
+        ptcb->OSTCBStat         &= (INT8U)~OS_STAT_SUSPEND;
+        OSRdyGrp                |= ptcb->OSTCBBitY;        /* Make task ready to run                   */
+        OSRdyTbl[ptcb->OSTCBY]  |= ptcb->OSTCBBitX;
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       ISR POST QUEUE TASK
+*
+* Description: This task replays, in order, the posts queued by ISRs and sleeps when the queue is empty.
+*
+* Arguments  : p_arg         is not used.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Each post is replayed with interrupts enabled between posts, so the interrupt disable
+*                 time no longer includes OS_EventTaskRdy() running in ISR context.
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQTask (void *p_arg)
+{
+    OS_INT_Q   entry;
+    INT16U     out;
+    INT8U      y;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    p_arg = p_arg;                                         /* Prevent compiler warning                 */
+    for (;;) {
+        while (OSIntQOut != OSIntQIn) {                    /* Replay the queued posts                  */
+            out   = OSIntQOut;
+            entry = OSIntQTbl[out];
+            __sync_synchronize();                          /* Entry read before the slot is released   */
+            out++;
+            if (out >= OS_INT_Q_SIZE) {                    /* Wrap OUT index                           */
+                out = 0u;
+            }
+            OSIntQOut = out;
+            OS_IntQRePost(&entry);
+        }
+        OS_ENTER_CRITICAL();
+        if (OSIntQOut == OSIntQIn) {                       /* Sleep until the next ISR post            */
+            y            =  OSTCBCur->OSTCBY;
+            OSRdyTbl[y] &= (OS_PRIO)~OSTCBCur->OSTCBBitX;
+            if (OSRdyTbl[y] == 0u) {
+                OSRdyGrp &= (OS_PRIO)~OSTCBCur->OSTCBBitY;
+            }
+            OSTCBCur->OSTCBStat |= OS_STAT_SUSPEND;
+            OS_EXIT_CRITICAL();
+            OS_Sched();                                    /* Find next highest priority task ready    */
+        } else {
+            OS_EXIT_CRITICAL();
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       REPLAY A QUEUED POST
+*
+* Description: This function performs the post described by an ISR post queue entry.
+*
+* Arguments  : pentry        is a pointer to a copy of the queue entry.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Errors are the same as for a direct post.  They can no longer be reported to the ISR
+*                 and are counted in OSIntQErrCtr[] instead.
+*********************************************************************************************************
+*/
+
+static  void  OS_IntQRePost (OS_INT_Q *pentry)
+{
+    INT8U  err;
+
+
+    err = OS_ERR_NONE;
+
+
+    switch (pentry->OSIntQType) {
+#if OS_SEM_EN > 0u
+        case OS_INT_Q_TYPE_SEM_POST:
+             err = OSSemPost((OS_EVENT *)pentry->OSIntQObjPtr);
+             break;
+#endif
+
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+#if OS_Q_POST_EN > 0u
+        case OS_INT_Q_TYPE_Q_POST:
+             err = OSQPost((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr);
+             break;
+#endif
+
+#if OS_Q_POST_FRONT_EN > 0u
+        case OS_INT_Q_TYPE_Q_POST_FRONT:
+             err = OSQPostFront((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr);
+             break;
+#endif
+
+#if OS_Q_POST_OPT_EN > 0u
+        case OS_INT_Q_TYPE_Q_POST_OPT:
+             err = OSQPostOpt((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr, pentry->OSIntQOpt);
+             break;
+#endif
+#endif
+
+#if OS_MBOX_EN > 0u
+#if OS_MBOX_POST_EN > 0u
+        case OS_INT_Q_TYPE_MBOX_POST:
+             err = OSMboxPost((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr);
+             break;
+#endif
+
+#if OS_MBOX_POST_OPT_EN > 0u
+        case OS_INT_Q_TYPE_MBOX_POST_OPT:
+             err = OSMboxPostOpt((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr, pentry->OSIntQOpt);
+             break;
+#endif
+#endif
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+        case OS_INT_Q_TYPE_PQ_POST:
+             err = OSPQPost((OS_EVENT *)pentry->OSIntQObjPtr, pentry->OSIntQMsgPtr, pentry->OSIntQOpt);
+             break;
+#endif
+
+#if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
+        case OS_INT_Q_TYPE_FLAG_POST:
+             (void)OSFlagPost((OS_FLAG_GRP *)pentry->OSIntQObjPtr, (OS_FLAGS)pentry->OSIntQFlags,
+                              pentry->OSIntQOpt, &err);
+             break;
+#endif
+
+        default:
+             break;
+    }
+    if (err != OS_ERR_NONE) {                              /* Count the posts that failed              */
+        OSIntQErrCtr[pentry->OSIntQType]++;
+        OSIntQErrLast = err;
+    }
+}
+#endif                                                     /* OS_ISR_POST_DEFERRED_EN                  */
@@ -201,6 +201,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT  *pevent,
              if (tasks_waiting == OS_FALSE) {
 #if OS_EVENT_NAME_EN > 0u
                  pevent->OSEventName = (INT8U *)(void *)"?";
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+                 OS_EventSetUnlink(pevent);                /* Remove mailbox from its event set        */
 #endif
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
@@ -222,6 +225,9 @@ OS_EVENT  *OSMboxDel (OS_EVENT  *pevent,
              }
 #if OS_EVENT_NAME_EN > 0u
              pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+             OS_EventSetUnlink(pevent);                    /* Remove mailbox from its event set        */
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -325,6 +331,7 @@ void  *OSMboxPend (OS_EVENT  *pevent,
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+    OS_TRACE(OS_TRACE_TYPE_MBOX_PEND, pevent);
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
@@ -464,6 +471,8 @@ INT8U  OSMboxPendAbort (OS_EVENT  *pevent,
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while the ISR post queue is full.
+*                                   Other errors of ISR posts are only counted (see OS_IntQPost()).
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *********************************************************************************************************
@@ -490,6 +499,12 @@ INT8U  OSMboxPost (OS_EVENT  *pevent,
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                          /* Called from ISR, defer to ISR queue task      */
+        return (OS_IntQPost(OS_INT_Q_TYPE_MBOX_POST, (void *)pevent, pmsg, 0u, 0u));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_MBOX_POST, pevent);
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0u) {                   /* See if any task pending on mailbox            */
                                                       /* Ready HPT waiting on event                    */
@@ -503,6 +518,13 @@ INT8U  OSMboxPost (OS_EVENT  *pevent,
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    if (OS_EventSetSignal(pevent) == OS_TRUE) {       /* Ready task pending on event set               */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -533,6 +555,8 @@ INT8U  OSMboxPost (OS_EVENT  *pevent,
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while the ISR post queue is full.
+*                                   Other errors of ISR posts are only counted (see OS_IntQPost()).
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *
@@ -563,6 +587,12 @@ INT8U  OSMboxPostOpt (OS_EVENT  *pevent,
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                          /* Called from ISR, defer to ISR queue task      */
+        return (OS_IntQPost(OS_INT_Q_TYPE_MBOX_POST_OPT, (void *)pevent, pmsg, 0u, opt));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_MBOX_POST, pevent);
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0u) {                   /* See if any task pending on mailbox            */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00u) { /* Do we need to post msg to ALL waiting tasks ? */
@@ -583,6 +613,15 @@ INT8U  OSMboxPostOpt (OS_EVENT  *pevent,
         return (OS_ERR_MBOX_FULL);
     }
     pevent->OSEventPtr = pmsg;                        /* Place message in mailbox                      */
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    if (OS_EventSetSignal(pevent) == OS_TRUE) {       /* Ready task pending on event set               */
+        OS_EXIT_CRITICAL();
+        if ((opt & OS_POST_OPT_NO_SCHED) == 0u) {     /* See if scheduler needs to be invoked          */
+            OS_Sched();                               /* Find highest priority task ready to run       */
+        }
+        return (OS_ERR_NONE);
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -46,6 +46,10 @@
 */
 
 static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
+#if OS_SCHED_RR_EN > 0u
+static  void  OSMutex_OwnerLink(OS_EVENT *pevent, OS_TCB *ptcb);
+static  void  OSMutex_OwnerUnlink(OS_EVENT *pevent);
+#endif
 
 /*$PAGE*/
 /*
@@ -118,6 +122,9 @@ BOOLEAN  OSMutexAccept (OS_EVENT  *pevent,
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;   /*      Mask off LSByte (Acquire Mutex)         */
         pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;     /*      Save current task priority in LSByte    */
         pevent->OSEventPtr  = (void *)OSTCBCur;        /*      Link TCB of task owning Mutex           */
+#if OS_SCHED_RR_EN > 0u
+        OSMutex_OwnerLink(pevent, OSTCBCur);
+#endif
         if (OSTCBCur->OSTCBPrio <= pip) {              /*      PIP 'must' have a SMALLER prio ...      */
             OS_EXIT_CRITICAL();                        /*      ... than current task!                  */
             *perr = OS_ERR_PIP_LOWER;
@@ -313,6 +320,9 @@ OS_EVENT  *OSMutexDel (OS_EVENT  *pevent,
     switch (opt) {
         case OS_DEL_NO_PEND:                               /* DELETE MUTEX ONLY IF NO TASK WAITING --- */
              if (tasks_waiting == OS_FALSE) {
+#if OS_SCHED_RR_EN > 0u
+                 OSMutex_OwnerUnlink(pevent);
+#endif
 #if OS_EVENT_NAME_EN > 0u
                  pevent->OSEventName = (INT8U *)(void *)"?";
 #endif
@@ -341,6 +351,9 @@ OS_EVENT  *OSMutexDel (OS_EVENT  *pevent,
                      OSMutex_RdyAtPrio(ptcb, prio);        /* Yes, Restore the task's original prio    */
                  }
              }
+#if OS_SCHED_RR_EN > 0u
+             OSMutex_OwnerUnlink(pevent);
+#endif
              while (pevent->OSEventGrp != 0u) {            /* Ready ALL tasks waiting for mutex        */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
              }
@@ -461,6 +474,9 @@ void  OSMutexPend (OS_EVENT  *pevent,
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;       /* Yes, Acquire the resource                */
         pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;         /*      Save priority of owning task        */
         pevent->OSEventPtr  = (void *)OSTCBCur;            /*      Point to owning task's OS_TCB       */
+#if OS_SCHED_RR_EN > 0u
+        OSMutex_OwnerLink(pevent, OSTCBCur);
+#endif
         
 		pip = (INT8U)(pevent->OSEventCnt >> 8u);               /* Get PIP from mutex                       */
 	    mprio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* No, Get priority of mutex owner   */
@@ -525,6 +541,7 @@ void  OSMutexPend (OS_EVENT  *pevent,
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+    OS_TRACE(OS_TRACE_TYPE_MUTEX_PEND, pevent);
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -595,6 +612,9 @@ void  OSMutexPend (OS_EVENT  *pevent,
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;       /* Yes, Acquire the resource                */
         pevent->OSEventCnt |= OSTCBCur->OSTCBPrio;         /*      Save priority of owning task        */
         pevent->OSEventPtr  = (void *)OSTCBCur;            /*      Point to owning task's OS_TCB       */
+#if OS_SCHED_RR_EN > 0u
+        OSMutex_OwnerLink(pevent, OSTCBCur);
+#endif
         if (OSTCBCur->OSTCBPrio <= pip) {                  /*      PIP 'must' have a SMALLER prio ...  */
             OS_EXIT_CRITICAL();                            /*      ... than current task!              */
             *perr = OS_ERR_PIP_LOWER;
@@ -653,6 +673,7 @@ void  OSMutexPend (OS_EVENT  *pevent,
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+    OS_TRACE(OS_TRACE_TYPE_MUTEX_PEND, pevent);
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -736,17 +757,24 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
         OS_EXIT_CRITICAL();
         return (OS_ERR_NOT_MUTEX_OWNER);
     }
+    OS_TRACE(OS_TRACE_TYPE_MUTEX_POST, pevent);
     if (OSTCBCur->OSTCBPrio == pip) {                 /* Did we have to raise current task's priority? */
         OSMutex_RdyAtPrio(OSTCBCur, prio);            /* Restore the task's original priority          */
 	
 	}
     OSTCBPrioTbl[pip] = OS_TCB_RESERVED;              /* Reserve table entry                           */
+#if OS_SCHED_RR_EN > 0u
+    OSMutex_OwnerUnlink(pevent);
+#endif
     if (pevent->OSEventGrp != 0u) {                   /* Any task waiting for the mutex?               */
                                                       /* Yes, Make HPT waiting for mutex ready         */
         prio                = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
         pevent->OSEventCnt |= prio;
         pevent->OSEventPtr  = OSTCBPrioTbl[prio];     /*      Link to new mutex owner's OS_TCB         */
+#if OS_SCHED_RR_EN > 0u
+        OSMutex_OwnerLink(pevent, OSTCBPrioTbl[prio]);
+#endif
         if (prio <= pip) {                            /*      PIP 'must' have a SMALLER prio ...       */
             OS_EXIT_CRITICAL();                       /*      ... than current task!                   */
             OS_Sched();                               /*      Find highest priority task ready to run  */
@@ -875,6 +903,55 @@ static  void  OSMutex_RdyAtPrio (OS_TCB  *ptcb,
 
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  LINK/UNLINK A MUTEX TO/FROM ITS OWNER
+*
+* Description: These functions maintain the list of the mutexes owned by a task (OSTCBMutexPtr) so that
+*              OS_SchedRRRotate() can update the owner priority of these mutexes without scanning
+*              OSEventTbl[].
+*
+* Arguments  : pevent          is a pointer to the mutex
+*
+*              ptcb            is a pointer to the OS_TCB of the new owner
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when these functions are called.
+*              2) OSMutex_OwnerUnlink() must be called before the owner of the mutex is changed.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0u
+static  void  OSMutex_OwnerLink (OS_EVENT  *pevent,
+                                 OS_TCB    *ptcb)
+{
+    pevent->OSEventMutexNext = ptcb->OSTCBMutexPtr;
+    ptcb->OSTCBMutexPtr      = pevent;
+}
+
+
+static  void  OSMutex_OwnerUnlink (OS_EVENT *pevent)
+{
+    OS_EVENT  **ppevent;
+
+
+    if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+        return;                                            /* Mutex is not owned                       */
+    }
+    ppevent = &((OS_TCB *)pevent->OSEventPtr)->OSTCBMutexPtr;
+    while (*ppevent != (OS_EVENT *)0) {                    /* Mutexes owned by a task are few          */
+        if (*ppevent == pevent) {
+            *ppevent = pevent->OSEventMutexNext;
+            break;
+        }
+        ppevent = &(*ppevent)->OSEventMutexNext;
+    }
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+}
+#endif
+
 
 #endif                                                     /* OS_MUTEX_EN                              */
 	 	   	  		 			 	    		   		 		 	 	 			 	    		   	 			 	  	 		 				 		  			 		 					 	  	  		      		  	   		      		  	 		 	      		   		 		  	 		 	      		  		  		  
@@ -0,0 +1,396 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                           PRIORITY CEILING MUTEXES
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_MUTEX_CEIL.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0u
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+                                                    /* Value of OSMutexCeilOwner for the task 'ptcb'   */
+#define  OS_MUTEX_CEIL_ID(ptcb)  (((INT32U)((ptcb) - &OSTCBTbl[0]) + 1u) << 1u)
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_MutexCeilRaise   (OS_TCB *ptcb, INT8U prio);
+static  void   OS_MutexCeilRestore (OS_TCB *ptcb, INT8U prev);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                ACCEPT A PRIORITY CEILING MUTEX
+*
+* Description: This function checks whether a priority ceiling mutex is available and, if so, acquires it.
+*              Unlike OSMutexCeilPend(), it does not suspend the calling task if the mutex is not available.
+*
+* Arguments  : pmutex        is a pointer to the priority ceiling mutex.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         if the call was successful.
+*                            OS_ERR_PEVENT_NULL  'pmutex' is a NULL pointer
+*                            OS_ERR_PEND_ISR     if you called this function from an ISR
+*                            OS_ERR_CEIL_PRIO    if the calling task has a higher priority than the ceiling
+*
+* Returns    : OS_TRUE       if the mutex was available and has been acquired.
+*              OS_FALSE      if the mutex is owned by another task.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OSMutexCeilAccept (OS_MUTEX_CEIL  *pmutex,
+                            INT8U          *perr)
+{
+    OS_TCB  *ptcb;
+    INT8U    prev;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pmutex == (OS_MUTEX_CEIL *)0) {                    /* Validate 'pmutex'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (OS_FALSE);
+    }
+#endif
+    if (OSIntNesting > 0u) {                               /* Make sure it's not called from an ISR    */
+        *perr = OS_ERR_PEND_ISR;
+        return (OS_FALSE);
+    }
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBPrio < pmutex->OSMutexCeilPrio) {       /* Task must not be above the ceiling       */
+        *perr = OS_ERR_CEIL_PRIO;
+        return (OS_FALSE);
+    }
+    prev  = OS_MutexCeilRaise(ptcb, pmutex->OSMutexCeilPrio);   /* Raise the task to the ceiling first */
+    *perr = OS_ERR_NONE;
+    if (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, 0u, OS_MUTEX_CEIL_ID(ptcb)) == OS_FALSE) {
+        OS_MutexCeilRestore(ptcb, prev);                   /* Mutex not available                      */
+        if (OSMutexCeilSchedPend == OS_TRUE) {             /* Perform the switches held back meanwhile */
+            OSMutexCeilSchedPend = OS_FALSE;
+            OS_Sched();
+        }
+        return (OS_FALSE);
+    }
+    pmutex->OSMutexCeilPrevPrio = prev;
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CREATE A PRIORITY CEILING MUTEX
+*
+* Description: This function initializes a mutual exclusion semaphore that uses the immediate priority
+*              ceiling protocol: as soon as a task acquires the mutex, the tasks at or below the ceiling
+*              can no longer preempt it, until it releases the mutex.
+*
+* Arguments  : pmutex        is a pointer to the storage of the mutex, allocated by the application.
+*
+*              prio          is the ceiling: the highest priority (lowest number) of the tasks that use the
+*                            mutex.  Unlike OSMutexCreate(), the priority is NOT reserved: it may be that of
+*                            one of the tasks and several mutexes may share the same ceiling.
+*
+* Returns    : OS_ERR_NONE          if the call was successful.
+*              OS_ERR_CREATE_ISR    if you attempted to create a mutex from an ISR
+*              OS_ERR_PEVENT_NULL   if 'pmutex' is a NULL pointer or, no more event control blocks are
+*                                   available for the semaphore used on contention.
+*              OS_ERR_PRIO_INVALID  if the ceiling is higher than the maximum allowed (i.e. > OS_LOWEST_PRIO)
+*********************************************************************************************************
+*/
+
+INT8U  OSMutexCeilCreate (OS_MUTEX_CEIL  *pmutex,
+                          INT8U           prio)
+{
+    OS_EVENT  *psem;
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pmutex == (OS_MUTEX_CEIL *)0) {                    /* Validate 'pmutex'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (prio > OS_LOWEST_PRIO) {                           /* Validate ceiling                         */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        return (OS_ERR_CREATE_ISR);                        /* ... can't CREATE mutex from an ISR       */
+    }
+    psem = OSSemCreate(0u);                                /* Waiting list for contention              */
+    if (psem == (OS_EVENT *)0) {
+        return (OS_ERR_PEVENT_NULL);
+    }
+    pmutex->OSMutexCeilOwner    = 0u;
+    pmutex->OSMutexCeilSem      = psem;
+    pmutex->OSMutexCeilPrio     = prio;
+    pmutex->OSMutexCeilPrevPrio = OS_MUTEX_CEIL_NONE;
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON PRIORITY CEILING MUTEX
+*
+* Description: This function waits for a priority ceiling mutex.
+*
+* Arguments  : pmutex        is a pointer to the priority ceiling mutex.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the mutex up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever at the specified
+*                            mutex or, until the mutex becomes available.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*                               OS_ERR_NONE        The call was successful and your task owns the mutex
+*                               OS_ERR_TIMEOUT     The mutex was not available within the specified 'timeout'.
+*                               OS_ERR_PEND_ABORT  The wait on the mutex was aborted.
+*                               OS_ERR_PEVENT_NULL 'pmutex' is a NULL pointer
+*                               OS_ERR_PEND_ISR    If you called this function from an ISR
+*                               OS_ERR_PEND_LOCKED If you called this function when the scheduler is locked
+*                                                  and the mutex is not available.
+*                               OS_ERR_CEIL_PRIO   If the calling task has a higher priority than the ceiling
+*
+* Returns    : none
+*
+* Note(s)    : 1) When the mutex is available, it is acquired with an atomic compare and swap of the owner
+*                 (see OS_CPU_AtomicCAS()) without disabling interrupts.  The ceiling only takes effect
+*                 through OSTCBCeilPrio and the stack of the owners (OSMutexCeilTCB), which OS_SchedNew()
+*                 checks whichever task runs: the priority of the task is not changed and no priority
+*                 needs to be reserved.
+*              2) On contention, the task flags the mutex and waits on its semaphore.  The owner posts the
+*                 semaphore when it releases a flagged mutex, and the task woken up tries again.
+*              3) The task must not block nor be deleted while it owns the mutex: the tasks below the
+*                 ceiling would then run and could contend, and the task would stay on OSMutexCeilTCB.
+*                 Mutexes must be released in the reverse order of acquisition and are not recursive.
+*********************************************************************************************************
+*/
+
+void  OSMutexCeilPend (OS_MUTEX_CEIL  *pmutex,
+                       INT32U          timeout,
+                       INT8U          *perr)
+{
+    OS_TCB  *ptcb;
+    INT32U   owner;
+    INT32U   id;
+    INT32U   wait;
+    INT8U    prev;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pmutex == (OS_MUTEX_CEIL *)0) {                    /* Validate 'pmutex'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return;
+    }
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBPrio < pmutex->OSMutexCeilPrio) {       /* Task must not be above the ceiling       */
+        *perr = OS_ERR_CEIL_PRIO;
+        return;
+    }
+    id   = OS_MUTEX_CEIL_ID(ptcb);
+    prev = OS_MutexCeilRaise(ptcb, pmutex->OSMutexCeilPrio);    /* Raise the task to the ceiling first */
+    if (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, 0u, id) == OS_FALSE) {
+        if (OSLockNesting > 0u) {                          /* See if called with scheduler locked ...  */
+            OS_MutexCeilRestore(ptcb, prev);
+            *perr = OS_ERR_PEND_LOCKED;                    /* ... can't PEND when locked               */
+            return;
+        }
+        for (;;) {                                         /* Mutex is owned, see Note #2              */
+            owner = pmutex->OSMutexCeilOwner;
+            if (owner == 0u) {                             /* Released: flag it if others still wait   */
+                wait = (pmutex->OSMutexCeilSem->OSEventGrp != 0u) ? OS_MUTEX_CEIL_WAIT : 0u;
+                if (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, 0u, id | wait) == OS_TRUE) {
+                    break;
+                }
+            } else if (((owner & OS_MUTEX_CEIL_WAIT) != 0u) ||
+                       (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, owner, owner | OS_MUTEX_CEIL_WAIT) == OS_TRUE)) {
+                OS_MutexCeilRestore(ptcb, prev);           /* Don't hold back others while waiting    */
+                OSSemPend(pmutex->OSMutexCeilSem, timeout, perr);
+                if (*perr != OS_ERR_NONE) {
+                    return;
+                }
+                (void)OS_MutexCeilRaise(ptcb, pmutex->OSMutexCeilPrio);
+            }
+        }
+    }
+    pmutex->OSMutexCeilPrevPrio = prev;
+    *perr = OS_ERR_NONE;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 POST TO A PRIORITY CEILING MUTEX
+*
+* Description: This function releases a priority ceiling mutex.
+*
+* Arguments  : pmutex              is a pointer to the priority ceiling mutex.
+*
+* Returns    : OS_ERR_NONE             The call was successful and the mutex was released
+*              OS_ERR_PEVENT_NULL      'pmutex' is a NULL pointer
+*              OS_ERR_POST_ISR         Attempted to post from an ISR (not valid for MUTEXes)
+*              OS_ERR_NOT_MUTEX_OWNER  The task that did the post is NOT the owner of the MUTEX.
+*
+* Note(s)    : 1) Without contention, the release is an atomic compare and swap: the kernel is only entered
+*                 to wake up a waiting task or, to perform a context switch held back by the ceiling.
+*********************************************************************************************************
+*/
+
+INT8U  OSMutexCeilPost (OS_MUTEX_CEIL  *pmutex)
+{
+    OS_TCB  *ptcb;
+    INT32U   id;
+    INT8U    prev;
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pmutex == (OS_MUTEX_CEIL *)0) {                    /* Validate 'pmutex'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        return (OS_ERR_POST_ISR);                          /* ... can't POST mutex from an ISR         */
+    }
+    ptcb = OSTCBCur;
+    id   = OS_MUTEX_CEIL_ID(ptcb);
+    prev = pmutex->OSMutexCeilPrevPrio;
+    if (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, id, 0u) == OS_TRUE) {
+        OS_MutexCeilRestore(ptcb, prev);                   /* Back to the previous ceiling, if any     */
+    } else {
+        if (OS_CPU_AtomicCAS(&pmutex->OSMutexCeilOwner, id | OS_MUTEX_CEIL_WAIT, 0u) == OS_FALSE) {
+            return (OS_ERR_NOT_MUTEX_OWNER);
+        }
+        OS_MutexCeilRestore(ptcb, prev);
+        (void)OSSemPost(pmutex->OSMutexCeilSem);           /* Wake up the highest priority waiter      */
+    }
+    if (OSMutexCeilSchedPend == OS_TRUE) {                 /* Perform the switches held back, if any   */
+        OSMutexCeilSchedPend = OS_FALSE;
+        OS_Sched();
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 RAISE / RESTORE THE CEILING OF A TASK
+*
+* Description: OS_MutexCeilRaise() raises the ceiling of the running task to 'prio' and returns its
+*              previous ceiling.  OS_MutexCeilRestore() gives the task back the ceiling 'prev'.  The task
+*              is pushed on OSMutexCeilTCB when it gets its first ceiling and is removed when it releases
+*              its last one: OS_SchedNew() thus still enforces the ceiling when another task runs.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the running task.
+*
+*              prio          is the ceiling of the mutex being acquired.
+*
+*              prev          is the ceiling returned by OS_MutexCeilRaise().
+*
+* Returns    : OS_MutexCeilRaise() returns the previous ceiling of the task (OS_MUTEX_CEIL_NONE if none).
+*
+* Note(s)    : 1) Only the running task changes its entry.  A task that preempts it runs above its ceiling
+*                 and, as it doesn't block while holding a ceiling mutex, has left the stack by the time
+*                 the task resumes.  The task is published last on a push and removed with a compare and
+*                 swap on a pop, without disabling interrupts.
+*              2) The stack is searched with interrupts disabled only if the task is not on top, that is
+*                 if a task blocked while holding a ceiling mutex.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_MutexCeilRaise (OS_TCB  *ptcb,
+                                  INT8U    prio)
+{
+    INT8U  prev;
+
+
+    prev = ptcb->OSTCBCeilPrio;
+    if (prio < prev) {
+        if (prev == OS_MUTEX_CEIL_NONE) {                  /* First ceiling of the task: push it       */
+            ptcb->OSTCBCeilNext = OSMutexCeilTCB;
+            ptcb->OSTCBCeilPrio = prio;
+            OSMutexCeilTCB      = ptcb;                    /* Published last, see Note #1              */
+        } else {
+            ptcb->OSTCBCeilPrio = prio;
+        }
+    }
+    return (prev);
+}
+
+
+static  void  OS_MutexCeilRestore (OS_TCB  *ptcb,
+                                   INT8U    prev)
+{
+    OS_TCB    **pptcb;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+
+    if ((prev == OS_MUTEX_CEIL_NONE) && (ptcb->OSTCBCeilPrio != OS_MUTEX_CEIL_NONE)) {
+        if (OS_CPU_AtomicCAS((volatile INT32U *)(void *)&OSMutexCeilTCB,
+                             (INT32U)ptcb,
+                             (INT32U)ptcb->OSTCBCeilNext) == OS_FALSE) {
+            OS_ENTER_CRITICAL();                           /* Not on top, see Note #2                  */
+            pptcb = (OS_TCB **)&OSMutexCeilTCB;
+            while ((*pptcb != (OS_TCB *)0) && (*pptcb != ptcb)) {
+                pptcb = &(*pptcb)->OSTCBCeilNext;
+            }
+            if (*pptcb == ptcb) {
+                *pptcb = ptcb->OSTCBCeilNext;
+            }
+            OS_EXIT_CRITICAL();
+        }
+        ptcb->OSTCBCeilNext = (OS_TCB *)0;
+    }
+    ptcb->OSTCBCeilPrio = prev;
+}
+#endif
\ No newline at end of file
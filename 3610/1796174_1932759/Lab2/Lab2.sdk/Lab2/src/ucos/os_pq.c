@@ -0,0 +1,714 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                   PRIORITY MESSAGE QUEUE MANAGEMENT
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_PQ.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  *OS_PQGet (OS_PQ  *ppq,
+                         INT8U  *pband);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                ACCEPT MESSAGE FROM A PRIORITY QUEUE
+*
+* Description: This function checks the priority queue to see if a message is available.  Unlike
+*              OSPQPend(), OSPQAccept() does not suspend the calling task if a message is not available.
+*
+* Arguments  : pevent        is a pointer to the event control block
+*
+*              pband         is a pointer to where the band of the message will be deposited.  You can
+*                            pass a NULL pointer if you don't need it.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a
+*                                                message.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a priority queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_Q_EMPTY      The priority queue did not contain any messages
+*
+* Returns    : != (void *)0  is the oldest message of the most urgent band holding a message.
+*              == (void *)0  if you received a NULL pointer message
+*                            if the priority queue is empty or,
+*                            if 'pevent' is a NULL pointer or,
+*                            if you passed an invalid event type
+*********************************************************************************************************
+*/
+
+#if OS_PQ_ACCEPT_EN > 0u
+void  *OSPQAccept (OS_EVENT  *pevent,
+                   INT8U     *pband,
+                   INT8U     *perr)
+{
+    void      *pmsg;
+    OS_PQ     *ppq;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_PQ) {   /* Validate event block type                      */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    ppq = (OS_PQ *)pevent->OSEventPtr;           /* Point at priority queue control block              */
+    if (ppq->OSPQEntries > 0u) {                 /* See if any messages in the bands                   */
+        pmsg  = OS_PQGet(ppq, pband);            /* Yes, extract it from the most urgent band          */
+        *perr = OS_ERR_NONE;
+    } else {
+        pmsg  = (void *)0;                       /* Priority queue is empty                            */
+        *perr = OS_ERR_Q_EMPTY;
+    }
+    OS_EXIT_CRITICAL();
+    return (pmsg);                               /* Return message received (or NULL)                  */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     CREATE A PRIORITY MESSAGE QUEUE
+*
+* Description: This function creates a message queue made of several bands.  Each band is a FIFO with
+*              its own capacity; a pend always returns the oldest message of the most urgent band that
+*              holds a message.
+*
+* Arguments  : start         is a pointer to the base address of the message storage area.  The storage
+*                            area MUST be declared as an array of pointers to 'void' holding the sum of
+*                            the sizes of the bands:
+*
+*                            void *MessageStorage[size0 + size1 + ...]
+*
+*              sizes         is a pointer to an array of 'nbr_bands' band capacities.  sizes[0] is the
+*                            capacity of band 0, the most urgent one.
+*
+*              nbr_bands     is the number of bands (1 to OS_PQ_BANDS_MAX).
+*
+*              perr          is a pointer to an error code that will be returned to your application:
+*                               OS_ERR_NONE             if the call was successful.
+*                               OS_ERR_CREATE_ISR       if you attempted to create it from an ISR.
+*                               OS_ERR_PDATA_NULL       if 'start' or 'sizes' is a NULL pointer.
+*                               OS_ERR_PQ_BAND_INVALID  if 'nbr_bands' is out of range or a band has a
+*                                                       capacity of 0.
+*                               OS_ERR_PEVENT_NULL      if no event control block or priority queue
+*                                                       control block was available.
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control clock (OS_EVENT) associated with the
+*                                created priority queue
+*              == (OS_EVENT *)0  if no event control blocks were available or an error was detected
+*
+* Note(s)    : The bands are carved out of 'start' in order: band 0 first.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSPQCreate (void    **start,
+                       INT16U   *sizes,
+                       INT8U     nbr_bands,
+                       INT8U    *perr)
+{
+    OS_EVENT    *pevent;
+    OS_PQ       *ppq;
+    OS_PQ_BAND  *pb;
+    INT8U        band;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR    cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == OS_TRUE) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if ((start == (void **)0) || (sizes == (INT16U *)0)) { /* Validate the storage and the band sizes   */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if ((nbr_bands == 0u) || (nbr_bands > OS_PQ_BANDS_MAX)) {
+        *perr = OS_ERR_PQ_BAND_INVALID;
+        return ((OS_EVENT *)0);
+    }
+    for (band = 0u; band < nbr_bands; band++) {
+        if (sizes[band] == 0u) {                           /* A band must be able to hold a message    */
+            *perr = OS_ERR_PQ_BAND_INVALID;
+            return ((OS_EVENT *)0);
+        }
+    }
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    ppq    = OSPQFreeList;                                 /* Get a free priority queue control block  */
+    if ((pevent == (OS_EVENT *)0) || (ppq == (OS_PQ *)0)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    OSPQFreeList    = ppq->OSPQPtr;
+    OS_EXIT_CRITICAL();
+    OS_MemClr((INT8U *)ppq, sizeof(OS_PQ));                /* No message, counters cleared             */
+    for (band = 0u; band < nbr_bands; band++) {            /* Carve the bands out of the storage       */
+        pb                = &ppq->OSPQBandTbl[band];
+        pb->OSPQBandStart = start;
+        pb->OSPQBandEnd   = &start[sizes[band]];
+        pb->OSPQBandIn    = start;
+        pb->OSPQBandOut   = start;
+        pb->OSPQBandSize  = sizes[band];
+        ppq->OSPQSize    += sizes[band];
+        start             = pb->OSPQBandEnd;
+    }
+    ppq->OSPQNbrBands      = nbr_bands;
+    pevent->OSEventType    = OS_EVENT_TYPE_PQ;
+    pevent->OSEventCnt     = 0u;
+    pevent->OSEventPtr     = ppq;
+#if OS_EVENT_NAME_EN > 0u
+    pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+    OS_EventWaitListInit(pevent);                          /* Initalize the wait list                  */
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DELETE A PRIORITY MESSAGE QUEUE
+*
+* Description: This function deletes a priority queue and readies all tasks pending on it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired
+*                            priority queue.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the queue ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the queue even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the queue was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the queue from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the queue
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a priority queue
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the queue was successfully deleted.
+*
+* Note(s)    : 1) Tasks readied by OS_DEL_ALWAYS return from OSPQPend() with OS_ERR_PEND_ABORT.
+*              2) The messages still held by the bands are lost: release them first if they point to
+*                 allocated memory.
+*********************************************************************************************************
+*/
+
+#if OS_PQ_DEL_EN > 0u
+OS_EVENT  *OSPQDel (OS_EVENT  *pevent,
+                    INT8U      opt,
+                    INT8U     *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_EVENT  *pevent_return;
+    OS_PQ     *ppq;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_PQ) {         /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0u) {                        /* See if any tasks waiting on queue        */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                               /* Delete queue only if no task waiting     */
+             if (tasks_waiting == OS_TRUE) {
+                 OS_EXIT_CRITICAL();
+                 *perr         = OS_ERR_TASK_WAITING;
+                 pevent_return = pevent;
+                 break;
+             }
+                                                           /* No task waiting, same as OS_DEL_ALWAYS   */
+        case OS_DEL_ALWAYS:                                /* Always delete the queue                  */
+             while (pevent->OSEventGrp != 0u) {            /* Ready ALL tasks waiting for queue        */
+                 (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_Q, OS_STAT_PEND_ABORT);
+             }
+#if OS_EVENT_NAME_EN > 0u
+             pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+             ppq                    = (OS_PQ *)pevent->OSEventPtr;  /* Return OS_PQ to free list       */
+             ppq->OSPQPtr           = OSPQFreeList;
+             OSPQFreeList           = ppq;
+             pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+             pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
+             pevent->OSEventCnt     = 0u;
+             OSEventFreeList        = pevent;              /* Get next free event control block        */
+             OS_EXIT_CRITICAL();
+             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+                 OS_Sched();                               /* Find highest priority task ready to run  */
+             }
+             *perr                  = OS_ERR_NONE;
+             pevent_return          = (OS_EVENT *)0;       /* Queue has been deleted                   */
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr                  = OS_ERR_INVALID_OPT;
+             pevent_return          = pevent;
+             break;
+    }
+    return (pevent_return);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 PEND ON A PRIORITY QUEUE FOR A MESSAGE
+*
+* Description: This function waits for a message to be sent to a priority queue.  The message returned
+*              is the oldest one of the most urgent band that holds a message.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the queue up to the amount of time
+*                            specified by this argument.  If you specify 0, however, your task will wait
+*                            forever at the specified queue or, until a message arrives.
+*
+*              pband         is a pointer to where the band of the message will be deposited.  You can
+*                            pass a NULL pointer if you don't need it.  It is only written when a message
+*                            is received.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a
+*                                                message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The queue was deleted while the task was waiting.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a priority queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the message received
+*              == (void *)0  if you received a NULL pointer message or,
+*                            if no message was received or,
+*                            if 'pevent' is a NULL pointer or,
+*                            if you didn't pass a pointer to a priority queue.
+*
+* Note(s)    : 1) The most urgent band is found with OS_CPU_CntTrailZeros() on the bitmap of the bands
+*                 holding a message: the cost does not depend on the number of bands or messages.
+*              2) A waiting task is marked OS_STAT_Q, like a task waiting on a queue.
+*********************************************************************************************************
+*/
+
+void  *OSPQPend (OS_EVENT  *pevent,
+                 INT32U     timeout,
+                 INT8U     *pband,
+                 INT8U     *perr)
+{
+    void      *pmsg;
+    OS_PQ     *ppq;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_PQ) {   /* Validate event block type                      */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    if (OSIntNesting > 0u) {                     /* See if called from ISR ...                         */
+        *perr = OS_ERR_PEND_ISR;                 /* ... can't PEND from an ISR                         */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0u) {                    /* See if called with scheduler locked ...            */
+        *perr = OS_ERR_PEND_LOCKED;              /* ... can't PEND when locked                         */
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    ppq = (OS_PQ *)pevent->OSEventPtr;           /* Point at priority queue control block              */
+    if (ppq->OSPQEntries > 0u) {                 /* See if any messages in the bands                   */
+        pmsg = OS_PQGet(ppq, pband);             /* Yes, extract it from the most urgent band          */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (pmsg);                           /* Return message received                            */
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+    OS_TRACE(OS_TRACE_TYPE_Q_PEND, pevent);
+    OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next highest priority task ready to run       */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Extract message from TCB (Put there by PQPost)*/
+             pmsg =  OSTCBCur->OSTCBMsg;
+             if (pband != (INT8U *)0) {
+                 *pband = OSTCBCur->OSTCBPQBand;
+             }
+            *perr =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             pmsg = (void *)0;
+            *perr =  OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             pmsg = (void *)0;
+            *perr =  OS_ERR_TIMEOUT;                  /* Indicate that we didn't get event within TO   */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0u)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (pmsg);                                    /* Return received message                       */
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   POST MESSAGE TO A PRIORITY QUEUE
+*
+* Description: This function sends a message to one band of a priority queue.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              band          is the band the message is posted to (0 is the most urgent one).
+*
+* Returns    : OS_ERR_NONE             The call was successful and the message was sent
+*              OS_ERR_Q_FULL           If the band cannot accept any more messages because it is full.
+*              OS_ERR_PQ_BAND_INVALID  If 'band' is not a band of the queue.
+*              OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a priority queue.
+*              OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL       If called from an ISR while the ISR post queue is full.
+*                                      Other errors of ISR posts are only counted (see OS_IntQPost()).
+*
+* Note(s)    : 1) This function allows you to send NULL pointer messages.
+*              2) Tasks only wait while every band is empty, so a waiting task receives 'pmsg' directly
+*                 whatever its band.
+*              3) A full band refuses 'pmsg' even if the other bands have room: each band has its own
+*                 capacity so that a flood of low priority messages cannot starve the urgent ones.
+*********************************************************************************************************
+*/
+
+INT8U  OSPQPost (OS_EVENT  *pevent,
+                 void      *pmsg,
+                 INT8U      band)
+{
+    OS_PQ       *ppq;
+    OS_PQ_BAND  *pb;
+    INT8U        prio;
+#if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
+    OS_CPU_SR    cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_PQ) {     /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    ppq = (OS_PQ *)pevent->OSEventPtr;                 /* Point to priority queue control block        */
+    if (band >= ppq->OSPQNbrBands) {                   /* Validate 'band' (set once by OSPQCreate())   */
+        return (OS_ERR_PQ_BAND_INVALID);
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                           /* Called from ISR, defer to ISR queue task     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_PQ_POST, (void *)pevent, pmsg, 0u, band));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_Q_POST, pevent);
+    pb = &ppq->OSPQBandTbl[band];
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0u) {                    /* See if any task pending on queue (Note 2)    */
+        pb->OSPQBandNPosts++;                          /* Message handed over without being queued     */
+        pb->OSPQBandNPends++;
+                                                       /* Ready highest priority task waiting on event */
+        prio = OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+        OSTCBPrioTbl[prio]->OSTCBPQBand = band;
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+        return (OS_ERR_NONE);
+    }
+    if (pb->OSPQBandEntries >= pb->OSPQBandSize) {     /* Make sure the band is not full (Note 3)      */
+        pb->OSPQBandNFull++;
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_Q_FULL);
+    }
+    *pb->OSPQBandIn++ = pmsg;                          /* Insert message into the band                 */
+    if (pb->OSPQBandIn == pb->OSPQBandEnd) {           /* Wrap IN ptr if we are at end of the band     */
+        pb->OSPQBandIn = pb->OSPQBandStart;
+    }
+    pb->OSPQBandEntries++;
+    pb->OSPQBandNPosts++;
+    if (pb->OSPQBandEntries > pb->OSPQBandEntriesMax) {
+        pb->OSPQBandEntriesMax = pb->OSPQBandEntries;
+    }
+    ppq->OSPQBandRdy |= (INT32U)1u << band;            /* The band holds a message                     */
+    ppq->OSPQEntries++;
+    if (ppq->OSPQEntries > ppq->OSPQEntriesMax) {
+        ppq->OSPQEntriesMax = ppq->OSPQEntries;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    READ PRIORITY QUEUE COUNTERS
+*
+* Description: This function obtains the occupancy and the counters of each band of a priority queue.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              p_pq_stat     is a pointer to a structure that will receive the counters of the queue.
+*
+*              opt           OS_Q_STAT_OPT_NONE     only read the counters
+*                            OS_Q_STAT_OPT_RESET    also start a new measurement period: the counters
+*                                                   start over, the high-water marks start from the
+*                                                   current number of entries
+*
+* Returns    : OS_ERR_NONE         The call was successful
+*              OS_ERR_EVENT_TYPE   If you are attempting to obtain data from a non priority queue.
+*              OS_ERR_PEVENT_NULL  If 'pevent'    is a NULL pointer
+*              OS_ERR_PDATA_NULL   If 'p_pq_stat' is a NULL pointer
+*
+* Note(s)    : Only the first 'OSPQNbrBands' entries of 'OSPQBandTbl[]' are written.
+*********************************************************************************************************
+*/
+
+#if OS_PQ_STAT_EN > 0u
+INT8U  OSPQStatGet (OS_EVENT    *pevent,
+                    OS_PQ_STAT  *p_pq_stat,
+                    INT8U        opt)
+{
+    OS_PQ            *ppq;
+    OS_PQ_BAND       *pb;
+    OS_PQ_BAND_STAT  *pstat;
+    INT8U             band;
+#if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
+    OS_CPU_SR         cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_pq_stat == (OS_PQ_STAT *)0) {                /* Validate 'p_pq_stat'                         */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_PQ) {     /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    ppq                       = (OS_PQ *)pevent->OSEventPtr;
+    p_pq_stat->OSPQNbrBands   = ppq->OSPQNbrBands;
+    p_pq_stat->OSPQEntries    = ppq->OSPQEntries;
+    p_pq_stat->OSPQEntriesMax = ppq->OSPQEntriesMax;
+    for (band = 0u; band < ppq->OSPQNbrBands; band++) {
+        pb                         = &ppq->OSPQBandTbl[band];
+        pstat                      = &p_pq_stat->OSPQBandTbl[band];
+        pstat->OSPQBandSize        = pb->OSPQBandSize;
+        pstat->OSPQBandEntries     = pb->OSPQBandEntries;
+        pstat->OSPQBandEntriesMax  = pb->OSPQBandEntriesMax;
+        pstat->OSPQBandNPosts      = pb->OSPQBandNPosts;
+        pstat->OSPQBandNPends      = pb->OSPQBandNPends;
+        pstat->OSPQBandNFull       = pb->OSPQBandNFull;
+        if (opt == OS_Q_STAT_OPT_RESET) {              /* Start a new measurement period               */
+            pb->OSPQBandEntriesMax = pb->OSPQBandEntries;
+            pb->OSPQBandNPosts     = 0u;
+            pb->OSPQBandNPends     = 0u;
+            pb->OSPQBandNFull      = 0u;
+        }
+    }
+    if (opt == OS_Q_STAT_OPT_RESET) {
+        ppq->OSPQEntriesMax = ppq->OSPQEntries;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 PRIORITY QUEUE MODULE INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the priority queue module.  Your
+*               application MUST NOT call this function.
+*
+* Arguments   :  none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_PQInit (void)
+{
+    INT16U   ix;
+
+
+
+    OS_MemClr((INT8U *)&OSPQTbl[0], sizeof(OSPQTbl));        /* Clear the priority queue table         */
+    for (ix = 0u; ix < (OS_MAX_PQS - 1u); ix++) {            /* Init. list of free control blocks      */
+        OSPQTbl[ix].OSPQPtr = &OSPQTbl[ix + 1u];
+    }
+    OSPQTbl[ix].OSPQPtr = (OS_PQ *)0;
+    OSPQFreeList        = &OSPQTbl[0];
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              EXTRACT A MESSAGE FROM THE MOST URGENT BAND
+*
+* Description: This function removes the oldest message of the most urgent band holding a message.
+*
+* Arguments  : ppq           is a pointer to the priority queue control block.  It MUST hold a message.
+*
+*              pband         is where the band of the message is returned (may be a NULL pointer).
+*
+* Returns    : The message.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  *OS_PQGet (OS_PQ  *ppq,
+                         INT8U  *pband)
+{
+    OS_PQ_BAND  *pb;
+    void        *pmsg;
+    INT8U        band;
+
+
+    band = OS_CPU_CntTrailZeros(ppq->OSPQBandRdy);     /* Lowest bit set is the most urgent band       */
+    pb   = &ppq->OSPQBandTbl[band];
+    pmsg = *pb->OSPQBandOut++;                         /* Extract oldest message of the band           */
+    if (pb->OSPQBandOut == pb->OSPQBandEnd) {          /* Wrap OUT pointer if we are at the end        */
+        pb->OSPQBandOut = pb->OSPQBandStart;
+    }
+    pb->OSPQBandEntries--;
+    pb->OSPQBandNPends++;
+    if (pb->OSPQBandEntries == 0u) {                   /* The band is now empty                        */
+        ppq->OSPQBandRdy &= ~((INT32U)1u << band);
+    }
+    ppq->OSPQEntries--;
+    if (pband != (INT8U *)0) {
+        *pband = band;
+    }
+    return (pmsg);
+}
+#endif                                                 /* OS_PQ_EN                                     */
@@ -28,6 +28,35 @@
 #if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
 /*
 *********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#if OS_Q_STAT_EN > 0u
+#define  OS_Q_STAT_TS_PER_TICK   (OS_TS_FREQ_HZ / OS_TICKS_PER_SEC)
+#define  OS_Q_STAT_TICKS_MAX     (0xFFFFFFFFuL / OS_Q_STAT_TS_PER_TICK - 1u) /* Span of OS_TS_GET()    */
+#endif
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if OS_Q_POLICY_EN > 0u
+static  BOOLEAN  OS_QFull    (OS_Q      *pq,
+                              void     **ppmsg);
+
+static  BOOLEAN  OS_QRoomRdy (OS_EVENT  *pevent);
+#endif
+
+#if OS_Q_STAT_EN > 0u
+static  void     OS_QStatUpd (OS_Q      *pq);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                      ACCEPT MESSAGE FROM QUEUE
 *
 * Description: This function checks the queue to see if a message is available.  Unlike OSQPend(),
@@ -52,8 +81,9 @@
 *                            if 'pevent' is a NULL pointer or,
 *                            if you passed an invalid event type
 *
-* Note(s)    : As of V2.60, you can now pass NULL pointers through queues.  Because of this, the argument
-*              'perr' has been added to the API to tell you about the outcome of the call.
+* Note(s)    : 1) As of V2.60, you can now pass NULL pointers through queues.  Because of this, the
+*                 argument 'perr' has been added to the API to tell you about the outcome of the call.
+*              2) Extracting a message readies the tasks waiting for room in OSQPostPend().
 *********************************************************************************************************
 */
 
@@ -88,12 +118,23 @@ void  *OSQAccept (OS_EVENT  *pevent,
     OS_ENTER_CRITICAL();
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0u) {                   /* See if any messages in the queue                   */
+#if OS_Q_STAT_EN > 0u
+        OS_QStatUpd(pq);                         /* Close the interval spent at the old occupancy      */
+        pq->OSQNPends++;
+#endif
         pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
         pq->OSQEntries--;                        /* Update the number of entries in the queue          */
         if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
             pq->OSQOut = pq->OSQStart;
         }
         *perr = OS_ERR_NONE;
+#if OS_Q_POLICY_EN > 0u
+        if (OS_QRoomRdy(pevent) == OS_TRUE) {    /* Ready tasks waiting for room, if any               */
+            OS_EXIT_CRITICAL();
+            OS_Sched();                          /* Find highest priority task ready to run            */
+            return (pmsg);
+        }
+#endif
     } else {
         *perr = OS_ERR_Q_EMPTY;
         pmsg  = (void *)0;                       /* Queue is empty                                     */
@@ -160,6 +201,23 @@ OS_EVENT  *OSQCreate (void    **start,
             pq->OSQOut             = start;
             pq->OSQSize            = size;
             pq->OSQEntries         = 0u;
+#if OS_Q_POLICY_EN > 0u
+            pq->OSQPolicy          = OS_Q_POLICY_DROP_TAIL;
+            pq->OSQDropFnct        = (OS_Q_DROP_FNCT)0;
+            pq->OSQNDropHead       = 0u;
+            pq->OSQNDropTail       = 0u;
+            pq->OSQNPostWait       = 0u;
+#endif
+#if OS_Q_STAT_EN > 0u
+            pq->OSQEntriesMax      = 0u;
+            pq->OSQNPosts          = 0u;
+            pq->OSQNPends          = 0u;
+            pq->OSQNFull           = 0u;
+            pq->OSQStatTs          = OS_TS_GET();
+            pq->OSQStatTick        = OSTime;
+            pq->OSQStatArea        = 0u;
+            pq->OSQStatTime        = 0u;
+#endif
             pevent->OSEventType    = OS_EVENT_TYPE_Q;
             pevent->OSEventCnt     = 0u;
             pevent->OSEventPtr     = pq;
@@ -267,6 +325,9 @@ OS_EVENT  *OSQDel (OS_EVENT  *pevent,
                  pq                     = (OS_Q *)pevent->OSEventPtr;  /* Return OS_Q to free list     */
                  pq->OSQPtr             = OSQFreeList;
                  OSQFreeList            = pq;
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+                 OS_EventSetUnlink(pevent);                /* Remove queue from its event set          */
+#endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
                  pevent->OSEventCnt     = 0u;
@@ -291,6 +352,9 @@ OS_EVENT  *OSQDel (OS_EVENT  *pevent,
              pq                     = (OS_Q *)pevent->OSEventPtr;   /* Return OS_Q to free list        */
              pq->OSQPtr             = OSQFreeList;
              OSQFreeList            = pq;
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+             OS_EventSetUnlink(pevent);                    /* Remove queue from its event set          */
+#endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
              pevent->OSEventCnt     = 0u;
@@ -330,6 +394,8 @@ OS_EVENT  *OSQDel (OS_EVENT  *pevent,
 *               the references to what the queue entries are pointing to and thus, you could cause
 *               'memory leaks'.  In other words, the data you are pointing to that's being referenced
 *               by the queue entries should, most likely, need to be de-allocated (i.e. freed).
+*
+* Note(s)     : Flushing the queue readies the tasks waiting for room in OSQPostPend().
 *********************************************************************************************************
 */
 
@@ -337,6 +403,9 @@ OS_EVENT  *OSQDel (OS_EVENT  *pevent,
 INT8U  OSQFlush (OS_EVENT *pevent)
 {
     OS_Q      *pq;
+#if OS_Q_POLICY_EN > 0u
+    BOOLEAN    sched = OS_FALSE;
+#endif
 #if OS_CRITICAL_METHOD == 3u                          /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -353,10 +422,23 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 #endif
     OS_ENTER_CRITICAL();
     pq             = (OS_Q *)pevent->OSEventPtr;      /* Point to queue storage structure              */
+#if OS_Q_POLICY_EN > 0u
+    if (pq->OSQEntries > 0u) {                        /* Ready tasks waiting for room, if any          */
+        sched = OS_QRoomRdy(pevent);
+    }
+#endif
+#if OS_Q_STAT_EN > 0u
+    OS_QStatUpd(pq);                                  /* Close the interval at the old occupancy       */
+#endif
     pq->OSQIn      = pq->OSQStart;
     pq->OSQOut     = pq->OSQStart;
     pq->OSQEntries = 0u;
     OS_EXIT_CRITICAL();
+#if OS_Q_POLICY_EN > 0u
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+#endif
     return (OS_ERR_NONE);
 }
 #endif
@@ -394,7 +476,8 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 *                            if 'pevent' is a NULL pointer or,
 *                            if you didn't pass a pointer to a queue.
 *
-* Note(s)    : As of V2.60, this function allows you to receive NULL pointer messages.
+* Note(s)    : 1) As of V2.60, this function allows you to receive NULL pointer messages.
+*              2) Extracting a message readies the tasks waiting for room in OSQPostPend().
 *********************************************************************************************************
 */
 
@@ -437,11 +520,23 @@ void  *OSQPend (OS_EVENT  *pevent,
     OS_ENTER_CRITICAL();
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0u) {                   /* See if any messages in the queue                   */
+#if OS_Q_STAT_EN > 0u
+        OS_QStatUpd(pq);                         /* Close the interval spent at the old occupancy      */
+        pq->OSQNPends++;
+#endif
         pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
         pq->OSQEntries--;                        /* Update the number of entries in the queue          */
         if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
             pq->OSQOut = pq->OSQStart;
         }
+#if OS_Q_POLICY_EN > 0u
+        if (OS_QRoomRdy(pevent) == OS_TRUE) {    /* Ready tasks waiting for room, if any               */
+            OS_EXIT_CRITICAL();
+            OS_Sched();                          /* Find highest priority task ready to run            */
+            *perr = OS_ERR_NONE;
+            return (pmsg);
+        }
+#endif
         OS_EXIT_CRITICAL();
         *perr = OS_ERR_NONE;
         return (pmsg);                           /* Return message received                            */
@@ -449,6 +544,7 @@ void  *OSQPend (OS_EVENT  *pevent,
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+    OS_TRACE(OS_TRACE_TYPE_Q_PEND, pevent);
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
@@ -511,6 +607,8 @@ void  *OSQPend (OS_EVENT  *pevent,
 *
 * Returns    : == 0          if no tasks were waiting on the queue, or upon error.
 *              >  0          if one or more tasks waiting on the queue are now readied and informed.
+*
+* Note(s)    : Tasks waiting for room in OSQPostPend() are aborted as well; they get OS_ERR_PEND_ABORT.
 *********************************************************************************************************
 */
 
@@ -570,6 +668,72 @@ INT8U  OSQPendAbort (OS_EVENT  *pevent,
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   SET THE OVERFLOW POLICY OF A QUEUE
+*
+* Description: This function selects what OSQPost(), OSQPostFront() and OSQPostOpt() do when the queue
+*              is full.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              policy        determines what happens to a message posted to a full queue:
+*                            OS_Q_POLICY_DROP_TAIL    The new message is refused and the post returns
+*                                                     OS_ERR_Q_FULL (default).  The caller still owns
+*                                                     the message.
+*                            OS_Q_POLICY_DROP_HEAD    The oldest message is dropped to make room and the
+*                                                     post returns OS_ERR_NONE (lossy telemetry).
+*
+*              drop_fnct     is called with each message dropped by OS_Q_POLICY_DROP_HEAD, e.g. to free
+*                            it, or NULL.  See Note(s).
+*
+* Returns    : OS_ERR_NONE           The call was successful
+*              OS_ERR_INVALID_OPT    If 'policy' is not one of the above
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*
+* Note(s)    : 1) 'drop_fnct' runs with interrupts enabled, in the context of the post that dropped the
+*                 message.  It must thus be callable from an ISR if ISRs post to the queue directly
+*                 (OS_ISR_POST_DEFERRED_EN == 0).
+*              2) Each queue counts the messages dropped by either policy (see OSQQuery()).
+*              3) OSQPostPend() waits for room instead of applying the policy.
+*********************************************************************************************************
+*/
+
+#if OS_Q_POLICY_EN > 0u
+INT8U  OSQPolicySet (OS_EVENT        *pevent,
+                     INT8U            policy,
+                     OS_Q_DROP_FNCT   drop_fnct)
+{
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3u                          /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    if ((policy != OS_Q_POLICY_DROP_TAIL) &&          /* Validate policy                               */
+        (policy != OS_Q_POLICY_DROP_HEAD)) {
+        return (OS_ERR_INVALID_OPT);
+    }
+    OS_ENTER_CRITICAL();
+    pq              = (OS_Q *)pevent->OSEventPtr;     /* Point to queue control block                  */
+    pq->OSQPolicy   = policy;
+    pq->OSQDropFnct = drop_fnct;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -585,8 +749,15 @@ INT8U  OSQPendAbort (OS_EVENT  *pevent,
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while the ISR post queue is full.
+*                                    Other errors of ISR posts are only counted (see OS_IntQPost()).
 *
-* Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
+* Note(s)    : 1) As of V2.60, this function allows you to send NULL pointer messages.
+*              2) Tasks waiting in OSQPostPend() share the wait list of the queue.  They only wait while
+*                 it is full and tasks only wait for a message while it is empty, so the queue readies
+*                 a task waiting on it with 'pmsg' only when it holds no message.
+*              3) When the queue is full, its overflow policy (see OSQPolicySet()) either refuses 'pmsg'
+*                 (OS_ERR_Q_FULL) or drops the oldest message to make room (OS_ERR_NONE).
 *********************************************************************************************************
 */
 
@@ -595,6 +766,12 @@ INT8U  OSQPost (OS_EVENT  *pevent,
                 void      *pmsg)
 {
     OS_Q      *pq;
+    BOOLEAN    sched = OS_FALSE;
+#if OS_Q_POLICY_EN > 0u
+    BOOLEAN    dropped = OS_FALSE;
+    void      *pdrop;
+    OS_Q_DROP_FNCT  drop_fnct = (OS_Q_DROP_FNCT)0;
+#endif
 #if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -609,25 +786,68 @@ INT8U  OSQPost (OS_EVENT  *pevent,
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                           /* Called from ISR, defer to ISR queue task     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_POST, (void *)pevent, pmsg, 0u, 0u));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_Q_POST, pevent);
     OS_ENTER_CRITICAL();
-    if (pevent->OSEventGrp != 0u) {                    /* See if any task pending on queue             */
+    pq = (OS_Q *)pevent->OSEventPtr;                   /* Point to queue control block                 */
+    if ((pevent->OSEventGrp != 0u) &&                  /* See if any task pending on queue ...         */
+        (pq->OSQEntries == 0u)) {                      /* ... for a message (see Note 2)               */
                                                        /* Ready highest priority task waiting on event */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNPosts++;                               /* Message handed over without being queued     */
+        pq->OSQNPends++;
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                    /* Find highest priority task ready to run      */
         return (OS_ERR_NONE);
     }
-    pq = (OS_Q *)pevent->OSEventPtr;                   /* Point to queue control block                 */
+#if OS_Q_STAT_EN > 0u
+    OS_QStatUpd(pq);                                   /* Close the interval at the old occupancy      */
+#endif
     if (pq->OSQEntries >= pq->OSQSize) {               /* Make sure queue is not full                  */
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNFull++;
+#endif
+#if OS_Q_POLICY_EN > 0u
+        dropped = OS_QFull(pq, &pdrop);                /* Apply the overflow policy (see Note 3)       */
+        if (dropped == OS_FALSE) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_Q_FULL);
+        }
+        drop_fnct = pq->OSQDropFnct;                   /* Latched while the queue is locked            */
+#else
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
+#endif
     }
     *pq->OSQIn++ = pmsg;                               /* Insert message into queue                    */
     pq->OSQEntries++;                                  /* Update the nbr of entries in the queue       */
+#if OS_Q_STAT_EN > 0u
+    pq->OSQNPosts++;
+    if (pq->OSQEntries > pq->OSQEntriesMax) {          /* Track the high-water mark                    */
+        pq->OSQEntriesMax = pq->OSQEntries;
+    }
+#endif
     if (pq->OSQIn == pq->OSQEnd) {                     /* Wrap IN ptr if we are at end of queue        */
         pq->OSQIn = pq->OSQStart;
     }
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    sched = OS_EventSetSignal(pevent);                 /* Ready task pending on event set              */
+#endif
     OS_EXIT_CRITICAL();
+#if OS_Q_POLICY_EN > 0u
+    if (drop_fnct != (OS_Q_DROP_FNCT)0) {
+        drop_fnct(pdrop);                              /* Hand the dropped message back                */
+    }
+#endif
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
     return (OS_ERR_NONE);
 }
 #endif
@@ -648,8 +868,11 @@ INT8U  OSQPost (OS_EVENT  *pevent,
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while the ISR post queue is full.
+*                                    Other errors of ISR posts are only counted (see OS_IntQPost()).
 *
-* Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
+* Note(s)    : 1) As of V2.60, this function allows you to send NULL pointer messages.
+*              2) A full queue applies its overflow policy, as in OSQPost().
 *********************************************************************************************************
 */
 
@@ -658,6 +881,12 @@ INT8U  OSQPostFront (OS_EVENT  *pevent,
                      void      *pmsg)
 {
     OS_Q      *pq;
+    BOOLEAN    sched = OS_FALSE;
+#if OS_Q_POLICY_EN > 0u
+    BOOLEAN    dropped = OS_FALSE;
+    void      *pdrop;
+    OS_Q_DROP_FNCT  drop_fnct = (OS_Q_DROP_FNCT)0;
+#endif
 #if OS_CRITICAL_METHOD == 3u                          /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -672,18 +901,44 @@ INT8U  OSQPostFront (OS_EVENT  *pevent,
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                          /* Called from ISR, defer to ISR queue task      */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_POST_FRONT, (void *)pevent, pmsg, 0u, 0u));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_Q_POST, pevent);
     OS_ENTER_CRITICAL();
-    if (pevent->OSEventGrp != 0u) {                   /* See if any task pending on queue              */
+    pq = (OS_Q *)pevent->OSEventPtr;                  /* Point to queue control block                  */
+    if ((pevent->OSEventGrp != 0u) &&                 /* See if any task pending on queue ...          */
+        (pq->OSQEntries == 0u)) {                     /* ... for a message (see OSQPost())             */
                                                       /* Ready highest priority task waiting on event  */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNPosts++;                              /* Message handed over without being queued      */
+        pq->OSQNPends++;
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                   /* Find highest priority task ready to run       */
         return (OS_ERR_NONE);
     }
-    pq = (OS_Q *)pevent->OSEventPtr;                  /* Point to queue control block                  */
+#if OS_Q_STAT_EN > 0u
+    OS_QStatUpd(pq);                                  /* Close the interval at the old occupancy       */
+#endif
     if (pq->OSQEntries >= pq->OSQSize) {              /* Make sure queue is not full                   */
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNFull++;
+#endif
+#if OS_Q_POLICY_EN > 0u
+        dropped = OS_QFull(pq, &pdrop);               /* Apply the overflow policy                     */
+        if (dropped == OS_FALSE) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_Q_FULL);
+        }
+        drop_fnct = pq->OSQDropFnct;                  /* Latched while the queue is locked             */
+#else
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
+#endif
     }
     if (pq->OSQOut == pq->OSQStart) {                 /* Wrap OUT ptr if we are at the 1st queue entry */
         pq->OSQOut = pq->OSQEnd;
@@ -691,7 +946,24 @@ INT8U  OSQPostFront (OS_EVENT  *pevent,
     pq->OSQOut--;
     *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_Q_STAT_EN > 0u
+    pq->OSQNPosts++;
+    if (pq->OSQEntries > pq->OSQEntriesMax) {         /* Track the high-water mark                     */
+        pq->OSQEntriesMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    sched = OS_EventSetSignal(pevent);                /* Ready task pending on event set               */
+#endif
     OS_EXIT_CRITICAL();
+#if OS_Q_POLICY_EN > 0u
+    if (drop_fnct != (OS_Q_DROP_FNCT)0) {
+        drop_fnct(pdrop);                             /* Hand the dropped message back                 */
+    }
+#endif
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
     return (OS_ERR_NONE);
 }
 #endif
@@ -719,9 +991,13 @@ INT8U  OSQPostFront (OS_EVENT  *pevent,
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while the ISR post queue is full.
+*                                    Other errors of ISR posts are only counted (see OS_IntQPost()).
 *
 * Warning    : Interrupts can be disabled for a long time if you do a 'broadcast'.  In fact, the
 *              interrupt disable time is proportional to the number of tasks waiting on the queue.
+*
+* Note(s)    : A full queue applies its overflow policy, as in OSQPost().
 *********************************************************************************************************
 */
 
@@ -731,6 +1007,12 @@ INT8U  OSQPostOpt (OS_EVENT  *pevent,
                    INT8U      opt)
 {
     OS_Q      *pq;
+    BOOLEAN    sched = OS_FALSE;
+#if OS_Q_POLICY_EN > 0u
+    BOOLEAN    dropped = OS_FALSE;
+    void      *pdrop;
+    OS_Q_DROP_FNCT  drop_fnct = (OS_Q_DROP_FNCT)0;
+#endif
 #if OS_CRITICAL_METHOD == 3u                          /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0u;
 #endif
@@ -745,25 +1027,56 @@ INT8U  OSQPostOpt (OS_EVENT  *pevent,
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                          /* Called from ISR, defer to ISR queue task      */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_POST_OPT, (void *)pevent, pmsg, 0u, opt));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_Q_POST, pevent);
     OS_ENTER_CRITICAL();
-    if (pevent->OSEventGrp != 0x00u) {                /* See if any task pending on queue              */
+    pq = (OS_Q *)pevent->OSEventPtr;                  /* Point to queue control block                  */
+    if ((pevent->OSEventGrp != 0x00u) &&              /* See if any task pending on queue ...          */
+        (pq->OSQEntries == 0u)) {                     /* ... for a message (see OSQPost())             */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00u) { /* Do we need to post msg to ALL waiting tasks ? */
             while (pevent->OSEventGrp != 0u) {        /* Yes, Post to ALL tasks waiting on queue       */
                 (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_Q_STAT_EN > 0u
+                pq->OSQNPends++;
+#endif
             }
         } else {                                      /* No,  Post to HPT waiting on queue             */
             (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_Q_STAT_EN > 0u
+            pq->OSQNPends++;
+#endif
         }
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNPosts++;                              /* Message handed over without being queued      */
+#endif
         OS_EXIT_CRITICAL();
         if ((opt & OS_POST_OPT_NO_SCHED) == 0u) {	  /* See if scheduler needs to be invoked          */
             OS_Sched();                               /* Find highest priority task ready to run       */
         }
         return (OS_ERR_NONE);
     }
-    pq = (OS_Q *)pevent->OSEventPtr;                  /* Point to queue control block                  */
+#if OS_Q_STAT_EN > 0u
+    OS_QStatUpd(pq);                                  /* Close the interval at the old occupancy       */
+#endif
     if (pq->OSQEntries >= pq->OSQSize) {              /* Make sure queue is not full                   */
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNFull++;
+#endif
+#if OS_Q_POLICY_EN > 0u
+        dropped = OS_QFull(pq, &pdrop);               /* Apply the overflow policy                     */
+        if (dropped == OS_FALSE) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_Q_FULL);
+        }
+        drop_fnct = pq->OSQDropFnct;                  /* Latched while the queue is locked             */
+#else
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
+#endif
     }
     if ((opt & OS_POST_OPT_FRONT) != 0x00u) {         /* Do we post to the FRONT of the queue?         */
         if (pq->OSQOut == pq->OSQStart) {             /* Yes, Post as LIFO, Wrap OUT pointer if we ... */
@@ -778,7 +1091,172 @@ INT8U  OSQPostOpt (OS_EVENT  *pevent,
         }
     }
     pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_Q_STAT_EN > 0u
+    pq->OSQNPosts++;
+    if (pq->OSQEntries > pq->OSQEntriesMax) {         /* Track the high-water mark                     */
+        pq->OSQEntriesMax = pq->OSQEntries;
+    }
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    sched = OS_EventSetSignal(pevent);                /* Ready task pending on event set               */
+#endif
     OS_EXIT_CRITICAL();
+#if OS_Q_POLICY_EN > 0u
+    if (drop_fnct != (OS_Q_DROP_FNCT)0) {
+        drop_fnct(pdrop);                             /* Hand the dropped message back                 */
+    }
+#endif
+    if ((sched == OS_TRUE) &&
+        ((opt & OS_POST_OPT_NO_SCHED) == 0u)) {       /* See if scheduler needs to be invoked          */
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                POST MESSAGE TO A QUEUE, WAITING FOR ROOM
+*
+* Description: This function sends a message to a queue like OSQPost() but, if the queue is full, the
+*              calling task waits for room instead of applying the overflow policy of the queue.  This
+*              gives producers backpressure.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for room in the queue up to the amount of time specified by this
+*                            argument.  If you specify 0, however, your task will wait forever.
+*
+* Returns    : OS_ERR_NONE           The call was successful and the message was sent
+*              OS_ERR_TIMEOUT        If the queue stayed full for 'timeout' ticks; 'pmsg' was not sent
+*              OS_ERR_PEND_ABORT     If the wait was aborted or the queue deleted; 'pmsg' was not sent
+*              OS_ERR_Q_FULL         If the call could not wait and the queue refused 'pmsg' (Note 2)
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*
+* Note(s)    : 1) Every extraction readies ALL the tasks waiting for room.  Those that find the queue full
+*                 again wait for the rest of their timeout.
+*              2) From an ISR or with the scheduler locked, this function cannot wait and behaves like
+*                 OSQPost(): the overflow policy of the queue applies.
+*              3) A refused or timed-out message counts as a tail drop in the queue statistics.
+*********************************************************************************************************
+*/
+
+#if OS_Q_POLICY_EN > 0u
+INT8U  OSQPostPend (OS_EVENT  *pevent,
+                    void      *pmsg,
+                    INT32U     timeout)
+{
+    OS_Q      *pq;
+    INT32U     deadline;
+    INT32U     dly;
+    INT8U      pend_stat;
+    BOOLEAN    sched = OS_FALSE;
+#if OS_CRITICAL_METHOD == 3u                          /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    if ((OSIntNesting > 0u) ||                        /* Can't wait from an ISR ...                    */
+        (OSLockNesting > 0u)) {                       /* ... or with the scheduler locked (Note 2)     */
+        return (OSQPost(pevent, pmsg));
+    }
+    OS_TRACE(OS_TRACE_TYPE_Q_POST, pevent);
+    OS_ENTER_CRITICAL();
+    pq       = (OS_Q *)pevent->OSEventPtr;            /* Point to queue control block                  */
+    deadline = OSTime + timeout;
+    if (pq->OSQEntries >= pq->OSQSize) {
+        pq->OSQNPostWait++;
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNFull++;
+#endif
+    }
+    while (pq->OSQEntries >= pq->OSQSize) {           /* Wait until there is room in the queue         */
+        dly = 0u;
+        if (timeout > 0u) {                           /* Wait for what is left of the timeout (Note 1) */
+            dly = deadline - OSTime;
+            if ((dly == 0u) || (dly > timeout)) {
+                pq->OSQNDropTail++;
+                OS_EXIT_CRITICAL();
+                return (OS_ERR_TIMEOUT);
+            }
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_Q;         /* Task will have to pend for room in the queue  */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = dly;               /* Load timeout into TCB                         */
+        OS_EventTaskWait(pevent);                     /* Suspend task until room or timeout occurs     */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find next highest priority task ready to run  */
+        OS_ENTER_CRITICAL();
+        pend_stat = OSTCBCur->OSTCBStatPend;
+        if (pend_stat == OS_STAT_PEND_TO) {
+            OS_EventTaskRemove(OSTCBCur, pevent);
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;  /* Set   task  status to ready                   */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                        */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                      */
+#if (OS_EVENT_MULTI_EN > 0u)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        OSTCBCur->OSTCBMsg           = (void      *)0;
+        if (pevent->OSEventType != OS_EVENT_TYPE_Q) { /* Queue deleted while we waited                 */
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_PEND_ABORT);
+        }
+        if (pend_stat != OS_STAT_PEND_OK) {           /* Aborted or timed out                          */
+            pq->OSQNDropTail++;
+            OS_EXIT_CRITICAL();
+            if (pend_stat == OS_STAT_PEND_ABORT) {
+                return (OS_ERR_PEND_ABORT);
+            }
+            return (OS_ERR_TIMEOUT);
+        }
+    }
+#if OS_Q_STAT_EN > 0u
+    OS_QStatUpd(pq);                                  /* Close the interval at the old occupancy       */
+#endif
+    if ((pevent->OSEventGrp != 0u) &&                 /* See if any task pending on queue ...          */
+        (pq->OSQEntries == 0u)) {                     /* ... for a message (see OSQPost())             */
+                                                      /* Ready highest priority task waiting on event  */
+        (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_Q_STAT_EN > 0u
+        pq->OSQNPosts++;                              /* Message handed over without being queued      */
+        pq->OSQNPends++;
+#endif
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+    *pq->OSQIn++ = pmsg;                              /* Insert message into queue                     */
+    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+#if OS_Q_STAT_EN > 0u
+    pq->OSQNPosts++;
+    if (pq->OSQEntries > pq->OSQEntriesMax) {         /* Track the high-water mark                     */
+        pq->OSQEntriesMax = pq->OSQEntries;
+    }
+#endif
+    if (pq->OSQIn == pq->OSQEnd) {                    /* Wrap IN ptr if we are at end of queue         */
+        pq->OSQIn = pq->OSQStart;
+    }
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    sched = OS_EventSetSignal(pevent);                /* Ready task pending on event set               */
+#endif
+    OS_EXIT_CRITICAL();
+    if (sched == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
     return (OS_ERR_NONE);
 }
 #endif
@@ -798,6 +1276,8 @@ INT8U  OSQPostOpt (OS_EVENT  *pevent,
 *              OS_ERR_EVENT_TYPE   If you are attempting to obtain data from a non queue.
 *              OS_ERR_PEVENT_NULL  If 'pevent'   is a NULL pointer
 *              OS_ERR_PDATA_NULL   If 'p_q_data' is a NULL pointer
+*
+* Note(s)    : When the queue is full, the wait list holds the tasks waiting for room (OSQPostPend()).
 *********************************************************************************************************
 */
 
@@ -841,11 +1321,99 @@ INT8U  OSQQuery (OS_EVENT  *pevent,
     }
     p_q_data->OSNMsgs = pq->OSQEntries;
     p_q_data->OSQSize = pq->OSQSize;
+#if OS_Q_POLICY_EN > 0u
+    p_q_data->OSQPolicy    = pq->OSQPolicy;
+    p_q_data->OSQNDropHead = pq->OSQNDropHead;
+    p_q_data->OSQNDropTail = pq->OSQNDropTail;
+    p_q_data->OSQNPostWait = pq->OSQNPostWait;
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
 #endif                                                 /* OS_Q_QUERY_EN                                */
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        READ QUEUE TELEMETRY
+*
+* Description: This function obtains the telemetry that a message queue maintains on every post and
+*              pend.  Unlike OSQQuery(), it does not copy the wait list or look at the messages.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              p_q_stat      is a pointer to a structure that will receive the telemetry of the queue.
+*
+*              opt           OS_Q_STAT_OPT_NONE     only read the telemetry
+*                            OS_Q_STAT_OPT_RESET    also start a new measurement period: the counters
+*                                                   and the mean start over, the high-water mark starts
+*                                                   from the current number of entries
+*
+* Returns    : OS_ERR_NONE         The call was successful
+*              OS_ERR_EVENT_TYPE   If you are attempting to obtain data from a non queue.
+*              OS_ERR_PEVENT_NULL  If 'pevent'   is a NULL pointer
+*              OS_ERR_PDATA_NULL   If 'p_q_stat' is a NULL pointer
+*
+* Note(s)    : 1) The mean number of entries is weighted by the time spent at each occupancy, measured
+*                 with OS_TS_GET().  Intervals longer than the span of the time stamps are measured
+*                 with OSTime instead.
+*              2) The division computing the mean is done here, not on the post and pend paths.
+*********************************************************************************************************
+*/
+
+#if OS_Q_STAT_EN > 0u
+INT8U  OSQStatGet (OS_EVENT   *pevent,
+                   OS_Q_STAT  *p_q_stat,
+                   INT8U       opt)
+{
+    OS_Q       *pq;
+    INT64U      area;
+#if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_q_stat == (OS_Q_STAT *)0) {                  /* Validate 'p_q_stat'                          */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    pq = (OS_Q *)pevent->OSEventPtr;
+    OS_QStatUpd(pq);                                   /* Include the current occupancy up to now      */
+    p_q_stat->OSQSize       = pq->OSQSize;
+    p_q_stat->OSQEntries    = pq->OSQEntries;
+    p_q_stat->OSQEntriesMax = pq->OSQEntriesMax;
+    p_q_stat->OSQNPosts     = pq->OSQNPosts;
+    p_q_stat->OSQNPends     = pq->OSQNPends;
+    p_q_stat->OSQNFull      = pq->OSQNFull;
+    p_q_stat->OSQTime       = pq->OSQStatTime;
+    area                    = pq->OSQStatArea;
+    if (opt == OS_Q_STAT_OPT_RESET) {                  /* Start a new measurement period               */
+        pq->OSQEntriesMax = pq->OSQEntries;
+        pq->OSQNPosts     = 0u;
+        pq->OSQNPends     = 0u;
+        pq->OSQNFull      = 0u;
+        pq->OSQStatArea   = 0u;
+        pq->OSQStatTime   = 0u;
+    }
+    OS_EXIT_CRITICAL();
+    if (p_q_stat->OSQTime > 0u) {                      /* Mean number of entries, in 1/100 entry       */
+        p_q_stat->OSQEntriesAvg = (INT32U)(area * 100u / p_q_stat->OSQTime);
+    } else {
+        p_q_stat->OSQEntriesAvg = (INT32U)p_q_stat->OSQEntries * 100u;
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -889,5 +1457,114 @@ void  OS_QInit (void)
     OSQFreeList = &OSQTbl[0];
 #endif
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       APPLY THE OVERFLOW POLICY
+*
+* Description: This function is called by the post functions when the queue is full.
+*
+* Arguments  : pq            is a pointer to the queue control block of the full queue.
+*
+*              ppmsg         is where the oldest message is returned when it is dropped.
+*
+* Returns    : OS_TRUE       if the oldest message was removed to make room (OS_Q_POLICY_DROP_HEAD)
+*              OS_FALSE      if the new message must be refused (OS_Q_POLICY_DROP_TAIL)
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+#if OS_Q_POLICY_EN > 0u
+static  BOOLEAN  OS_QFull (OS_Q   *pq,
+                           void  **ppmsg)
+{
+    if (pq->OSQPolicy != OS_Q_POLICY_DROP_HEAD) {    /* Drop-tail: refuse the new message              */
+        pq->OSQNDropTail++;
+        return (OS_FALSE);
+    }
+    *ppmsg = *pq->OSQOut++;                          /* Drop-head: extract the oldest message          */
+    pq->OSQEntries--;
+    if (pq->OSQOut == pq->OSQEnd) {                  /* Wrap OUT pointer if we are at the end          */
+        pq->OSQOut = pq->OSQStart;
+    }
+    pq->OSQNDropHead++;
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    READY TASKS WAITING FOR ROOM
+*
+* Description: This function is called after a message was extracted from a non-empty queue.  Tasks
+*              waiting on the queue then wait for room (see OSQPostPend()): they are ALL readied and
+*              retry, the first ones to run getting the free entries.
+*
+* Arguments  : pevent        is a pointer to the event control block of the queue.
+*
+* Returns    : OS_TRUE       if tasks were readied, the caller must then call OS_Sched()
+*              OS_FALSE      if no task was waiting
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_QRoomRdy (OS_EVENT *pevent)
+{
+    if (pevent->OSEventGrp == 0u) {                  /* See if any task waiting for room               */
+        return (OS_FALSE);
+    }
+    while (pevent->OSEventGrp != 0u) {               /* Yes, ready ALL of them                         */
+        (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_Q, OS_STAT_PEND_OK);
+    }
+    return (OS_TRUE);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      UPDATE THE OCCUPANCY INTEGRAL
+*
+* Description: This function adds the time elapsed since the last change of the number of entries,
+*              weighted by that number, to the occupancy integral of the queue.  It is called just
+*              before the number of entries changes.
+*
+* Arguments  : pq            is a pointer to the queue control block.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) OS_TS_GET() wraps after about 6 s at 667 MHz.  An idle queue can stay unchanged for
+*                 longer, so OSTime measures intervals that long (at the resolution of a tick).
+*********************************************************************************************************
+*/
+
+#if OS_Q_STAT_EN > 0u
+static  void  OS_QStatUpd (OS_Q *pq)
+{
+    INT32U  ts;
+    INT32U  ticks;
+    INT64U  dt;
+
+
+    ts    = OS_TS_GET();
+    ticks = OSTime - pq->OSQStatTick;
+    if (ticks < OS_Q_STAT_TICKS_MAX) {               /* Time stamps did not wrap since last update     */
+        dt = (INT64U)(INT32U)(ts - pq->OSQStatTs);
+    } else {                                         /* Idle for too long, use the tick counter        */
+        dt = (INT64U)ticks * OS_Q_STAT_TS_PER_TICK;
+    }
+    pq->OSQStatTs    = ts;
+    pq->OSQStatTick += ticks;
+    pq->OSQStatArea += dt * pq->OSQEntries;
+    pq->OSQStatTime += dt;
+}
+#endif
 #endif                                               /* OS_Q_EN                                        */
 	 	   	  		 			 	    		   		 		 	 	 			 	    		   	 			 	  	 		 				 		  			 		 					 	  	  		      		  	   		      		  	 		 	      		   		 		  	 		 	      		  		  		  
@@ -0,0 +1,607 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                        ROUND-ROBIN SCHEDULING
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_RR.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micrim to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_SCHED_RR_EN > 0u
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#define  OS_RR_MUTEX_KEEP_LOWER_8   ((INT16U)0x00FFu)      /* Same encoding as OS_MUTEX.C              */
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_SchedRRUnlink  (OS_TCB *ptcb);
+static  void     OS_SchedRRLink    (OS_TCB *ptcb, INT8U prio, BOOLEAN rdy);
+static  void     OS_SchedRRRotate  (OS_SCHED_RR *prr, OS_TCB *pcur);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      CREATE A ROUND-ROBIN LEVEL
+*
+* Description: This function allows several tasks to share the same priority level.  The level occupies
+*              'nbr_tasks' consecutive priorities starting at 'prio'.  Every task subsequently created
+*              with OSTaskCreate() or OSTaskCreateExt() at ANY priority of the level is placed in the
+*              first free priority of the level.  The running task of a level is moved behind the other
+*              members of its level each time it consumes its time quantum, so that ready members of the
+*              level share the CPU in round-robin fashion.  Tasks outside of the level still see all the
+*              members as a single priority level.
+*
+* Arguments  : prio       is the highest priority of the level.  This is the priority that should be
+*                         passed to OSTaskCreate() for the members of the level.
+*
+*              nbr_tasks  is the maximum number of tasks in the level (2..OS_SCHED_RR_MAX_TASKS).
+*
+*              quantum    is the default time quantum (in ticks) of the members of the level.  Specify 0
+*                         to use OS_SCHED_RR_QUANTUM.
+*
+* Returns    : OS_ERR_NONE              if the level was created.
+*              OS_ERR_PRIO_INVALID      if the level does not fit below OS_LOWEST_PRIO.
+*              OS_ERR_RR_INVALID_NBR    if 'nbr_tasks' is out of range.
+*              OS_ERR_RR_PRIO_EXIST     if one of the priorities of the level is already used by a task,
+*                                       a mutex PIP or another level.
+*              OS_ERR_RR_NO_MORE_LEVELS if all OS_SCHED_RR_MAX_LEVELS levels are already created.
+*
+* Note(s)    : 1) The level must be created before any of its tasks.
+*
+*              2) A priority of the level designates a slot, not a task: the task found at a given
+*                 priority changes every time the level rotates.  Services such as OSTaskSuspend() or
+*                 OSTaskDel() should thus be called with OS_PRIO_SELF by the members themselves, or be
+*                 applied to all the priorities of the level.
+*
+*              3) A member which inherits the priority of a mutex (PIP) keeps its slot until it releases
+*                 the mutex and is not charged for the time it runs at the PIP.
+*********************************************************************************************************
+*/
+
+INT8U  OSSchedRRCreate (INT8U   prio,
+                        INT8U   nbr_tasks,
+                        INT16U  quantum)
+{
+    OS_SCHED_RR  *prr;
+    INT8U         i;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if ((nbr_tasks < 2u) || (nbr_tasks > OS_SCHED_RR_MAX_TASKS)) {
+        return (OS_ERR_RR_INVALID_NBR);
+    }
+    if ((INT16U)((INT16U)prio + (INT16U)nbr_tasks) > (INT16U)OS_LOWEST_PRIO) {
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    if (quantum == 0u) {
+        quantum = OS_SCHED_RR_QUANTUM;
+    }
+    OS_ENTER_CRITICAL();
+    if (OSSchedRRCtr >= OS_SCHED_RR_MAX_LEVELS) {          /* Any level left?                          */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RR_NO_MORE_LEVELS);
+    }
+    for (i = 0u; i < nbr_tasks; i++) {                     /* All slots of the level must be free      */
+        if ((OSTCBPrioTbl[prio + i] != (OS_TCB *)0) ||
+            (OS_SchedRRFind((INT8U)(prio + i)) != (OS_SCHED_RR *)0)) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_RR_PRIO_EXIST);
+        }
+    }
+    prr                    = &OSSchedRRTbl[OSSchedRRCtr];
+    prr->OSSchedRRPrio     = prio;
+    prr->OSSchedRRNbrTasks = nbr_tasks;
+    prr->OSSchedRRQuantum  = quantum;
+    prr->OSSchedRRRotCtr   = 0uL;
+    OSSchedRRCtr++;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    CHANGE THE TIME QUANTUM OF A TASK
+*
+* Description: This function changes the time quantum of a member of a round-robin level.
+*
+* Arguments  : prio       is the priority of the task or OS_PRIO_SELF.
+*
+*              quantum    is the new time quantum (in ticks).  Specify 0 to use the default quantum of the
+*                         level.
+*
+* Returns    : OS_ERR_NONE              if the quantum was changed.
+*              OS_ERR_PRIO_INVALID      if 'prio' is invalid.
+*              OS_ERR_TASK_NOT_EXIST    if there is no task at 'prio'.
+*              OS_ERR_RR_NOT_MEMBER     if the task is not a member of a round-robin level.
+*
+* Note(s)    : The quantum currently being consumed is shortened if it exceeds the new quantum.
+*********************************************************************************************************
+*/
+
+INT8U  OSSchedRRQuantumSet (INT8U   prio,
+                            INT16U  quantum)
+{
+    OS_TCB     *ptcb;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR   cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio >= OS_LOWEST_PRIO) {
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                            /* See if changing self                     */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb->OSTCBRRPtr == (OS_SCHED_RR *)0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_RR_NOT_MEMBER);
+    }
+    ptcb->OSTCBRRQuantum = quantum;
+    if (quantum == 0u) {
+        quantum = ptcb->OSTCBRRPtr->OSSchedRRQuantum;
+    }
+    if (ptcb->OSTCBRRQuantumCtr > quantum) {
+        ptcb->OSTCBRRQuantumCtr = quantum;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 FIND THE ROUND-ROBIN LEVEL OF A PRIORITY
+*
+* Description: This function returns the round-robin level that contains a given priority.
+*
+* Arguments  : prio       is the priority to look up.
+*
+* Returns    : A pointer to the level or, a NULL pointer if 'prio' does not belong to a level.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+OS_SCHED_RR  *OS_SchedRRFind (INT8U prio)
+{
+    OS_SCHED_RR  *prr;
+    INT8U         i;
+
+
+    prr = &OSSchedRRTbl[0];
+    for (i = 0u; i < OSSchedRRCtr; i++) {
+        if ((INT8U)(prio - prr->OSSchedRRPrio) < prr->OSSchedRRNbrTasks) {
+            return (prr);
+        }
+        prr++;
+    }
+    return ((OS_SCHED_RR *)0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          INITIALIZATION
+*
+* Description: This function is called by OSInit() to initialize the round-robin levels.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_SchedRRInit (void)
+{
+    OS_MemClr((INT8U *)&OSSchedRRTbl[0], sizeof(OSSchedRRTbl));
+    OSSchedRRCtr = 0u;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                MAP A PRIORITY TO A FREE SLOT OF ITS LEVEL
+*
+* Description: This function is called by OSTaskCreate() and OSTaskCreateExt() to place a new task in
+*              the first free priority of the round-robin level that 'prio' belongs to.
+*
+* Arguments  : prio       is the priority requested by the application.
+*
+* Returns    : The first free priority of the level or, 'prio' if it does not belong to a level or if the
+*              level is full (the caller then reports OS_ERR_PRIO_EXIST).
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+INT8U  OS_SchedRRPrioGet (INT8U prio)
+{
+    OS_SCHED_RR  *prr;
+    INT8U         i;
+
+
+    if (prio > OS_LOWEST_PRIO) {
+        return (prio);
+    }
+    prr = OS_SchedRRFind(prio);
+    if (prr == (OS_SCHED_RR *)0) {
+        return (prio);
+    }
+    for (i = 0u; i < prr->OSSchedRRNbrTasks; i++) {
+        if (OSTCBPrioTbl[prr->OSSchedRRPrio + i] == (OS_TCB *)0) {
+            return ((INT8U)(prr->OSSchedRRPrio + i));
+        }
+    }
+    return (prio);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 INITIALIZE THE ROUND-ROBIN FIELDS OF A TCB
+*
+* Description: This function is called by OS_TCBInit() to attach a new task to its round-robin level and
+*              to clear its quantum accounting.
+*
+* Arguments  : ptcb       is a pointer to the TCB of the task being created.
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_SchedRRTCBInit (OS_TCB *ptcb)
+{
+    OS_SCHED_RR  *prr;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    prr                     = OS_SchedRRFind(ptcb->OSTCBPrio);
+    OS_EXIT_CRITICAL();
+    ptcb->OSTCBRRPtr        = prr;
+    ptcb->OSTCBRRQuantum    = 0u;                          /* Use the quantum of the level             */
+    ptcb->OSTCBRRQuantumCtr = (prr != (OS_SCHED_RR *)0) ? prr->OSSchedRRQuantum : 0u;
+    ptcb->OSTCBRRTicks      = 0uL;
+    ptcb->OSTCBRRSliceCtr   = 0uL;
+#if (OS_MUTEX_EN > 0u) && (OS_MAX_EVENTS > 0u)
+    ptcb->OSTCBMutexPtr     = (OS_EVENT *)0;               /* Task owns no mutex                       */
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       CHARGE THE RUNNING TASK
+*
+* Description: This function is called by OSTimeTick() to charge one tick to the running task when it
+*              belongs to a round-robin level.  When the task exhausts its quantum and another member of
+*              its level is ready, the level is rotated so that the task goes behind all the other
+*              members.  The context switch itself is performed by OSIntExit().
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_SchedRRTick (void)
+{
+    OS_TCB       *ptcb;
+    OS_SCHED_RR  *prr;
+    OS_TCB       *pmember;
+    INT8U         prio;
+    INT8U         i;
+    BOOLEAN       contend;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR     cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    prr  = ptcb->OSTCBRRPtr;
+    if (prr == (OS_SCHED_RR *)0) {                         /* Is running task a member of a level?     */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    if ((INT8U)(ptcb->OSTCBPrio - prr->OSSchedRRPrio) >= prr->OSSchedRRNbrTasks) {
+        OS_EXIT_CRITICAL();                                /* No, running at a mutex PIP               */
+        return;
+    }
+    ptcb->OSTCBRRTicks++;
+    if (ptcb->OSTCBRRQuantumCtr > 1u) {                    /* Quantum not consumed yet                 */
+        ptcb->OSTCBRRQuantumCtr--;
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    ptcb->OSTCBRRSliceCtr++;                               /* Quantum consumed, reload it              */
+    ptcb->OSTCBRRQuantumCtr = (ptcb->OSTCBRRQuantum != 0u) ? ptcb->OSTCBRRQuantum
+                                                           : prr->OSSchedRRQuantum;
+    contend = OS_FALSE;                                    /* Is another member of the level ready?    */
+    for (i = 0u; i < prr->OSSchedRRNbrTasks; i++) {
+        prio    = (INT8U)(prr->OSSchedRRPrio + i);
+        pmember = OSTCBPrioTbl[prio];
+        if ((pmember != ptcb)                       &&
+            (pmember != (OS_TCB *)0)                &&
+            (pmember != OS_TCB_RESERVED)            &&
+            (pmember->OSTCBPrio == prio)            &&
+            ((OSRdyTbl[pmember->OSTCBY] & pmember->OSTCBBitX) != 0u)) {
+            contend = OS_TRUE;
+            break;
+        }
+    }
+    if (contend == OS_TRUE) {
+        OS_SchedRRRotate(prr, ptcb);
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         ROTATE A LEVEL
+*
+* Description: This function moves every member of a level one position ahead in the round-robin order
+*              and places 'pcur' behind all of them.  Members keep their ready state and their position
+*              in the wait list of the event(s) they are pending on.
+*
+* Arguments  : prr        is a pointer to the level.
+*
+*              pcur       is a pointer to the TCB of the task that consumed its quantum.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) Members running at a mutex PIP keep their slot.
+*              3) The owner priority recorded in the mutexes owned by a member is updated so that
+*                 OSMutexPost() restores the member at its new slot.  Only the mutexes linked to the
+*                 members (OSTCBMutexPtr) are visited, not the whole OSEventTbl[].
+*********************************************************************************************************
+*/
+
+static  void  OS_SchedRRRotate (OS_SCHED_RR  *prr,
+                                OS_TCB       *pcur)
+{
+    OS_TCB    *ptcbs[OS_SCHED_RR_MAX_TASKS];
+    INT8U      prios[OS_SCHED_RR_MAX_TASKS];
+    BOOLEAN    rdys[OS_SCHED_RR_MAX_TASKS];
+    OS_TCB    *ptcb;
+    INT8U      nbr;
+    INT8U      cur;
+    INT8U      prio;
+    INT8U      i;
+    INT8U      j;
+#if (OS_MUTEX_EN > 0u) && (OS_MAX_EVENTS > 0u)
+    OS_EVENT  *pevent;
+#endif
+
+
+    nbr = 0u;
+    cur = 0u;
+    for (i = 0u; i < prr->OSSchedRRNbrTasks; i++) {        /* Collect the members, in slot order       */
+        prio = (INT8U)(prr->OSSchedRRPrio + i);
+        ptcb = OSTCBPrioTbl[prio];
+        if ((ptcb != (OS_TCB *)0) && (ptcb != OS_TCB_RESERVED) && (ptcb->OSTCBPrio == prio)) {
+            if (ptcb == pcur) {
+                cur = nbr;
+            }
+            ptcbs[nbr] = ptcb;
+            prios[nbr] = prio;
+            nbr++;
+        }
+    }
+    for (i = 0u; i < nbr; i++) {                           /* Take all members out of the lists ...    */
+        rdys[i]               = OS_SchedRRUnlink(ptcbs[i]);
+        OSTCBPrioTbl[prios[i]] = (OS_TCB *)0;
+    }
+    for (i = 0u; i < nbr; i++) {                           /* ... and put them back, rotated           */
+        j = (INT8U)((cur + 1u + i) % nbr);
+        OS_SchedRRLink(ptcbs[j], prios[i], rdys[j]);
+    }
+    if (pcur == OSTCBCur) {
+        OSPrioCur = pcur->OSTCBPrio;                       /* Let OSIntExit() see the rotation         */
+    }
+    prr->OSSchedRRRotCtr++;
+
+#if (OS_MUTEX_EN > 0u) && (OS_MAX_EVENTS > 0u)
+    for (i = 0u; i < nbr; i++) {                           /* Update the owner prio of owned mutexes   */
+        ptcb   = ptcbs[i];
+        pevent = ptcb->OSTCBMutexPtr;
+        while (pevent != (OS_EVENT *)0) {
+            pevent->OSEventCnt &= (INT16U)~OS_RR_MUTEX_KEEP_LOWER_8;
+            pevent->OSEventCnt |= (INT16U)ptcb->OSTCBPrio;
+            pevent              = pevent->OSEventMutexNext;
+        }
+    }
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              REMOVE A TASK FROM THE READY AND WAIT LISTS
+*
+* Description: This function clears the bits of a task in the ready list and in the wait list of the
+*              event(s) it is pending on.
+*
+* Arguments  : ptcb       is a pointer to the TCB of the task.
+*
+* Returns    : OS_TRUE    if the task was ready to run.
+*              OS_FALSE   otherwise.
+*
+* Note(s)    : Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_SchedRRUnlink (OS_TCB *ptcb)
+{
+    BOOLEAN    rdy;
+    INT8U      y;
+#if (OS_EVENT_EN)
+    OS_EVENT  *pevent;
+#if (OS_EVENT_MULTI_EN > 0u)
+    OS_EVENT **pevents;
+#endif
+#endif
+
+
+    y   = ptcb->OSTCBY;
+    rdy = OS_FALSE;
+    if ((OSRdyTbl[y] & ptcb->OSTCBBitX) != 0u) {
+        OSRdyTbl[y] &= (OS_PRIO)~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0u) {
+            OSRdyGrp &= (OS_PRIO)~ptcb->OSTCBBitY;
+        }
+        rdy = OS_TRUE;
+    }
+#if (OS_EVENT_EN)
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {
+        pevent->OSEventTbl[y] &= (OS_PRIO)~ptcb->OSTCBBitX;
+        if (pevent->OSEventTbl[y] == 0u) {
+            pevent->OSEventGrp &= (OS_PRIO)~ptcb->OSTCBBitY;
+        }
+    }
+#if (OS_EVENT_MULTI_EN > 0u)
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if (pevents != (OS_EVENT **)0) {
+        pevent = *pevents;
+        while (pevent != (OS_EVENT *)0) {
+            pevent->OSEventTbl[y] &= (OS_PRIO)~ptcb->OSTCBBitX;
+            if (pevent->OSEventTbl[y] == 0u) {
+                pevent->OSEventGrp &= (OS_PRIO)~ptcb->OSTCBBitY;
+            }
+            pevents++;
+            pevent = *pevents;
+        }
+    }
+#endif
+#endif
+    return (rdy);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             PLACE A TASK AT A NEW PRIORITY OF ITS LEVEL
+*
+* Description: This function assigns a new priority to a task previously removed from the lists by
+*              OS_SchedRRUnlink() and puts it back in the ready list and in the wait list of the event(s)
+*              it is pending on.
+*
+* Arguments  : ptcb       is a pointer to the TCB of the task.
+*
+*              prio       is the new priority of the task.
+*
+*              rdy        indicates whether the task was ready to run.
+*
+* Returns    : none
+*
+* Note(s)    : Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  void  OS_SchedRRLink (OS_TCB   *ptcb,
+                              INT8U     prio,
+                              BOOLEAN   rdy)
+{
+#if (OS_EVENT_EN)
+    OS_EVENT  *pevent;
+#if (OS_EVENT_MULTI_EN > 0u)
+    OS_EVENT **pevents;
+#endif
+#endif
+
+
+    ptcb->OSTCBPrio    = prio;
+#if OS_LOWEST_PRIO <= 63u
+    ptcb->OSTCBY       = (INT8U)(prio >> 3u);
+    ptcb->OSTCBX       = (INT8U)(prio & 0x07u);
+#else
+    ptcb->OSTCBY       = (INT8U)((INT8U)(prio >> 4u) & 0xFFu);
+    ptcb->OSTCBX       = (INT8U)(prio & 0x0Fu);
+#endif
+    ptcb->OSTCBBitY    = (OS_PRIO)(1uL << ptcb->OSTCBY);
+    ptcb->OSTCBBitX    = (OS_PRIO)(1uL << ptcb->OSTCBX);
+    OSTCBPrioTbl[prio] = ptcb;
+    if (rdy == OS_TRUE) {
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    }
+#if (OS_EVENT_EN)
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {
+        pevent->OSEventGrp               |= ptcb->OSTCBBitY;
+        pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+    }
+#if (OS_EVENT_MULTI_EN > 0u)
+    pevents = ptcb->OSTCBEventMultiPtr;
+    if (pevents != (OS_EVENT **)0) {
+        pevent = *pevents;
+        while (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp               |= ptcb->OSTCBBitY;
+            pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+            pevents++;
+            pevent = *pevents;
+        }
+    }
+#endif
+#endif
+}
+#endif                                                     /* OS_SCHED_RR_EN                           */
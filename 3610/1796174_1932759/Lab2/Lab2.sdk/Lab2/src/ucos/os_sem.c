@@ -209,6 +209,9 @@ OS_EVENT  *OSSemDel (OS_EVENT  *pevent,
              if (tasks_waiting == OS_FALSE) {
 #if OS_EVENT_NAME_EN > 0u
                  pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+                 OS_EventSetUnlink(pevent);                /* Remove semaphore from its event set      */
 #endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
                  pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
@@ -230,6 +233,9 @@ OS_EVENT  *OSSemDel (OS_EVENT  *pevent,
              }
 #if OS_EVENT_NAME_EN > 0u
              pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+             OS_EventSetUnlink(pevent);                    /* Remove semaphore from its event set      */
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
              pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
@@ -331,6 +337,7 @@ void  OSSemPend (OS_EVENT  *pevent,
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
     OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_TRACE(OS_TRACE_TYPE_SEM_PEND, pevent);
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -465,6 +472,8 @@ INT8U  OSSemPendAbort (OS_EVENT  *pevent,
 *                                  OSSemAccept() or OSSemPend().
 *              OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a semaphore
 *              OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*              OS_ERR_INT_Q_FULL   If called from an ISR while the ISR post queue is full.
+*                                  Other errors of ISR posts are only counted (see OS_IntQPost()).
 *********************************************************************************************************
 */
 
@@ -484,6 +493,12 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     if (pevent->OSEventType != OS_EVENT_TYPE_SEM) {   /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0u
+    if (OSIntNesting > 0u) {                          /* Called from ISR, defer to ISR queue task      */
+        return (OS_IntQPost(OS_INT_Q_TYPE_SEM_POST, (void *)pevent, (void *)0, 0u, 0u));
+    }
+#endif
+    OS_TRACE(OS_TRACE_TYPE_SEM_POST, pevent);
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0u) {                   /* See if any task waiting for semaphore         */
                                                       /* Ready HPT waiting on event                    */
@@ -494,6 +509,13 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     }
     if (pevent->OSEventCnt < 65535u) {                /* Make sure semaphore will not overflow         */
         pevent->OSEventCnt++;                         /* Increment semaphore count to register event   */
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+        if (OS_EventSetSignal(pevent) == OS_TRUE) {   /* Ready task pending on event set               */
+            OS_EXIT_CRITICAL();
+            OS_Sched();                               /* Find highest priority task ready to run       */
+            return (OS_ERR_NONE);
+        }
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
     }
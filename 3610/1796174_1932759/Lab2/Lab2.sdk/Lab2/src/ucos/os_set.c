@@ -0,0 +1,756 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                         EVENT SET MANAGEMENT
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_SET.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  INT8U    OS_EventSetCollect (OS_EVENT_SET  *pset,
+                                     OS_EVENT     **pevents_rdy,
+                                     INT8U          nbr_max);
+
+static  BOOLEAN  OS_EventSetMemberRdy (OS_EVENT    *pevent);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  ACCEPT READY MEMBERS OF AN EVENT SET
+*
+* Description: This function returns the members of an event set that are ready (i.e. that would not
+*              block if pended on) without suspending the calling task.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the event set.
+*
+*              pevents_rdy   is a pointer to an array where the ready members are returned, highest
+*                            member priority first.
+*
+*              nbr_max       is the number of entries of 'pevents_rdy'.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         At least one member is ready.
+*                            OS_ERR_SET_EMPTY    No member is ready.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to an event set.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' or 'pevents_rdy' is a NULL pointer.
+*
+* Returns    : The number of ready members returned in 'pevents_rdy'.
+*
+* Note(s)    : 1) The members are NOT consumed: the caller must call OSQAccept(), OSSemAccept() or
+*                 OSMboxAccept() on the returned members.
+*********************************************************************************************************
+*/
+
+#if OS_EVENT_SET_ACCEPT_EN > 0u
+INT8U  OSEventSetAccept (OS_EVENT   *pevent,
+                         OS_EVENT  **pevents_rdy,
+                         INT8U       nbr_max,
+                         INT8U      *perr)
+{
+    INT8U      nbr_rdy;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if ((pevent == (OS_EVENT *)0) || (pevents_rdy == (OS_EVENT **)0)) {
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0u);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SET) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0u);
+    }
+    OS_ENTER_CRITICAL();
+    nbr_rdy = OS_EventSetCollect((OS_EVENT_SET *)pevent->OSEventPtr, pevents_rdy, nbr_max);
+    OS_EXIT_CRITICAL();
+    if (nbr_rdy == 0u) {
+        *perr = OS_ERR_SET_EMPTY;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    return (nbr_rdy);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ADD A MEMBER TO AN EVENT SET
+*
+* Description: This function registers a queue, a semaphore or a mailbox with an event set.  Once
+*              registered, every post to the member that is not consumed by a task pending directly on it
+*              marks the member ready in the set in constant time.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the event set.
+*
+*              pmember       is a pointer to the event control block of the queue, semaphore or mailbox.
+*
+*              prio          is the priority of the member within the set (0 == highest).  Ready members
+*                            are returned by OSEventSetPend() in priority order.
+*
+* Returns    : OS_ERR_NONE              The member was added.
+*              OS_ERR_PEVENT_NULL       If 'pevent' or 'pmember' is a NULL pointer.
+*              OS_ERR_EVENT_TYPE        If 'pevent' is not an event set or, 'pmember' is not a queue, a
+*                                       semaphore or a mailbox.
+*              OS_ERR_SET_PRIO_INVALID  If 'prio' is >= OS_EVENT_SET_SIZE.
+*              OS_ERR_SET_PRIO_EXIST    If another member already uses 'prio'.
+*              OS_ERR_SET_MEMBER        If 'pmember' already belongs to an event set.
+*
+* Note(s)    : 1) A member can only belong to one event set at a time.
+*              2) A member that already holds messages or a non-zero count is marked ready immediately.
+*********************************************************************************************************
+*/
+
+INT8U  OSEventSetAdd (OS_EVENT  *pevent,
+                      OS_EVENT  *pmember,
+                      INT8U      prio)
+{
+    OS_EVENT_SET  *pset;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if ((pevent == (OS_EVENT *)0) || (pmember == (OS_EVENT *)0)) {
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (prio >= OS_EVENT_SET_SIZE) {
+        return (OS_ERR_SET_PRIO_INVALID);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SET) {        /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    switch (pmember->OSEventType) {                        /* Only objects with a 'count' or messages  */
+        case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_SEM:
+        case OS_EVENT_TYPE_MBOX:
+             break;
+
+        default:
+             return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (pmember->OSEventSetPtr != (OS_EVENT *)0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_SET_MEMBER);
+    }
+    pset = (OS_EVENT_SET *)pevent->OSEventPtr;
+    if (pset->OSSetTbl[prio] != (OS_EVENT *)0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_SET_PRIO_EXIST);
+    }
+    pset->OSSetTbl[prio]    = pmember;
+    pset->OSSetEntries++;
+    pmember->OSEventSetPtr  = pevent;
+    pmember->OSEventSetPrio = prio;
+    if (OS_EventSetMemberRdy(pmember) == OS_TRUE) {        /* Member already ready?                    */
+        if (OS_EventSetSignal(pmember) == OS_TRUE) {
+            OS_EXIT_CRITICAL();
+            OS_Sched();                                    /* Find HPT ready to run                    */
+            return (OS_ERR_NONE);
+        }
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          CREATE AN EVENT SET
+*
+* Description: This function creates an empty event set.
+*
+* Arguments  : perr          is a pointer to an error code that will be returned to your application:
+*                               OS_ERR_NONE          if the call was successful.
+*                               OS_ERR_CREATE_ISR    if you attempted to create an event set from an ISR.
+*                               OS_ERR_PEVENT_NULL   if no event control block or event set was available.
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control block (OS_EVENT) associated with the
+*                                created event set.
+*              == (OS_EVENT *)0  if no event control block or event set was available.
+*********************************************************************************************************
+*/
+
+OS_EVENT  *OSEventSetCreate (INT8U  *perr)
+{
+    OS_EVENT      *pevent;
+    OS_EVENT_SET  *pset;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == OS_TRUE) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    pset   = OSEventSetFreeList;                           /* Get a free event set                     */
+    if ((pevent == (OS_EVENT *)0) || (pset == (OS_EVENT_SET *)0)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    OSEventFreeList    = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    OSEventSetFreeList = pset->OSSetPtr;
+    OS_EXIT_CRITICAL();
+    OS_MemClr((INT8U *)pset, sizeof(OS_EVENT_SET));        /* No member, none ready                    */
+    pevent->OSEventType    = OS_EVENT_TYPE_SET;
+    pevent->OSEventCnt     = 0u;
+    pevent->OSEventPtr     = pset;
+    pevent->OSEventSetPtr  = (OS_EVENT *)0;
+#if OS_EVENT_NAME_EN > 0u
+    pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+    OS_EventWaitListInit(pevent);                          /* Initalize the wait list                  */
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          DELETE AN EVENT SET
+*
+* Description: This function deletes an event set.  Its members are released (they are NOT deleted).
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the event set.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the event set ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the event set even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the event set was deleted
+*                            OS_ERR_DEL_ISR          If you tried to delete the event set from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the event set
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to an event set
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the event set was successfully deleted.
+*
+* Note(s)    : 1) Tasks readied by OS_DEL_ALWAYS return from OSEventSetPend() with OS_ERR_PEND_ABORT.
+*              2) The interrupt disable time is proportional to OS_EVENT_SET_SIZE.
+*********************************************************************************************************
+*/
+
+#if OS_EVENT_SET_DEL_EN > 0u
+OS_EVENT  *OSEventSetDel (OS_EVENT  *pevent,
+                          INT8U      opt,
+                          INT8U     *perr)
+{
+    OS_EVENT_SET  *pset;
+    BOOLEAN        tasks_waiting;
+    INT8U          i;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SET) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    if ((opt != OS_DEL_NO_PEND) && (opt != OS_DEL_ALWAYS)) {
+        *perr = OS_ERR_INVALID_OPT;
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0u) {                        /* See if any tasks waiting on event set    */
+        tasks_waiting = OS_TRUE;
+    } else {
+        tasks_waiting = OS_FALSE;
+    }
+    if ((tasks_waiting == OS_TRUE) && (opt == OS_DEL_NO_PEND)) {
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TASK_WAITING;
+        return (pevent);
+    }
+    while (pevent->OSEventGrp != 0u) {                     /* Ready ALL tasks waiting for event set    */
+        (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_SET, OS_STAT_PEND_ABORT);
+    }
+    pset = (OS_EVENT_SET *)pevent->OSEventPtr;
+    for (i = 0u; i < OS_EVENT_SET_SIZE; i++) {             /* Release the members                      */
+        if (pset->OSSetTbl[i] != (OS_EVENT *)0) {
+            pset->OSSetTbl[i]->OSEventSetPtr = (OS_EVENT *)0;
+            pset->OSSetTbl[i]                = (OS_EVENT *)0;
+        }
+    }
+    pset->OSSetPtr         = OSEventSetFreeList;           /* Return event set to free list            */
+    OSEventSetFreeList     = pset;
+#if OS_EVENT_NAME_EN > 0u
+    pevent->OSEventName    = (INT8U *)(void *)"?";
+#endif
+    pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+    pevent->OSEventPtr     = OSEventFreeList;              /* Return Event Control Block to free list  */
+    pevent->OSEventCnt     = 0u;
+    OSEventFreeList        = pevent;
+    OS_EXIT_CRITICAL();
+    if (tasks_waiting == OS_TRUE) {                        /* Reschedule only if task(s) were waiting  */
+        OS_Sched();                                        /* Find highest priority task ready to run  */
+    }
+    *perr = OS_ERR_NONE;
+    return ((OS_EVENT *)0);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PEND ON AN EVENT SET
+*
+* Description: This function waits until at least one member of an event set is ready and returns the
+*              ready members in priority order.  Unlike OSEventPendMulti(), the members are NOT linked
+*              into and out of the task's wait lists: only the wait list of the event set is used, so the
+*              cost of a wait does not depend on the number of members.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the event set.
+*
+*              pevents_rdy   is a pointer to an array where the ready members are returned, highest
+*                            member priority first.
+*
+*              nbr_max       is the number of entries of 'pevents_rdy'.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a member to be ready up to the amount of time specified by this
+*                            argument.  If you specify 0, however, your task will wait forever.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         At least one member is ready.
+*                            OS_ERR_TIMEOUT      No member was ready within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the event set was aborted.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to an event set.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' or 'pevents_rdy' is a NULL pointer.
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler locked.
+*
+* Returns    : The number of ready members returned in 'pevents_rdy' (0 upon timeout or error).
+*
+* Note(s)    : 1) The members are NOT consumed: the caller must call OSQAccept(), OSSemAccept() or
+*                 OSMboxAccept() on the returned members.
+*              2) If the member that readied the task is consumed by another task before this task runs,
+*                 the task waits again with the full 'timeout'.
+*********************************************************************************************************
+*/
+
+INT8U  OSEventSetPend (OS_EVENT   *pevent,
+                       OS_EVENT  **pevents_rdy,
+                       INT8U       nbr_max,
+                       INT32U      timeout,
+                       INT8U      *perr)
+{
+    OS_EVENT_SET  *pset;
+    INT8U          nbr_rdy;
+    INT8U          pend_stat;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if ((pevent == (OS_EVENT *)0) || (pevents_rdy == (OS_EVENT **)0)) {
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0u);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SET) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0u);
+    }
+    if (OSIntNesting > 0u) {                               /* See if called from ISR ...               */
+        *perr = OS_ERR_PEND_ISR;                           /* ... can't PEND from an ISR               */
+        return (0u);
+    }
+    if (OSLockNesting > 0u) {                              /* See if called with scheduler locked ...  */
+        *perr = OS_ERR_PEND_LOCKED;                        /* ... can't PEND when locked               */
+        return (0u);
+    }
+    pset = (OS_EVENT_SET *)pevent->OSEventPtr;
+    OS_ENTER_CRITICAL();
+    for (;;) {
+        nbr_rdy = OS_EventSetCollect(pset, pevents_rdy, nbr_max);
+        if (nbr_rdy > 0u) {                                /* Any member ready?                        */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_NONE;
+            return (nbr_rdy);
+        }
+        OSTCBCur->OSTCBStat     |= OS_STAT_SET;            /* Task will have to pend on the event set  */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OSTCBCur->OSTCBDly       = timeout;                /* Load timeout into TCB                    */
+        OS_EventTaskWait(pevent);                          /* Suspend task until member ready or TO    */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                        /* Find next highest priority task ready    */
+        OS_ENTER_CRITICAL();
+        pend_stat = OSTCBCur->OSTCBStatPend;
+        if (pend_stat == OS_STAT_PEND_TO) {
+            OS_EventTaskRemove(OSTCBCur, pevent);
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;       /* Set   task  status to ready              */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;   /* Clear pend  status                       */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;     /* Clear event pointers                     */
+#if (OS_EVENT_MULTI_EN > 0u)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        OSTCBCur->OSTCBMsg           = (void      *)0;
+        if (pend_stat == OS_STAT_PEND_ABORT) {
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_PEND_ABORT;                     /* Indicate that we aborted                 */
+            return (0u);
+        }
+        if (pend_stat != OS_STAT_PEND_OK) {
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TIMEOUT;                        /* Indicate that we didn't get a member     */
+            return (0u);
+        }
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   REMOVE A MEMBER FROM AN EVENT SET
+*
+* Description: This function unregisters a queue, a semaphore or a mailbox from an event set.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the event set.
+*
+*              pmember       is a pointer to the event control block of the member.
+*
+* Returns    : OS_ERR_NONE              The member was removed.
+*              OS_ERR_PEVENT_NULL       If 'pevent' or 'pmember' is a NULL pointer.
+*              OS_ERR_EVENT_TYPE        If 'pevent' is not an event set.
+*              OS_ERR_SET_NOT_MEMBER    If 'pmember' does not belong to the event set.
+*********************************************************************************************************
+*/
+
+INT8U  OSEventSetRemove (OS_EVENT  *pevent,
+                         OS_EVENT  *pmember)
+{
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if ((pevent == (OS_EVENT *)0) || (pmember == (OS_EVENT *)0)) {
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_SET) {        /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (pmember->OSEventSetPtr != pevent) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_SET_NOT_MEMBER);
+    }
+    OS_EventSetUnlink(pmember);
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    EVENT SET MODULE INITIALIZATION
+*
+* Description : This function is called by uC/OS-II to initialize the event set module.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)     : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_EventSetInit (void)
+{
+    INT16U         ix;
+    OS_EVENT_SET  *pset;
+
+
+    OS_MemClr((INT8U *)&OSEventSetTbl[0], sizeof(OSEventSetTbl));  /* Clear the event set table       */
+    pset = &OSEventSetTbl[0];
+    for (ix = 0u; ix < (OS_MAX_EVENT_SETS - 1u); ix++) {   /* Init. list of free event sets            */
+        pset->OSSetPtr = &OSEventSetTbl[ix + 1u];
+        pset++;
+    }
+    pset->OSSetPtr     = (OS_EVENT_SET *)0;
+    OSEventSetFreeList = &OSEventSetTbl[0];
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   MARK A MEMBER READY IN ITS EVENT SET
+*
+* Description: This function is called by OSQPost(), OSQPostFront(), OSQPostOpt(), OSSemPost(),
+*              OSMboxPost() and OSMboxPostOpt() when a post was NOT consumed by a task pending directly on
+*              the member.  The member is marked ready in its event set and the highest priority task
+*              pending on the set, if any, is readied.
+*
+* Arguments  : pmember       is a pointer to the event control block of the member that was posted to.
+*
+* Returns    : OS_TRUE       if a task pending on the event set was readied (the caller must call
+*                            OS_Sched() once interrupts are re-enabled).
+*              OS_FALSE      otherwise.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+BOOLEAN  OS_EventSetSignal (OS_EVENT *pmember)
+{
+    OS_EVENT      *pevent;
+    OS_EVENT_SET  *pset;
+    INT8U          prio;
+
+
+    pevent = pmember->OSEventSetPtr;
+    if (pevent == (OS_EVENT *)0) {                         /* Does member belong to an event set?      */
+        return (OS_FALSE);
+    }
+    pset                            = (OS_EVENT_SET *)pevent->OSEventPtr;
+    prio                            = pmember->OSEventSetPrio;
+    pset->OSSetRdyGrp              |= (INT8U)(1u << (prio >> 3u));
+    pset->OSSetRdyTbl[prio >> 3u]  |= (INT8U)(1u << (prio & 0x07u));
+    if (pevent->OSEventGrp == 0u) {                        /* Any task pending on the event set?       */
+        return (OS_FALSE);
+    }
+    (void)OS_EventTaskRdy(pevent, (void *)pmember, OS_STAT_SET, OS_STAT_PEND_OK);
+    return (OS_TRUE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 REMOVE A MEMBER FROM ITS EVENT SET
+*
+* Description: This function is called by OSEventSetRemove() and when a queue, a semaphore or a mailbox
+*              is deleted to release its entry in its event set.
+*
+* Arguments  : pmember       is a pointer to the event control block of the member.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_EventSetUnlink (OS_EVENT *pmember)
+{
+    OS_EVENT      *pevent;
+    OS_EVENT_SET  *pset;
+    INT8U          prio;
+
+
+    pevent = pmember->OSEventSetPtr;
+    if (pevent == (OS_EVENT *)0) {
+        return;
+    }
+    pset                            = (OS_EVENT_SET *)pevent->OSEventPtr;
+    prio                            = pmember->OSEventSetPrio;
+    pset->OSSetRdyTbl[prio >> 3u]  &= (INT8U)~(1u << (prio & 0x07u));
+    if (pset->OSSetRdyTbl[prio >> 3u] == 0u) {
+        pset->OSSetRdyGrp          &= (INT8U)~(1u << (prio >> 3u));
+    }
+    pset->OSSetTbl[prio]            = (OS_EVENT *)0;
+    pset->OSSetEntries--;
+    pmember->OSEventSetPtr          = (OS_EVENT *)0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   COLLECT THE READY MEMBERS OF A SET
+*
+* Description: This function walks the ready bitmap of an event set, highest member priority first.
+*              Members whose ready bit is set but that have been consumed since (e.g. by OSQAccept()) are
+*              cleared from the bitmap on the way.
+*
+* Arguments  : pset          is a pointer to the event set.
+*
+*              pevents_rdy   is a pointer to an array where the ready members are returned.
+*
+*              nbr_max       is the number of entries of 'pevents_rdy'.
+*
+* Returns    : The number of ready members returned in 'pevents_rdy'.
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) The cost is proportional to the number of ready bits visited, not to the number of
+*                 members of the set.
+*********************************************************************************************************
+*/
+
+static  INT8U  OS_EventSetCollect (OS_EVENT_SET  *pset,
+                                   OS_EVENT     **pevents_rdy,
+                                   INT8U          nbr_max)
+{
+    OS_EVENT  *pmember;
+    INT8U      grp;
+    INT8U      tbl;
+    INT8U      x;
+    INT8U      y;
+    INT8U      nbr_rdy;
+
+
+    nbr_rdy = 0u;
+    grp     = pset->OSSetRdyGrp;
+    while ((grp != 0u) && (nbr_rdy < nbr_max)) {
+        y   = OSUnMapTbl[grp];
+        tbl = pset->OSSetRdyTbl[y];
+        while ((tbl != 0u) && (nbr_rdy < nbr_max)) {
+            x       = OSUnMapTbl[tbl];
+            tbl    &= (INT8U)~(1u << x);
+            pmember = pset->OSSetTbl[(y << 3u) + x];
+            if (OS_EventSetMemberRdy(pmember) == OS_TRUE) {
+                pevents_rdy[nbr_rdy] = pmember;
+                nbr_rdy++;
+            } else {                                       /* Consumed since it was marked, clear it   */
+                pset->OSSetRdyTbl[y] &= (INT8U)~(1u << x);
+            }
+        }
+        if (pset->OSSetRdyTbl[y] == 0u) {
+            pset->OSSetRdyGrp &= (INT8U)~(1u << y);
+        }
+        grp &= (INT8U)~(1u << y);
+    }
+    return (nbr_rdy);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   SEE IF A MEMBER WOULD NOT BLOCK
+*
+* Description: This function determines whether a queue, a semaphore or a mailbox currently holds a
+*              message or a non-zero count.
+*
+* Arguments  : pevent        is a pointer to the event control block of the member.
+*
+* Returns    : OS_TRUE       if a pend on the member would not block.
+*              OS_FALSE      otherwise.
+*
+* Note(s)    : Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OS_EventSetMemberRdy (OS_EVENT *pevent)
+{
+    BOOLEAN  rdy;
+
+
+    switch (pevent->OSEventType) {
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+        case OS_EVENT_TYPE_Q:
+             rdy = (((OS_Q *)pevent->OSEventPtr)->OSQEntries > 0u) ? OS_TRUE : OS_FALSE;
+             break;
+#endif
+
+#if OS_SEM_EN > 0u
+        case OS_EVENT_TYPE_SEM:
+             rdy = (pevent->OSEventCnt > 0u) ? OS_TRUE : OS_FALSE;
+             break;
+#endif
+
+#if OS_MBOX_EN > 0u
+        case OS_EVENT_TYPE_MBOX:
+             rdy = (pevent->OSEventPtr != (void *)0) ? OS_TRUE : OS_FALSE;
+             break;
+#endif
+
+        default:
+             rdy = OS_FALSE;
+             break;
+    }
+    return (rdy);
+}
+#endif                                                     /* OS_EVENT_SET_EN                          */
@@ -233,6 +233,9 @@ INT8U  OSTaskCreate (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0u
+    prio = OS_SchedRRPrioGet(prio);          /* Use first free priority of a round-robin level         */
+#endif
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
@@ -360,6 +363,9 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0u
+    prio = OS_SchedRRPrioGet(prio);          /* Use first free priority of a round-robin level         */
+#endif
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
@@ -389,6 +395,119 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                     SNAPSHOT OF THE TASKS' CPU TIME
+*
+* Description: This function copies the number of clock cycles consumed so far by every task, and by
+*              the ISRs, so that the CPU usage over a window can be computed with OSTaskCycUsage().
+*
+* Arguments  : psnap        is a pointer to where the snapshot will be stored.
+*
+* Returns    : none
+*
+* Note(s)    : 1) The counters are maintained by the port: OSTaskSwHook() charges the task being switched
+*                 out, and the time spent in ISRs is accumulated in OSIntCyclesTot instead.
+*              2) The running task (i.e. the caller) is charged when it is switched out: its current
+*                 time slice falls in the next window.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0u
+void  OSTaskCycSnap (OS_TASK_CYC_SNAP *psnap)
+{
+    INT8U      i;
+#if OS_CRITICAL_METHOD == 3u                     /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    for (i = 0u; i < (OS_MAX_TASKS + OS_N_SYS_TASKS); i++) {
+        psnap->OSSnapCycTot[i] = OSTCBTbl[i].OSTCBCyclesTot;
+    }
+    psnap->OSSnapIntCycTot = OSIntCyclesTot;
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   CPU USAGE OF A TASK OVER A WINDOW
+*
+* Description: This function computes the share of the CPU used by a task between two snapshots taken
+*              with OSTaskCycSnap().
+*
+* Arguments  : pprev        is a pointer to the snapshot taken at the beginning of the window.
+*
+*              pcur         is a pointer to the snapshot taken at the end of the window.
+*
+*              prio         is the priority of the task.  Specify OS_PRIO_SELF for the calling task, or
+*                           OS_TASK_CYC_ISR for the time spent in ISRs.
+*
+*              perr         is a pointer to an error code:
+*                           OS_ERR_NONE            if the usage was computed.
+*                           OS_ERR_PRIO_INVALID    if 'prio' is out of range.
+*                           OS_ERR_TASK_NOT_EXIST  if there is no task at 'prio'.
+*
+* Returns    : The CPU usage in hundredths of a percent (0 to 10000).
+*
+* Note(s)    : 1) Every cycle is charged either to a task (the idle task included) or to the ISRs, so the
+*                 length of the window is the sum of all the counters: it is not limited by the wrap of
+*                 the 32-bit cycle counter.
+*              2) A task deleted during the window is dropped from it.
+*********************************************************************************************************
+*/
+
+INT16U  OSTaskCycUsage (OS_TASK_CYC_SNAP  *pprev,
+                        OS_TASK_CYC_SNAP  *pcur,
+                        INT8U              prio,
+                        INT8U             *perr)
+{
+    OS_TCB  *ptcb;
+    INT64U   delta;
+    INT64U   tot;
+    INT8U    i;
+
+
+    if ((prio > OS_TASK_CYC_ISR) && (prio != OS_PRIO_SELF)) {
+        *perr = OS_ERR_PRIO_INVALID;
+        return (0u);
+    }
+    tot = 0u;
+    for (i = 0u; i < (OS_MAX_TASKS + OS_N_SYS_TASKS); i++) {
+        if (pcur->OSSnapCycTot[i] >= pprev->OSSnapCycTot[i]) {
+            tot += pcur->OSSnapCycTot[i] - pprev->OSSnapCycTot[i];
+        }
+    }
+    tot += pcur->OSSnapIntCycTot - pprev->OSSnapIntCycTot;
+    if (prio == OS_TASK_CYC_ISR) {
+        delta = pcur->OSSnapIntCycTot - pprev->OSSnapIntCycTot;
+    } else {
+        if (prio == OS_PRIO_SELF) {
+            ptcb = OSTCBCur;
+        } else {
+            ptcb = OSTCBPrioTbl[prio];
+        }
+        if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+            *perr = OS_ERR_TASK_NOT_EXIST;
+            return (0u);
+        }
+        i = (INT8U)(ptcb - &OSTCBTbl[0]);
+        if (pcur->OSSnapCycTot[i] >= pprev->OSSnapCycTot[i]) {
+            delta = pcur->OSSnapCycTot[i] - pprev->OSSnapCycTot[i];
+        } else {
+            delta = 0u;
+        }
+    }
+    *perr = OS_ERR_NONE;
+    if (tot == 0u) {
+        return (0u);
+    }
+    return ((INT16U)((delta * 10000u) / tot));
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            DELETE A TASK
 *
 * Description: This function allows you to delete a task.  The calling task can delete itself by
@@ -856,6 +975,10 @@ INT8U  OSTaskResume (INT8U prio)
 *              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
 *              OS_ERR_TASK_OPT        if you did NOT specified OS_TASK_OPT_STK_CHK when the task was created
 *              OS_ERR_PDATA_NULL      if 'p_stk_data' is a NULL pointer
+*
+* Note(s)    : 1) This function scans the whole free part of the stack.  OSTaskStkHwm() returns the
+*                 high-water mark kept by the statistic task instead, without scanning the stack.
+*              2) The guard entries at the end of the stack (see OS_TaskStkClr()) are not counted.
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
@@ -905,6 +1028,16 @@ INT8U  OSTaskStkChk (INT8U         prio,
     size  = ptcb->OSTCBStkSize;
     pchk  = ptcb->OSTCBStkBottom;
     OS_EXIT_CRITICAL();
+#if OS_TASK_STK_GUARD_SIZE > 0u
+    if (size > OS_TASK_STK_GUARD_SIZE) {               /* Skip the guard at the end of the stack       */
+        size -= OS_TASK_STK_GUARD_SIZE;
+#if OS_STK_GROWTH == 1u
+        pchk += OS_TASK_STK_GUARD_SIZE;
+#else
+        pchk -= OS_TASK_STK_GUARD_SIZE;
+#endif
+    }
+#endif
 #if OS_STK_GROWTH == 1u
     while (*pchk++ == (OS_STK)0) {                    /* Compute the number of zero entries on the stk */
         nfree++;
@@ -922,6 +1055,97 @@ INT8U  OSTaskStkChk (INT8U         prio,
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                         STACK HIGH-WATER MARK
+*
+* Description: This function returns the maximum stack usage of the specified task, as found so far by
+*              the statistic task (see OS_TaskStatStkChk()).  Unlike OSTaskStkChk(), it does not scan the
+*              stack and can be called as often as needed.
+*
+* Arguments  : prio          is the task priority.  Specify OS_PRIO_SELF for the calling task.
+*
+*              p_stk_data    is a pointer to a data structure of type OS_STK_DATA.
+*
+* Returns    : OS_ERR_NONE            upon success
+*              OS_ERR_TASK_STK_OVF    if the guard at the end of the stack was overwritten.  'p_stk_data'
+*                                     is filled anyway but the actual usage is larger than reported.
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
+*              OS_ERR_TASK_OPT        if you did NOT specified OS_TASK_OPT_STK_CHK when the task was created
+*              OS_ERR_PDATA_NULL      if 'p_stk_data' is a NULL pointer
+*
+* Note(s)    : 1) The statistic task checks at most OS_TASK_STK_CHK_SLICE entries per stack every 100 ms,
+*                 sweeping the free part of the stack from the high-water mark to its end.  The mark is
+*                 exact once a full sweep is done, and lags behind a deeper use by at most one sweep.
+*********************************************************************************************************
+*/
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
+INT8U  OSTaskStkHwm (INT8U         prio,
+                     OS_STK_DATA  *p_stk_data)
+{
+    OS_TCB    *ptcb;
+    INT32U     nused;
+    INT32U     size;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0u
+    if (prio > OS_LOWEST_PRIO) {                       /* Make sure task priority is valid             */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_stk_data == (OS_STK_DATA *)0) {              /* Validate 'p_stk_data'                        */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    p_stk_data->OSFree = 0u;                           /* Assume failure, set to 0 size                */
+    p_stk_data->OSUsed = 0u;
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                        /* See if check for SELF                        */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb == (OS_TCB *)0) {                         /* Make sure task exist                         */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb == OS_TCB_RESERVED) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if ((ptcb->OSTCBOpt & OS_TASK_OPT_STK_CHK) == 0u) { /* Make sure stack checking option is set      */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_OPT);
+    }
+    size  = ptcb->OSTCBStkSize;
+#if OS_STK_GROWTH == 1u                                /* Entries between the mark and the stack top   */
+    nused = (INT32U)((ptcb->OSTCBStkBottom + size) - ptcb->OSTCBStkHwmPtr);
+#else
+    nused = (INT32U)(ptcb->OSTCBStkHwmPtr - (ptcb->OSTCBStkBottom - size));
+#endif
+    err   = OS_ERR_NONE;
+#if OS_TASK_STK_GUARD_SIZE > 0u
+    if (size > OS_TASK_STK_GUARD_SIZE) {               /* The guard is not part of the usable stack    */
+        size -= OS_TASK_STK_GUARD_SIZE;
+    }
+    if (ptcb->OSTCBStkOvf == OS_TRUE) {
+        err = OS_ERR_TASK_STK_OVF;
+    }
+#endif
+    OS_EXIT_CRITICAL();
+    p_stk_data->OSFree = (size - nused) * sizeof(OS_STK);
+    p_stk_data->OSUsed = nused * sizeof(OS_STK);
+    return (err);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            SUSPEND A TASK
 *
 * Description: This function is called to suspend a task.  The task can be the calling task if the
@@ -1221,6 +1445,13 @@ void  OS_TaskReturn (void)
 *
 * Description: This function is used to clear the stack of a task (i.e. write all zeros)
 *
+*              The OS_TASK_STK_GUARD_SIZE entries at the end of the stack are filled with
+*              OS_TASK_STK_GUARD_PATTERN instead, whether the stack is cleared or not: OS_TaskStatStkChk()
+*              reports a stack overflow when one of them was overwritten.
+*
+*              With OS_TASK_STK_CLR_LAZY_EN, only the guard is filled here: the rest of the stack is cleared
+*              by the idle task once the task is created (see OS_TaskStkClrIdle()).
+*
 * Arguments  : pbos     is a pointer to the task's bottom of stack.  If the configuration constant
 *                       OS_STK_GROWTH is set to 1, the stack is assumed to grow downward (i.e. from high
 *                       memory to low memory).  'pbos' will thus point to the lowest (valid) memory
@@ -1242,7 +1473,25 @@ void  OS_TaskStkClr (OS_STK  *pbos,
                      INT32U   size,
                      INT16U   opt)
 {
+#if OS_TASK_STK_GUARD_SIZE > 0u
+    INT32U  i;
+#endif
+
+
     if ((opt & OS_TASK_OPT_STK_CHK) != 0x0000u) {      /* See if stack checking has been enabled       */
+#if OS_TASK_STK_GUARD_SIZE > 0u
+        if (size > OS_TASK_STK_GUARD_SIZE) {
+            for (i = 0u; i < OS_TASK_STK_GUARD_SIZE; i++) {
+#if OS_STK_GROWTH == 1u
+                *pbos++ = (OS_STK)OS_TASK_STK_GUARD_PATTERN; /* Fill the guard at the end of the stack   */
+#else
+                *pbos-- = (OS_STK)OS_TASK_STK_GUARD_PATTERN;
+#endif
+            }
+            size -= OS_TASK_STK_GUARD_SIZE;
+        }
+#endif
+#if OS_TASK_STK_CLR_LAZY_EN == 0u
         if ((opt & OS_TASK_OPT_STK_CLR) != 0x0000u) {  /* See if stack needs to be cleared             */
 #if OS_STK_GROWTH == 1u
             while (size > 0u) {                        /* Stack grows from HIGH to LOW memory          */
@@ -1256,8 +1505,91 @@ void  OS_TaskStkClr (OS_STK  *pbos,
             }
 #endif
         }
+#endif
     }
 }
 
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CLEAR TASK STACKS FROM THE IDLE TASK
+*
+* Description: This function is called by the idle task on every loop to clear the stacks of the tasks
+*              created with OS_TASK_OPT_STK_CLR, instead of OSTaskCreateExt() (see OS_TaskStkClr()).
+*              Creating a task no longer costs a pass over its whole stack before OSStart().
+*
+*              At most OS_TASK_STK_CLR_SLICE entries of one task are cleared per call, with interrupts
+*              disabled, from the end of the stack up to the task's saved stack pointer: the entries
+*              past it are not in use while the task is not running.  The stack is then cleared
+*              (OSTCBStkClrPtr is set to 0) and OS_TaskStatStkChk() starts checking it.  The tasks are
+*              visited in turn, one priority per call.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) The idle task's own stack is not cleared.  It is declared in uC/OS-II (OSTaskIdleStk[])
+*                 and is cleared at startup like the rest of .bss.
+*              2) A task that used more stack than it is using at the time its stack is cleared does not
+*                 get the difference counted in its high-water mark.  Until a stack is cleared,
+*                 OSTaskStkChk() counts its old content as used.
+*              3) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TASK_STK_CLR_LAZY_EN > 0u)
+void  OS_TaskStkClrIdle (void)
+{
+    OS_TCB    *ptcb;
+    OS_STK    *pclr;
+    OS_STK    *plim;
+    INT32U     nclr;
+#if OS_CRITICAL_METHOD == 3u                           /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[OSTaskStkClrPrio];
+    pclr = (OS_STK *)0;
+    if ((ptcb != (OS_TCB *)0) &&                       /* Make sure task 'ptcb' is valid ...           */
+        (ptcb != OS_TCB_RESERVED)) {
+        if (ptcb == OSTCBCur) {                        /* Idle task: its stack is in .bss (Note #1)    */
+            ptcb->OSTCBStkClrPtr = (OS_STK *)0;
+        }
+        pclr = ptcb->OSTCBStkClrPtr;
+    }
+    if (pclr != (OS_STK *)0) {                         /* ... and has part of its stack left to clear  */
+        plim = ptcb->OSTCBStkPtr;                      /* Entries from the saved SP on are in use      */
+        nclr = OS_TASK_STK_CLR_SLICE;
+#if OS_STK_GROWTH == 1u
+        while ((nclr > 0u) && (pclr < plim)) {         /* Stack grows from HIGH to LOW memory          */
+            *pclr++ = (OS_STK)0;
+            nclr--;
+        }
+        if (pclr >= plim) {
+            pclr = (OS_STK *)0;                        /* Done, OS_TaskStatStkChk() may check it       */
+        }
+#else
+        while ((nclr > 0u) && (pclr > plim)) {         /* Stack grows from LOW to HIGH memory          */
+            *pclr-- = (OS_STK)0;
+            nclr--;
+        }
+        if (pclr <= plim) {
+            pclr = (OS_STK *)0;
+        }
+#endif
+        ptcb->OSTCBStkClrPtr = pclr;
+    }
+    if (pclr == (OS_STK *)0) {                         /* Move on to the next priority when done       */
+        if (OSTaskStkClrPrio < OS_LOWEST_PRIO) {
+            OSTaskStkClrPrio++;
+        } else {
+            OSTaskStkClrPrio = 0u;
+        }
+    }
+    OS_EXIT_CRITICAL();
+}
 #endif
 	 	   	  		 			 	    		   		 		 	 	 			 	    		   	 			 	  	 		 				 		  			 		 					 	  	  		      		  	   		      		  	 		 	      		   		 		  	 		 	      		  		  		  
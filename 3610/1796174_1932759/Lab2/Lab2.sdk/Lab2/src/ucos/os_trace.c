@@ -0,0 +1,224 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                         EVENT TRACE RECORDER
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_TRACE.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_TRACE_EN > 0u
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      EVENT TRACE INITIALIZATION
+*
+* Description: This function is called by OSInit() to clear the trace and start recording.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TraceInit (void)
+{
+    OS_MemClr((INT8U *)&OSTrace, sizeof(OSTrace));         /* Clear the trace                          */
+    OSTrace.OSTraceMagic   = OS_TRACE_MAGIC;               /* Header read by the host converter        */
+    OSTrace.OSTraceVersion = OS_TRACE_VERSION;
+    OSTrace.OSTraceRecSize = (INT16U)sizeof(OS_TRACE_REC);
+    OSTrace.OSTraceTsFreq  = OS_TS_FREQ_HZ;
+    OSTrace.OSTraceSize    = OS_TRACE_SIZE;
+    OSTrace.OSTraceState   = OS_TRACE_STATE_RUN;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          RECORD AN EVENT
+*
+* Description: This function is called through OS_TRACE() to add an event to the trace.  When the trace
+*              is full, the oldest event is overwritten.
+*
+* Arguments  : type     is the kind of event (see OS_TRACE_TYPE_xxx).
+*
+*              arg      is the argument of the event.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function may be called with interrupts disabled and from ISRs.
+*              3) The kernel only runs on one CPU: a single ring is used.
+*********************************************************************************************************
+*/
+
+void  OS_TraceRec (INT8U   type,
+                   INT32U  arg)
+{
+    OS_TRACE_REC  *prec;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR      cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (OSTrace.OSTraceState == OS_TRACE_STATE_STOP) {     /* Not recording                            */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    prec                    = &OSTrace.OSTraceTbl[OSTrace.OSTraceIn & (OS_TRACE_SIZE - 1u)];
+    prec->OSTraceTs         = OS_TS_GET();
+    prec->OSTraceType       = type;
+    prec->OSTracePrio       = OSPrioCur;
+    prec->OSTraceIntNesting = OSIntNesting;
+    prec->OSTraceArg        = arg;
+    OSTrace.OSTraceIn++;
+    if (OSTrace.OSTraceState == OS_TRACE_STATE_TRIG) {     /* Stop once the post-trigger events are in */
+        OSTrace.OSTraceStopCtr--;
+        if (OSTrace.OSTraceStopCtr == 0u) {
+            OSTrace.OSTraceState = OS_TRACE_STATE_STOP;
+        }
+    }
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        SNAPSHOT OF THE TRACE
+*
+* Description: This function copies the trace, for example to dump it while recording goes on.
+*
+* Arguments  : psnap    is a pointer to where the copy of the trace will be stored.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Recording is suspended during the copy, but interrupts are not disabled: the events
+*                 that occur during the copy are lost.
+*********************************************************************************************************
+*/
+
+void  OSTraceSnap (OS_TRACE *psnap)
+{
+    INT8U      state;
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    state                = OSTrace.OSTraceState;
+    OSTrace.OSTraceState = OS_TRACE_STATE_STOP;
+    OS_EXIT_CRITICAL();
+    OS_MemCopy((INT8U *)psnap, (INT8U *)&OSTrace, sizeof(OS_TRACE));
+    psnap->OSTraceState  = state;
+    OS_ENTER_CRITICAL();
+    if (OSTrace.OSTraceState == OS_TRACE_STATE_STOP) {     /* Resume, unless restarted meanwhile       */
+        OSTrace.OSTraceState = state;
+    }
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      START/STOP RECORDING EVENTS
+*
+* Description: OSTraceStart() resumes recording (and cancels a pending trigger).  OSTraceStop() freezes
+*              the trace so that it can be dumped.
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+void  OSTraceStart (void)
+{
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSTrace.OSTraceStopCtr = 0u;
+    OSTrace.OSTraceState   = OS_TRACE_STATE_RUN;
+    OS_EXIT_CRITICAL();
+}
+
+
+void  OSTraceStop (void)
+{
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSTrace.OSTraceState = OS_TRACE_STATE_STOP;
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         TRIGGER THE TRACE
+*
+* Description: This function records a trigger event and stops the trace after 'nbr_post' more events,
+*              so that the trace shows what led to the trigger and what followed it.
+*
+* Arguments  : arg        is a value recorded with the trigger event (e.g. an error code).
+*
+*              nbr_post   is the number of events to record after the trigger (0 stops immediately).
+*
+* Returns    : none
+*
+* Note(s)    : 1) Only the first trigger is taken into account: the trace must be restarted with
+*                 OSTraceStart() to be triggered again.
+*********************************************************************************************************
+*/
+
+void  OSTraceTrigger (INT32U  arg,
+                      INT32U  nbr_post)
+{
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0u;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (OSTrace.OSTraceState != OS_TRACE_STATE_RUN) {      /* Already triggered or stopped             */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    OS_TraceRec(OS_TRACE_TYPE_TRIG, arg);
+    if (nbr_post == 0u) {
+        OSTrace.OSTraceState   = OS_TRACE_STATE_STOP;
+    } else {
+        OSTrace.OSTraceStopCtr = nbr_post;
+        OSTrace.OSTraceState   = OS_TRACE_STATE_TRIG;
+    }
+    OS_EXIT_CRITICAL();
+}
+#endif
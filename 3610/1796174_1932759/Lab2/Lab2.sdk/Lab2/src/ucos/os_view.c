@@ -0,0 +1,312 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                             KERNEL VIEW SNAPSHOTS
+*
+*                              (c) Copyright 1992-2009, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_VIEW.C
+* By      : Jean J. Labrosse
+* Version : V2.91
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micri�m to properly license
+* its use in your product. We provide ALL the source code for your convenience and to help you experience
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_VIEW_EN > 0u
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void   OS_ViewName(INT8U *pdest, INT8U *psrc);
+
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+static  INT8U  OS_ViewNbrWait(OS_EVENT *pevent);
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       TAKE A SNAPSHOT OF THE KERNEL
+*
+* Description: This function serializes the state of the tasks and of the event control blocks in use
+*              (see OS_VIEW_HDR), for example to send it to a host that displays it.
+*
+* Arguments  : pbuf     is a pointer to where the snapshot will be stored.
+*
+*              size     is the size of the buffer, which must hold OS_VIEW_SIZE_MAX bytes.
+*
+*              perr     is a pointer to an error code that can contain one of these values:
+*                       OS_ERR_NONE          The call was successful.
+*                       OS_ERR_PDATA_NULL    'pbuf' is a NULL pointer.
+*                       OS_ERR_VIEW_SIZE     The buffer is smaller than OS_VIEW_SIZE_MAX.
+*
+* Returns    : The size of the snapshot (bytes), or 0 upon error.
+*
+* Note(s)    : 1) Interrupts are only disabled while a single task or event is copied, so the
+*                 interrupt latency does not grow with the number of tasks and events.  The time taken
+*                 by the whole snapshot is stored in OSViewCycles.
+*              2) The scheduler is not locked: a task that runs during the snapshot may change the
+*                 tasks or events not copied yet.  Each record is consistent, the snapshot as a whole
+*                 is not.
+*              3) The buffer must be aligned on 8 bytes.
+*********************************************************************************************************
+*/
+
+INT32U  OSViewSnap (void    *pbuf,
+                    INT32U   size,
+                    INT8U   *perr)
+{
+    OS_VIEW_HDR    *phdr;
+    OS_VIEW_TASK   *ptask;
+    OS_TCB         *ptcb;
+    INT8U           prio;
+    INT16U          nbr_tasks;
+    INT32U          ts;
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+    OS_VIEW_EVENT  *pview;
+    OS_EVENT       *pevent;
+    INT16U          ix;
+    INT16U          nbr_events;
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+    OS_Q           *pq;
+#endif
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+    OS_PQ          *ppq;
+    INT8U           band;
+#endif
+#endif
+#if OS_CRITICAL_METHOD == 3u                               /* Allocate storage for CPU status register */
+    OS_CPU_SR       cpu_sr = 0u;
+#endif
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (perr == (INT8U *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+    }
+#endif
+
+#if OS_ARG_CHK_EN > 0u
+    if (pbuf == (void *)0) {                               /* Validate 'pbuf'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0u);
+    }
+#endif
+    if (size < OS_VIEW_SIZE_MAX) {                         /* Must hold every task and every event     */
+        *perr = OS_ERR_VIEW_SIZE;
+        return (0u);
+    }
+    ts   = OS_TS_GET();
+    phdr = (OS_VIEW_HDR *)pbuf;
+    OS_MemClr((INT8U *)phdr, sizeof(OS_VIEW_HDR));
+    phdr->OSViewMagic      = OS_VIEW_MAGIC;
+    phdr->OSViewVersion    = OS_VIEW_VERSION;
+    phdr->OSViewTaskSize   = (INT8U)sizeof(OS_VIEW_TASK);
+    phdr->OSViewEventSize  = (INT8U)sizeof(OS_VIEW_EVENT);
+    phdr->OSViewTsFreq     = OS_TS_FREQ_HZ;
+    phdr->OSViewTs         = ts;
+    OS_ENTER_CRITICAL();
+    phdr->OSViewTime       = OSTime;
+    phdr->OSViewCtxSwCtr   = OSCtxSwCtr;
+#if OS_TASK_STAT_EN > 0u
+    phdr->OSViewCPUUsage   = OSCPUUsage;
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+    phdr->OSViewIntCyclesTot = OSIntCyclesTot;
+#endif
+    OS_EXIT_CRITICAL();
+/*$PAGE*/
+    ptask     = (OS_VIEW_TASK *)(phdr + 1);
+    nbr_tasks = 0u;
+    for (prio = 0u; prio <= OS_LOWEST_PRIO; prio++) {      /* Tasks, from the highest priority         */
+        OS_MemClr((INT8U *)ptask, sizeof(OS_VIEW_TASK));
+        OS_ENTER_CRITICAL();
+        ptcb = OSTCBPrioTbl[prio];
+        if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+            OS_EXIT_CRITICAL();                            /* No task at this priority                 */
+            continue;
+        }
+        ptask->OSViewPrio     = prio;
+        ptask->OSViewStat     = ptcb->OSTCBStat;
+        ptask->OSViewStatPend = ptcb->OSTCBStatPend;
+        ptask->OSViewDly      = ptcb->OSTCBDly;
+        ptask->OSViewEventId  = OS_VIEW_EVENT_NONE;
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+        if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
+            ptask->OSViewEventId = (INT16U)(ptcb->OSTCBEventPtr - &OSEventTbl[0]);
+        }
+#endif
+#if OS_TASK_CREATE_EXT_EN > 0u
+        ptask->OSViewStkSize  = ptcb->OSTCBStkSize * sizeof(OS_STK);
+#if OS_TASK_STAT_STK_CHK_EN > 0u
+        if ((ptcb->OSTCBOpt & OS_TASK_OPT_STK_CHK) != 0u) {    /* Mark kept by the statistic task      */
+#if OS_STK_GROWTH == 1u
+            ptask->OSViewStkUsed = (INT32U)((ptcb->OSTCBStkBottom + ptcb->OSTCBStkSize)
+                                          - ptcb->OSTCBStkHwmPtr) * sizeof(OS_STK);
+#else
+            ptask->OSViewStkUsed = (INT32U)(ptcb->OSTCBStkHwmPtr
+                                          - (ptcb->OSTCBStkBottom - ptcb->OSTCBStkSize)) * sizeof(OS_STK);
+#endif
+        }
+#endif
+#endif
+#if OS_TASK_PROFILE_EN > 0u
+        ptask->OSViewCtxSwCtr  = ptcb->OSTCBCtxSwCtr;
+        ptask->OSViewCyclesTot = ptcb->OSTCBCyclesTot;
+#endif
+#if OS_TASK_NAME_EN > 0u
+        OS_ViewName(&ptask->OSViewName[0], ptcb->OSTCBTaskName);
+#endif
+        OS_EXIT_CRITICAL();
+        ptask++;
+        nbr_tasks++;
+    }
+    phdr->OSViewNbrTasks = nbr_tasks;
+/*$PAGE*/
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+    pview      = (OS_VIEW_EVENT *)ptask;
+    nbr_events = 0u;
+    for (ix = 0u; ix < OS_MAX_EVENTS; ix++) {              /* Event control blocks in use              */
+        pevent = &OSEventTbl[ix];
+        OS_MemClr((INT8U *)pview, sizeof(OS_VIEW_EVENT));
+        OS_ENTER_CRITICAL();
+        if (pevent->OSEventType == OS_EVENT_TYPE_UNUSED) {
+            OS_EXIT_CRITICAL();
+            continue;
+        }
+        pview->OSViewId      = ix;
+        pview->OSViewType    = pevent->OSEventType;
+        pview->OSViewNbrWait = OS_ViewNbrWait(pevent);
+        pview->OSViewCnt     = pevent->OSEventCnt;
+        switch (pevent->OSEventType) {
+#if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
+            case OS_EVENT_TYPE_Q:
+                 pq                       = (OS_Q *)pevent->OSEventPtr;
+                 pview->OSViewEntries     = pq->OSQEntries;
+                 pview->OSViewQSize       = pq->OSQSize;
+#if OS_Q_STAT_EN > 0u
+                 pview->OSViewQEntriesMax = pq->OSQEntriesMax;
+                 pview->OSViewQNPosts     = pq->OSQNPosts;
+#endif
+                 break;
+#endif
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+            case OS_EVENT_TYPE_PQ:                         /* Whole priority queue, all bands summed   */
+                 ppq                      = (OS_PQ *)pevent->OSEventPtr;
+                 pview->OSViewEntries     = ppq->OSPQEntries;
+                 pview->OSViewQSize       = ppq->OSPQSize;
+                 pview->OSViewQEntriesMax = ppq->OSPQEntriesMax;
+                 for (band = 0u; band < ppq->OSPQNbrBands; band++) {
+                     pview->OSViewQNPosts += ppq->OSPQBandTbl[band].OSPQBandNPosts;
+                 }
+                 break;
+#endif
+
+            case OS_EVENT_TYPE_MBOX:
+                 if (pevent->OSEventPtr != (void *)0) {    /* Message waiting in the mailbox           */
+                     pview->OSViewEntries = 1u;
+                 }
+                 break;
+
+            default:
+                 break;
+        }
+#if OS_EVENT_NAME_EN > 0u
+        OS_ViewName(&pview->OSViewName[0], pevent->OSEventName);
+#endif
+        OS_EXIT_CRITICAL();
+        pview++;
+        nbr_events++;
+    }
+    phdr->OSViewNbrEvents = nbr_events;
+    phdr->OSViewSize      = (INT32U)((INT8U *)pview - (INT8U *)phdr);
+#else
+    phdr->OSViewSize      = (INT32U)((INT8U *)ptask - (INT8U *)phdr);
+#endif
+    phdr->OSViewCycles    = OS_TS_GET() - ts;
+    *perr                 = OS_ERR_NONE;
+    return (phdr->OSViewSize);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      COPY THE NAME OF AN OBJECT
+*
+* Description: This function copies at most OS_VIEW_NAME_SIZE - 1 characters of a name and pads the rest
+*              with NULs.
+*
+* Arguments  : pdest    is a pointer to the OS_VIEW_NAME_SIZE bytes to fill (already cleared).
+*
+*              psrc     is a pointer to the name (NUL terminated).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  void  OS_ViewName (INT8U  *pdest,
+                           INT8U  *psrc)
+{
+    INT8U  i;
+
+
+    if (psrc == (INT8U *)0) {
+        return;
+    }
+    for (i = 0u; (i < (OS_VIEW_NAME_SIZE - 1u)) && (psrc[i] != (INT8U)0); i++) {
+        pdest[i] = psrc[i];
+    }
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  COUNT THE TASKS WAITING ON AN EVENT
+*
+* Description: This function counts the bits set in the wait list of an event control block.
+*
+* Arguments  : pevent   is a pointer to the event control block.
+*
+* Returns    : The number of tasks waiting on the event.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
+static  INT8U  OS_ViewNbrWait (OS_EVENT  *pevent)
+{
+    INT8U    i;
+    INT8U    nbr;
+    OS_PRIO  bits;
+
+
+    nbr = 0u;
+    for (i = 0u; i < OS_EVENT_TBL_SIZE; i++) {
+        bits = pevent->OSEventTbl[i];
+        while (bits != 0u) {                               /* Clear the lowest bit set until none left */
+            bits &= (OS_PRIO)(bits - 1u);
+            nbr++;
+        }
+    }
+    return (nbr);
+}
+#endif
+#endif
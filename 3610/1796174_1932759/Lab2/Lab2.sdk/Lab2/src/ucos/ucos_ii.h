@@ -57,6 +57,12 @@ extern "C" {
 #define  OS_EXT  extern
 #endif
 
+#if OS_INIT_STATIC_EN > 0u                              /* Free lists defined in OS_INIT_TBL.C         */
+#define  OS_EXT_INIT  extern
+#else
+#define  OS_EXT_INIT  OS_EXT
+#endif
+
 #ifndef  OS_FALSE
 #define  OS_FALSE                       0u
 #endif
@@ -89,6 +95,7 @@ extern "C" {
 #define  OS_TASK_IDLE_ID            65535u              /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID            65534u
 #define  OS_TASK_TMR_ID             65533u
+#define  OS_TASK_INT_Q_ID           65532u
 
 #define  OS_EVENT_EN           (((OS_Q_EN > 0u) && (OS_MAX_QS > 0u)) || (OS_MBOX_EN > 0u) || (OS_SEM_EN > 0u) || (OS_MUTEX_EN > 0u))
 
@@ -107,9 +114,10 @@ extern "C" {
 #define  OS_STAT_SUSPEND             0x08u  /* Task is suspended                                       */
 #define  OS_STAT_MUTEX               0x10u  /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG                0x20u  /* Pending on event flag group                             */
+#define  OS_STAT_SET                 0x40u  /* Pending on event set                                    */
 #define  OS_STAT_MULTI               0x80u  /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | OS_STAT_SET)
 
 /*
 *********************************************************************************************************
@@ -131,6 +139,8 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM              3u
 #define  OS_EVENT_TYPE_MUTEX            4u
 #define  OS_EVENT_TYPE_FLAG             5u
+#define  OS_EVENT_TYPE_SET              6u
+#define  OS_EVENT_TYPE_PQ               7u
 
 #define  OS_TMR_TYPE                  100u  /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
@@ -203,6 +213,22 @@ extern "C" {
 #define  OS_POST_OPT_FRONT           0x02u  /* Post to highest priority task waiting                   */
 #define  OS_POST_OPT_NO_SCHED        0x04u  /* Do not call the scheduler if this option is selected    */
 
+/*
+*********************************************************************************************************
+*                                 QUEUE OVERFLOW POLICIES (see OSQPolicySet())
+*********************************************************************************************************
+*/
+#define  OS_Q_POLICY_DROP_TAIL         0u  /* Full queue refuses the new message (OS_ERR_Q_FULL)       */
+#define  OS_Q_POLICY_DROP_HEAD         1u  /* Full queue drops its oldest message to make room         */
+
+/*
+*********************************************************************************************************
+*                                   OSQStatGet() OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_Q_STAT_OPT_NONE            0u  /* Only read the queue telemetry                            */
+#define  OS_Q_STAT_OPT_RESET           1u  /* Start a new measurement period once read                 */
+
 /*
 *********************************************************************************************************
 *                                 TASK OPTIONS (see OSTaskCreateExt())
@@ -213,6 +239,8 @@ extern "C" {
 #define  OS_TASK_OPT_STK_CLR       0x0002u  /* Clear the stack when the task is create                 */
 #define  OS_TASK_OPT_SAVE_FP       0x0004u  /* Save the contents of any floating-point registers       */
 
+#define  OS_TASK_STK_GUARD_PATTERN 0xDEADBEEFuL /* Fills the guard entries of stacks checked (STK_CHK)   */
+
 /*
 *********************************************************************************************************
 *                            TIMER OPTIONS (see OSTmrStart() and OSTmrStop())
@@ -336,6 +364,27 @@ extern "C" {
 #define OS_ERR_TMR_STOPPED            142u
 #define OS_ERR_TMR_NO_CALLBACK        143u
 
+#define OS_ERR_RR_INVALID_NBR         150u
+#define OS_ERR_RR_PRIO_EXIST          151u
+#define OS_ERR_RR_NO_MORE_LEVELS      152u
+#define OS_ERR_RR_NOT_MEMBER          153u
+
+#define OS_ERR_SET_EMPTY              160u
+#define OS_ERR_SET_PRIO_INVALID       161u
+#define OS_ERR_SET_PRIO_EXIST         162u
+#define OS_ERR_SET_MEMBER             163u
+#define OS_ERR_SET_NOT_MEMBER         164u
+
+#define OS_ERR_INT_Q_FULL             170u
+
+#define OS_ERR_TASK_STK_OVF           180u
+
+#define OS_ERR_CEIL_PRIO              190u
+
+#define OS_ERR_VIEW_SIZE              200u
+
+#define OS_ERR_PQ_BAND_INVALID        210u
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -360,9 +409,37 @@ typedef struct os_event {
 #if OS_EVENT_NAME_EN > 0u
     INT8U   *OSEventName;
 #endif
+
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+    struct os_event *OSEventSetPtr;          /* Pointer to event set the event belongs to (NULL if none)*/
+    INT8U    OSEventSetPrio;                 /* Priority of the event within its event set              */
+#endif
+
+#if (OS_MUTEX_EN > 0u) && (OS_SCHED_RR_EN > 0u)
+    struct os_event *OSEventMutexNext;       /* Next mutex owned by the same task (see OSTCBMutexPtr)   */
+#endif
 } OS_EVENT;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                            EVENT SET
+*********************************************************************************************************
+*/
+
+#if (OS_EVENT_EN) && (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+#define  OS_EVENT_SET_RDY_TBL_SIZE   ((OS_EVENT_SET_SIZE - 1u) / 8u + 1u)
+
+typedef struct os_event_set {
+    struct os_event_set *OSSetPtr;           /* Link to next event set in list of free event sets       */
+    OS_EVENT  *OSSetTbl[OS_EVENT_SET_SIZE];  /* Members of the set, indexed by member priority          */
+    INT8U      OSSetRdyGrp;                  /* Group of members that may be ready                      */
+    INT8U      OSSetRdyTbl[OS_EVENT_SET_RDY_TBL_SIZE];  /* Members that may be ready (posted to)        */
+    INT8U      OSSetEntries;                 /* Number of members of the set                            */
+} OS_EVENT_SET;
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -372,7 +449,7 @@ typedef struct os_event {
 
 #if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
 
-#if OS_FLAGS_NBITS == 8u                    /* Determine the size of OS_FLAGS (8, 16 or 32 bits)       */
+#if OS_FLAGS_NBITS == 8u                    /* Determine the size of OS_FLAGS (8, 16, 32 or 64 bits)   */
 typedef  INT8U    OS_FLAGS;
 #endif
 
@@ -384,11 +461,29 @@ typedef  INT16U   OS_FLAGS;
 typedef  INT32U   OS_FLAGS;
 #endif
 
+#if OS_FLAGS_NBITS == 64u
+typedef  INT64U   OS_FLAGS;
+#endif
+
+#if OS_FLAG_WAIT_IX_EN > 0u                 /* Lists of OSFlagWaitTbl[]:                               */
+                                            /*     0 .. OS_FLAGS_NBITS-1: waits on a single bit (ANY)  */
+                                            /*     or still missing this bit (ALL)                     */
+#define  OS_FLAG_WAIT_IX_ANY    (OS_FLAGS_NBITS)        /* Waits for ANY of several bits to be set     */
+#define  OS_FLAG_WAIT_IX_CLR    (OS_FLAGS_NBITS + 1u)   /* Waits for bits to be cleared                */
+#define  OS_FLAG_WAIT_IX_SIZE   (OS_FLAGS_NBITS + 2u)
+#endif
+
 
 typedef struct os_flag_grp {                /* Event Flag Group                                        */
     INT8U         OSFlagType;               /* Should be set to OS_EVENT_TYPE_FLAG                     */
     void         *OSFlagWaitList;           /* Pointer to first NODE of task waiting on event flag     */
-    OS_FLAGS      OSFlagFlags;              /* 8, 16 or 32 bit flags                                   */
+    OS_FLAGS      OSFlagFlags;              /* 8, 16, 32 or 64 bit flags                               */
+#if OS_FLAG_WAIT_IX_EN > 0u
+    void         *OSFlagWaitTbl[OS_FLAG_WAIT_IX_SIZE];  /* Same NODEs, indexed by bit(s) waited for */
+    OS_FLAGS      OSFlagWaitBits;           /* Bits whose list in OSFlagWaitTbl[] is not empty         */
+    OS_FLAGS      OSFlagWaitAny;            /* Bits waited for in list OS_FLAG_WAIT_IX_ANY (or more)   */
+    OS_FLAGS      OSFlagWaitClr;            /* Bits waited for in list OS_FLAG_WAIT_IX_CLR (or more)   */
+#endif
 #if OS_FLAG_NAME_EN > 0u
     INT8U        *OSFlagName;
 #endif
@@ -407,6 +502,11 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
                                             /*      OS_FLAG_WAIT_ALL                                   */
                                             /*      OS_FLAG_WAIT_OR                                    */
                                             /*      OS_FLAG_WAIT_ANY                                   */
+#if OS_FLAG_WAIT_IX_EN > 0u
+    INT8U         OSFlagNodeIx;             /* List of OSFlagWaitTbl[] the NODE is in                  */
+    void         *OSFlagNodeIxNext;         /* Pointer to next     NODE in that list                   */
+    void         *OSFlagNodeIxPrev;         /* Pointer to previous NODE in that list                   */
+#endif
 } OS_FLAG_NODE;
 #endif
 
@@ -471,6 +571,24 @@ typedef struct os_mutex_data {
 } OS_MUTEX_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                       PRIORITY CEILING MUTEX
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_CEIL_EN > 0u
+#define  OS_MUTEX_CEIL_NONE       0xFFu     /* OSTCBCeilPrio of a task that holds no ceiling mutex     */
+#define  OS_MUTEX_CEIL_WAIT       0x01u     /* OSMutexCeilOwner flag: tasks may be waiting             */
+
+typedef struct os_mutex_ceil {
+    volatile INT32U  OSMutexCeilOwner;      /* Address of the owner's TCB (0 if free) | WAIT flag      */
+    OS_EVENT        *OSMutexCeilSem;        /* Semaphore the tasks wait on, used on contention only    */
+    INT8U            OSMutexCeilPrio;       /* Ceiling: highest priority of the tasks using the mutex  */
+    INT8U            OSMutexCeilPrevPrio;   /* Owner's OSTCBCeilPrio before it acquired the mutex      */
+} OS_MUTEX_CEIL;
+#endif
+
 /*
 *********************************************************************************************************
 *                                          MESSAGE QUEUE DATA
@@ -478,6 +596,8 @@ typedef struct os_mutex_data {
 */
 
 #if OS_Q_EN > 0u
+typedef  void  (*OS_Q_DROP_FNCT)(void *pmsg);   /* Receives each message dropped by a full queue      */
+
 typedef struct os_q {                   /* QUEUE CONTROL BLOCK                                         */
     struct os_q   *OSQPtr;              /* Link to next queue control block in list of free blocks     */
     void         **OSQStart;            /* Pointer to start of queue data                              */
@@ -486,6 +606,23 @@ typedef struct os_q {                   /* QUEUE CONTROL BLOCK
     void         **OSQOut;              /* Pointer to where next message will be extracted from the Q  */
     INT16U         OSQSize;             /* Size of queue (maximum number of entries)                   */
     INT16U         OSQEntries;          /* Current number of entries in the queue                      */
+#if OS_Q_POLICY_EN > 0u
+    INT8U          OSQPolicy;           /* What a post does when the queue is full (OS_Q_POLICY_xxx)   */
+    OS_Q_DROP_FNCT OSQDropFnct;         /* Called with each message dropped by OS_Q_POLICY_DROP_HEAD   */
+    INT32U         OSQNDropHead;        /* Nbr of oldest messages dropped to make room                 */
+    INT32U         OSQNDropTail;        /* Nbr of new messages refused (full queue or post timeout)    */
+    INT32U         OSQNPostWait;        /* Nbr of OSQPostPend() calls that had to wait for room        */
+#endif
+#if OS_Q_STAT_EN > 0u
+    INT16U         OSQEntriesMax;       /* High-water mark of OSQEntries                               */
+    INT32U         OSQNPosts;           /* Nbr of messages posted (queued or handed to a waiting task) */
+    INT32U         OSQNPends;           /* Nbr of messages received                                    */
+    INT32U         OSQNFull;            /* Nbr of posts that found the queue full                      */
+    INT32U         OSQStatTs;           /* OS_TS_GET() and OSTime at the last change of OSQEntries     */
+    INT32U         OSQStatTick;
+    INT64U         OSQStatArea;         /* Integral of OSQEntries over time (entries x time stamps)    */
+    INT64U         OSQStatTime;         /* Time covered by OSQStatArea (time stamps)                   */
+#endif
 } OS_Q;
 
 
@@ -495,7 +632,76 @@ typedef struct os_q_data {
     INT16U         OSQSize;             /* Size of message queue                                       */
     OS_PRIO        OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
     OS_PRIO        OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
+#if OS_Q_POLICY_EN > 0u
+    INT8U          OSQPolicy;           /* Overflow policy of the queue                                */
+    INT32U         OSQNDropHead;        /* Nbr of oldest messages dropped to make room                 */
+    INT32U         OSQNDropTail;        /* Nbr of new messages refused                                 */
+    INT32U         OSQNPostWait;        /* Nbr of OSQPostPend() calls that had to wait for room        */
+#endif
 } OS_Q_DATA;
+
+
+typedef struct os_q_stat {              /* QUEUE TELEMETRY (see OSQStatGet())                          */
+    INT16U         OSQSize;             /* Size of message queue                                       */
+    INT16U         OSQEntries;          /* Number of messages in message queue                         */
+    INT16U         OSQEntriesMax;       /* High-water mark of OSQEntries                               */
+    INT32U         OSQEntriesAvg;       /* Time-weighted mean of OSQEntries, in 1/100 of an entry      */
+    INT32U         OSQNPosts;           /* Nbr of messages posted                                      */
+    INT32U         OSQNPends;           /* Nbr of messages received                                    */
+    INT32U         OSQNFull;            /* Nbr of posts that found the queue full                      */
+    INT64U         OSQTime;             /* Length of the measurement period (OS_TS_GET() time stamps)  */
+} OS_Q_STAT;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      PRIORITY MESSAGE QUEUE DATA
+*********************************************************************************************************
+*/
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+typedef struct os_pq_band {             /* BAND OF A PRIORITY QUEUE (circular buffer of messages)      */
+    void         **OSPQBandStart;       /* Pointer to start of band data                               */
+    void         **OSPQBandEnd;         /* Pointer to end   of band data                               */
+    void         **OSPQBandIn;          /* Pointer to where next message will be inserted in the band  */
+    void         **OSPQBandOut;         /* Pointer to where next message will be extracted             */
+    INT16U         OSPQBandSize;        /* Capacity of the band (maximum number of entries)            */
+    INT16U         OSPQBandEntries;     /* Current number of entries in the band                       */
+    INT16U         OSPQBandEntriesMax;  /* High-water mark of OSPQBandEntries                          */
+    INT32U         OSPQBandNPosts;      /* Nbr of messages posted (queued or handed to a waiting task) */
+    INT32U         OSPQBandNPends;      /* Nbr of messages received                                    */
+    INT32U         OSPQBandNFull;       /* Nbr of messages refused because the band was full           */
+} OS_PQ_BAND;
+
+
+typedef struct os_pq {                  /* PRIORITY QUEUE CONTROL BLOCK                                */
+    struct os_pq  *OSPQPtr;             /* Link to next priority queue control block in the free list  */
+    INT32U         OSPQBandRdy;         /* Bit n is set when band n holds at least one message         */
+    INT16U         OSPQSize;            /* Capacity of all the bands                                   */
+    INT16U         OSPQEntries;         /* Number of messages in all the bands                         */
+    INT16U         OSPQEntriesMax;      /* High-water mark of OSPQEntries                              */
+    INT8U          OSPQNbrBands;        /* Number of bands, band 0 is the most urgent                  */
+    OS_PQ_BAND     OSPQBandTbl[OS_PQ_BANDS_MAX];
+} OS_PQ;
+
+
+typedef struct os_pq_band_stat {
+    INT16U         OSPQBandSize;        /* Capacity of the band                                        */
+    INT16U         OSPQBandEntries;     /* Number of messages in the band                              */
+    INT16U         OSPQBandEntriesMax;  /* High-water mark of OSPQBandEntries                          */
+    INT32U         OSPQBandNPosts;      /* Nbr of messages posted                                      */
+    INT32U         OSPQBandNPends;      /* Nbr of messages received                                    */
+    INT32U         OSPQBandNFull;       /* Nbr of messages refused because the band was full           */
+} OS_PQ_BAND_STAT;
+
+
+typedef struct os_pq_stat {             /* PRIORITY QUEUE COUNTERS (see OSPQStatGet())                 */
+    INT8U           OSPQNbrBands;       /* Number of bands of the priority queue                       */
+    INT16U          OSPQEntries;        /* Number of messages in all the bands                         */
+    INT16U          OSPQEntriesMax;     /* High-water mark of OSPQEntries                              */
+    OS_PQ_BAND_STAT OSPQBandTbl[OS_PQ_BANDS_MAX];
+} OS_PQ_STAT;
 #endif
 
 /*
@@ -525,6 +731,37 @@ typedef struct os_stk_data {
 } OS_STK_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                        TASK CPU USAGE SNAPSHOT
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0u
+#define  OS_TASK_CYC_ISR   (OS_LOWEST_PRIO + 1u)   /* 'prio' of OSTaskCycUsage() for the time spent in ISRs  */
+
+typedef struct os_task_cyc_snap {
+    INT64U  OSSnapCycTot[OS_MAX_TASKS + OS_N_SYS_TASKS];  /* OSTCBCyclesTot of each entry of OSTCBTbl[]  */
+    INT64U  OSSnapIntCycTot;           /* Value of OSIntCyclesTot                                      */
+} OS_TASK_CYC_SNAP;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          ROUND-ROBIN LEVEL
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0u
+typedef struct os_sched_rr {
+    INT8U   OSSchedRRPrio;             /* Highest priority of the level                                */
+    INT8U   OSSchedRRNbrTasks;         /* Number of consecutive priorities used by the level           */
+    INT16U  OSSchedRRQuantum;          /* Default time quantum of the members (in ticks)               */
+    INT32U  OSSchedRRRotCtr;           /* Number of times the level was rotated                        */
+} OS_SCHED_RR;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -543,6 +780,17 @@ typedef struct os_tcb {
     INT16U           OSTCBId;               /* Task ID (0..65535)                                      */
 #endif
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
+    OS_STK          *OSTCBStkHwmPtr;        /* Deepest stack entry found in use (high-water mark)      */
+    OS_STK          *OSTCBStkChkPtr;        /* Next stack entry to check by OS_TaskStatStkChk()        */
+#if OS_TASK_STK_GUARD_SIZE > 0u
+    BOOLEAN          OSTCBStkOvf;           /* Guard entries at the end of the stack were overwritten  */
+#endif
+#if OS_TASK_STK_CLR_LAZY_EN > 0u
+    OS_STK          *OSTCBStkClrPtr;        /* Next stack entry to clear by the idle task (0 if done)  */
+#endif
+#endif
+
     struct os_tcb   *OSTCBNext;             /* Pointer to next     TCB in the TCB list                 */
     struct os_tcb   *OSTCBPrev;             /* Pointer to previous TCB in the TCB list                 */
 
@@ -558,6 +806,10 @@ typedef struct os_tcb {
     void            *OSTCBMsg;              /* Message received from OSMboxPost() or OSQPost()         */
 #endif
 
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+    INT8U            OSTCBPQBand;           /* Band of the message received from OSPQPost()            */
+#endif
+
 #if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
 #if OS_TASK_DEL_EN > 0u
     OS_FLAG_NODE    *OSTCBFlagNode;         /* Pointer to event flag node                              */
@@ -579,14 +831,32 @@ typedef struct os_tcb {
     INT8U            OSTCBDelReq;           /* Indicates whether a task needs to delete itself         */
 #endif
 
+#if OS_MUTEX_CEIL_EN > 0u
+    INT8U            OSTCBCeilPrio;         /* Tasks at or below this priority cannot preempt the task */
+    struct os_tcb   *OSTCBCeilNext;         /* Next task holding ceiling mutexes (see OSMutexCeilTCB)  */
+#endif
+
 #if OS_TASK_PROFILE_EN > 0u
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
-    INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
+    INT32U           OSTCBCtxSwOutCtr;      /* Number of time the task was switched out                */
+    INT32U           OSTCBFPCtr;            /* Number of time the task used the FPU after a switch in  */
+    INT64U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
     INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
 
+#if OS_SCHED_RR_EN > 0u
+    OS_SCHED_RR     *OSTCBRRPtr;            /* Pointer to round-robin level (NULL if none)             */
+    INT16U           OSTCBRRQuantum;        /* Time quantum in ticks (0 == quantum of the level)       */
+    INT16U           OSTCBRRQuantumCtr;     /* Ticks left in the current quantum                       */
+    INT32U           OSTCBRRTicks;          /* Number of ticks charged to the task                     */
+    INT32U           OSTCBRRSliceCtr;       /* Number of quanta consumed by the task                   */
+#if (OS_MUTEX_EN > 0u) && (OS_MAX_EVENTS > 0u)
+    OS_EVENT        *OSTCBMutexPtr;         /* List of the mutexes owned by the task                   */
+#endif
+#endif
+
 #if OS_TASK_NAME_EN > 0u
     INT8U           *OSTCBTaskName;
 #endif
@@ -635,6 +905,160 @@ typedef  struct  os_tmr_wheel {
 } OS_TMR_WHEEL;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DEFERRED ISR POST QUEUE
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0u
+#define  OS_INT_Q_TYPE_SEM_POST         1u  /* Kind of post queued by an ISR (see OS_IntQPost())       */
+#define  OS_INT_Q_TYPE_Q_POST           2u
+#define  OS_INT_Q_TYPE_Q_POST_FRONT     3u
+#define  OS_INT_Q_TYPE_Q_POST_OPT       4u
+#define  OS_INT_Q_TYPE_MBOX_POST        5u
+#define  OS_INT_Q_TYPE_MBOX_POST_OPT    6u
+#define  OS_INT_Q_TYPE_FLAG_POST        7u
+#define  OS_INT_Q_TYPE_PQ_POST          8u  /* OSIntQOpt holds the band                                */
+#define  OS_INT_Q_TYPE_NBR              9u  /* Size of the tables indexed by OS_INT_Q_TYPE_xxx          */
+
+#if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u) && (OS_FLAGS_NBITS == 64u)
+typedef  INT64U  OS_INT_Q_FLAGS;             /* Wide enough for OS_FLAGS                                */
+#else
+typedef  INT32U  OS_INT_Q_FLAGS;
+#endif
+
+typedef struct os_int_q {
+    INT8U    OSIntQType;                     /* Kind of post to replay (see OS_INT_Q_TYPE_xxx)          */
+    INT8U    OSIntQOpt;                      /* Post options (xxxPostOpt(), OSFlagPost()) or band       */
+    void    *OSIntQObjPtr;                   /* Pointer to event control block or event flag group      */
+    void    *OSIntQMsgPtr;                   /* Message posted to a queue or a mailbox                  */
+    OS_INT_Q_FLAGS  OSIntQFlags;             /* Flags posted to an event flag group                     */
+} OS_INT_Q;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             EVENT TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0u
+#define  OS_TRACE_MAGIC           0x52544375uL  /* 'uCTR', identifies OSTrace in a memory dump          */
+#define  OS_TRACE_VERSION                 1u
+
+#define  OS_TRACE_STATE_STOP              0u    /* Recording state (see OSTraceStart(), OSTraceTrigger()) */
+#define  OS_TRACE_STATE_RUN               1u
+#define  OS_TRACE_STATE_TRIG              2u    /* Running, stops after OSTraceStopCtr more events      */
+
+#define  OS_TRACE_TYPE_TASK_SW            1u    /* Arg: priority of the task switched in                */
+#define  OS_TRACE_TYPE_ISR_ENTER          2u    /* Arg: interrupt ID (0 if unknown)                     */
+#define  OS_TRACE_TYPE_ISR_EXIT           3u
+#define  OS_TRACE_TYPE_Q_POST             4u    /* Arg: pointer to the event control block             */
+#define  OS_TRACE_TYPE_Q_PEND             5u    /* xxxPEND: the task blocks on the event               */
+#define  OS_TRACE_TYPE_SEM_POST           6u
+#define  OS_TRACE_TYPE_SEM_PEND           7u
+#define  OS_TRACE_TYPE_MBOX_POST          8u
+#define  OS_TRACE_TYPE_MBOX_PEND          9u
+#define  OS_TRACE_TYPE_MUTEX_POST        10u
+#define  OS_TRACE_TYPE_MUTEX_PEND        11u
+#define  OS_TRACE_TYPE_TRIG              12u    /* Arg: value passed to OSTraceTrigger()                */
+
+typedef struct os_trace_rec {
+    INT32U   OSTraceTs;                      /* Time stamp (OS_TS_GET(), wraps)                         */
+    INT8U    OSTraceType;                    /* Kind of event (see OS_TRACE_TYPE_xxx)                   */
+    INT8U    OSTracePrio;                    /* Priority of the running task                            */
+    INT8U    OSTraceIntNesting;              /* Value of OSIntNesting (0 if at task level)              */
+    INT8U    OSTraceRsvd;
+    INT32U   OSTraceArg;                     /* Argument of the event                                   */
+} OS_TRACE_REC;
+
+typedef struct os_trace {
+    INT32U        OSTraceMagic;              /* OS_TRACE_MAGIC                                          */
+    INT16U        OSTraceVersion;            /* OS_TRACE_VERSION                                        */
+    INT16U        OSTraceRecSize;            /* sizeof(OS_TRACE_REC)                                    */
+    INT32U        OSTraceTsFreq;             /* Frequency of the time stamps (Hz)                       */
+    INT32U        OSTraceSize;               /* Number of entries in OSTraceTbl[]                       */
+    INT32U        OSTraceIn;                 /* Number of events recorded (next entry: In % Size)       */
+    INT32U        OSTraceStopCtr;            /* Events still to record after the trigger                */
+    INT8U         OSTraceState;              /* See OS_TRACE_STATE_xxx                                  */
+    INT8U         OSTraceRsvd[3];
+    OS_TRACE_REC  OSTraceTbl[OS_TRACE_SIZE];
+} OS_TRACE;
+
+#define  OS_TRACE(type, arg)     OS_TraceRec((INT8U)(type), (INT32U)(arg))
+#else
+#define  OS_TRACE(type, arg)
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          KERNEL VIEW SNAPSHOT
+*
+* Note(s): A snapshot is an OS_VIEW_HDR followed by 'OSViewNbrTasks' OS_VIEW_TASK and 'OSViewNbrEvents'
+*          OS_VIEW_EVENT, all little-endian and without padding (see tools/osview.py).
+*********************************************************************************************************
+*/
+
+#if OS_VIEW_EN > 0u
+#define  OS_VIEW_MAGIC            0x4E534375uL  /* 'uCSN', identifies a snapshot in a byte stream       */
+#define  OS_VIEW_VERSION                  1u
+#define  OS_VIEW_NAME_SIZE               16u    /* Names are truncated and padded with NULs             */
+#define  OS_VIEW_EVENT_NONE          0xFFFFu    /* OSViewEventId of a task not waiting on an event      */
+
+typedef struct os_view_hdr {
+    INT32U  OSViewMagic;                     /* OS_VIEW_MAGIC                                           */
+    INT16U  OSViewVersion;                   /* OS_VIEW_VERSION                                         */
+    INT8U   OSViewTaskSize;                  /* sizeof(OS_VIEW_TASK)                                    */
+    INT8U   OSViewEventSize;                 /* sizeof(OS_VIEW_EVENT)                                   */
+    INT32U  OSViewSize;                      /* Size of the snapshot, header included (bytes)           */
+    INT16U  OSViewNbrTasks;                  /* Number of OS_VIEW_TASK following the header             */
+    INT16U  OSViewNbrEvents;                 /* Number of OS_VIEW_EVENT following the tasks             */
+    INT32U  OSViewTsFreq;                    /* Frequency of the time stamps (Hz)                       */
+    INT32U  OSViewTs;                        /* OS_TS_GET() at the start of the snapshot                */
+    INT32U  OSViewTime;                      /* OSTime   at the start of the snapshot                   */
+    INT32U  OSViewCtxSwCtr;                  /* OSCtxSwCtr                                              */
+    INT32U  OSViewCycles;                    /* Time taken by OSViewSnap() (OS_TS_GET() time stamps)    */
+    INT8U   OSViewCPUUsage;                  /* OSCPUUsage (0 without the statistic task)               */
+    INT8U   OSViewRsvd[3];
+    INT64U  OSViewIntCyclesTot;              /* OSIntCyclesTot (0 without task profiling)               */
+} OS_VIEW_HDR;
+
+typedef struct os_view_task {
+    INT8U   OSViewPrio;                      /* Task priority                                           */
+    INT8U   OSViewStat;                      /* OSTCBStat                                               */
+    INT8U   OSViewStatPend;                  /* OSTCBStatPend                                           */
+    INT8U   OSViewRsvd;
+    INT16U  OSViewEventId;                   /* Index in OSEventTbl[] of the event waited for           */
+    INT16U  OSViewRsvd2;
+    INT32U  OSViewDly;                       /* OSTCBDly                                                */
+    INT32U  OSViewStkSize;                   /* Size of the stack (bytes, 0 if unknown)                 */
+    INT32U  OSViewStkUsed;                   /* Stack high-water mark (bytes, 0 if unknown)             */
+    INT32U  OSViewCtxSwCtr;                  /* OSTCBCtxSwCtr (0 without task profiling)                */
+    INT64U  OSViewCyclesTot;                 /* OSTCBCyclesTot (0 without task profiling)               */
+    INT8U   OSViewName[OS_VIEW_NAME_SIZE];
+} OS_VIEW_TASK;
+
+typedef struct os_view_event {
+    INT16U  OSViewId;                        /* Index in OSEventTbl[]                                   */
+    INT8U   OSViewType;                      /* OS_EVENT_TYPE_xxx                                       */
+    INT8U   OSViewNbrWait;                   /* Number of tasks waiting                                 */
+    INT16U  OSViewCnt;                       /* OSEventCnt: semaphore count, or PIP and owner of mutex  */
+    INT16U  OSViewEntries;                   /* Messages in the queue (or in the mailbox)               */
+    INT16U  OSViewQSize;                     /* Size of the queue                                       */
+    INT16U  OSViewQEntriesMax;               /* Peak of OSViewEntries (OS_Q_STAT_EN)                    */
+    INT32U  OSViewQNPosts;                   /* Messages posted to the queue (OS_Q_STAT_EN)             */
+    INT8U   OSViewName[OS_VIEW_NAME_SIZE];
+} OS_VIEW_EVENT;
+
+#define  OS_VIEW_SIZE_MAX       (sizeof(OS_VIEW_HDR)                                            \
+                               + (OS_MAX_TASKS + OS_N_SYS_TASKS) * sizeof(OS_VIEW_TASK)        \
+                               +  OS_MAX_EVENTS                  * sizeof(OS_VIEW_EVENT))
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -645,13 +1069,13 @@ typedef  struct  os_tmr_wheel {
 OS_EXT  INT32U            OSCtxSwCtr;               /* Counter of number of context switches           */
 
 #if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)
-OS_EXT  OS_EVENT         *OSEventFreeList;          /* Pointer to list of free EVENT control blocks    */
-OS_EXT  OS_EVENT          OSEventTbl[OS_MAX_EVENTS];/* Table of EVENT control blocks                   */
+OS_EXT_INIT  OS_EVENT    *OSEventFreeList;          /* Pointer to list of free EVENT control blocks    */
+OS_EXT_INIT  OS_EVENT     OSEventTbl[OS_MAX_EVENTS];/* Table of EVENT control blocks                   */
 #endif
 
 #if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
-OS_EXT  OS_FLAG_GRP       OSFlagTbl[OS_MAX_FLAGS];  /* Table containing event flag groups              */
-OS_EXT  OS_FLAG_GRP      *OSFlagFreeList;           /* Pointer to free list of event flag groups       */
+OS_EXT_INIT  OS_FLAG_GRP  OSFlagTbl[OS_MAX_FLAGS];  /* Table containing event flag groups              */
+OS_EXT_INIT  OS_FLAG_GRP *OSFlagFreeList;           /* Pointer to free list of event flag groups       */
 #endif
 
 #if OS_TASK_STAT_EN > 0u
@@ -664,6 +1088,10 @@ OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statisti
 
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
 
+#if OS_TASK_PROFILE_EN > 0u
+OS_EXT  INT64U            OSIntCyclesTot;           /* Total number of clock cycles spent in ISRs      */
+#endif
+
 OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting level                 */
 
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
@@ -684,13 +1112,22 @@ OS_EXT  BOOLEAN           OSSafetyCriticalStartFlag;
 
 OS_EXT  OS_STK            OSTaskIdleStk[OS_TASK_IDLE_STK_SIZE];      /* Idle task stack                */
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TASK_STK_CLR_LAZY_EN > 0u)
+OS_EXT  INT8U             OSTaskStkClrPrio;         /* Next task whose stack is cleared by idle task   */
+#endif
+
 
 OS_EXT  OS_TCB           *OSTCBCur;                        /* Pointer to currently running TCB         */
-OS_EXT  OS_TCB           *OSTCBFreeList;                   /* Pointer to list of free TCBs             */
+OS_EXT_INIT  OS_TCB      *OSTCBFreeList;                   /* Pointer to list of free TCBs             */
 OS_EXT  OS_TCB           *OSTCBHighRdy;                    /* Pointer to highest priority TCB R-to-R   */
 OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly linked list of TCBs    */
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1u];    /* Table of pointers to created TCBs   */
-OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
+OS_EXT_INIT  OS_TCB       OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
+
+#if OS_SCHED_RR_EN > 0u
+OS_EXT  OS_SCHED_RR       OSSchedRRTbl[OS_SCHED_RR_MAX_LEVELS];  /* Table of round-robin levels     */
+OS_EXT  INT8U             OSSchedRRCtr;             /* Number of round-robin levels created            */
+#endif
 
 #if OS_TICK_STEP_EN > 0u
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
@@ -701,9 +1138,19 @@ OS_EXT  OS_MEM           *OSMemFreeList;            /* Pointer to free list of m
 OS_EXT  OS_MEM            OSMemTbl[OS_MAX_MEM_PART];/* Storage for memory partition manager            */
 #endif
 
+#if (OS_EVENT_EN) && (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+OS_EXT  OS_EVENT_SET     *OSEventSetFreeList;       /* Pointer to list of free event sets              */
+OS_EXT  OS_EVENT_SET      OSEventSetTbl[OS_MAX_EVENT_SETS];  /* Table of event sets                    */
+#endif
+
 #if (OS_Q_EN > 0u) && (OS_MAX_QS > 0u)
-OS_EXT  OS_Q             *OSQFreeList;              /* Pointer to list of free QUEUE control blocks    */
-OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
+OS_EXT_INIT  OS_Q        *OSQFreeList;              /* Pointer to list of free QUEUE control blocks    */
+OS_EXT_INIT  OS_Q         OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
+#endif
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+OS_EXT_INIT  OS_PQ       *OSPQFreeList;             /* Pointer to list of free PRIORITY QUEUE blocks   */
+OS_EXT_INIT  OS_PQ        OSPQTbl[OS_MAX_PQS];      /* Table of PRIORITY QUEUE control blocks          */
 #endif
 
 #if OS_TIME_GET_SET_EN > 0u
@@ -725,6 +1172,26 @@ OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0u
+OS_EXT  OS_INT_Q          OSIntQTbl[OS_INT_Q_SIZE]; /* Posts queued by ISRs                            */
+OS_EXT  volatile  INT16U  OSIntQIn;                 /* Index of next free entry    (written by ISRs)   */
+OS_EXT  volatile  INT16U  OSIntQOut;                /* Index of next entry to post (written by task)   */
+OS_EXT  INT16U            OSIntQNbrEntriesMax;      /* Maximum number of posts waiting in the queue    */
+OS_EXT  INT32U            OSIntQOvfCtr;             /* Number of posts lost because the queue was full */
+OS_EXT  INT32U            OSIntQErrCtr[OS_INT_Q_TYPE_NBR]; /* Replayed posts that failed, per type    */
+OS_EXT  INT8U             OSIntQErrLast;            /* Error of the last replayed post that failed     */
+OS_EXT  OS_STK            OSIntQTaskStk[OS_TASK_INT_Q_STK_SIZE];
+#endif
+
+#if OS_TRACE_EN > 0u
+OS_EXT  OS_TRACE          OSTrace;                  /* Kernel event trace (dump it as is to the host)  */
+#endif
+
+#if OS_MUTEX_CEIL_EN > 0u
+OS_EXT  BOOLEAN           OSMutexCeilSchedPend;     /* A switch was held back by a ceiling mutex       */
+OS_EXT  OS_TCB * volatile OSMutexCeilTCB;           /* Stack of the tasks holding ceiling mutexes      */
+#endif
+
 extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
 
 /*$PAGE*/
@@ -761,6 +1228,36 @@ INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
                                        INT8U           *perr);
 #endif
 
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+#if (OS_EVENT_SET_ACCEPT_EN > 0u)
+INT8U         OSEventSetAccept        (OS_EVENT        *pevent,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT8U            nbr_max,
+                                       INT8U           *perr);
+#endif
+
+INT8U         OSEventSetAdd           (OS_EVENT        *pevent,
+                                       OS_EVENT        *pmember,
+                                       INT8U            prio);
+
+OS_EVENT     *OSEventSetCreate        (INT8U           *perr);
+
+#if (OS_EVENT_SET_DEL_EN > 0u)
+OS_EVENT     *OSEventSetDel           (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+INT8U         OSEventSetPend          (OS_EVENT        *pevent,
+                                       OS_EVENT       **pevents_rdy,
+                                       INT8U            nbr_max,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSEventSetRemove        (OS_EVENT        *pevent,
+                                       OS_EVENT        *pmember);
+#endif
+
 #endif
 
 /*
@@ -931,6 +1428,20 @@ INT8U         OSMutexQuery            (OS_EVENT        *pevent,
 
 #endif
 
+#if OS_MUTEX_CEIL_EN > 0u
+BOOLEAN       OSMutexCeilAccept       (OS_MUTEX_CEIL   *pmutex,
+                                       INT8U           *perr);
+
+INT8U         OSMutexCeilCreate       (OS_MUTEX_CEIL   *pmutex,
+                                       INT8U            prio);
+
+void          OSMutexCeilPend         (OS_MUTEX_CEIL   *pmutex,
+                                       INT32U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSMutexCeilPost         (OS_MUTEX_CEIL   *pmutex);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -968,6 +1479,12 @@ INT8U         OSQPendAbort            (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if OS_Q_POLICY_EN > 0u
+INT8U         OSQPolicySet            (OS_EVENT        *pevent,
+                                       INT8U            policy,
+                                       OS_Q_DROP_FNCT   drop_fnct);
+#endif
+
 #if OS_Q_POST_EN > 0u
 INT8U         OSQPost                 (OS_EVENT        *pevent,
                                        void            *pmsg);
@@ -978,6 +1495,12 @@ INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_POLICY_EN > 0u
+INT8U         OSQPostPend             (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT32U           timeout);
+#endif
+
 #if OS_Q_POST_OPT_EN > 0u
 INT8U         OSQPostOpt              (OS_EVENT        *pevent,
                                        void            *pmsg,
@@ -989,6 +1512,55 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
                                        OS_Q_DATA       *p_q_data);
 #endif
 
+#if OS_Q_STAT_EN > 0u
+INT8U         OSQStatGet              (OS_EVENT        *pevent,
+                                       OS_Q_STAT       *p_q_stat,
+                                       INT8U            opt);
+#endif
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PRIORITY MESSAGE QUEUE MANAGEMENT
+*********************************************************************************************************
+*/
+
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+
+#if OS_PQ_ACCEPT_EN > 0u
+void         *OSPQAccept              (OS_EVENT        *pevent,
+                                       INT8U           *pband,
+                                       INT8U           *perr);
+#endif
+
+OS_EVENT     *OSPQCreate              (void           **start,
+                                       INT16U          *sizes,
+                                       INT8U            nbr_bands,
+                                       INT8U           *perr);
+
+#if OS_PQ_DEL_EN > 0u
+OS_EVENT     *OSPQDel                 (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+void         *OSPQPend                (OS_EVENT        *pevent,
+                                       INT32U           timeout,
+                                       INT8U           *pband,
+                                       INT8U           *perr);
+
+INT8U         OSPQPost                (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            band);
+
+#if OS_PQ_STAT_EN > 0u
+INT8U         OSPQStatGet             (OS_EVENT        *pevent,
+                                       OS_PQ_STAT      *p_pq_stat,
+                                       INT8U            opt);
+#endif
+
 #endif
 
 /*$PAGE*/
@@ -1066,6 +1638,15 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT16U           opt);
 #endif
 
+#if OS_TASK_PROFILE_EN > 0u
+void          OSTaskCycSnap           (OS_TASK_CYC_SNAP *psnap);
+
+INT16U        OSTaskCycUsage          (OS_TASK_CYC_SNAP *pprev,
+                                       OS_TASK_CYC_SNAP *pcur,
+                                       INT8U            prio,
+                                       INT8U           *perr);
+#endif
+
 #if OS_TASK_DEL_EN > 0u
 INT8U         OSTaskDel               (INT8U            prio);
 INT8U         OSTaskDelReq            (INT8U            prio);
@@ -1089,6 +1670,9 @@ INT8U         OSTaskSuspend           (INT8U            prio);
 #if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u)
 INT8U         OSTaskStkChk            (INT8U            prio,
                                        OS_STK_DATA     *p_stk_data);
+
+INT8U         OSTaskStkHwm            (INT8U            prio,
+                                       OS_STK_DATA     *p_stk_data);
 #endif
 
 #if OS_TASK_QUERY_EN > 0u
@@ -1176,6 +1760,35 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
 INT8U        OSTmrSignal              (void);
 #endif
 
+/*
+*********************************************************************************************************
+*                                              EVENT TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0u
+void          OSTraceSnap             (OS_TRACE        *psnap);
+
+void          OSTraceStart            (void);
+
+void          OSTraceStop             (void);
+
+void          OSTraceTrigger          (INT32U           arg,
+                                       INT32U           nbr_post);
+#endif
+
+/*
+*********************************************************************************************************
+*                                          KERNEL VIEW SNAPSHOT
+*********************************************************************************************************
+*/
+
+#if OS_VIEW_EN > 0u
+INT32U        OSViewSnap              (void            *pbuf,
+                                       INT32U           size,
+                                       INT8U           *perr);
+#endif
+
 /*
 *********************************************************************************************************
 *                                             MISCELLANEOUS
@@ -1196,6 +1809,15 @@ void          OSSchedLock             (void);
 void          OSSchedUnlock           (void);
 #endif
 
+#if OS_SCHED_RR_EN > 0u
+INT8U         OSSchedRRCreate         (INT8U            prio,
+                                       INT8U            nbr_tasks,
+                                       INT16U           quantum);
+
+INT8U         OSSchedRRQuantumSet     (INT8U            prio,
+                                       INT16U           quantum);
+#endif
+
 void          OSStart                 (void);
 
 void          OSStatInit              (void);
@@ -1233,6 +1855,12 @@ void          OS_EventTaskRemoveMulti (OS_TCB          *ptcb,
 #endif
 
 void          OS_EventWaitListInit    (OS_EVENT        *pevent);
+
+#if (OS_EVENT_SET_EN > 0u) && (OS_MAX_EVENT_SETS > 0u)
+void          OS_EventSetInit         (void);
+BOOLEAN       OS_EventSetSignal       (OS_EVENT        *pmember);
+void          OS_EventSetUnlink       (OS_EVENT        *pmember);
+#endif
 #endif
 
 #if (OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)
@@ -1251,12 +1879,43 @@ void          OS_MemCopy              (INT8U           *pdest,
 void          OS_MemInit              (void);
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0u
+void          OS_IntQInit             (void);
+
+INT8U         OS_IntQPost             (INT8U            type,
+                                       void            *pobj,
+                                       void            *pmsg,
+                                       OS_INT_Q_FLAGS   flags,
+                                       INT8U            opt);
+
+void          OS_IntQTaskRdy          (void);
+#endif
+
+#if OS_TRACE_EN > 0u
+void          OS_TraceInit            (void);
+
+void          OS_TraceRec             (INT8U            type,
+                                       INT32U           arg);
+#endif
+
 #if OS_Q_EN > 0u
 void          OS_QInit                (void);
 #endif
 
+#if (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+void          OS_PQInit               (void);
+#endif
+
 void          OS_Sched                (void);
 
+#if OS_SCHED_RR_EN > 0u
+OS_SCHED_RR  *OS_SchedRRFind          (INT8U            prio);
+void          OS_SchedRRInit          (void);
+INT8U         OS_SchedRRPrioGet       (INT8U            prio);
+void          OS_SchedRRTCBInit       (OS_TCB          *ptcb);
+void          OS_SchedRRTick          (void);
+#endif
+
 #if (OS_EVENT_NAME_EN > 0u) || (OS_FLAG_NAME_EN > 0u) || (OS_MEM_NAME_EN > 0u) || (OS_TASK_NAME_EN > 0u)
 INT8U         OS_StrLen               (INT8U           *psrc);
 #endif
@@ -1279,6 +1938,10 @@ void          OS_TaskStkClr           (OS_STK          *pbos,
 void          OS_TaskStatStkChk       (void);
 #endif
 
+#if (OS_TASK_STAT_STK_CHK_EN > 0u) && (OS_TASK_CREATE_EXT_EN > 0u) && (OS_TASK_STK_CLR_LAZY_EN > 0u)
+void          OS_TaskStkClrIdle       (void);
+#endif
+
 INT8U         OS_TCBInit              (INT8U            prio,
                                        OS_STK          *ptos,
                                        OS_STK          *pbos,
@@ -1402,7 +2065,11 @@ void          OSCtxSw                 (void);
     #endif
 
     #ifndef OS_FLAGS_NBITS
-    #error  "OS_CFG.H, Missing OS_FLAGS_NBITS: Determine #bits used for event flags, MUST be either 8, 16 or 32"
+    #error  "OS_CFG.H, Missing OS_FLAGS_NBITS: Determine #bits used for event flags, MUST be either 8, 16, 32 or 64"
+    #endif
+
+    #ifndef OS_FLAG_WAIT_IX_EN
+    #error  "OS_CFG.H, Missing OS_FLAG_WAIT_IX_EN: Index tasks waiting on EVENT FLAGS by bit"
     #endif
 
     #ifndef OS_FLAG_WAIT_CLR_EN
@@ -1508,6 +2175,14 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+#ifndef OS_MUTEX_CEIL_EN
+#error  "OS_CFG.H, Missing OS_MUTEX_CEIL_EN: Enable (1) or Disable (0) the priority ceiling mutexes"
+#else
+    #if     (OS_MUTEX_CEIL_EN > 0u) && (OS_SEM_EN == 0u)
+    #error  "OS_CFG.H, OS_SEM_EN must be enabled for the priority ceiling mutexes (waiting on contention)"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              MESSAGE QUEUES
@@ -1556,6 +2231,72 @@ void          OSCtxSw                 (void);
     #ifndef OS_Q_QUERY_EN
     #error  "OS_CFG.H, Missing OS_Q_QUERY_EN: Include code for OSQQuery()"
     #endif
+
+    #ifndef OS_Q_POLICY_EN
+    #error  "OS_CFG.H, Missing OS_Q_POLICY_EN: Include OSQPolicySet(), OSQPostPend() and drop counters"
+    #endif
+
+    #ifndef OS_Q_STAT_EN
+    #error  "OS_CFG.H, Missing OS_Q_STAT_EN: Include queue telemetry and OSQStatGet()"
+    #endif
+
+    #if     OS_Q_STAT_EN > 0u
+        #ifndef OS_TS_GET
+        #error  "OS_CPU.H, Missing OS_TS_GET(): Read the time stamp counter"
+        #endif
+    #endif
+
+    #if     (OS_Q_POLICY_EN > 0u) && (OS_Q_POST_EN == 0u)
+    #error  "OS_CFG.H, OS_Q_POST_EN must be enabled to use OSQPostPend() (OS_Q_POLICY_EN)"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                         PRIORITY MESSAGE QUEUES
+*********************************************************************************************************
+*/
+
+#ifndef OS_PQ_EN
+#error  "OS_CFG.H, Missing OS_PQ_EN: Enable (1) or Disable (0) code generation for PRIORITY QUEUES"
+#else
+    #ifndef OS_MAX_PQS
+    #error  "OS_CFG.H, Missing OS_MAX_PQS: Max. number of priority queue control blocks"
+    #else
+        #if     OS_MAX_PQS > 65500u
+        #error  "OS_CFG.H, OS_MAX_PQS must be <= 65500"
+        #endif
+    #endif
+
+    #ifndef OS_PQ_BANDS_MAX
+    #error  "OS_CFG.H, Missing OS_PQ_BANDS_MAX: Max. number of bands of a priority queue"
+    #else
+        #if     (OS_PQ_BANDS_MAX == 0u) || (OS_PQ_BANDS_MAX > 32u)
+        #error  "OS_CFG.H, OS_PQ_BANDS_MAX must be > 0 and <= 32"
+        #endif
+    #endif
+
+    #ifndef OS_PQ_ACCEPT_EN
+    #error  "OS_CFG.H, Missing OS_PQ_ACCEPT_EN: Include code for OSPQAccept()"
+    #endif
+
+    #ifndef OS_PQ_DEL_EN
+    #error  "OS_CFG.H, Missing OS_PQ_DEL_EN: Include code for OSPQDel()"
+    #endif
+
+    #ifndef OS_PQ_STAT_EN
+    #error  "OS_CFG.H, Missing OS_PQ_STAT_EN: Include code for OSPQStatGet()"
+    #endif
+
+    #if     (OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)
+        #if     (OS_Q_EN == 0u) || (OS_MAX_QS == 0u)
+        #error  "OS_CFG.H, OS_Q_EN and OS_MAX_QS must be enabled to use the priority queues (OS_PQ_EN)"
+        #endif
+
+        #ifndef OS_CPU_CntTrailZeros
+        #error  "OS_CPU.H, Missing OS_CPU_CntTrailZeros(): Find the lowest bit set in a 32-bit word"
+        #endif
+    #endif
 #endif
 
 /*
@@ -1625,6 +2366,34 @@ void          OSCtxSw                 (void);
 
 #ifndef OS_TASK_STAT_STK_CHK_EN
 #error  "OS_CFG.H, Missing OS_TASK_STAT_STK_CHK_EN: Check task stacks from statistics task"
+#else
+    #if     OS_TASK_STAT_STK_CHK_EN > 0u
+        #ifndef OS_TASK_STK_CHK_SLICE
+        #error  "OS_CFG.H, Missing OS_TASK_STK_CHK_SLICE: Max. number of stack entries checked per task"
+        #else
+            #if     OS_TASK_STK_CHK_SLICE == 0u
+            #error  "OS_CFG.H, OS_TASK_STK_CHK_SLICE must be > 0"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_STK_GUARD_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_STK_GUARD_SIZE: Number of guard entries at the end of each stack"
+        #endif
+
+        #ifndef OS_TASK_STK_CLR_LAZY_EN
+        #error  "OS_CFG.H, Missing OS_TASK_STK_CLR_LAZY_EN: Stacks cleared by the idle task"
+        #else
+            #if     OS_TASK_STK_CLR_LAZY_EN > 0u
+                #ifndef OS_TASK_STK_CLR_SLICE
+                #error  "OS_CFG.H, Missing OS_TASK_STK_CLR_SLICE: Max. number of stack entries cleared per idle task loop"
+                #else
+                    #if     OS_TASK_STK_CLR_SLICE == 0u
+                    #error  "OS_CFG.H, OS_TASK_STK_CLR_SLICE must be > 0"
+                    #endif
+                #endif
+            #endif
+        #endif
+    #endif
 #endif
 
 #ifndef OS_TASK_CHANGE_PRIO_EN
@@ -1737,6 +2506,80 @@ void          OSCtxSw                 (void);
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          DEFERRED ISR POSTS
+*********************************************************************************************************
+*/
+
+#ifndef OS_ISR_POST_DEFERRED_EN
+#error  "OS_CFG.H, Missing OS_ISR_POST_DEFERRED_EN: Defer posts made from ISRs to a task"
+#else
+    #if     OS_ISR_POST_DEFERRED_EN > 0u
+        #ifndef OS_INT_Q_SIZE
+        #error  "OS_CFG.H, Missing OS_INT_Q_SIZE: Size of the ISR post queue"
+        #else
+            #if     OS_INT_Q_SIZE < 2u
+            #error  "OS_CFG.H, OS_INT_Q_SIZE must be >= 2"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_INT_Q_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_PRIO: Priority of the ISR post queue task"
+        #endif
+
+        #ifndef OS_TASK_INT_Q_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_STK_SIZE: Determines the size of the ISR post queue task's stack"
+        #endif
+    #endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              EVENT TRACE
+*********************************************************************************************************
+*/
+
+#ifndef OS_TRACE_EN
+#error  "OS_CFG.H, Missing OS_TRACE_EN: Enable (1) or Disable (0) the kernel event trace recorder"
+#else
+    #if     OS_TRACE_EN > 0u
+        #ifndef OS_TRACE_SIZE
+        #error  "OS_CFG.H, Missing OS_TRACE_SIZE: Number of events kept in the trace"
+        #else
+            #if     (OS_TRACE_SIZE < 2u) || ((OS_TRACE_SIZE & (OS_TRACE_SIZE - 1u)) != 0u)
+            #error  "OS_CFG.H, OS_TRACE_SIZE must be a power of 2 >= 2"
+            #endif
+            #if     OS_TRACE_SIZE > 4096u
+            #error  "OS_CFG.H, OS_TRACE_SIZE must be <= 4096 (OSTraceSnap() copies it with OS_MemCopy())"
+            #endif
+        #endif
+
+        #ifndef OS_TS_GET
+        #error  "OS_CPU.H, Missing OS_TS_GET(): Read the time stamp counter"
+        #endif
+    #endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          KERNEL VIEW SNAPSHOT
+*********************************************************************************************************
+*/
+
+#ifndef OS_VIEW_EN
+#error  "OS_CFG.H, Missing OS_VIEW_EN: Enable (1) or Disable (0) the kernel view snapshots (OSViewSnap())"
+#else
+    #if     OS_VIEW_EN > 0u
+        #ifndef OS_TS_GET
+        #error  "OS_CPU.H, Missing OS_TS_GET(): Read the time stamp counter"
+        #endif
+    #endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                            MISCELLANEOUS
@@ -1763,6 +2606,11 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_INIT_STATIC_EN
+#error  "OS_CFG.H, Missing OS_INIT_STATIC_EN: Free lists initialized in .data (OS_INIT_TBL.C)"
+#endif
+
+
 #ifndef OS_LOWEST_PRIO
 #error  "OS_CFG.H, Missing OS_LOWEST_PRIO: Defines the lowest priority that can be assigned"
 #endif
@@ -1782,11 +2630,60 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_SCHED_RR_EN
+#error  "OS_CFG.H, Missing OS_SCHED_RR_EN: Include code for round-robin levels"
+#else
+    #if     OS_SCHED_RR_EN > 0u
+        #ifndef OS_SCHED_RR_MAX_LEVELS
+        #error  "OS_CFG.H, Missing OS_SCHED_RR_MAX_LEVELS: Max. number of round-robin levels"
+        #else
+            #if     OS_SCHED_RR_MAX_LEVELS == 0u
+            #error  "OS_CFG.H, OS_SCHED_RR_MAX_LEVELS must be > 0"
+            #endif
+        #endif
+        #ifndef OS_SCHED_RR_MAX_TASKS
+        #error  "OS_CFG.H, Missing OS_SCHED_RR_MAX_TASKS: Max. number of tasks in a round-robin level"
+        #else
+            #if     OS_SCHED_RR_MAX_TASKS < 2u
+            #error  "OS_CFG.H, OS_SCHED_RR_MAX_TASKS must be >= 2"
+            #endif
+        #endif
+        #ifndef OS_SCHED_RR_QUANTUM
+        #error  "OS_CFG.H, Missing OS_SCHED_RR_QUANTUM: Default time quantum of a round-robin level"
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_EVENT_MULTI_EN
 #error  "OS_CFG.H, Missing OS_EVENT_MULTI_EN: Include code for OSEventPendMulti()"
 #endif
 
 
+#ifndef OS_EVENT_SET_EN
+#error  "OS_CFG.H, Missing OS_EVENT_SET_EN: Include code for event sets"
+#else
+    #if     OS_EVENT_SET_EN > 0u
+        #ifndef OS_MAX_EVENT_SETS
+        #error  "OS_CFG.H, Missing OS_MAX_EVENT_SETS: Max. number of event sets"
+        #endif
+        #ifndef OS_EVENT_SET_ACCEPT_EN
+        #error  "OS_CFG.H, Missing OS_EVENT_SET_ACCEPT_EN: Include code for OSEventSetAccept()"
+        #endif
+        #ifndef OS_EVENT_SET_DEL_EN
+        #error  "OS_CFG.H, Missing OS_EVENT_SET_DEL_EN: Include code for OSEventSetDel()"
+        #endif
+        #ifndef OS_EVENT_SET_SIZE
+        #error  "OS_CFG.H, Missing OS_EVENT_SET_SIZE: Max. number of members of an event set"
+        #else
+            #if     (OS_EVENT_SET_SIZE == 0u) || (OS_EVENT_SET_SIZE > 64u)
+            #error  "OS_CFG.H, OS_EVENT_SET_SIZE must be > 0 and <= 64"
+            #endif
+        #endif
+    #endif
+#endif
+
+
 #ifndef OS_TASK_PROFILE_EN
 #error  "OS_CFG.H, Missing OS_TASK_PROFILE_EN: Include data structure for run-time task profiling"
 #endif
@@ -1870,6 +2767,12 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+#if    OS_PQ_EN > 0u
+    #if    OS_PQ_DEL_EN > 0u
+    #error "OS_CFG.H, OS_PQ_DEL_EN must be disabled for safety-critical release code"
+    #endif
+#endif
+
 #if    OS_SEM_EN > 0u
     #if    OS_SEM_DEL_EN > 0u
     #error "OS_CFG.H, OS_SEM_DEL_EN must be disabled for safety-critical release code"
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Generate src/ucos/os_init_tbl.c, the statically initialized kernel tables
+used when OS_INIT_STATIC_EN is set in os_cfg_r.h.
+
+OSInit() then finds the free lists of TCBs, event control blocks, event flag
+groups, queues and priority queues already chained in .data instead of
+clearing and chaining them at run time. Run again after changing
+OS_MAX_TASKS, OS_TASK_STAT_EN, OS_MAX_EVENTS, OS_MAX_FLAGS, OS_MAX_QS or
+OS_MAX_PQS (os_init_tbl.c stops the build on an #error until then):
+
+    os_init_gen.py                     # src/ucos/os_cfg_r.h -> src/ucos/os_init_tbl.c
+    os_init_gen.py -c os_cfg_r.h -o os_init_tbl.c
+"""
+
+import argparse
+import os
+import re
+import sys
+
+UCOS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "ucos")
+
+HEADER = """\
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                  STATICALLY INITIALIZED KERNEL TABLES
+*
+* File    : OS_INIT_TBL.C
+* Version : V2.91
+*
+* Generated by tools/os_init_gen.py from OS_CFG_R.H, DO NOT EDIT.
+*
+* The free lists built by OS_InitTCBList(), OS_InitEventList(), OS_FlagInit(), OS_QInit() and OS_PQInit()
+* when OS_INIT_STATIC_EN is 0, placed in .data so that OSInit() does not have to build them.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include "ucos_ii.h"
+#endif
+
+#if OS_INIT_STATIC_EN > 0u
+"""
+
+# (table, free list, type, link field, #if of the table, size, what sets it, name field, #if of the name)
+TABLES = [
+    ("OSTCBTbl", "OSTCBFreeList", "OS_TCB", "OSTCBNext", None,
+     "OS_MAX_TASKS + OS_N_SYS_TASKS", "OS_MAX_TASKS or OS_TASK_STAT_EN",
+     "OSTCBTaskName", "OS_TASK_NAME_EN", "FREE LIST OF TASK CONTROL BLOCKS"),
+    ("OSEventTbl", "OSEventFreeList", "OS_EVENT", "OSEventPtr", "(OS_EVENT_EN) && (OS_MAX_EVENTS > 0u)",
+     "OS_MAX_EVENTS", "OS_MAX_EVENTS",
+     "OSEventName", "OS_EVENT_NAME_EN", "FREE LIST OF EVENT CONTROL BLOCKS"),
+    ("OSFlagTbl", "OSFlagFreeList", "OS_FLAG_GRP", "OSFlagWaitList", "(OS_FLAG_EN > 0u) && (OS_MAX_FLAGS > 0u)",
+     "OS_MAX_FLAGS", "OS_MAX_FLAGS",
+     "OSFlagName", "OS_FLAG_NAME_EN", "FREE LIST OF EVENT FLAG GROUPS"),
+    ("OSQTbl", "OSQFreeList", "OS_Q", "OSQPtr", "(OS_Q_EN > 0u) && (OS_MAX_QS > 0u)",
+     "OS_MAX_QS", "OS_MAX_QS", None, None, "FREE LIST OF QUEUE CONTROL BLOCKS"),
+    ("OSPQTbl", "OSPQFreeList", "OS_PQ", "OSPQPtr", "(OS_PQ_EN > 0u) && (OS_MAX_PQS > 0u)",
+     "OS_MAX_PQS", "OS_MAX_PQS", None, None, "FREE LIST OF PRIORITY QUEUE CONTROL BLOCKS"),
+]
+
+
+def read_cfg(path):
+    cfg = {}
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            m = re.match(r"\s*#define\s+(OS_\w+)\s+(0x[0-9A-Fa-f]+|\d+)[uUlL]*\b", line)
+            if m:
+                cfg[m.group(1)] = int(m.group(2), 0)
+    return cfg
+
+
+def banner(title):
+    return ("/*$PAGE*/\n/*\n" + "*" * 105 + "\n*" + title.center(103).rstrip() + "\n" +
+            "*" * 105 + "\n*/\n\n")
+
+
+def table(name, free, typ, link, guard, size_expr, size_cfg, name_field, name_guard, title, n):
+    macro = "OS_INIT_" + typ[3:].replace("_GRP", "")
+    ptr = "(void *)" if link == "OSFlagWaitList" else "(%s *)" % typ
+    out = [banner(title)]
+    if guard:
+        out.append("#if %s\n" % guard)
+    out.append("#if (%s) != %du\n" % (size_expr, n))
+    out.append('#error  "OS_INIT_TBL.C, %s changed: run tools/os_init_gen.py"\n' % size_cfg)
+    out.append("#endif\n\n")
+    if name_field:
+        out.append("#if %s > 0u\n" % name_guard)
+        out.append("#define  %-20s { .%s = (next), .%s = (INT8U *)(void *)\"?\" }\n" %
+                   (macro + "(next)", link, name_field))
+        out.append("#else\n")
+    out.append("#define  %-20s { .%s = (next) }\n" % (macro + "(next)", link))
+    if name_field:
+        out.append("#endif\n")
+    out.append("\n%-8s  %s[%s] = {\n" % (typ, name, size_expr))
+    for i in range(n):
+        nxt = "&%s[%d]" % (name, i + 1) if i + 1 < n else ptr + "0"
+        out.append("    %s(%s)%s\n" % (macro, nxt, "," if i + 1 < n else ""))
+    out.append("};\n\n")
+    out.append("%-8s *%s = &%s[0];\n" % (typ, free, name))
+    if guard:
+        out.append("#endif\n")
+    out.append("\n")
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("-c", "--cfg", default=os.path.join(UCOS, "os_cfg_r.h"))
+    parser.add_argument("-o", "--output", default=os.path.join(UCOS, "os_init_tbl.c"))
+    args = parser.parse_args()
+
+    cfg = read_cfg(args.cfg)
+    try:
+        sizes = {
+            "OSTCBTbl":   cfg["OS_MAX_TASKS"] + (2 if cfg["OS_TASK_STAT_EN"] else 1),
+            "OSEventTbl": cfg["OS_MAX_EVENTS"],
+            "OSFlagTbl":  cfg["OS_MAX_FLAGS"],
+            "OSQTbl":     cfg["OS_MAX_QS"],
+            "OSPQTbl":    cfg.get("OS_MAX_PQS", 0),
+        }
+    except KeyError as e:
+        sys.exit("%s: %s not found" % (args.cfg, e))
+
+    out = [HEADER, "\n"]
+    for t in TABLES:
+        if sizes[t[0]] > 0:
+            out.append(table(*t, sizes[t[0]]))
+    out.append("#endif\n")
+    text = "".join(out).replace("/*$PAGE*/\n", "/*$PAGE*/\f\n")
+    with open(args.output, "w", newline="\n") as f:
+        f.write(text)
+    print("%s: %s" % (os.path.normpath(args.output), ", ".join("%s[%d]" % kv for kv in sizes.items())))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""Live top-like view of uC/OS-II from the kernel snapshots (OSViewSnap(), see
+src/ucos/os_view.c) that TaskOSView (src/osview.c) sends on the console UART.
+
+    osview.py /dev/ttyUSB1                 # needs pyserial
+    osview.py /dev/ttyUSB1 -n 10=TaskGenerate -n 16=TaskForwarding
+    osview.py capture.bin --once           # frames saved from the UART
+
+Any key sent to the board asks for a snapshot right away (osview.py sends one
+every --interval seconds, or only at start with --interval 0). Text printed by
+the application between frames is shown at the bottom.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+SYNC = b"\x00\xff"
+MAGIC = 0x4E534375
+HDR = struct.Struct("<IHBBIHHIIIIIB3xQ")
+TASK = struct.Struct("<BBBxHxxIIIIQ16s")
+EVENT = struct.Struct("<HBBHHHHI16s")
+
+# OSTCBStat bits, see ucos_ii.h
+STAT_BITS = [(0x01, "SEM"), (0x02, "MBOX"), (0x04, "Q"), (0x10, "MUTEX"), (0x20, "FLAG"),
+             (0x40, "SET"), (0x80, "MULTI"), (0x08, "SUSP")]
+EVENT_TYPES = {1: "MBOX", 2: "Q", 3: "SEM", 4: "MUTEX", 5: "FLAG", 6: "SET", 7: "PQ"}
+QUEUE_TYPES = (2, 7)
+EVENT_NONE = 0xFFFF
+MUTEX_AVAILABLE = 0xFF
+
+# Kernel tasks, see os_cfg_r.h
+TASK_NAMES = {0: "OS_IntQTask", 62: "OS_TaskStat", 63: "OS_TaskIdle"}
+
+
+def fletcher16(data):
+    s1 = s2 = 0
+    for b in data:
+        s1 = (s1 + b) % 255
+        s2 = (s2 + s1) % 255
+    return s1, s2
+
+
+def cstr(raw):
+    return raw.split(b"\0", 1)[0].decode("latin-1")
+
+
+def parse(snap):
+    (magic, version, task_size, event_size, size, nbr_tasks, nbr_events, ts_freq, ts, tick,
+     ctx_sw, cycles, cpu_usage, int_cycles) = HDR.unpack_from(snap)
+    if magic != MAGIC or version != 1 or task_size != TASK.size or event_size != EVENT.size:
+        raise ValueError("unsupported snapshot (version %d)" % version)
+    off = HDR.size
+    tasks, events = [], []
+    for _ in range(nbr_tasks):
+        prio, stat, stat_pend, event_id, dly, stk_size, stk_used, sw, cyc, name = \
+            TASK.unpack_from(snap, off)
+        tasks.append(dict(prio=prio, stat=stat, stat_pend=stat_pend, event=event_id, dly=dly,
+                          stk_size=stk_size, stk_used=stk_used, sw=sw, cycles=cyc, name=cstr(name)))
+        off += TASK.size
+    for _ in range(nbr_events):
+        ident, typ, nbr_wait, cnt, entries, q_size, q_max, q_posts, name = EVENT.unpack_from(snap, off)
+        events.append(dict(id=ident, type=typ, wait=nbr_wait, cnt=cnt, entries=entries,
+                           size=q_size, max=q_max, posts=q_posts, name=cstr(name)))
+        off += EVENT.size
+    return dict(size=size, ts_freq=ts_freq, ts=ts, tick=tick, ctx_sw=ctx_sw, cycles=cycles,
+                cpu=cpu_usage, int_cycles=int_cycles, tasks=tasks, events=events)
+
+
+class Reader:
+    """Splits the UART byte stream into snapshots and application text."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.ok = self.bad = 0
+
+    def feed(self, data):
+        self.buf += data
+        snaps = []
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                keep = 1 if self.buf.endswith(SYNC[:1]) else 0
+                self.text += self.buf[:len(self.buf) - keep]
+                del self.buf[:len(self.buf) - keep]
+                break
+            self.text += self.buf[:i]
+            del self.buf[:i]
+            if len(self.buf) < 2 + HDR.size:
+                break
+            magic, = struct.unpack_from("<I", self.buf, 2)
+            size, = struct.unpack_from("<I", self.buf, 2 + 8)
+            if magic != MAGIC or size < HDR.size or size > 1 << 20:
+                del self.buf[:1]                     # Not a frame: resync
+                continue
+            if len(self.buf) < 2 + size + 2:
+                break
+            snap = bytes(self.buf[2:2 + size])
+            if fletcher16(snap) == tuple(self.buf[2 + size:4 + size]):
+                snaps.append(snap)
+                self.ok += 1
+                del self.buf[:4 + size]
+            else:                                    # Frame cut by other output
+                self.bad += 1
+                del self.buf[:1]
+        del self.text[:-4096]
+        return snaps
+
+
+def task_state(t):
+    if t["stat"] == 0:
+        return "DLY" if t["dly"] else "RDY"
+    return "+".join(name for bit, name in STAT_BITS if t["stat"] & bit)
+
+
+def render(cur, prev, names, reader, cost_max):
+    us = 1e6 / cur["ts_freq"]
+    ev_names = {e["id"]: e["name"] if e["name"] not in ("", "?") else "%s#%d" %
+                (EVENT_TYPES.get(e["type"], "?"), e["id"]) for e in cur["events"]}
+    prev_tasks = {t["prio"]: t for t in prev["tasks"]} if prev else {}
+    total = 0
+    if prev:
+        total = cur["int_cycles"] - prev["int_cycles"]
+        total += sum(t["cycles"] - prev_tasks[t["prio"]]["cycles"]
+                     for t in cur["tasks"] if t["prio"] in prev_tasks)
+    dt = (cur["tick"] - prev["tick"]) if prev else 0
+
+    out = ["uC/OS-II  tick %d  CPU %d%%  switches %d/tick  snapshot %d B in %.1f us (max %.1f us)"
+           "  frames %d ok, %d dropped" % (
+               cur["tick"], cur["cpu"], (cur["ctx_sw"] - prev["ctx_sw"]) // dt if dt else 0,
+               cur["size"], cur["cycles"] * us, cost_max * us, reader.ok, reader.bad), ""]
+    out.append("%4s  %-16s %-10s %-16s %8s %15s %6s %8s" %
+               ("PRIO", "TASK", "STATE", "WAITING ON", "DLY", "STACK USED", "CPU%", "SW"))
+    for t in cur["tasks"]:
+        name = names.get(t["prio"]) or (t["name"] if t["name"] not in ("", "?") else "")
+        p = prev_tasks.get(t["prio"])
+        cpu = 100.0 * (t["cycles"] - p["cycles"]) / total if p and total else 0.0
+        sw = t["sw"] - p["sw"] if p else 0
+        stack = "%d/%d" % (t["stk_used"], t["stk_size"]) if t["stk_size"] else "-"
+        event = ev_names.get(t["event"], "") if t["event"] != EVENT_NONE else ""
+        out.append("%4d  %-16s %-10s %-16s %8d %15s %6.1f %8d" %
+                   (t["prio"], name, task_state(t), event, t["dly"], stack, cpu, sw))
+    out.append("")
+    out.append("%4s  %-16s %-6s %5s %-14s %-12s %6s %10s" %
+               ("ID", "EVENT", "TYPE", "WAIT", "COUNT/OWNER", "MSGS/SIZE", "MAX", "POSTS"))
+    for e in cur["events"]:
+        typ = EVENT_TYPES.get(e["type"], str(e["type"]))
+        if e["type"] == 4:                           # Mutex: PIP in the high byte, owner in the low byte
+            owner = e["cnt"] & 0xFF
+            cnt = "free" if owner == MUTEX_AVAILABLE else "prio %d" % owner
+        elif e["type"] == 3:
+            cnt = str(e["cnt"])
+        else:
+            cnt = ""
+        msgs = "%d/%d" % (e["entries"], e["size"]) if e["type"] in QUEUE_TYPES else \
+            (str(e["entries"]) if e["type"] == 1 else "")
+        out.append("%4d  %-16s %-6s %5d %-14s %-12s %6s %10s" %
+                   (e["id"], ev_names[e["id"]], typ, e["wait"], cnt, msgs,
+                    e["max"] if e["type"] in QUEUE_TYPES else "",
+                    e["posts"] if e["type"] in QUEUE_TYPES else ""))
+    text = reader.text.decode("latin-1", "replace").splitlines()[-8:]
+    if text:
+        out += ["", "---- console ----"] + text
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("port", help="serial port of the board, or a file of captured frames")
+    parser.add_argument("-b", "--baud", type=int, default=115200)
+    parser.add_argument("-i", "--interval", type=float, default=1.0,
+                        help="seconds between snapshot requests (0: rely on OSVIEW_PERIODE)")
+    parser.add_argument("-n", "--name", action="append", default=[], metavar="PRIO=NAME",
+                        help="name of the task at a priority (repeatable)")
+    parser.add_argument("--once", action="store_true", help="print the last snapshot and exit")
+    args = parser.parse_args()
+
+    names = dict(TASK_NAMES)
+    for spec in args.name:
+        prio, name = spec.split("=", 1)
+        names[int(prio, 0)] = name
+
+    reader = Reader()
+    if args.once:
+        with open(args.port, "rb") as f:
+            snaps = reader.feed(f.read())
+        if not snaps:
+            sys.exit("no snapshot found (%d dropped)" % reader.bad)
+        cur = parse(snaps[-1])
+        prev = parse(snaps[-2]) if len(snaps) > 1 else None
+        print(render(cur, prev, names, reader, max(parse(s)["cycles"] for s in snaps)))
+        return
+
+    import serial
+    port = serial.Serial(args.port, args.baud, timeout=0.1)
+    prev, cost_max, last_req = None, 0, 0.0
+    try:
+        while True:
+            if args.interval and time.monotonic() - last_req >= args.interval:
+                port.write(b"s")
+                last_req = time.monotonic()
+            for snap in reader.feed(port.read(4096)):
+                cur = parse(snap)
+                cost_max = max(cost_max, cur["cycles"])
+                sys.stdout.write("\x1b[H\x1b[2J" + render(cur, prev, names, reader, cost_max) + "\n")
+                sys.stdout.flush()
+                prev = cur
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
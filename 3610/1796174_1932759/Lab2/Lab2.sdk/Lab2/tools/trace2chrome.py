@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Convert a uC/OS-II event trace (OSTrace, see src/ucos/os_trace.c) to the
+Chrome trace JSON format, which can be opened in Perfetto (ui.perfetto.dev)
+or chrome://tracing.
+
+Dump OSTrace from the board with XSCT once the trace is stopped
+(OSTraceStop() or OSTraceTrigger()), or copied with OSTraceSnap():
+
+    xsct% mrd -bin -file trace.bin [print &OSTrace] <sizeof(OSTrace) / 4>
+
+or with GDB:
+
+    (gdb) dump binary value trace.bin OSTrace
+
+then:
+
+    trace2chrome.py trace.bin -o trace.json -n 10=TaskGenerate -n 16=TaskForwarding
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x52544375
+HDR = struct.Struct("<IHHIIIIB3x")
+REC = struct.Struct("<IBBBBI")
+
+TASK_SW, ISR_ENTER, ISR_EXIT = 1, 2, 3
+TRIG = 12
+KERNEL_EVENTS = {
+    4: "OSQPost", 5: "OSQPend (block)",
+    6: "OSSemPost", 7: "OSSemPend (block)",
+    8: "OSMboxPost", 9: "OSMboxPend (block)",
+    10: "OSMutexPost", 11: "OSMutexPend (block)",
+}
+
+# GIC interrupt IDs used by bsp_init.c
+ISR_NAMES = {29: "timer_isr", 31: "XIntc_DeviceInterruptHandler"}
+
+# Kernel tasks, see os_cfg_r.h
+TASK_NAMES = {0: "OS_IntQTask", 62: "OS_TaskStat", 63: "OS_TaskIdle"}
+
+PID = 1
+ISR_TID = 1000
+
+
+def read_trace(data):
+    magic, version, rec_size, ts_freq, size, nbr_in, _, _ = HDR.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit("not an OSTrace dump (bad magic 0x%08x)" % magic)
+    if version != 1 or rec_size != REC.size:
+        sys.exit("unsupported OSTrace version %d (record size %d)" % (version, rec_size))
+    if len(data) < HDR.size + size * REC.size:
+        sys.exit("truncated dump: %d bytes, %d expected" % (len(data), HDR.size + size * REC.size))
+    if nbr_in <= size:
+        order = range(nbr_in)
+    else:                                    # Ring wrapped: oldest event at In % Size
+        order = [(nbr_in + i) % size for i in range(size)]
+    recs = [REC.unpack_from(data, HDR.size + i * REC.size) for i in order]
+    return ts_freq, nbr_in - len(recs), recs
+
+
+def unwrap(recs):
+    """Extend the 32-bit time stamps (the timer ISR keeps gaps far below a wrap)."""
+    ts_hi, prev = 0, None
+    for ts, *rest in recs:
+        if prev is not None and ts < prev:
+            ts_hi += 1 << 32
+        prev = ts
+        yield (ts_hi + ts, *rest)
+
+
+def convert(recs, ts_freq, task_names):
+    events = []
+    t0 = None
+    cur = None                               # (prio, start) of the running task
+    isr_stack = []
+    seen = set()
+
+    def us(cyc):
+        return (cyc - t0) * 1e6 / ts_freq
+
+    def task_slice(prio, start, end):
+        seen.add(prio)
+        events.append({"name": task_names.get(prio, "prio %d" % prio), "ph": "X", "pid": PID,
+                       "tid": prio, "ts": us(start), "dur": us(end) - us(start)})
+
+    for ts, typ, prio, nesting, _, arg in unwrap(recs):
+        if t0 is None:
+            t0 = ts
+            cur = (prio, ts)
+        if typ == TASK_SW:
+            if cur is not None:
+                task_slice(cur[0], cur[1], ts)
+            cur = (arg, ts)
+        elif typ == ISR_ENTER:
+            name = ISR_NAMES.get(arg, "IRQ %d" % arg)
+            isr_stack.append(name)
+            events.append({"name": name, "ph": "B", "pid": PID, "tid": ISR_TID, "ts": us(ts)})
+        elif typ == ISR_EXIT:
+            if isr_stack:                    # Skip exits whose entry was overwritten
+                events.append({"name": isr_stack.pop(), "ph": "E", "pid": PID, "tid": ISR_TID,
+                               "ts": us(ts)})
+        elif typ == TRIG:
+            events.append({"name": "trigger", "ph": "i", "s": "g", "pid": PID, "tid": prio,
+                           "ts": us(ts), "args": {"arg": arg}})
+        else:
+            tid = ISR_TID if nesting > 0 else prio
+            seen.add(prio)
+            events.append({"name": KERNEL_EVENTS.get(typ, "event %d" % typ), "ph": "i", "s": "t",
+                           "pid": PID, "tid": tid, "ts": us(ts),
+                           "args": {"event": "0x%08x" % arg}})
+    if cur is not None and recs:
+        task_slice(cur[0], cur[1], ts)
+
+    meta = [{"name": "process_name", "ph": "M", "pid": PID, "args": {"name": "uC/OS-II"}},
+            {"name": "thread_name", "ph": "M", "pid": PID, "tid": ISR_TID, "args": {"name": "ISR"}}]
+    for prio in sorted(seen):
+        meta.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": prio,
+                     "args": {"name": "%s (%d)" % (task_names.get(prio, "task"), prio)}})
+        meta.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": prio,
+                     "args": {"sort_index": prio}})
+    return meta + events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("dump", help="binary dump of OSTrace")
+    parser.add_argument("-o", "--output", default="-", help="JSON output (default: stdout)")
+    parser.add_argument("-n", "--name", action="append", default=[], metavar="PRIO=NAME",
+                        help="name of the task at a priority (repeatable)")
+    args = parser.parse_args()
+
+    task_names = dict(TASK_NAMES)
+    for spec in args.name:
+        prio, name = spec.split("=", 1)
+        task_names[int(prio, 0)] = name
+
+    with open(args.dump, "rb") as f:
+        ts_freq, lost, recs = read_trace(f.read())
+    trace = {"traceEvents": convert(recs, ts_freq, task_names), "displayTimeUnit": "ns"}
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    json.dump(trace, out)
+    if out is not sys.stdout:
+        out.close()
+    print("%d events (%d overwritten)" % (len(recs), lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -56,6 +56,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a sdm  07/11/11 First release
+* 6.3a  inf  10/18/26 Added XPM_CNTRCFG12 and Xpm_ReadEventCounters for
+*		      counting per task without stopping the counters.
 * </pre>
 *
 ******************************************************************************/
@@ -540,6 +542,13 @@ extern "C" {
  *			  XPM_EVENT_DATA_CACHEREFILL,
  *			  XPM_EVENT_DATA_CACHEACCESS,
  *			  XPM_EVENT_DATA_TLBREFILL }
+ *
+ * XPM_CNTRCFG12	{ XPM_EVENT_INSTRRENAME,
+ *			  XPM_EVENT_DATA_CACHEACCESS,
+ *			  XPM_EVENT_DATA_CACHEREFILL,
+ *			  XPM_EVENT_DATA_TLBREFILL,
+ *			  XPM_EVENT_BRANCHMISS,
+ *			  XPM_EVENT_DATASTALL }
  */
 #define XPM_CNTRCFG1	0
 #define XPM_CNTRCFG2	1
@@ -552,6 +561,7 @@ extern "C" {
 #define XPM_CNTRCFG9	8
 #define XPM_CNTRCFG10	9
 #define XPM_CNTRCFG11	10
+#define XPM_CNTRCFG12	11
 
 /**************************** Type Definitions ******************************/
 
@@ -564,6 +574,7 @@ extern "C" {
 /* Interface fuctions to access perfromance counters from abstraction layer */
 void Xpm_SetEvents(s32 PmcrCfg);
 void Xpm_GetEventCounters(u32 *PmCtrValue);
+void Xpm_ReadEventCounters(u32 *PmCtrValue);
 
 #ifdef __cplusplus
 }
@@ -57,6 +57,10 @@
 *		      from uncached area. Fix for CR #663885.
 * 2.1   srt  07/15/14 Add support for Zynq Ultrascale Mp architecture.
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.4   inf  10/18/26 Added XEmacPs_BdRingFromHwRxBurst,
+*		      XEmacPs_BdRingRefillRx and XEmacPs_BdRingFromHwTxBurst,
+*		      which read each BD word once, invalidate the received
+*		      buffers in one batch and recycle BDs in bulk.
 *
 * </pre>
 ******************************************************************************/
@@ -863,6 +867,268 @@ u32 XEmacPs_BdRingFromHwRx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 }
 
 
+/*****************************************************************************/
+/**
+ * Burst version of XEmacPs_BdRingFromHwRx(). Claims up to BdLimit received
+ * BDs and copies out what the caller needs from each one, so that the BDs,
+ * which live in uncached memory, are read once per word:
+ *
+ * <pre>
+ *        NumBd = XEmacPs_BdRingFromHwRxBurst(MyRingPtr, MaxBd, &MyBdSet,
+ *                                            Frames, Lengths, 2),
+ *        for (i=0; i<NumBd; i++)
+ *        {
+ *           * Frames[i] holds Lengths[i] bytes, already invalidated *
+ *        }
+ *        XEmacPs_BdRingFree(MyRingPtr, NumBd, MyBdSet),
+ *        XEmacPs_BdRingRefillRx(MyRingPtr, NumBuf, Buffers),
+ * </pre>
+ *
+ * The received bytes of all the claimed buffers are invalidated in the data
+ * cache with a single Xil_DCacheInvalidateRanges() call, and the first line
+ * of each frame is prefetched, since the caller looks at the headers first.
+ * Prefetching the BDs themselves would be of no use in uncached memory.
+ *
+ * @param RingPtr is a pointer to the instance to be worked on.
+ * @param BdLimit is the maximum number of BDs to return in the set.
+ * @param BdSetPtr is an output parameter, it points to the first BD of the
+ *        set, to be given to XEmacPs_BdRingFree().
+ * @param FrameAddrs is an array of at least BdLimit entries that receives
+ *        the address of each frame (buffer address plus Headroom).
+ * @param Lengths is an array of at least BdLimit entries that receives the
+ *        length field of each BD.
+ * @param Headroom is the RX buffer offset programmed in the network
+ *        configuration register (0 to 3 bytes).
+ *
+ * @return
+ *   The number of BDs processed by hardware. A value of 0 indicates that no
+ *   data is available. No more than BdLimit BDs will be returned.
+ *
+ * @note The caller must not write to the received bytes before this call
+ *       (see Xil_DCacheInvalidateRanges()). Unlike XEmacPs_BdRingFromHwRx(),
+ *       the search stops at the end of the work group.
+ *
+ * @note This function should not be preempted by another XEmacPs_Bd function
+ *       call that modifies the BD space. It is the caller's responsibility to
+ *       provide a mutual exclusion mechanism.
+ *
+ *****************************************************************************/
+u32 XEmacPs_BdRingFromHwRxBurst(XEmacPs_BdRing * RingPtr, u32 BdLimit,
+				XEmacPs_Bd ** BdSetPtr, UINTPTR *FrameAddrs,
+				u32 *Lengths, u32 Headroom)
+{
+	XEmacPs_Bd *CurBdPtr;
+	u32 BdAddr;
+	u32 BdStr;
+	u32 BdCount;
+	u32 BdPartialCount;
+	u32 BdLimitLoc = BdLimit;
+	u32 i;
+
+	CurBdPtr = RingPtr->HwHead;
+	BdCount = 0U;
+	BdPartialCount = 0U;
+
+	if (BdLimitLoc > RingPtr->HwCnt) {
+		BdLimitLoc = RingPtr->HwCnt;
+	}
+
+	while (BdCount < BdLimitLoc) {
+		/* Word 0 holds the new bit, read it first */
+		BdAddr = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_ADDR_OFFSET);
+		if ((BdAddr & XEMACPS_RXBUF_NEW_MASK) == 0x00000000U) {
+			break;
+		}
+		BdStr = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_STAT_OFFSET);
+
+		FrameAddrs[BdCount] = (BdAddr & XEMACPS_RXBUF_ADD_MASK) + Headroom;
+		Lengths[BdCount] = BdStr & XEMACPS_RXBUF_LEN_MASK;
+		BdCount++;
+
+		if ((BdStr & XEMACPS_RXBUF_EOF_MASK) != 0x00000000U) {
+			BdPartialCount = 0U;
+		} else {
+			BdPartialCount++;
+		}
+
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	/* Subtract off any partial packet BDs found */
+	BdCount -= BdPartialCount;
+
+	if (BdCount == 0x00000000U) {
+		*BdSetPtr = NULL;
+	} else {
+		Xil_DCacheInvalidateRanges((const INTPTR *)FrameAddrs, Lengths,
+					   BdCount);
+		for (i = 0U; i < BdCount; i++) {
+			__builtin_prefetch((const void *)FrameAddrs[i]);
+		}
+
+		*BdSetPtr = RingPtr->HwHead;
+		RingPtr->HwCnt -= BdCount;
+		RingPtr->PostCnt += BdCount;
+		XEMACPS_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
+	}
+	return BdCount;
+}
+
+
+/*****************************************************************************/
+/**
+ * Gives a set of receive buffers to hardware in one step, in place of
+ * XEmacPs_BdRingAlloc(), XEmacPs_BdSetAddressRx() for each BD and
+ * XEmacPs_BdRingToHw(). Each BD gets one buffer, its status word is cleared
+ * and its new bit is cleared last, with the wrap bit of the last BD of the
+ * ring kept.
+ *
+ * @param RingPtr is a pointer to the instance to be worked on.
+ * @param NumBuf is the number of buffers in BufAddrs.
+ * @param BufAddrs is an array of buffer addresses, aligned on 4 bytes.
+ *
+ * @return
+ *   The number of buffers given to hardware, which is less than NumBuf when
+ *   fewer BDs are free. The caller keeps the remaining ones. 0 is also
+ *   returned if BDs are pending between XEmacPs_BdRingAlloc() and
+ *   XEmacPs_BdRingToHw().
+ *
+ * @note The buffers must not have dirty lines in the data cache, which could
+ *       be written back over the received data: they must have been flushed
+ *       or only read since they were last written by the CPU.
+ *
+ * @note This function should not be preempted by another XEmacPs_Bd function
+ *       call that modifies the BD space. It is the caller's responsibility to
+ *       provide a mutual exclusion mechanism.
+ *
+ *****************************************************************************/
+u32 XEmacPs_BdRingRefillRx(XEmacPs_BdRing * RingPtr, u32 NumBuf,
+			   const UINTPTR *BufAddrs)
+{
+	XEmacPs_Bd *CurBdPtr;
+	u32 NumBd = NumBuf;
+	u32 Wrap;
+	u32 i;
+
+	if (NumBd > RingPtr->FreeCnt) {
+		NumBd = RingPtr->FreeCnt;
+	}
+	if (RingPtr->PreCnt != 0x00000000U) {
+		NumBd = 0U;
+	}
+
+	CurBdPtr = RingPtr->FreeHead;
+	for (i = 0U; i < NumBd; i++) {
+		Wrap = ((UINTPTR)CurBdPtr == RingPtr->HighBdAddr) ?
+			XEMACPS_RXBUF_WRAP_MASK : 0U;
+		XEmacPs_BdWrite(CurBdPtr, XEMACPS_BD_STAT_OFFSET, 0U);
+		XEmacPs_BdWrite(CurBdPtr, XEMACPS_BD_ADDR_OFFSET,
+				(BufAddrs[i] & XEMACPS_RXBUF_ADD_MASK) | Wrap);
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	if (NumBd > 0x00000000U) {
+		/* XEmacPs_BdRingAlloc() and XEmacPs_BdRingToHw() in one step */
+		RingPtr->FreeHead = CurBdPtr;
+		RingPtr->PreHead = CurBdPtr;
+		RingPtr->FreeCnt -= NumBd;
+		RingPtr->HwTail = CurBdPtr;
+		RingPtr->HwCnt += NumBd;
+	}
+	return NumBd;
+}
+
+
+/*****************************************************************************/
+/**
+ * Burst version of XEmacPs_BdRingFromHwTx() followed by
+ * XEmacPs_BdRingFree(). Claims up to BdLimit BDs of frames that hardware
+ * has sent, copies out their buffer addresses, gives their status word back
+ * to the CPU (used bit set, wrap bit kept) and returns them to the free
+ * group, so that the caller only has to recycle the buffers.
+ *
+ * @param RingPtr is a pointer to the instance to be worked on.
+ * @param BdLimit is the maximum number of BDs to recycle.
+ * @param BufAddrs is an array of at least BdLimit entries that receives the
+ *        buffer address of each recycled BD.
+ *
+ * @return
+ *   The number of BDs recycled. Only whole frames are recycled. 0 is also
+ *   returned if sets retrieved by XEmacPs_BdRingFromHwTx() have not been
+ *   freed yet.
+ *
+ * @note This function should not be preempted by another XEmacPs_Bd function
+ *       call that modifies the BD space. It is the caller's responsibility to
+ *       provide a mutual exclusion mechanism.
+ *
+ *****************************************************************************/
+u32 XEmacPs_BdRingFromHwTxBurst(XEmacPs_BdRing * RingPtr, u32 BdLimit,
+				UINTPTR *BufAddrs)
+{
+	XEmacPs_Bd *CurBdPtr;
+	u32 BdStr;
+	u32 BdCount;
+	u32 BdPartialCount;
+	u32 Sop = 0U;
+	u32 BdLimitLoc = BdLimit;
+	u32 i;
+
+	CurBdPtr = RingPtr->HwHead;
+	BdCount = 0U;
+	BdPartialCount = 0U;
+
+	if (BdLimitLoc > RingPtr->HwCnt) {
+		BdLimitLoc = RingPtr->HwCnt;
+	}
+	if (RingPtr->PostCnt != 0x00000000U) {
+		BdLimitLoc = 0U;
+	}
+
+	/* Hardware sets the used bit of the first BD of each frame sent */
+	while (BdCount < BdLimitLoc) {
+		BdStr = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_STAT_OFFSET);
+		if (Sop == 0x00000000U) {
+			if ((BdStr & XEMACPS_TXBUF_USED_MASK) == 0x00000000U) {
+				break;
+			}
+			Sop = 1U;
+		}
+
+		BufAddrs[BdCount] = XEmacPs_BdRead(CurBdPtr, XEMACPS_BD_ADDR_OFFSET);
+		BdCount++;
+		BdPartialCount++;
+
+		if ((BdStr & XEMACPS_TXBUF_LAST_MASK) != 0x00000000U) {
+			Sop = 0U;
+			BdPartialCount = 0U;
+		}
+
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	/* Subtract off any partial packet BDs found */
+	BdCount -= BdPartialCount;
+
+	CurBdPtr = RingPtr->HwHead;
+	for (i = 0U; i < BdCount; i++) {
+		XEmacPs_BdWrite(CurBdPtr, XEMACPS_BD_STAT_OFFSET,
+				XEMACPS_TXBUF_USED_MASK |
+				(((UINTPTR)CurBdPtr == RingPtr->HighBdAddr) ?
+				 XEMACPS_TXBUF_WRAP_MASK : 0U));
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	if (BdCount > 0x00000000U) {
+		/* XEmacPs_BdRingFromHwTx() and XEmacPs_BdRingFree() in one step */
+		RingPtr->HwHead = CurBdPtr;
+		RingPtr->HwCnt -= BdCount;
+		RingPtr->PostHead = CurBdPtr;
+		RingPtr->FreeCnt += BdCount;
+	}
+	return BdCount;
+}
+
+
 /*****************************************************************************/
 /**
  * Frees a set of BDs that had been previously retrieved with
@@ -47,6 +47,7 @@
 * 1.00a wsy  01/10/10 First release
 * 2.1   srt  07/15/14 Add support for Zynq Ultrascale Mp architecture.
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.4   inf  10/18/26 Added burst completion and refill functions.
 *
 * </pre>
 *
@@ -228,6 +229,17 @@ u32 XEmacPs_BdRingFromHwRx(XEmacPs_BdRing * RingPtr, u32 BdLimit,
 				 XEmacPs_Bd ** BdSetPtr);
 LONG XEmacPs_BdRingCheck(XEmacPs_BdRing * RingPtr, u8 Direction);
 
+/*
+ * Burst completion and refill, see xemacps_bdring.c
+ */
+u32 XEmacPs_BdRingFromHwRxBurst(XEmacPs_BdRing * RingPtr, u32 BdLimit,
+				XEmacPs_Bd ** BdSetPtr, UINTPTR *FrameAddrs,
+				u32 *Lengths, u32 Headroom);
+u32 XEmacPs_BdRingRefillRx(XEmacPs_BdRing * RingPtr, u32 NumBuf,
+			   const UINTPTR *BufAddrs);
+u32 XEmacPs_BdRingFromHwTxBurst(XEmacPs_BdRing * RingPtr, u32 BdLimit,
+				UINTPTR *BufAddrs);
+
 
 #ifdef __cplusplus
 }
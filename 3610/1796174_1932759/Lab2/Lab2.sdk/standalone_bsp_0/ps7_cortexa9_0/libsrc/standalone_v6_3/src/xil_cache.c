@@ -92,6 +92,15 @@
 * 5.03	 pkp 10/07/15 L2 Cache functionalities are avoided for the OpenAMP slave
 *					  application(when USE_AMP flag is defined for BSP) as master CPU
 *					  would be utilizing L2 cache for its operation
+* 5.03a  inf 10/18/26 Xil_DCacheFlushRange and Xil_DCacheInvalidateRange work
+*					  in blocks of XIL_CACHE_RANGE_BLOCK bytes with interrupts
+*					  masked per block only, and issue one L2 cache sync per
+*					  block instead of one per line (L2 maintenance by PA is
+*					  atomic). Ranges of XIL_CACHE_L1_ALL_THRESHOLD and
+*					  XIL_CACHE_L2_ALL_THRESHOLD bytes or more are flushed with
+*					  the whole L1 (set/way) or L2 (way) cache instead.
+* 5.03b  inf 10/18/26 Added Xil_DCacheInvalidateRanges to invalidate a set of
+*					  DMA receive buffers with one L2 cache sync and one dsb.
 *
 * </pre>
 *
@@ -115,6 +124,20 @@
 
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * Range maintenance: bytes handled with interrupts masked at a time, and
+ * range lengths from which the whole L1 (32 KB, 1024 lines by set/way) or
+ * L2 (512 KB, background operation by way) cache is flushed instead of
+ * walking the range line by line. See Xil_DCacheFlushRange().
+ */
+#define XIL_CACHE_RANGE_BLOCK		4096U
+#ifndef XIL_CACHE_L1_ALL_THRESHOLD
+#define XIL_CACHE_L1_ALL_THRESHOLD	(32U * 1024U)
+#endif
+#ifndef XIL_CACHE_L2_ALL_THRESHOLD
+#define XIL_CACHE_L2_ALL_THRESHOLD	(256U * 1024U)
+#endif
+
 #ifdef __GNUC__
 	extern s32  _stack_end;
 	extern s32  __undef_stack;
@@ -325,7 +348,12 @@ void Xil_DCacheInvalidateLine(u32 adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		Interrupts are masked for XIL_CACHE_RANGE_BLOCK bytes at a time.
+*			From XIL_CACHE_L1_ALL_THRESHOLD (L1) or XIL_CACHE_L2_ALL_THRESHOLD
+*			(L2) bytes, the whole cache is flushed (cleaned and invalidated)
+*			instead: dirty lines of the range, if any, are then written back
+*			rather than lost, which only matters if the CPU wrote to a buffer
+*			owned by a DMA.
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
@@ -334,9 +362,15 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 	u32 end;
 	u32 tempadr = adr;
 	u32 tempend;
+	u32 blockend;
+	u32 LocalAddr;
 	u32 currmask;
+	u32 AllL1 = (len >= XIL_CACHE_L1_ALL_THRESHOLD) ? 1U : 0U;
+#ifndef USE_AMP
+	u32 AllL2 = (len >= XIL_CACHE_L2_ALL_THRESHOLD) ? 1U : 0U;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
+#endif
 
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
@@ -374,28 +408,130 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 			Xil_L2CacheSync();
 #endif
 		}
+		mtcpsr(currmask);
 
-		while (tempadr < tempend) {
+		/* L2 before L1, so that L1 cannot refill from stale L2 lines */
 #ifndef USE_AMP
-			/* Invalidate L2 cache line */
-			*L2CCOffset = tempadr;
-			Xil_L2CacheSync();
+		if (AllL2 != 0U) {
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+			Xil_L2CacheFlush();
+			mtcpsr(currmask);
+		}
+		if ((AllL1 == 0U) || (AllL2 == 0U)) {
+#else
+		if (AllL1 == 0U) {
 #endif
+			while (tempadr < tempend) {
+				blockend = tempadr + XIL_CACHE_RANGE_BLOCK;
+				if ((blockend > tempend) || (blockend < tempadr)) {
+					blockend = tempend;
+				}
+
+				currmask = mfcpsr();
+				mtcpsr(currmask | IRQ_FIQ_MASK);
+#ifndef USE_AMP
+				if (AllL2 == 0U) {
+					/* Invalidate L2 cache lines, then wait once */
+					for (LocalAddr = tempadr; LocalAddr < blockend;
+					     LocalAddr += cacheline) {
+						*L2CCOffset = LocalAddr;
+					}
+					Xil_L2CacheSync();
+				}
+#endif
+				if (AllL1 == 0U) {
+					/* Invalidate L1 Data cache lines */
+					for (LocalAddr = tempadr; LocalAddr < blockend;
+					     LocalAddr += cacheline) {
+#if defined (__GNUC__) || defined (__ICCARM__)
+						asm_cp15_inval_dc_line_mva_poc(LocalAddr);
+#else
+						{ volatile register u32 Reg
+							__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
+						  Reg = LocalAddr; }
+#endif
+					}
+					dsb();
+				}
+				mtcpsr(currmask);
+				tempadr = blockend;
+			}
+		}
+
+		if (AllL1 != 0U) {
+			Xil_L1DCacheFlush();
+		}
+		currmask = mfcpsr();
+		mtcpsr(currmask | IRQ_FIQ_MASK);
+	}
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate a set of ranges in the Data cache, such as the buffers
+*			of a burst of received frames: L2 lines of every range, one L2
+*			cache sync, then L1 lines of every range and one dsb.
+*
+* @param	adr: array of 32bit start addresses.
+* @param	len: array of lengths in bytes, one per address.
+* @param	count: number of ranges.
+*
+* @return	None.
+*
+* @note		Unlike Xil_DCacheInvalidateRange(), the edge lines are not
+*			cleaned: each range is widened to whole cache lines, all of which
+*			must belong to buffers written by a DMA. Interrupts are masked for
+*			one range at a time.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRanges(const INTPTR *adr, const u32 *len, u32 count)
+{
+	const u32 cacheline = 32U;
+	u32 i;
+	u32 LocalAddr;
+	u32 end;
+	u32 currmask;
+#ifndef USE_AMP
+	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
+				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
 
-	/* Invalidate L1 Data cache line */
+	/* L2 before L1, so that L1 cannot refill from stale L2 lines */
+	for (i = 0U; i < count; i++) {
+		end = (u32)adr[i] + len[i];
+		currmask = mfcpsr();
+		mtcpsr(currmask | IRQ_FIQ_MASK);
+		for (LocalAddr = (u32)adr[i] & (~(cacheline - 1U));
+		     LocalAddr < end; LocalAddr += cacheline) {
+			*L2CCOffset = LocalAddr;
+		}
+		mtcpsr(currmask);
+	}
+	Xil_L2CacheSync();
+#endif
+
+	/* Select L1 Data cache in CSSR */
+	mtcp(XREG_CP15_CACHE_SIZE_SEL, 0U);
+	for (i = 0U; i < count; i++) {
+		end = (u32)adr[i] + len[i];
+		currmask = mfcpsr();
+		mtcpsr(currmask | IRQ_FIQ_MASK);
+		for (LocalAddr = (u32)adr[i] & (~(cacheline - 1U));
+		     LocalAddr < end; LocalAddr += cacheline) {
 #if defined (__GNUC__) || defined (__ICCARM__)
-			asm_cp15_inval_dc_line_mva_poc(tempadr);
+			asm_cp15_inval_dc_line_mva_poc(LocalAddr);
 #else
 			{ volatile register u32 Reg
 				__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
-			  Reg = tempadr; }
+			  Reg = LocalAddr; }
 #endif
-			tempadr += cacheline;
 		}
+		mtcpsr(currmask);
 	}
-
 	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************/
@@ -471,7 +607,12 @@ void Xil_DCacheFlushLine(u32 adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The range is flushed XIL_CACHE_RANGE_BLOCK bytes at a time, L1
+*			lines then L2 lines, with interrupts masked for one block only and
+*			a single L2 cache sync per block. From XIL_CACHE_L1_ALL_THRESHOLD
+*			bytes the whole L1 cache is flushed by set/way instead, and from
+*			XIL_CACHE_L2_ALL_THRESHOLD bytes the whole L2 cache by way (with
+*			interrupts masked until the background operation completes).
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
@@ -479,40 +620,80 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
 	u32 end;
+	u32 blockend;
+	u32 tempadr;
 	u32 currmask;
+	u32 AllL1 = (len >= XIL_CACHE_L1_ALL_THRESHOLD) ? 1U : 0U;
+#ifndef USE_AMP
+	u32 AllL2 = (len >= XIL_CACHE_L2_ALL_THRESHOLD) ? 1U : 0U;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
-
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
+#endif
 
 	if (len != 0U) {
+		/* L1 before L2, so that L1 dirty lines reach memory */
+		if (AllL1 != 0U) {
+			Xil_L1DCacheFlush();
+		}
+
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
 		 */
 		end = LocalAddr + len;
 		LocalAddr &= ~(cacheline - 1U);
 
-		while (LocalAddr < end) {
-
-	/* Flush L1 Data cache line */
+#ifndef USE_AMP
+		if ((AllL1 == 0U) || (AllL2 == 0U)) {
+#else
+		if (AllL1 == 0U) {
+#endif
+			while (LocalAddr < end) {
+				blockend = LocalAddr + XIL_CACHE_RANGE_BLOCK;
+				if ((blockend > end) || (blockend < LocalAddr)) {
+					blockend = end;
+				}
+
+				currmask = mfcpsr();
+				mtcpsr(currmask | IRQ_FIQ_MASK);
+				if (AllL1 == 0U) {
+					/* Flush L1 Data cache lines */
+					for (tempadr = LocalAddr; tempadr < blockend;
+					     tempadr += cacheline) {
 #if defined (__GNUC__) || defined (__ICCARM__)
-			asm_cp15_clean_inval_dc_line_mva_poc(LocalAddr);
+						asm_cp15_clean_inval_dc_line_mva_poc(tempadr);
 #else
-			{ volatile register u32 Reg
-				__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
-			  Reg = LocalAddr; }
+						{ volatile register u32 Reg
+							__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
+						  Reg = tempadr; }
 #endif
+					}
+					dsb();
+				}
 #ifndef USE_AMP
-			/* Flush L2 cache line */
-			*L2CCOffset = LocalAddr;
-			Xil_L2CacheSync();
+				if (AllL2 == 0U) {
+					/* Flush L2 cache lines, then wait once */
+					for (tempadr = LocalAddr; tempadr < blockend;
+					     tempadr += cacheline) {
+						*L2CCOffset = tempadr;
+					}
+					Xil_L2CacheSync();
+				}
 #endif
-			LocalAddr += cacheline;
+				mtcpsr(currmask);
+				LocalAddr = blockend;
+			}
 		}
+
+#ifndef USE_AMP
+		if (AllL2 != 0U) {
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+			Xil_L2CacheFlush();
+			mtcpsr(currmask);
+		}
+#endif
 	}
 	dsb();
-	mtcpsr(currmask);
 }
 /****************************************************************************/
 /**
@@ -46,6 +46,8 @@
 * 1.00a sdm  07/11/11 First release
 * 3.07a asa  08/30/12 Updated for CR 675636 to provide the L2 Base Address
 *		      inside the APIs
+* 6.3a  inf  10/18/26 Added XL2cc_EventCtrRead to read the counters while
+*		      they count.
 * </pre>
 *
 ******************************************************************************/
@@ -151,6 +153,28 @@ void XL2cc_EventCtrStop(u32 *EveCtr0, u32 *EveCtr1)
 	XL2cc_EventCtrReset();
 }
 
+/****************************************************************************/
+/**
+*
+* @brief	This function returns the values of the event counters in L2
+*			Cache controller, without disabling or resetting them.
+*
+* @param	EveCtr0: Output parameter which is used to return the value
+*			in event counter 0.
+*			EveCtr1: Output parameter which is used to return the value
+*			in event counter 1.
+*
+* @return	None.
+*
+* @note		The counters saturate at 0xFFFFFFFF instead of wrapping.
+*
+*****************************************************************************/
+void XL2cc_EventCtrRead(u32 *EveCtr0, u32 *EveCtr1)
+{
+	*EveCtr1 = *((volatile u32*)(XPS_L2CC_BASEADDR + XPS_L2CC_EVNT_CNT1_VAL_OFFSET));
+	*EveCtr0 = *((volatile u32*)(XPS_L2CC_BASEADDR + XPS_L2CC_EVNT_CNT0_VAL_OFFSET));
+}
+
 /****************************************************************************/
 /**
 *
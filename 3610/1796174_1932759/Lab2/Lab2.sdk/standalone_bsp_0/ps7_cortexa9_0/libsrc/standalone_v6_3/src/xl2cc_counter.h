@@ -54,6 +54,8 @@
 * 1.00a sdm  07/11/11 First release
 * 3.07a asa  08/30/12 Updated for CR 675636 to provide the L2 Base Address
 *		      inside the APIs
+* 6.3a  inf  10/18/26 Added XL2cc_EventCtrRead to read the counters while
+*		      they count.
 * </pre>
 *
 ******************************************************************************/
@@ -102,6 +104,7 @@ extern "C" {
 void XL2cc_EventCtrInit(s32 Event0, s32 Event1);
 void XL2cc_EventCtrStart(void);
 void XL2cc_EventCtrStop(u32 *EveCtr0, u32 *EveCtr1);
+void XL2cc_EventCtrRead(u32 *EveCtr0, u32 *EveCtr1);
 
 #ifdef __cplusplus
 }
@@ -46,6 +46,8 @@
 * 1.00a sdm  07/11/11 First release
 * 4.2	pkp	 07/21/14 Corrected reset value of event counter in function
 *					  Xpm_ResetEventCounters to fix CR#796275
+* 6.3a  inf  10/18/26 Added XPM_CNTRCFG12 and Xpm_ReadEventCounters, which
+*		      reads the counters without disabling them.
 * </pre>
 *
 ******************************************************************************/
@@ -243,6 +245,14 @@ void Xpm_SetEvents(s32 PmcrCfg)
 		XPM_EVENT_DATA_CACHEACCESS,
 		XPM_EVENT_DATA_TLBREFILL
 	},
+	{
+		XPM_EVENT_INSTRRENAME,
+		XPM_EVENT_DATA_CACHEACCESS,
+		XPM_EVENT_DATA_CACHEREFILL,
+		XPM_EVENT_DATA_TLBREFILL,
+		XPM_EVENT_BRANCHMISS,
+		XPM_EVENT_DATASTALL
+	},
 	};
 	const u32 *ptr = PmcrEvents[PmcrCfg];
 
@@ -295,3 +305,39 @@ void Xpm_GetEventCounters(u32 *PmCtrValue)
 #endif
 	}
 }
+
+/****************************************************************************/
+/**
+*
+* @brief	This function returns the counter values without disabling the
+*			event counters, so that they can be sampled while they count
+*			(e.g. at each context switch).
+*
+* @param	PmCtrValue: Pointer to an array of type u32 PmCtrValue[6].
+*			It is an output parameter which is used to return the PM
+*			counter values.
+*
+* @return	None.
+*
+* @note		The counters keep counting while they are read: the values
+*			are not a snapshot of a single instant. The caller must not be
+*			interrupted by code that selects another counter.
+*
+*****************************************************************************/
+void Xpm_ReadEventCounters(u32 *PmCtrValue)
+{
+	u32 Counter;
+
+	for(Counter = 0U; Counter < XPM_CTRCOUNT; Counter++) {
+
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, Counter);
+#ifdef __GNUC__
+		PmCtrValue[Counter] = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+#elif defined (__ICCARM__)
+		mfcp(XREG_CP15_PERF_MONITOR_COUNT, PmCtrValue[Counter]);
+#else
+		{ register u32 Cp15Reg __asm(XREG_CP15_PERF_MONITOR_COUNT);
+		  PmCtrValue[Counter] = Cp15Reg; }
+#endif
+	}
+}